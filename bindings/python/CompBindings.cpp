@@ -68,6 +68,8 @@ void registerCompilation(py::module_& m) {
         .def_readwrite("maxConstexprBacktrace", &CompilationOptions::maxConstexprBacktrace)
         .def_readwrite("maxDefParamSteps", &CompilationOptions::maxDefParamSteps)
         .def_readwrite("maxInstanceArray", &CompilationOptions::maxInstanceArray)
+        .def_readwrite("maxElaborationTime", &CompilationOptions::maxElaborationTime)
+        .def_readwrite("maxElaborationMemory", &CompilationOptions::maxElaborationMemory)
         .def_readwrite("errorLimit", &CompilationOptions::errorLimit)
         .def_readwrite("typoCorrectionLimit", &CompilationOptions::typoCorrectionLimit)
         .def_readwrite("minTypMax", &CompilationOptions::minTypMax)
@@ -167,13 +169,14 @@ void registerCompilation(py::module_& m) {
         .value("v1800_2023", LanguageVersion::v1800_2023)
         .value("Default", LanguageVersion::Default);
 
-    py::class_<Driver>(m, "Driver")
-        .def(py::init<>())
+    py::class_<Driver> driver(m, "Driver");
+    driver.def(py::init<>())
         .def_readonly("sourceManager", &Driver::sourceManager)
         .def_readonly("diagEngine", &Driver::diagEngine)
         .def_readonly("diagClient", &Driver::diagClient)
         .def_readonly("sourceLoader", &Driver::sourceLoader)
         .def_readonly("syntaxTrees", &Driver::syntaxTrees)
+        .def_readwrite("batchConfigs", &Driver::batchConfigs)
         .def_readwrite("languageVersion", &Driver::languageVersion)
         .def("addStandardArgs", &Driver::addStandardArgs)
         .def(
@@ -184,22 +187,36 @@ void registerCompilation(py::module_& m) {
             "arg"_a, "parseOptions"_a = CommandLine::ParseOptions{})
         .def("processCommandFiles", &Driver::processCommandFiles, "fileName"_a, "makeRelative"_a,
              "separateUnit"_a)
+        .def("loadBatchFiles", &Driver::loadBatchFiles, "pattern"_a)
         .def("processOptions", &Driver::processOptions)
         .def("runPreprocessor", &Driver::runPreprocessor, "includeComments"_a,
              "includeDirectives"_a, "obfuscateIds"_a, "useFixedObfuscationSeed"_a = false)
         .def("reportMacros", &Driver::reportMacros)
         .def("parseAllSources", &Driver::parseAllSources)
         .def("createOptionBag", &Driver::createOptionBag)
-        .def("createCompilation", &Driver::createCompilation)
+        .def("createCompilation", py::overload_cast<>(&Driver::createCompilation))
+        .def("createCompilation",
+             py::overload_cast<const Driver::BatchConfig&>(&Driver::createCompilation),
+             "config"_a)
         .def("reportParseDiags", &Driver::reportParseDiags)
-        .def("reportCompilation", &Driver::reportCompilation, "compilation"_a, "quiet"_a);
+        .def("reportCompilation", &Driver::reportCompilation, "compilation"_a, "quiet"_a)
+        .def("runBatch", &Driver::runBatch, "quiet"_a);
+
+    py::class_<Driver::BatchConfig>(driver, "BatchConfig")
+        .def(py::init<>())
+        .def_readwrite("name", &Driver::BatchConfig::name)
+        .def_readwrite("topModules", &Driver::BatchConfig::topModules)
+        .def_readwrite("paramOverrides", &Driver::BatchConfig::paramOverrides)
+        .def_readwrite("compat", &Driver::BatchConfig::compat);
 
     py::class_<SourceOptions>(m, "SourceOptions")
         .def(py::init<>())
         .def_readwrite("numThreads", &SourceOptions::numThreads)
         .def_readwrite("singleUnit", &SourceOptions::singleUnit)
         .def_readwrite("onlyLint", &SourceOptions::onlyLint)
-        .def_readwrite("librariesInheritMacros", &SourceOptions::librariesInheritMacros);
+        .def_readwrite("librariesInheritMacros", &SourceOptions::librariesInheritMacros)
+        .def_readwrite("maxParseTime", &SourceOptions::maxParseTime)
+        .def_readwrite("maxParseMemory", &SourceOptions::maxParseMemory);
 
     py::class_<SourceLoader> sourceLoader(m, "SourceLoader");
     sourceLoader.def(py::init<SourceManager&>(), "sourceManager"_a)
@@ -309,16 +309,22 @@ void registerNumeric(py::module_& m) {
                         return py::cast(arg);
                     else if constexpr (std::is_same_v<T, ConstantValue::UnboundedPlaceholder>)
                         return py::cast(arg);
-                    else if constexpr (std::is_same_v<T, ConstantValue::Elements>)
-                        return py::cast(arg);
+                    else if constexpr (std::is_same_v<T, ConstantValue::Unpacked>)
+                        return py::cast(*arg);
                     else if constexpr (std::is_same_v<T, std::string>)
                         return py::cast(arg);
-                    else if constexpr (std::is_same_v<T, ConstantValue::Map>)
-                        return py::cast(*arg);
+                    else if constexpr (std::is_same_v<T, ConstantValue::Map>) {
+                        py::dict result;
+                        for (auto& [key, val] : *arg)
+                            result[py::cast(key)] = py::cast(val);
+                        return result;
+                    }
                     else if constexpr (std::is_same_v<T, ConstantValue::Queue>)
-                        return py::cast(*arg);
+                        return py::cast(std::vector<ConstantValue>(arg->begin(), arg->end()));
                     else if constexpr (std::is_same_v<T, ConstantValue::Union>)
                         return py::cast(*arg);
+                    else if constexpr (std::is_same_v<T, ConstantValue::Dense>)
+                        return py::cast(arg->expand());
                     else
                         static_assert(always_false<T>::value, "Missing case");
                 },
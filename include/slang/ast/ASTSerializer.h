@@ -12,7 +12,8 @@
 namespace slang {
 
 class ConstantValue;
-class JsonWriter;
+class StructuredWriter;
+class ThreadPool;
 
 } // namespace slang
 
@@ -24,15 +25,17 @@ class Compilation;
 class Constraint;
 class Expression;
 class Pattern;
+class Scope;
 class Statement;
 class Symbol;
 class TimingControl;
 
-/// A class that serializes AST nodes to JSON.
+/// A class that serializes AST nodes to JSON, or to any other format
+/// supported by a StructuredWriter.
 class SLANG_EXPORT ASTSerializer {
 public:
     /// Constructs a new instance of the ASTSerializer class.
-    ASTSerializer(Compilation& compilation, JsonWriter& writer);
+    ASTSerializer(Compilation& compilation, StructuredWriter& writer);
 
     /// Sets a flag that indicates whether the addresses of AST objects
     /// should be included in the JSON output.
@@ -42,6 +45,19 @@ public:
     /// information should be included in the JSON output.
     void setIncludeSourceInfo(bool set) { includeSourceInfo = set; }
 
+    /// Sets a thread pool to use for serializing the members of the outermost scope
+    /// being serialized in parallel, such as the compilation units and top-level
+    /// instances of the root of the design. Each member is written to its own in-memory
+    /// fragment and the fragments are appended in their original order, so the output
+    /// is identical to serializing serially. This has no effect if the writer does not
+    /// support fragments.
+    ///
+    /// @note Serialization reads lazily computed state throughout the AST, so the pool
+    /// is only used once Compilation::isFullyElaborated returns true (for example after
+    /// a complete call to Compilation::getAllDiagnostics). Otherwise everything is
+    /// serialized on the calling thread.
+    void setThreadPool(ThreadPool* pool) { threadPool = pool; }
+
     /// Serializes a symbol to JSON.
     void serialize(const Symbol& symbol, bool inMembersArray = false);
 
@@ -170,8 +186,11 @@ private:
     template<typename T>
     void visit(const T& symbol, bool inMembersArray = false);
 
+    bool serializeMembersParallel(const Scope& scope);
+
     Compilation& compilation;
-    JsonWriter& writer;
+    StructuredWriter& writer;
+    ThreadPool* threadPool = nullptr;
     bool includeAddrs = true;
     bool includeSourceInfo = false;
 };
@@ -7,6 +7,7 @@
 //------------------------------------------------------------------------------
 #pragma once
 
+#include <functional>
 #include <memory>
 
 #include "slang/ast/OpaqueInstancePath.h"
@@ -17,6 +18,7 @@
 #include "slang/syntax/SyntaxNode.h"
 #include "slang/util/Bag.h"
 #include "slang/util/BumpAllocator.h"
+#include "slang/util/CancellationToken.h"
 #include "slang/util/IntervalMap.h"
 #include "slang/util/LanguageVersion.h"
 #include "slang/util/SafeIndexedVector.h"
@@ -31,7 +33,10 @@ class AttributeSymbol;
 class ASTContext;
 class CompilationUnitSymbol;
 class ConfigBlockSymbol;
+class ConstEvalProfiler;
+class ConstFunctionMemo;
 class DefinitionSymbol;
+class EvalProgram;
 class Expression;
 class GenericClassDefSymbol;
 class InterfacePortSymbol;
@@ -129,9 +134,26 @@ enum class SLANG_EXPORT CompilationFlags {
 
     /// Allow merging ANSI port declarations with nets and variables
     /// declared in the module body.
-    AllowMergingAnsiPorts = 1 << 14
+    AllowMergingAnsiPorts = 1 << 14,
+
+    /// Defer binding the bodies of subroutines declared in packages and classes
+    /// until they are called, override or implement a called method, are exported
+    /// via DPI, or are explicitly visited, instead of binding all of them during elaboration.
+    /// Diagnostics inside bodies that are never needed are not reported.
+    /// This has no effect when LintMode is also set.
+    LazySubroutineBodies = 1 << 15,
+
+    /// Evaluate constant function calls by walking the AST of their bodies
+    /// instead of compiling them to bytecode first. Results are the same
+    /// either way; this is mostly useful for debugging the bytecode compiler.
+    DisableConstBytecode = 1 << 16,
+
+    /// Record the number of calls, statement steps, wall time and allocations
+    /// spent evaluating each constant function and parameter initializer.
+    /// The results are available via Compilation::getConstEvalProfiler.
+    ProfileConstEval = 1 << 17
 };
-SLANG_BITMASK(CompilationFlags, AllowMergingAnsiPorts)
+SLANG_BITMASK(CompilationFlags, ProfileConstEval)
 
 /// Contains various options that can control compilation behavior.
 struct SLANG_EXPORT CompilationOptions {
@@ -162,6 +184,11 @@ struct SLANG_EXPORT CompilationOptions {
     /// before abbreviating them.
     uint32_t maxConstexprBacktrace = 10;
 
+    /// The maximum number of results of pure constant function calls to
+    /// remember for reuse by later calls with the same arguments.
+    /// Setting this to zero disables memoization.
+    uint32_t maxConstexprMemoEntries = 65536;
+
     /// The maximum number of iterations to try to resolve defparams before
     /// giving up due to potentially cyclic dependencies in parameter values.
     uint32_t maxDefParamSteps = 128;
@@ -172,6 +199,14 @@ struct SLANG_EXPORT CompilationOptions {
     /// The maximum depth of recursive generic class specializations.
     uint32_t maxRecursiveClassSpecialization = 8;
 
+    /// The maximum wall clock time, in milliseconds, that elaboration is allowed
+    /// to take before it is cancelled. Zero means there is no limit.
+    uint32_t maxElaborationTime = 0;
+
+    /// The maximum number of bytes the compilation is allowed to allocate for
+    /// its AST before elaboration is cancelled. Zero means there is no limit.
+    uint64_t maxElaborationMemory = 0;
+
     /// The maximum number of errors that can be found before we short circuit
     /// the tree walking process.
     uint32_t errorLimit = 64;
@@ -307,6 +342,13 @@ public:
     /// Indicates whether the design has been compiled and can no longer accept modifications.
     bool isFinalized() const { return finalized; }
 
+    /// Indicates whether every symbol, statement, and expression in the design has been
+    /// elaborated, which is the case once @a getSemanticDiagnostics has run to completion
+    /// without being stopped, cancelled, or deferring any subroutine bodies. Nothing is
+    /// lazily created after that point, so the design can be safely read from multiple
+    /// threads at once.
+    bool isFullyElaborated() const { return fullyElaborated; }
+
     /// Gets the diagnostics produced during lexing, preprocessing, and syntax parsing.
     const Diagnostics& getParseDiagnostics();
 
@@ -319,6 +361,42 @@ public:
     /// Gets all of the diagnostics produced during compilation.
     const Diagnostics& getAllDiagnostics();
 
+    /// A callback that receives batches of semantic diagnostics during elaboration.
+    /// Returning false stops elaboration as soon as possible, for example because
+    /// the client has already reported as many errors as it wants to.
+    using DiagnosticCallback = std::function<bool(const Diagnostics&)>;
+
+    /// @brief Streams semantic diagnostics to the given callback as they are found.
+    ///
+    /// Instead of being held until the whole design has been elaborated, diagnostics
+    /// are delivered in batches as each instance finishes. Diagnostics from different
+    /// instances of the same definition are only coalesced within a batch; later
+    /// copies of a diagnostic that has already been delivered are dropped, unless
+    /// their arguments differ. Delivered diagnostics are not kept in memory and are
+    /// not included in the results of getSemanticDiagnostics or getAllDiagnostics.
+    ///
+    /// Pass nullptr to go back to collecting diagnostics.
+    void setDiagnosticCallback(DiagnosticCallback callback);
+
+    /// Delivers all semantic diagnostics found so far to the diagnostic callback.
+    /// Does nothing if no callback has been set. This is called automatically
+    /// during elaboration.
+    void flushDiagnostics();
+
+    /// Indicates whether the diagnostic callback has asked for elaboration to stop.
+    bool isElaborationStopped() const { return elaborationStopped; }
+
+    /// @brief Gets the token that can be used to cancel elaboration.
+    ///
+    /// The token's budget is set from the maxElaborationTime and maxElaborationMemory
+    /// options when elaboration starts. It can also be cancelled from another thread,
+    /// after which elaboration stops as soon as possible with an error diagnostic.
+    CancellationToken& getCancellationToken() { return cancellation; }
+
+    /// Checks whether elaboration has been cancelled, either explicitly or
+    /// because it has used up its time or memory budget.
+    bool isCancelled() { return cancellation.poll(getBytesAllocated()); }
+
     /// @}
     /// @name Utility and convenience methods
     /// @{
@@ -569,6 +647,42 @@ public:
     /// The second item is only relevant for nodes where it makes sense; e.g. variables and nets.
     std::pair<bool, bool> isReferenced(const syntax::SyntaxNode& node) const;
 
+    /// Notes that the given subroutine is called somewhere in the AST.
+    /// This is only tracked when CompilationFlags::LazySubroutineBodies is set,
+    /// in which case it's used to decide which subroutine bodies need to be bound.
+    void noteSubroutineCall(const SubroutineSymbol& subroutine);
+
+    /// Checks whether a call to the given subroutine has been noted via
+    /// @a noteSubroutineCall thus far.
+    bool isSubroutineCalled(const SubroutineSymbol& subroutine) const {
+        return calledSubroutines.contains(&subroutine);
+    }
+
+    /// Notes that @a impl implements the interface class method @a ifaceMethod.
+    /// Calls made through an interface class handle can dispatch to any of its
+    /// implementations, so like @a noteSubroutineCall this is only tracked when
+    /// CompilationFlags::LazySubroutineBodies is set.
+    void noteInterfaceMethodImpl(const SubroutineSymbol& ifaceMethod,
+                                 const SubroutineSymbol& impl);
+
+    /// Gets the interface class methods that @a impl has been noted as implementing
+    /// via @a noteInterfaceMethodImpl thus far.
+    std::span<const SubroutineSymbol* const> getImplementedInterfaceMethods(
+        const SubroutineSymbol& impl) const;
+
+    /// Gets the bytecode program for evaluating calls to the given subroutine,
+    /// compiling it on first use. Returns nullptr if the subroutine can't be
+    /// compiled, in which case it must be evaluated by walking its body's AST.
+    const EvalProgram* getEvalProgram(const SubroutineSymbol& subroutine);
+
+    /// Gets the table used to memoize the results of pure constant function
+    /// calls. Returns nullptr if memoization has been disabled.
+    ConstFunctionMemo* getConstFunctionMemo();
+
+    /// Gets the profiler that records the cost of constant evaluation.
+    /// Returns nullptr unless the ProfileConstEval flag is set.
+    ConstEvalProfiler* getConstEvalProfiler();
+
     /// Notes that the given symbol has a name conflict in its parent scope.
     /// This will cause appropriate errors to be issued.
     void noteNameConflict(const Symbol& symbol);
@@ -671,6 +785,19 @@ public:
     /// @name Allocation functions
     /// @{
 
+    /// Constructs a new object using the compilation's allocator.
+    /// This hides BumpAllocator::emplace so that symbols created via the
+    /// compilation can be counted when time tracing is enabled.
+    template<typename T, typename... Args>
+    T* emplace(Args&&... args) {
+        auto result = BumpAllocator::emplace<T>(std::forward<Args>(args)...);
+        if constexpr (std::is_base_of_v<Symbol, T>) {
+            if (traceSymbols)
+                noteSymbolCreated(result->kind);
+        }
+        return result;
+    }
+
     /// Allocates space for a constant value in the pool of constants.
     ConstantValue* allocConstant(ConstantValue&& value) {
         return constantAllocator.emplace(std::move(value));
@@ -731,9 +858,11 @@ private:
     std::span<const AttributeSymbol* const> getAttributes(const void* ptr) const;
 
     Diagnostic& addDiag(Diagnostic diag);
+    void noteSymbolCreated(SymbolKind kind);
 
     const RootSymbol& getRoot(bool skipDefParamsAndBinds);
     void elaborate();
+    void coalesceDiags(Diagnostics& results);
     void insertDefinition(Symbol& symbol, const Scope& scope);
     void parseParamOverrides(flat_hash_map<std::string_view, const ConstantValue*>& results);
     void checkDPIMethods(std::span<const SubroutineSymbol* const> dpiImports);
@@ -789,6 +918,25 @@ private:
     // for things like variables and nets.
     flat_hash_map<const syntax::SyntaxNode*, std::pair<bool, bool>> referenceStatusMap;
 
+    // A set of subroutines that have been called, used to decide which
+    // deferred subroutine bodies need binding.
+    flat_hash_set<const SubroutineSymbol*> calledSubroutines;
+
+    // Map from methods that implement interface class methods to the
+    // interface methods they implement.
+    flat_hash_map<const SubroutineSymbol*, std::vector<const SubroutineSymbol*>>
+        interfaceMethodImpls;
+
+    // A cache of compiled constant function bodies. Null entries are for
+    // subroutines that couldn't be compiled.
+    flat_hash_map<const SubroutineSymbol*, std::unique_ptr<EvalProgram>> evalPrograms;
+
+    // Results of previous pure constant function calls, created on first use.
+    std::unique_ptr<ConstFunctionMemo> constFunctionMemo;
+
+    // Records constant evaluation costs, created on first use if profiling is enabled.
+    std::unique_ptr<ConstEvalProfiler> constEvalProfiler;
+
     // The name map for all module, interface, program, and primitive definitions.
     // The key is a combination of definition name + the scope in which it was declared.
     // The value is a pair -- the first element is a list of definitions that share
@@ -839,6 +987,15 @@ private:
     using DiagMap = flat_hash_map<std::tuple<DiagCode, SourceLocation>, std::vector<Diagnostic>>;
     DiagMap diagMap;
 
+    // When streaming diagnostics, the callback that receives them, along with a
+    // fingerprint of the arguments of the first diagnostic delivered for each
+    // code and location so that repeats can be dropped.
+    DiagnosticCallback diagCallback;
+    flat_hash_map<std::tuple<DiagCode, SourceLocation>, size_t> streamedDiags;
+
+    // Cancels elaboration when asked to or when it goes over its budget.
+    CancellationToken cancellation;
+
     // A list of libraries that control the order in which we search for cell bindings.
     std::vector<const SourceLibrary*> defaultLiblist;
 
@@ -856,7 +1013,10 @@ private:
     size_t numErrors = 0; // total number of errors inserted into the diagMap
     bool finalized = false;
     bool finalizing = false; // to prevent reentrant calls to getRoot()
+    bool elaborationStopped = false; // set when the diagnostic callback asks to stop
+    bool fullyElaborated = false;    // set when elaborate() has visited everything
     bool anyElemsWithTimescales = false;
+    bool traceSymbols = false; // set when time tracing was enabled at construction
     uint32_t typoCorrections = 0;
     int nextEnumSystemId = 1;
     int nextStructSystemId = 1;
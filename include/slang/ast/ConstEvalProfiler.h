@@ -0,0 +1,141 @@
+//------------------------------------------------------------------------------
+//! @file ConstEvalProfiler.h
+//! @brief Attribution of constant evaluation cost to functions and parameters
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "slang/util/Hash.h"
+#include "slang/util/SmallVector.h"
+
+namespace slang::ast {
+
+class Symbol;
+
+/// @brief Records where time is spent during constant evaluation.
+///
+/// Each call of a constant function and each evaluation of a parameter's
+/// initializer is tracked as a scope. For every function and parameter the
+/// profiler accumulates the number of times it was entered along with the
+/// statement steps, wall time, and SVInt heap allocations spent inside it,
+/// both including and excluding nested scopes.
+///
+/// When time tracing is enabled each scope is also recorded as a trace event,
+/// so long running evaluations show up in the timeline along with the rest
+/// of elaboration.
+///
+/// Profiling is enabled via CompilationFlags::ProfileConstEval. Like the
+/// rest of elaboration, the profiler is not safe to use from multiple threads.
+class SLANG_EXPORT ConstEvalProfiler {
+public:
+    using Duration = std::chrono::steady_clock::duration;
+
+    /// Accumulated costs for a single function or parameter.
+    struct Entry {
+        /// The subroutine or parameter symbol.
+        const Symbol* symbol;
+
+        /// A printable name for the symbol.
+        std::string name;
+
+        /// The number of times the symbol's scope was entered.
+        uint64_t calls = 0;
+
+        /// The number of statement steps taken, including nested scopes.
+        uint64_t steps = 0;
+
+        /// The number of statement steps taken directly in this scope.
+        uint64_t selfSteps = 0;
+
+        /// The wall time spent, including nested scopes.
+        Duration time{};
+
+        /// The wall time spent directly in this scope.
+        Duration selfTime{};
+
+        /// The number of SVInt heap allocations, including nested scopes.
+        uint64_t allocations = 0;
+
+        /// The number of SVInt heap allocations made directly in this scope.
+        uint64_t selfAllocations = 0;
+
+        /// Constructs a new entry for the given symbol.
+        Entry(const Symbol& symbol, std::string name) : symbol(&symbol), name(std::move(name)) {}
+
+    private:
+        friend class ConstEvalProfiler;
+
+        // The number of currently active scopes for this entry,
+        // used to avoid double counting inclusive costs for recursion.
+        uint32_t activeDepth = 0;
+    };
+
+    /// An RAII helper that enters a scope on construction and exits it
+    /// on destruction. The profiler pointer may be null, in which case
+    /// nothing happens.
+    class Scope {
+    public:
+        Scope(ConstEvalProfiler* profiler, const Symbol& symbol) : profiler(profiler) {
+            if (profiler)
+                profiler->enter(symbol);
+        }
+
+        ~Scope() {
+            if (profiler)
+                profiler->exit();
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        ConstEvalProfiler* profiler;
+    };
+
+    ConstEvalProfiler();
+    ~ConstEvalProfiler();
+
+    /// Begins a new scope for the given subroutine or parameter.
+    void enter(const Symbol& symbol);
+
+    /// Ends the most recently entered scope.
+    void exit();
+
+    /// Records that a statement step was taken in the active scope.
+    void step() { totalSteps++; }
+
+    /// Gets all recorded entries, sorted by descending inclusive time.
+    std::vector<const Entry*> getEntries() const;
+
+    /// Gets the number of entries recorded so far.
+    size_t size() const { return entryMap.size(); }
+
+    /// Formats a report table of the @a maxEntries most expensive entries.
+    std::string report(size_t maxEntries) const;
+
+private:
+    struct ActiveScope {
+        Entry* entry;
+        std::chrono::steady_clock::time_point startTime;
+        uint64_t startSteps;
+        uint64_t startAllocations;
+        Duration childTime{};
+        uint64_t childSteps = 0;
+        uint64_t childAllocations = 0;
+    };
+
+    Entry& getEntry(const Symbol& symbol);
+
+    flat_hash_map<const Symbol*, std::unique_ptr<Entry>> entryMap;
+    SmallVector<ActiveScope> active;
+    uint64_t totalSteps = 0;
+};
+
+} // namespace slang::ast
@@ -0,0 +1,113 @@
+//------------------------------------------------------------------------------
+//! @file ConstFunctionMemo.h
+//! @brief Memoization of pure constant function calls
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "slang/ast/Lookup.h"
+#include "slang/numeric/ConstantValue.h"
+#include "slang/util/Hash.h"
+
+namespace slang::ast {
+
+class SubroutineSymbol;
+class ValueSymbol;
+
+/// @brief A table of results from previous constant function calls.
+///
+/// Designs frequently call the same constant function with the same arguments
+/// from many places, such as a width computation in every instance of a FIFO.
+/// For functions whose result depends only on their argument values this table
+/// lets the caller skip re-evaluating the body.
+///
+/// A function qualifies if nothing it (transitively) calls or references can
+/// make its result depend on where or how it's being evaluated. Parameters and
+/// enum values are allowed, since their values are fixed, but because constant
+/// function rules require them to be declared before the call site, a lookup
+/// is only allowed when all of them would pass that check.
+///
+/// Only calls with integral or string arguments that completed without issuing
+/// any diagnostics are recorded. Once the table reaches its size limit no new
+/// entries are added.
+class SLANG_EXPORT ConstFunctionMemo {
+public:
+    /// Constructs a new memo table that holds at most @a maxEntries results.
+    explicit ConstFunctionMemo(size_t maxEntries) : maxEntries(maxEntries) {}
+
+    /// Determines whether a call to the given subroutine from the given
+    /// location with the given argument values can use the table.
+    bool canMemoize(const SubroutineSymbol& subroutine, LookupLocation lookupLocation,
+                    std::span<const ConstantValue> args);
+
+    /// Looks up the result of a previous call with the same argument values.
+    /// Returns nullptr if there isn't one.
+    const ConstantValue* find(const SubroutineSymbol& subroutine,
+                              std::span<const ConstantValue> args);
+
+    /// Records the result of a call. Does nothing if the table is full.
+    void insert(const SubroutineSymbol& subroutine, std::span<const ConstantValue> args,
+                const ConstantValue& result);
+
+    /// Gets the number of lookups that found a previous result.
+    uint64_t getHitCount() const { return hits; }
+
+    /// Gets the number of lookups that did not find a previous result.
+    uint64_t getMissCount() const { return misses; }
+
+    /// Gets the number of results currently stored in the table.
+    size_t size() const { return results.size(); }
+
+private:
+    struct Purity {
+        bool isPure = false;
+        std::vector<const ValueSymbol*> declOrderChecked;
+    };
+
+    struct KeyView {
+        const SubroutineSymbol* subroutine;
+        std::span<const ConstantValue> args;
+    };
+
+    struct Key {
+        const SubroutineSymbol* subroutine;
+        std::vector<ConstantValue> args;
+
+        KeyView view() const { return {subroutine, args}; }
+    };
+
+    struct KeyHash {
+        using is_transparent = void;
+        size_t operator()(const KeyView& key) const;
+        size_t operator()(const Key& key) const { return (*this)(key.view()); }
+    };
+
+    struct KeyEqual {
+        using is_transparent = void;
+        bool operator()(const KeyView& lhs, const KeyView& rhs) const;
+        bool operator()(const Key& lhs, const Key& rhs) const {
+            return (*this)(lhs.view(), rhs.view());
+        }
+        bool operator()(const KeyView& lhs, const Key& rhs) const {
+            return (*this)(lhs, rhs.view());
+        }
+        bool operator()(const Key& lhs, const KeyView& rhs) const {
+            return (*this)(lhs.view(), rhs);
+        }
+    };
+
+    const Purity& getPurity(const SubroutineSymbol& subroutine);
+
+    flat_hash_map<const SubroutineSymbol*, Purity> purityCache;
+    flat_hash_map<Key, ConstantValue, KeyHash, KeyEqual> results;
+    size_t maxEntries;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+};
+
+} // namespace slang::ast
@@ -8,6 +8,9 @@
 #pragma once
 
 #include <map>
+#include <memory>
+#include <optional>
+#include <span>
 
 #include "slang/ast/ASTContext.h"
 #include "slang/numeric/ConstantValue.h"
@@ -17,6 +20,7 @@
 namespace slang::ast {
 
 class Compilation;
+class ConstEvalProfiler;
 class LValue;
 class SubroutineSymbol;
 class ValueSymbol;
@@ -35,8 +39,14 @@ public:
 
     /// Represents a single frame in the call stack.
     struct Frame {
-        /// A set of temporary values materialized within the stack frame.
-        /// Uses a map so that the values don't move around in memory.
+        /// Storage for the subroutine's local variables, indexed by the slots
+        /// assigned to them when the subroutine's body was bound. Entries are
+        /// empty until the corresponding local has been created.
+        std::span<std::optional<ConstantValue>> slots;
+
+        /// A set of temporary values materialized within the stack frame that
+        /// don't have an assigned slot. Uses a map so that the values don't
+        /// move around in memory.
         std::map<const ValueSymbol*, ConstantValue> temporaries;
 
         /// The function that is being executed in this frame, if any.
@@ -50,8 +60,7 @@ public:
     };
 
     /// Constructs a new EvalContext instance.
-    explicit EvalContext(const ASTContext& astCtx, bitmask<EvalFlags> flags = {}) :
-        astCtx(astCtx), flags(flags) {}
+    explicit EvalContext(const ASTContext& astCtx, bitmask<EvalFlags> flags = {});
 
     /// Gets the compilation associated with the context.
     Compilation& getCompilation() const { return astCtx.getCompilation(); }
@@ -161,6 +170,10 @@ public:
     /// Gets the set of diagnostics that have been produced during constant evaluation.
     Diagnostics getAllDiagnostics() const;
 
+    /// Gets the number of diagnostics (including warnings) that have been
+    /// produced during constant evaluation and not yet reported.
+    size_t getDiagnosticCount() const { return diags.size() + warnings.size(); }
+
     /// Records a diagnostic under the current evaluation context.
     Diagnostic& addDiag(DiagCode code, SourceLocation location);
 
@@ -177,12 +190,33 @@ public:
     void reportStack(Diagnostic& diag) const;
 
 private:
+    // Slot storage for frames is carved out of a list of blocks in stack
+    // order, so that the same memory gets reused by subsequent calls
+    // and pointers to locals remain stable while their frame is live.
+    struct SlotBlock {
+        std::unique_ptr<std::optional<ConstantValue>[]> data;
+        size_t capacity = 0;
+        size_t used = 0;
+    };
+
+    // Records where a frame's slots were allocated so they can be released.
+    struct SlotMark {
+        size_t block;
+        size_t offset;
+        size_t prevBlock;
+    };
+
+    std::span<std::optional<ConstantValue>> allocateSlots(size_t count);
     void reportDiags(Diagnostics& diagSet);
 
     uint32_t steps = 0;
+    ConstEvalProfiler* profiler = nullptr;
     const Symbol* disableTarget = nullptr;
     const ConstantValue* queueTarget = nullptr;
     SmallVector<Frame> stack;
+    SmallVector<SlotMark> slotMarks;
+    SmallVector<SlotBlock, 2> slotBlocks;
+    size_t currentSlotBlock = 0;
     SmallVector<LValue*> lvalStack;
     Diagnostics diags;
     Diagnostics warnings;
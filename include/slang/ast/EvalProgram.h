@@ -0,0 +1,104 @@
+//------------------------------------------------------------------------------
+//! @file EvalProgram.h
+//! @brief Bytecode compilation of constant functions
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "slang/ast/Statements.h"
+#include "slang/numeric/ConstantValue.h"
+
+namespace slang::ast {
+
+class EvalContext;
+class Expression;
+class SubroutineSymbol;
+class ValueSymbol;
+
+/// @brief A subroutine body compiled into register-based bytecode for constant evaluation.
+///
+/// Walking the AST to evaluate a constant function costs a virtual dispatch and
+/// a handful of checks per node, plus a fresh copy of every value that flows
+/// between nodes. Hot loops (CRC tables, LFSRs, log2 computations) instead get
+/// compiled into a flat list of instructions that operate on a fixed set of
+/// registers and directly on the storage of the function's local variables.
+///
+/// Only the common subset of statements and expressions is compiled -- loops,
+/// conditionals, blocks, local variable declarations and assignments, and
+/// operators applied to locals and literals. Everything else is embedded in the
+/// program as a single instruction that falls back to evaluating that node
+/// via the AST, so results and diagnostics are the same either way.
+class SLANG_EXPORT EvalProgram {
+public:
+    /// Compiles the body of the given subroutine. Returns nullptr if the body
+    /// can't be compiled at all, in which case it must be evaluated via its AST.
+    static std::unique_ptr<EvalProgram> compile(const SubroutineSymbol& subroutine);
+
+    /// Runs the program. The caller is expected to have already pushed a frame
+    /// for the subroutine onto the context's call stack, and to have created
+    /// locals for each argument and for the return value.
+    Statement::EvalResult run(EvalContext& context) const;
+
+    /// Gets the number of instructions in the program.
+    size_t getInstructionCount() const { return code.size(); }
+
+    /// Gets the number of AST nodes that are evaluated by falling
+    /// back to the AST interpreter instead of being compiled.
+    size_t getFallbackCount() const { return numFallbacks; }
+
+private:
+    class Compiler;
+
+    enum class OpCode : uint8_t {
+        Step,
+        Eval,
+        Exec,
+        Move,
+        Store,
+        Unary,
+        Binary,
+        Convert,
+        IncDec,
+        Select,
+        ShortCircuit,
+        Jump,
+        JumpIfFalse,
+        JumpIfTrue,
+        JumpIfUnknown,
+        DeclLocal,
+        BindLocal,
+        RepeatInit,
+        RepeatNext,
+        Exit
+    };
+
+    struct Instruction {
+        OpCode op;
+        uint8_t subop = 0;
+        uint32_t dst = 0;
+        uint32_t a = 0;
+        uint32_t b = 0;
+        uint32_t c = 0;
+        union {
+            const void* none = nullptr;
+            const Statement* stmt;
+            const Expression* expr;
+            const ValueSymbol* symbol;
+        };
+    };
+
+    std::vector<Instruction> code;
+    std::vector<ConstantValue> constants;
+    std::vector<const ValueSymbol*> localSymbols;
+    uint32_t numEntryLocals = 0;
+    uint32_t numRegisters = 0;
+    uint32_t numCounters = 0;
+    size_t numFallbacks = 0;
+};
+
+} // namespace slang::ast
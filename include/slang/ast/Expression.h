@@ -358,6 +358,16 @@ public:
     /// target operand. Otherwise returns `*this`.
     const Expression& unwrapImplicitConversions() const;
 
+    /// Applies the given (non-lvalue) unary operator to an already evaluated operand.
+    /// @returns the result of the operation.
+    static ConstantValue evalUnaryOperator(UnaryOperator op, const ConstantValue& cv);
+
+    /// Applies the given binary operator to already evaluated operands.
+    /// Short-circuiting is the responsibility of the caller.
+    /// @returns the result of the operation, or an empty value if it can't be computed.
+    static ConstantValue evalBinaryOperator(BinaryOperator op, const ConstantValue& cvl,
+                                            const ConstantValue& cvr);
+
     /// @brief Casts this expression to the given concrete derived type.
     ///
     /// Asserts that the type is appropriate given this expression's kind.
@@ -414,9 +424,6 @@ protected:
     static const Type* binaryOperatorType(Compilation& compilation, const Type* lt, const Type* rt,
                                           bool forceFourState, bool signednessFromRt = false);
 
-    static ConstantValue evalBinaryOperator(BinaryOperator op, const ConstantValue& cvl,
-                                            const ConstantValue& cvr);
-
     static Expression& create(Compilation& compilation, const ExpressionSyntax& syntax,
                               const ASTContext& context,
                               bitmask<ASTFlags> extraFlags = ASTFlags::None,
@@ -117,6 +117,9 @@ public:
     /// @returns the operand of the conversion
     Expression& operand() { return *operand_; }
 
+    /// Applies this conversion to an already evaluated operand value.
+    ConstantValue applyTo(EvalContext& context, ConstantValue&& value) const;
+
     ConstantValue evalImpl(EvalContext& context) const;
     std::optional<bitwidth_t> getEffectiveWidthImpl() const;
     EffectiveSign getEffectiveSignImpl(bool isForConversion) const;
@@ -110,6 +110,12 @@ public:
     bool isUninstantiated = false;
     const SVInt* arrayIndex = nullptr;
 
+    /// If this block is one iteration of a loop generate whose body does not
+    /// depend on the genvar, this points to the first iteration of that loop.
+    /// Declared types and parameter values of members are shared with it
+    /// instead of being resolved again for every iteration.
+    const GenerateBlockSymbol* prototype = nullptr;
+
     GenerateBlockSymbol(Compilation& compilation, std::string_view name, SourceLocation loc,
                         uint32_t constructIndex, bool isUninstantiated) :
         Symbol(SymbolKind::GenerateBlock, name, loc), Scope(compilation, this),
@@ -119,6 +125,11 @@ public:
 
     void serializeTo(ASTSerializer& serializer) const;
 
+    /// If the given symbol is a direct member of a generate block that has a
+    /// prototype, returns the corresponding member of that prototype block.
+    /// Otherwise returns nullptr.
+    static const Symbol* findPrototypeMember(const Symbol& member);
+
     static void fromSyntax(Compilation& compilation, const syntax::IfGenerateSyntax& syntax,
                            const ASTContext& context, uint32_t constructIndex,
                            bool isUninstantiated, SmallVectorBase<GenerateBlockSymbol*>& results);
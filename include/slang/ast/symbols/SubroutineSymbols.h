@@ -122,6 +122,15 @@ public:
     const Statement& getBody() const;
     const Type& getReturnType() const { return declaredReturnType.getType(); }
 
+    /// @return true if the body has already been bound via a call to @a getBody.
+    bool isBodyBound() const { return stmt != nullptr; }
+
+    /// Gets the variables local to this subroutine (including its arguments
+    /// and return value) that have storage slots assigned for use during
+    /// constant evaluation, indexed by slot number. Slots are assigned when
+    /// the body is bound, so this will bind it if that hasn't happened yet.
+    std::span<const VariableSymbol* const> getLocalSlots() const;
+
     void setOverride(const SubroutineSymbol& parentMethod) const;
     const SubroutineSymbol* getOverride() const { return overrides; }
 
@@ -176,9 +185,11 @@ public:
 
 private:
     void addThisVar(const Type& type);
+    void assignLocalSlots() const;
 
     std::span<const StatementBlockSymbol* const> blocks;
     mutable const Statement* stmt = nullptr;
+    mutable std::span<const VariableSymbol* const> localSlots;
     ArgList arguments;
     mutable const SubroutineSymbol* overrides = nullptr;
     mutable const MethodPrototypeSymbol* prototype = nullptr;
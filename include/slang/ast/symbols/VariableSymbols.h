@@ -51,6 +51,11 @@ public:
     VariableLifetime lifetime;
     bitmask<VariableFlags> flags;
 
+    /// If this variable is local to a subroutine, the index of its storage
+    /// slot in that subroutine's frames during constant evaluation.
+    /// @see SubroutineSymbol::getLocalSlots
+    mutable uint32_t localSlot = UINT32_MAX;
+
     VariableSymbol(std::string_view name, SourceLocation loc, VariableLifetime lifetime);
 
     void checkInitializer() const;
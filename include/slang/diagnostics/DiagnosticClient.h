@@ -17,6 +17,10 @@ public:
     virtual ~DiagnosticClient() = default;
     virtual void report(const ReportedDiagnostic& diagnostic) = 0;
 
+    /// Indicates whether the client makes use of the formatted message text of the
+    /// diagnostics it's given. If no client does, the engine skips formatting them.
+    virtual bool wantsFormattedMessage() const { return true; }
+
     void setEngine(const DiagnosticEngine& engine);
 
 protected:
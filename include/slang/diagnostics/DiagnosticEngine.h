@@ -82,6 +82,10 @@ public:
     /// is set to zero (the default) the limit is infinite.
     void setErrorLimit(int limit) { errorLimit = limit; }
 
+    /// Gets the limit on the number of errors that will be issued, or zero
+    /// if there is no limit.
+    int getErrorLimit() const { return errorLimit; }
+
     /// Sets whether all warnings should be ignored. Note that this does not apply to
     /// diagnostics that have an overridden severity specified via setSeverity().
     void setIgnoreAllWarnings(bool set) { ignoreAllWarnings = set; }
@@ -172,6 +176,10 @@ public:
     /// message for its diagnostic code.
     std::string formatMessage(const Diagnostic& diag) const;
 
+    /// Formats a single argument of the given diagnostic to a string, the same way
+    /// it would be formatted when substituted into the diagnostic's message.
+    std::string formatArg(const Diagnostic& diag, size_t index) const;
+
     /// Initializes diagnostic warnings to the default group.
     void setDefaultWarnings();
 
@@ -221,6 +229,7 @@ private:
     std::optional<DiagnosticSeverity> findMappedSeverity(DiagCode code,
                                                          SourceLocation location) const;
     bool issueImpl(const Diagnostic& diagnostic, DiagnosticSeverity severity);
+    std::string formatCustomArg(const Diagnostic::CustomArgType& arg) const;
 
     template<typename TDirective>
     void setMappingsFromPragmasImpl(BufferID buffer, std::span<const TDirective> directives,
@@ -0,0 +1,90 @@
+//------------------------------------------------------------------------------
+//! @file JsonDiagnosticClient.h
+//! @brief Diagnostic client that writes machine-readable JSON
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <deque>
+#include <iosfwd>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "slang/diagnostics/DiagnosticClient.h"
+#include "slang/text/Json.h"
+#include "slang/util/Hash.h"
+
+namespace slang {
+
+/// @brief A diagnostic client that writes diagnostics as structured JSON.
+///
+/// Two output formats are supported:
+/// - JSON Lines, where each diagnostic is written as a single self-contained
+///   JSON object on its own line.
+/// - SARIF 2.1.0, where the diagnostics are written as the results of a single
+///   run. Each diagnostic code becomes a rule and each file an artifact.
+///
+/// Rather than formatting each message into English text, the diagnostic's
+/// arguments are written as structured values next to its code, so consumers
+/// don't need to parse them back out of the message. If no other client needs
+/// formatted messages the engine skips formatting them altogether.
+///
+/// Output is written directly into a buffer that gets flushed to the stream
+/// in large chunks. @a finish must be called once all diagnostics have been
+/// issued to write any remaining output.
+class SLANG_EXPORT JsonDiagnosticClient : public DiagnosticClient {
+public:
+    /// The supported output formats.
+    enum class Format { JsonLines, Sarif };
+
+    /// Constructs a new client that writes to the given stream, which must
+    /// outlive the client.
+    JsonDiagnosticClient(std::ostream& stream, Format format = Format::JsonLines,
+                         size_t chunkSize = JsonWriter::DefaultChunkSize);
+    ~JsonDiagnosticClient();
+
+    /// Sets whether the formatted message text is included along with the
+    /// structured arguments (off by default).
+    void showMessage(bool show) { includeMessage = show; }
+
+    /// Sets whether the written locations include column numbers (on by default).
+    void showColumn(bool show) { includeColumn = show; }
+
+    bool wantsFormattedMessage() const override { return includeMessage; }
+
+    void report(const ReportedDiagnostic& diagnostic) override;
+
+    /// Finishes writing the output and flushes it to the stream.
+    /// No more diagnostics should be reported after this is called.
+    void finish();
+
+private:
+    void writeArgs(const Diagnostic& diag, bool asStrings);
+    void writeJsonLine(const ReportedDiagnostic& diag);
+    void writeSarifResult(const ReportedDiagnostic& diag);
+    void startSarif();
+    void writeArtifactUri(std::string_view fileName);
+    uint32_t getFileIndex(std::string_view fileName);
+    uint32_t getRuleIndex(DiagCode code);
+
+    JsonWriter writer;
+    Format format;
+    bool includeMessage = false;
+    bool includeColumn = true;
+    bool started = false;
+    bool finished = false;
+
+    // Files and diagnostic codes that have been seen so far, in the order
+    // they were first seen, along with lookup tables back to their indices.
+    // In SARIF mode these become the artifacts and rules of the run. File
+    // names are copied into a deque so the keys in the lookup table stay valid.
+    std::deque<std::string> files;
+    flat_hash_map<std::string_view, uint32_t> fileIndices;
+    std::vector<DiagCode> rules;
+    flat_hash_map<DiagCode, uint32_t> ruleIndices;
+};
+
+} // namespace slang
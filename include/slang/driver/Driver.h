@@ -8,6 +8,9 @@
 //------------------------------------------------------------------------------
 #pragma once
 
+#include <iosfwd>
+#include <span>
+
 #include "slang/diagnostics/DiagnosticEngine.h"
 #include "slang/driver/SourceLoader.h"
 #include "slang/text/SourceManager.h"
@@ -18,8 +21,9 @@
 #include "slang/util/Util.h"
 
 namespace slang {
+class JsonWriter;
 class TextDiagnosticClient;
-}
+} // namespace slang
 
 namespace slang::syntax {
 class SyntaxTree;
@@ -119,6 +123,14 @@ public:
         /// The number of threads to use for parsing.
         std::optional<uint32_t> numThreads;
 
+        /// The maximum wall clock time, in seconds, to spend loading and
+        /// parsing sources before giving up.
+        std::optional<double> maxParseTime;
+
+        /// The maximum amount of memory, in megabytes, that parsed syntax
+        /// trees can occupy before giving up.
+        std::optional<uint64_t> maxParseMemory;
+
         /// @}
         /// @name Compilation
         /// @{
@@ -143,9 +155,21 @@ public:
         /// before abbreviating them.
         std::optional<uint32_t> maxConstexprBacktrace;
 
+        /// The maximum number of pure constant function call results to
+        /// remember for reuse by later calls with the same arguments.
+        std::optional<uint32_t> maxConstexprMemoEntries;
+
         /// The maximum number of instances allowed in a single instance array.
         std::optional<uint32_t> maxInstanceArray;
 
+        /// The maximum wall clock time, in seconds, to spend elaborating
+        /// the design before giving up.
+        std::optional<double> maxElabTime;
+
+        /// The maximum amount of memory, in megabytes, that the elaborated
+        /// design can occupy before giving up.
+        std::optional<uint64_t> maxElabMemory;
+
         /// A string indicating a member of @a CompatMode to use for tailoring
         /// other compilation options.
         std::optional<std::string> compat;
@@ -209,6 +233,10 @@ public:
         /// The maximum number of errors to print before giving up.
         std::optional<uint32_t> errorLimit;
 
+        /// If true, print elaboration diagnostics as soon as each instance has
+        /// been elaborated instead of all at once at the end.
+        std::optional<bool> streamDiags;
+
         /// A list of warning options that will be passed to the DiagnosticEngine.
         std::vector<std::string> warningOptions;
 
@@ -229,6 +257,77 @@ public:
         bool lintMode() const;
     } options;
 
+    /// @brief A set of elaboration options for one configuration in a batch.
+    ///
+    /// Each configuration in a batch is elaborated separately from the same parsed
+    /// sources, with these options applied on top of the ones set for the driver.
+    struct BatchConfig {
+        /// The name used to refer to the configuration in the printed output.
+        std::string name;
+
+        /// The top-level modules to instantiate. If empty, the driver's
+        /// own list of top modules is used instead.
+        std::vector<std::string> topModules;
+
+        /// Parameter overrides to apply when instantiating top-level modules,
+        /// in addition to the driver's own. These take precedence when both
+        /// override the same parameter.
+        std::vector<std::string> paramOverrides;
+
+        /// The tool to increase compatibility with. If unset, the
+        /// driver's own compatibility setting is used instead.
+        std::optional<std::string> compat;
+    };
+
+    /// The configurations that will be elaborated by @a runBatch.
+    std::vector<BatchConfig> batchConfigs;
+
+    /// @brief The dependencies of one compilation unit, as found by @a scanDependencies.
+    ///
+    /// Names point into the unit's syntax tree and remain valid for as long as it does.
+    struct UnitDependencies {
+        /// The syntax tree for the compilation unit.
+        std::shared_ptr<syntax::SyntaxTree> tree;
+
+        /// The names of the source files that make up the unit.
+        std::vector<std::string> files;
+
+        /// The names of all files included by the unit, directly or indirectly.
+        std::vector<std::string> includes;
+
+        /// The names of the modules, interfaces, programs, primitives,
+        /// and packages declared in the unit.
+        std::vector<std::string_view> definitions;
+
+        /// The names of packages declared elsewhere that the unit refers to.
+        std::vector<std::string_view> packages;
+
+        /// The names of modules, interfaces, programs, and primitives declared
+        /// elsewhere that the unit instantiates (or uses as interface ports).
+        std::vector<std::string_view> instances;
+
+        /// The names of instantiated definitions and imported
+        /// packages that aren't declared by any unit.
+        std::vector<std::string_view> unresolved;
+
+        /// The indices of the other units that declare any of the
+        /// packages or definitions that this unit refers to.
+        std::vector<size_t> dependsOn;
+    };
+
+    /// The source files needed to elaborate a design, as found by @a findRequiredSources.
+    struct RequiredSources {
+        /// The source files that are needed, in the order they were loaded.
+        std::vector<BufferID> files;
+
+        /// The files included by the needed source files, directly or indirectly.
+        std::vector<BufferID> includes;
+
+        /// The names of definitions and packages referred to by the
+        /// needed source files that aren't declared anywhere.
+        std::vector<std::string_view> unresolved;
+    };
+
     /// Constructs a new instance of the @a Driver class.
     Driver();
 
@@ -270,6 +369,32 @@ public:
     /// @returns true on success and false if errors were encountered.
     bool processCommandFiles(std::string_view pattern, bool makeRelative, bool separateUnit);
 
+    /// A command file that was read while parsing a command line.
+    struct CommandFile {
+        /// The path to the file.
+        std::filesystem::path path;
+
+        /// The contents of the file at the time it was read.
+        std::string contents;
+
+        bool operator==(const CommandFile&) const = default;
+    };
+
+    /// Gets all of the command files that have been read so far, including ones
+    /// referenced from other command files, in the order in which they were read.
+    std::span<const CommandFile> getCommandFiles() const { return commandFiles; }
+
+    /// @brief Loads batch configurations from the given file(s) and appends them
+    /// to the @a batchConfigs list.
+    ///
+    /// Each non-empty line of a file describes one configuration with the
+    /// --name, --top, -G, and --compat options. Configurations that aren't
+    /// given a name are named after the file and line they come from.
+    /// Any errors encountered will be printed to stderr.
+    /// @param pattern a file path pattern indicating the batch file(s) to load.
+    /// @returns true on success and false if errors were encountered.
+    bool loadBatchFiles(std::string_view pattern);
+
     /// Processes and applies all configured options.
     /// @returns true on success and false if errors were encountered.
     [[nodiscard]] bool processOptions();
@@ -291,18 +416,92 @@ public:
     /// Prints all macros from all loaded buffers to stdout.
     void reportMacros();
 
+    /// @brief Finds the dependencies of each of the @a syntaxTrees without
+    /// elaborating them.
+    ///
+    /// Package and definition names are resolved purely from syntax, by matching
+    /// the names each unit refers to against the names declared at the top level
+    /// of all of the other units. This doesn't account for library ordering or
+    /// configurations, so a name declared in more than one unit depends on all of
+    /// them. Must be called after @a parseAllSources.
+    /// @returns the dependencies of each tree, in the same order as @a syntaxTrees.
+    [[nodiscard]] std::vector<UnitDependencies> scanDependencies() const;
+
+    /// @brief Writes the given dependencies in the depfile format understood by
+    /// Make and Ninja.
+    ///
+    /// If @a target is empty, each unit gets its own rule naming its first source file
+    /// as the target, with its includes and the files of the units it depends on as
+    /// prerequisites. Otherwise a single rule is written for @a target with every
+    /// source file, include file, and library map as prerequisites, which is the form
+    /// Ninja expects.
+    void writeDepfile(std::ostream& stream, std::span<const UnitDependencies> deps,
+                      std::string_view target) const;
+
+    /// Writes the given dependencies as a JSON dependency graph, with one object per
+    /// unit that refers to the other units it depends on by index.
+    static void writeDependencyGraph(JsonWriter& writer, std::span<const UnitDependencies> deps);
+
+    /// @brief Finds the source files needed to elaborate the design rooted at the
+    /// top modules given in the options, without elaborating it.
+    ///
+    /// Starting from the top modules, each definition and package that gets referred
+    /// to is looked up in @a compilation, which must have been created by this driver,
+    /// the same way elaboration would find it, and the syntax of everything found is in
+    /// turn searched for more references. Generate blocks are searched regardless of
+    /// their conditions, so the result is a superset of what any one set of parameter
+    /// values needs. A file is kept along with everything it was parsed with, so
+    /// files parsed as a single unit are all kept or all dropped together, and files
+    /// with bind directives outside of any module are always kept.
+    [[nodiscard]] RequiredSources findRequiredSources(const ast::Compilation& compilation) const;
+
+    /// @brief Writes the given sources as a command file that can be passed to the
+    /// -f option to load only those files.
+    ///
+    /// Files that belong to a library other than the default one, or that were loaded
+    /// as library files, are written with the -v option. Other options, such as include
+    /// directories and macro definitions, aren't written and still need to be passed
+    /// along with the file.
+    void writeFilelist(std::ostream& stream, const RequiredSources& sources) const;
+
     /// @brief Parses all loaded buffers into syntax trees and appends the resulting trees
     /// to the @a syntaxTrees list.
     ///
     /// @returns true on success and false if errors were encountered.
+    /// If parsing was cancelled @a wasParseCancelled returns true as well,
+    /// and the resulting syntax trees shouldn't be elaborated.
     [[nodiscard]] bool parseAllSources();
 
+    /// Returns true if the last call to @a parseAllSources was cancelled
+    /// because it exceeded its time or memory budget.
+    bool wasParseCancelled() const { return sourceLoader.wasCancelled(); }
+
+    /// @brief Brings the @a syntaxTrees list up to date with the files on disk.
+    ///
+    /// All previously loaded files are read again, and each syntax tree that depends
+    /// on a file that has changed (directly or through an include) gets reparsed.
+    /// All other syntax trees are left as they are. This is meant for long-lived
+    /// drivers that compile the same set of sources over and over, after an initial
+    /// call to @a parseAllSources. Note that `pragma diagnostic directives are only
+    /// checked again for the trees that get reparsed.
+    ///
+    /// @returns true if the syntax trees are up to date, and false if they can't be
+    /// updated in place -- because the files are parsed as a single unit, a library
+    /// map has changed, or a file can no longer be read -- in which case a new
+    /// driver should be used to start over.
+    [[nodiscard]] bool reparseChangedSources();
+
     /// Creates an options bag from all of the currently set options.
     [[nodiscard]] Bag createOptionBag() const;
 
     /// Creates a compilation object from all of the current loaded state of the driver.
     [[nodiscard]] std::unique_ptr<ast::Compilation> createCompilation();
 
+    /// Creates a compilation object from all of the current loaded state of the driver,
+    /// with the options from the given batch configuration applied. The syntax trees
+    /// are shared with any other compilations created by the driver.
+    [[nodiscard]] std::unique_ptr<ast::Compilation> createCompilation(const BatchConfig& config);
+
     /// Reports all parsing diagnostics found in all of the @a syntaxTrees
     /// @returns true on success and false if errors were encountered.
     [[nodiscard]] bool reportParseDiags();
@@ -313,17 +512,30 @@ public:
     /// @returns true if compilation succeeded and false if errors were encountered.
     [[nodiscard]] bool reportCompilation(ast::Compilation& compilation, bool quiet);
 
+    /// @brief Elaborates and reports a compilation for each of the @a batchConfigs.
+    ///
+    /// All of the compilations share the syntax trees that have already been parsed.
+    /// Unless the number of threads is set to one they are elaborated concurrently,
+    /// after which each one is reported in turn, the same way as @a reportCompilation.
+    /// If @a quiet is set to true, non-essential output will be suppressed.
+    /// @returns true if all of the compilations succeeded and false if errors were
+    /// encountered in any of them.
+    [[nodiscard]] bool runBatch(bool quiet);
+
 private:
     bool parseUnitListing(std::string_view text);
+    bool parseBatchConfig(std::string_view text, std::string_view location);
     void addLibraryFiles(std::string_view pattern);
     void addParseOptions(Bag& bag) const;
-    void addCompilationOptions(Bag& bag) const;
+    void addCompilationOptions(Bag& bag, const BatchConfig& config) const;
+    Diagnostics setDiagSeverities(bool vcsCompat);
     bool reportLoadErrors();
     void printError(const std::string& message);
     void printWarning(const std::string& message);
 
     bool anyFailedLoads = false;
     flat_hash_set<std::filesystem::path> activeCommandFiles;
+    std::vector<CommandFile> commandFiles;
 };
 
 } // namespace slang::driver
@@ -49,6 +49,14 @@ struct SLANG_EXPORT SourceOptions {
 
     /// If true, library files will inherit macro definitions from primary source files.
     bool librariesInheritMacros;
+
+    /// The maximum wall clock time, in milliseconds, that loading and parsing is
+    /// allowed to take before it is cancelled. Zero means there is no limit.
+    uint32_t maxParseTime = 0;
+
+    /// The maximum number of bytes that parsed syntax trees are allowed to
+    /// occupy before loading is cancelled. Zero means there is no limit.
+    uint64_t maxParseMemory = 0;
 };
 
 /// @brief Handles loading and parsing of groups of source files
@@ -131,6 +139,10 @@ public:
     /// and false if none have been added to the loader.
     bool hasFiles() const { return !fileEntries.empty(); }
 
+    /// Returns the paths of all source files that have been added to the loader,
+    /// with any glob patterns expanded, in the order in which they were added.
+    std::vector<std::filesystem::path> getFilePaths() const;
+
     /// Loads all of the sources that have been added to the loader,
     /// but does not parse them. Returns the loaded buffers.
     std::vector<SourceBuffer> loadSources();
@@ -141,6 +153,10 @@ public:
     /// Gets the list of errors that have occurred while loading files.
     std::span<const std::string> getErrors() const { return errors; }
 
+    /// Returns true if the last call to @a loadAndParseSources ran out of its
+    /// time or memory budget, in which case the returned trees are incomplete.
+    bool wasCancelled() const { return cancelled; }
+
     /// Gets a pointer to the source library with the given name, or adds it if
     /// it does not exist. Returns nullptr if @a name is empty.
     SourceLibrary* getOrAddLibrary(std::string_view name);
@@ -223,6 +239,7 @@ private:
     flat_hash_set<std::string_view> uniqueExtensions;
     std::vector<std::string> errors;
     SyntaxTreeList libraryMapTrees;
+    bool cancelled = false;
 
     static constexpr int MinFilesForThreading = 4;
 };
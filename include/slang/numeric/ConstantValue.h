@@ -7,20 +7,22 @@
 //------------------------------------------------------------------------------
 #pragma once
 
-#include <deque>
-#include <map>
+#include <atomic>
+#include <mutex>
 #include <string>
 #include <variant>
 #include <vector>
 
 #include "slang/numeric/SVInt.h"
-#include "slang/util/CopyPtr.h"
+#include "slang/util/CowPtr.h"
+#include "slang/util/Hash.h"
 #include "slang/util/Iterator.h"
 
 namespace slang {
 
-struct AssociativeArray;
-struct SVQueue;
+class AssociativeArray;
+class DenseArray;
+class SVQueue;
 struct SVUnion;
 
 /// Represents an IEEE754 double precision floating point number.
@@ -58,12 +60,20 @@ public:
     struct UnboundedPlaceholder : std::monostate {};
 
     using Elements = std::vector<ConstantValue>;
-    using Map = CopyPtr<AssociativeArray>;
-    using Queue = CopyPtr<SVQueue>;
-    using Union = CopyPtr<SVUnion>;
 
-    using Variant = std::variant<std::monostate, SVInt, real_t, shortreal_t, NullPlaceholder,
-                                 Elements, std::string, Map, Queue, Union, UnboundedPlaceholder>;
+    // Aggregate values are shared between copies until one of them is modified,
+    // so that large arrays can be passed around and read without copying them.
+    using Unpacked = CowPtr<Elements>;
+    using Map = CowPtr<AssociativeArray>;
+    using Queue = CowPtr<SVQueue>;
+    using Union = CowPtr<SVUnion>;
+
+    // Large arrays of integers can be stored densely instead; see DenseArray.
+    using Dense = CowPtr<DenseArray>;
+
+    using Variant =
+        std::variant<std::monostate, SVInt, real_t, shortreal_t, NullPlaceholder, Unpacked,
+                     std::string, Map, Queue, Union, UnboundedPlaceholder, Dense>;
 
     ConstantValue() = default;
     ConstantValue(nullptr_t) {}
@@ -75,8 +85,8 @@ public:
 
     ConstantValue(NullPlaceholder nul) : value(nul) {}
     ConstantValue(UnboundedPlaceholder unbounded) : value(unbounded) {}
-    ConstantValue(const Elements& elements) : value(elements) {}
-    ConstantValue(Elements&& elements) : value(std::move(elements)) {}
+    ConstantValue(const Elements& elements) : value(Unpacked(elements)) {}
+    ConstantValue(Elements&& elements) : value(Unpacked(std::move(elements))) {}
     ConstantValue(const std::string& str) : value(str) {}
     ConstantValue(std::string&& str) : value(std::move(str)) {}
 
@@ -95,6 +105,11 @@ public:
     ConstantValue(const SVUnion& unionVal) : value(Union(unionVal)) {}
     ConstantValue(SVUnion&& unionVal) : value(Union(std::move(unionVal))) {}
 
+    ConstantValue(const Dense& dense) : value(dense) {}
+    ConstantValue(Dense&& dense) : value(std::move(dense)) {}
+    ConstantValue(const DenseArray& dense) : value(Dense(dense)) {}
+    ConstantValue(DenseArray&& dense) : value(Dense(std::move(dense))) {}
+
     bool bad() const { return std::holds_alternative<std::monostate>(value); }
     explicit operator bool() const { return !bad(); }
 
@@ -103,7 +118,10 @@ public:
     bool isShortReal() const { return std::holds_alternative<shortreal_t>(value); }
     bool isNullHandle() const { return std::holds_alternative<NullPlaceholder>(value); }
     bool isUnbounded() const { return std::holds_alternative<UnboundedPlaceholder>(value); }
-    bool isUnpacked() const { return std::holds_alternative<Elements>(value); }
+    bool isUnpacked() const {
+        return std::holds_alternative<Unpacked>(value) || std::holds_alternative<Dense>(value);
+    }
+    bool isDense() const { return std::holds_alternative<Dense>(value); }
     bool isString() const { return std::holds_alternative<std::string>(value); }
     bool isMap() const { return std::holds_alternative<Map>(value); }
     bool isQueue() const { return std::holds_alternative<Queue>(value); }
@@ -119,8 +137,22 @@ public:
     real_t real() const { return std::get<real_t>(value); }
     shortreal_t shortReal() const { return std::get<shortreal_t>(value); }
 
-    std::span<ConstantValue> elements() { return std::get<Elements>(value); }
-    std::span<ConstantValue const> elements() const { return std::get<Elements>(value); }
+    /// Gets the elements of an unpacked value for modification. If the elements
+    /// are shared with other copies of this value they are cloned first, so
+    /// prefer the const overload when only reading. Dense arrays are expanded
+    /// into a value per element.
+    std::span<ConstantValue> elements() {
+        expandDense();
+        return *std::get<Unpacked>(value);
+    }
+
+    /// Gets the elements of an unpacked value for reading. Dense arrays don't
+    /// store a value per element, so this asserts if given one; for them use
+    /// @a getElement or iterate over the value instead.
+    std::span<ConstantValue const> elements() const {
+        SLANG_ASSERT(!isDense());
+        return *std::get<Unpacked>(value);
+    }
 
     std::string& str() & { return std::get<std::string>(value); }
     const std::string& str() const& { return std::get<std::string>(value); }
@@ -142,8 +174,18 @@ public:
     Union unionVal() && { return std::get<Union>(std::move(value)); }
     Union unionVal() const&& { return std::get<Union>(std::move(value)); }
 
+    Dense& dense() & { return std::get<Dense>(value); }
+    const Dense& dense() const& { return std::get<Dense>(value); }
+    Dense dense() && { return std::get<Dense>(std::move(value)); }
+    Dense dense() const&& { return std::get<Dense>(std::move(value)); }
+
     ConstantValue getSlice(int32_t upper, int32_t lower, const ConstantValue& defaultValue) const;
 
+    /// Allows aggregate storage in this value to be shared with copies again after
+    /// it has been modified. Only call this once no references obtained from non-const
+    /// accessors of this value are still in use.
+    void allowSharing();
+
     Variant& getVariant() { return value; }
     const Variant& getVariant() const { return value; }
 
@@ -155,9 +197,24 @@ public:
     [[nodiscard]] bool empty() const;
     size_t size() const;
 
+    /// Gets a reference to the element at the given index of an unpacked array or queue.
+    /// The non-const overload expands dense arrays first; the const overload asserts if
+    /// given one, since there is no element value to refer to.
     ConstantValue& at(size_t index);
     const ConstantValue& at(size_t index) const;
 
+    /// Gets a copy of the element at the given index of an unpacked array or queue.
+    /// Unlike @a at this works for dense arrays without expanding them.
+    ConstantValue getElement(size_t index) const&;
+
+    /// Takes the element at the given index of an unpacked array or queue, moving it
+    /// out of this value if the storage isn't shared with any other copies.
+    ConstantValue getElement(size_t index) &&;
+
+    /// If this value is a dense array, converts it into a normal unpacked array with
+    /// a value per element. Does nothing for any other kind of value.
+    void expandDense();
+
     bool isTrue() const;
     bool isFalse() const;
     bool hasUnknown() const;
@@ -173,6 +230,15 @@ public:
     /// Gets the size of this value when converted to a bitstream.
     uint64_t getBitstreamWidth() const;
 
+    /// Creates a value for a fixed-size unpacked array with the given elements. If they
+    /// are all integers of the same width and signedness and there are enough of them
+    /// they are stored densely.
+    static ConstantValue createArray(Elements&& elements);
+
+    /// Creates a value for a fixed-size unpacked array with @a count copies of the given
+    /// element, which is stored densely if it's an integer and there are enough of them.
+    static ConstantValue createArray(size_t count, const ConstantValue& element);
+
     static const ConstantValue Invalid;
 
     SLANG_EXPORT friend std::ostream& operator<<(std::ostream& os, const ConstantValue& cv);
@@ -185,20 +251,263 @@ private:
 };
 
 /// Represents a SystemVerilog associative array, for use during constant evaluation.
-struct SLANG_EXPORT AssociativeArray : public std::map<ConstantValue, ConstantValue> {
-    using std::map<ConstantValue, ConstantValue>::map;
+///
+/// Entries are kept in a hash table so that lookups and insertions take the same
+/// time no matter how large the array gets. Iterating the array visits entries
+/// in key order, as the LRM requires for foreach loops and the traversal methods;
+/// that order comes from a sorted view of the table that is built the first time
+/// it's needed and then kept up to date as keys are added and removed.
+class SLANG_EXPORT AssociativeArray {
+public:
+    using value_type = std::pair<const ConstantValue, ConstantValue>;
+
+    /// An iterator over the entries of the array in key order.
+    template<bool IsConst>
+    class iterator_base : public iterator_facade<iterator_base<IsConst>> {
+    public:
+        using TRef = std::conditional_t<IsConst, const value_type&, value_type&>;
+
+        iterator_base() = default;
+        iterator_base(value_type* const* current) : current(current) {}
+
+        TRef dereference() const { return **current; }
+        bool equals(const iterator_base& other) const { return current == other.current; }
+        ptrdiff_t distance_to(const iterator_base& other) const { return other.current - current; }
+        void advance(ptrdiff_t n) { current += n; }
+
+        // The facade's iterator and sentinel overloads are ambiguous for two iterators.
+        friend ptrdiff_t operator-(const iterator_base& left, const iterator_base& right) {
+            return right.distance_to(left);
+        }
+
+    private:
+        value_type* const* current = nullptr;
+    };
+
+    using iterator = iterator_base<false>;
+    using const_iterator = iterator_base<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    /// The value to return when reading a key that isn't in the array.
     ConstantValue defaultValue;
+
+    AssociativeArray() = default;
+    AssociativeArray(const AssociativeArray& other);
+    AssociativeArray(AssociativeArray&& other) noexcept;
+    ~AssociativeArray();
+
+    AssociativeArray& operator=(const AssociativeArray& other);
+    AssociativeArray& operator=(AssociativeArray&& other) noexcept;
+
+    size_t size() const { return table.size(); }
+    bool empty() const { return table.empty(); }
+    bool contains(const ConstantValue& key) const { return table.contains(key); }
+
+    /// Gets a pointer to the value stored for the given key,
+    /// or nullptr if the key isn't in the array.
+    ConstantValue* find(const ConstantValue& key);
+
+    /// @copydoc find
+    const ConstantValue* find(const ConstantValue& key) const;
+
+    /// Adds an entry for the given key if there isn't one already.
+    /// @returns a pointer to the key's value and whether a new entry was added.
+    std::pair<ConstantValue*, bool> try_emplace(ConstantValue key, ConstantValue value);
+
+    /// Removes the entry for the given key, if there is one.
+    /// @returns true if an entry was removed.
+    bool erase(const ConstantValue& key);
+
+    /// Removes all entries (but not the default value).
+    void clear();
+
+    /// Gets an iterator to the first entry whose key is not less than @a key.
+    const_iterator lower_bound(const ConstantValue& key) const;
+
+    /// Gets an iterator to the first entry whose key is greater than @a key.
+    const_iterator upper_bound(const ConstantValue& key) const;
+
+    iterator begin() { return getSorted(); }
+    iterator end() { return getSorted() + table.size(); }
+    const_iterator begin() const { return getSorted(); }
+    const_iterator end() const { return getSorted() + table.size(); }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    SLANG_EXPORT friend bool operator==(const AssociativeArray& lhs, const AssociativeArray& rhs);
+    SLANG_EXPORT friend std::partial_ordering operator<=>(const AssociativeArray& lhs,
+                                                          const AssociativeArray& rhs);
+
+private:
+    // Keys that are integers compare equal regardless of their width or
+    // signedness, matching how the LRM treats wildcard index values.
+    struct KeyHash {
+        size_t operator()(const ConstantValue& key) const;
+    };
+    struct KeyEqual {
+        bool operator()(const ConstantValue& lhs, const ConstantValue& rhs) const;
+    };
+
+    using Table = flat_hash_map<ConstantValue, ConstantValue, KeyHash, KeyEqual>;
+
+    value_type* const* getSorted() const;
+
+    Table table;
+
+    // Pointers to the entries in the table, in key order. Only valid while
+    // sortedValid is set; building it is guarded by a mutex because arrays
+    // can be shared between threads and read concurrently.
+    mutable std::vector<value_type*> sorted;
+    mutable std::atomic<bool> sortedValid = false;
+    mutable std::mutex sortedMutex;
 };
 
 /// Represents a SystemVerilog queue, for use during constant evaluation.
-struct SLANG_EXPORT SVQueue : public std::deque<ConstantValue> {
-    using std::deque<ConstantValue>::deque;
+///
+/// Elements are stored in a ring buffer so that pushing and popping at either
+/// end never moves the other elements and indexing is a single array access.
+class SLANG_EXPORT SVQueue {
+public:
+    using value_type = ConstantValue;
+
+    /// An iterator over the elements of the queue.
+    template<bool IsConst>
+    class iterator_base : public iterator_facade<iterator_base<IsConst>> {
+    public:
+        using ParentQueue = std::conditional_t<IsConst, const SVQueue, SVQueue>;
+
+        iterator_base() = default;
+        iterator_base(ParentQueue& queue, size_t index) : queue(&queue), index(index) {}
+
+        template<bool C = IsConst>
+            requires C
+        iterator_base(const iterator_base<false>& other) :
+            queue(other.queue), index(other.index) {}
+
+        decltype(auto) dereference() const { return (*queue)[index]; }
+        bool equals(const iterator_base& other) const { return index == other.index; }
+
+        ptrdiff_t distance_to(const iterator_base& other) const {
+            return ptrdiff_t(other.index) - ptrdiff_t(index);
+        }
+
+        void advance(ptrdiff_t n) { index = size_t(ptrdiff_t(index) + n); }
+
+        // The facade's iterator and sentinel overloads are ambiguous for two iterators.
+        friend ptrdiff_t operator-(const iterator_base& left, const iterator_base& right) {
+            return right.distance_to(left);
+        }
+
+    private:
+        template<bool>
+        friend class iterator_base;
+        friend class SVQueue;
+
+        ParentQueue* queue = nullptr;
+        size_t index = 0;
+    };
+
+    using iterator = iterator_base<false>;
+    using const_iterator = iterator_base<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    /// The maximum index allowed in the queue, or zero if it's unbounded.
     uint32_t maxBound = 0;
 
+    SVQueue() = default;
+
+    /// Constructs a queue holding @a count empty values.
+    explicit SVQueue(size_t count) { resize(count); }
+
+    /// Constructs a queue holding a copy of each value in the given range.
+    template<std::input_iterator TIter>
+    SVQueue(TIter first, TIter last) {
+        if constexpr (std::random_access_iterator<TIter>)
+            reserve(size_t(last - first));
+        for (; first != last; ++first)
+            push_back(*first);
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    ConstantValue& operator[](size_t index) { return slot(index); }
+    const ConstantValue& operator[](size_t index) const {
+        return storage[(head + index) & (storage.size() - 1)];
+    }
+
+    ConstantValue& at(size_t index) {
+        checkIndex(index);
+        return slot(index);
+    }
+
+    const ConstantValue& at(size_t index) const {
+        checkIndex(index);
+        return (*this)[index];
+    }
+
+    ConstantValue& front() { return slot(0); }
+    const ConstantValue& front() const { return (*this)[0]; }
+    ConstantValue& back() { return slot(count - 1); }
+    const ConstantValue& back() const { return (*this)[count - 1]; }
+
+    iterator begin() { return {*this, 0}; }
+    iterator end() { return {*this, count}; }
+    const_iterator begin() const { return {*this, 0}; }
+    const_iterator end() const { return {*this, count}; }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    void push_back(ConstantValue value);
+    void push_front(ConstantValue value);
+    ConstantValue& emplace_back(ConstantValue value);
+    void pop_back();
+    void pop_front();
+
+    /// Inserts @a value before the element at @a pos, moving whichever
+    /// side of the queue is shorter to make room for it.
+    iterator insert(const_iterator pos, ConstantValue value);
+
+    /// Removes the element at @a pos, moving whichever side of the queue
+    /// is shorter to close the gap.
+    iterator erase(const_iterator pos);
+
+    /// Changes the number of elements, adding empty values or
+    /// removing elements from the back as needed.
+    void resize(size_t newSize);
+
+    /// Ensures there is room for at least @a capacity elements.
+    void reserve(size_t capacity);
+
+    void clear();
+
+    /// Removes elements from the back until the size fits within maxBound.
     void resizeToBound() {
         if (maxBound && size() > maxBound + 1)
             resize(maxBound + 1);
     }
+
+    SLANG_EXPORT friend bool operator==(const SVQueue& lhs, const SVQueue& rhs);
+    SLANG_EXPORT friend std::partial_ordering operator<=>(const SVQueue& lhs, const SVQueue& rhs);
+
+private:
+    ConstantValue& slot(size_t index) { return storage[(head + index) & (storage.size() - 1)]; }
+    void checkIndex(size_t index) const;
+    void grow(size_t capacity);
+
+    // The size of the storage is always a power of two. Slots that
+    // don't hold an element are left as empty values.
+    std::vector<ConstantValue> storage;
+    size_t head = 0;
+    size_t count = 0;
 };
 
 /// Represents a SystemVerilog unpacked union, for use during constant evaluation.
@@ -207,28 +516,140 @@ struct SLANG_EXPORT SVUnion {
     std::optional<uint32_t> activeMember;
 };
 
+/// Represents a fixed-size unpacked array of integers that all have the same width
+/// and signedness, for use during constant evaluation. Instead of a ConstantValue
+/// per element, the bits of all elements are stored back to back with the first
+/// element in the most significant position, which makes the storage identical
+/// to the array's bitstream.
+class SLANG_EXPORT DenseArray {
+public:
+    /// The smallest number of elements for which dense storage gets used.
+    static constexpr size_t MinElements = 32;
+
+    /// Creates an array with @a count copies of the given element.
+    DenseArray(size_t count, const SVInt& element);
+
+    /// Creates an array from the given elements, which must all be integers
+    /// of the same width and signedness.
+    explicit DenseArray(std::span<const ConstantValue> elements);
+
+    /// Creates an array of @a count elements from their bitstream, with the
+    /// first element in the most significant bits.
+    static DenseArray fromPacked(size_t count, const SVInt& packed, bool isSigned);
+
+    /// Determines whether an array of @a count elements with the given width
+    /// should be stored densely.
+    static bool canStore(size_t count, bitwidth_t elementWidth);
+
+    /// Determines whether the given elements should be stored densely.
+    static bool canStore(std::span<const ConstantValue> elements);
+
+    size_t size() const { return count; }
+    bitwidth_t getElementWidth() const { return elementWidth; }
+    bool isSigned() const { return signFlag; }
+
+    /// Checks whether any of the elements have unknown bits.
+    bool hasUnknown() const;
+
+    /// Gets a copy of the element at the given index.
+    SVInt get(size_t index) const;
+
+    /// Replaces the element at the given index. The value must have the same
+    /// width as the elements; its signedness is ignored.
+    void set(size_t index, const SVInt& value) {
+        SLANG_ASSERT(value.getBitWidth() == elementWidth);
+        setBits(getElementOffset(index), value);
+    }
+
+    /// Gets the offset of the least significant bit of the given element
+    /// within the packed storage.
+    size_t getElementOffset(size_t index) const {
+        SLANG_ASSERT(index < count);
+        return (count - index - 1) * elementWidth;
+    }
+
+    /// Replaces bits of the packed storage starting at the given offset,
+    /// which can cover any part of one or more elements.
+    void setBits(size_t offset, const SVInt& value);
+
+    /// Gets all of the elements packed together, with the first element
+    /// in the most significant bits.
+    SVInt getPacked() const;
+
+    /// Expands the array into a value per element.
+    std::vector<ConstantValue> expand() const;
+
+    bool operator==(const DenseArray& rhs) const;
+
+private:
+    DenseArray(size_t count, bitwidth_t elementWidth, bool isSigned);
+
+    SVInt extract(size_t offset, bitwidth_t width, bool isSigned) const;
+    size_t planeWords() const { return (count * elementWidth + 63) / 64; }
+
+    // The value bits of all elements, followed by an equally sized plane
+    // of unknown bits once any element has been given one.
+    std::vector<uint64_t> words;
+    size_t count;
+    bitwidth_t elementWidth;
+    bool signFlag;
+    bool unknownFlag = false;
+};
+
 /// An iterator for child elements in a ConstantValue, if it represents an
 /// array, map, or queue.
+///
+/// Const iterators return elements by value, since the elements of dense arrays
+/// aren't stored as ConstantValues and have to be produced as they're read.
+/// Aggregate elements share their storage with the array, so this is cheap.
 template<bool IsConst>
 class CVIterator : public iterator_facade<CVIterator<IsConst>> {
 public:
-    using TRef = std::conditional_t<IsConst, const ConstantValue&, ConstantValue&>;
+    using TRef = std::conditional_t<IsConst, ConstantValue, ConstantValue&>;
+    using TKey = std::conditional_t<IsConst, ConstantValue, const ConstantValue&>;
     using ElemIt = std::conditional_t<IsConst, ConstantValue::Elements::const_iterator,
                                       ConstantValue::Elements::iterator>;
     using AssocIt =
         std::conditional_t<IsConst, AssociativeArray::const_iterator, AssociativeArray::iterator>;
     using QueueIt = std::conditional_t<IsConst, SVQueue::const_iterator, SVQueue::iterator>;
-    using VarType = std::variant<ElemIt, AssocIt, QueueIt>;
+
+    /// Elements of dense arrays are produced one at a time as the iterator is
+    /// dereferenced. Non-const iterators expand dense arrays instead.
+    struct DenseIt {
+        const DenseArray* array;
+        size_t index;
+
+        DenseIt& operator++() {
+            index++;
+            return *this;
+        }
+
+        DenseIt& operator--() {
+            index--;
+            return *this;
+        }
+
+        bool operator==(const DenseIt& other) const = default;
+    };
+
+    using VarType = std::variant<ElemIt, AssocIt, QueueIt, DenseIt>;
 
     CVIterator(ElemIt&& it) : current(std::move(it)) {}
     CVIterator(AssocIt&& it) : current(std::move(it)) {}
     CVIterator(QueueIt&& it) : current(std::move(it)) {}
+    CVIterator(DenseIt&& it) : current(std::move(it)) {}
     CVIterator(const CVIterator& other) : current(other.current) {}
 
     TRef dereference() const {
         return std::visit(
             [](auto&& arg) -> TRef {
-                if constexpr (requires { arg->second; })
+                if constexpr (std::is_same_v<std::decay_t<decltype(arg)>, DenseIt>) {
+                    if constexpr (IsConst)
+                        return arg.array->get(arg.index);
+                    else
+                        SLANG_UNREACHABLE;
+                }
+                else if constexpr (requires { arg->second; })
                     return arg->second;
                 else
                     return *arg;
@@ -246,10 +667,16 @@ public:
 
     bool equals(const CVIterator& other) const { return current == other.current; }
 
-    const ConstantValue& key() const {
+    TKey key() const {
         return std::visit(
-            [](auto&& arg) -> const ConstantValue& {
-                if constexpr (requires { arg->first; })
+            [](auto&& arg) -> TKey {
+                if constexpr (std::is_same_v<std::decay_t<decltype(arg)>, DenseIt>) {
+                    if constexpr (IsConst)
+                        return arg.array->get(arg.index);
+                    else
+                        SLANG_UNREACHABLE;
+                }
+                else if constexpr (requires { arg->first; })
                     return arg->first;
                 else
                     return *arg;
@@ -264,14 +691,20 @@ private:
 template<typename TValue, bool IsConst = std::is_const_v<TValue>>
     requires std::is_same_v<std::remove_cvref_t<TValue>, ConstantValue>
 CVIterator<IsConst> begin(TValue& cv) {
+    // Dense arrays are expanded if their elements might be modified through the iterator.
+    if constexpr (!IsConst)
+        cv.expandDense();
+
     return std::visit(
         [](auto&& arg) -> CVIterator<IsConst> {
             using T = std::decay_t<decltype(arg)>;
-            if constexpr (std::is_same_v<T, ConstantValue::Elements>) {
-                return arg.begin();
+            if constexpr (std::is_same_v<T, ConstantValue::Dense>) {
+                auto dense = std::as_const(arg).get();
+                return typename CVIterator<IsConst>::DenseIt{dense, 0};
             }
-            else if constexpr (std::is_same_v<T, ConstantValue::Map> ||
-                               std::is_same_v<T, ConstantValue::Queue>) {
+            else if constexpr (std::is_same_v<T, ConstantValue::Unpacked> ||
+                          std::is_same_v<T, ConstantValue::Map> ||
+                          std::is_same_v<T, ConstantValue::Queue>) {
                 return arg->begin();
             }
             else {
@@ -284,14 +717,20 @@ CVIterator<IsConst> begin(TValue& cv) {
 template<typename TValue, bool IsConst = std::is_const_v<TValue>>
     requires std::is_same_v<std::remove_cvref_t<TValue>, ConstantValue>
 CVIterator<IsConst> end(TValue& cv) {
+    // Dense arrays are expanded if their elements might be modified through the iterator.
+    if constexpr (!IsConst)
+        cv.expandDense();
+
     return std::visit(
         [](auto&& arg) -> CVIterator<IsConst> {
             using T = std::decay_t<decltype(arg)>;
-            if constexpr (std::is_same_v<T, ConstantValue::Elements>) {
-                return arg.end();
+            if constexpr (std::is_same_v<T, ConstantValue::Dense>) {
+                auto dense = std::as_const(arg).get();
+                return typename CVIterator<IsConst>::DenseIt{dense, dense->size()};
             }
-            else if constexpr (std::is_same_v<T, ConstantValue::Map> ||
-                               std::is_same_v<T, ConstantValue::Queue>) {
+            else if constexpr (std::is_same_v<T, ConstantValue::Unpacked> ||
+                          std::is_same_v<T, ConstantValue::Map> ||
+                          std::is_same_v<T, ConstantValue::Queue>) {
                 return arg->end();
             }
             else {
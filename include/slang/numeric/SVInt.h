@@ -145,9 +145,10 @@ public:
 /// states of X and Z.
 ///
 /// Small integer values that fit within 64 bits are kept in a simple native integer. Otherwise,
-/// space is allocated on the heap. If there are any unknown bits in the number, an extra set of
-/// words are allocated adjacent in memory. The bits in these extra words indicate whether the
-/// corresponding bits in the low words are unknown or normal.
+/// the words are kept in a small buffer inside the object if they fit, and allocated on the heap
+/// if they don't. If there are any unknown bits in the number, an extra set of words are allocated
+/// adjacent in memory. The bits in these extra words indicate whether the corresponding bits in
+/// the low words are unknown or normal.
 ///
 class SLANG_EXPORT SVInt : SVIntStorage {
 public:
@@ -208,10 +209,7 @@ public:
         initSlowCase(bytes);
     }
 
-    ~SVInt() {
-        if (!isSingleWord())
-            delete[] pVal;
-    }
+    ~SVInt() { freeWords(); }
 
     /// Copy construct.
     SVInt(const SVInt& other) : SVInt(static_cast<const SVIntStorage&>(other)) {}
@@ -228,6 +226,11 @@ public:
         SVIntStorage(other.bitWidth, other.signFlag, other.unknownFlag) {
         if (isSingleWord())
             val = other.val;
+        else if (other.pVal == other.inlineWords) {
+            // The clamp lets the compiler see that we stay within the buffer.
+            std::copy_n(other.inlineWords, std::min(getNumWords(), INLINE_WORDS), inlineWords);
+            pVal = inlineWords;
+        }
         else
             pVal = std::exchange(other.pVal, nullptr);
     }
@@ -432,14 +435,19 @@ public:
         if (this == &rhs)
             return *this;
 
-        if (!isSingleWord())
-            delete[] pVal;
+        freeWords();
 
         val = rhs.val;
         bitWidth = rhs.bitWidth;
         signFlag = rhs.signFlag;
         unknownFlag = rhs.unknownFlag;
 
+        // inline words move with the object; heap memory is taken over
+        if (!isSingleWord() && rhs.pVal == rhs.inlineWords) {
+            std::copy_n(rhs.inlineWords, std::min(getNumWords(), INLINE_WORDS), inlineWords);
+            pVal = inlineWords;
+        }
+
         // prevent the other object from releasing memory
         rhs.pVal = nullptr;
         return *this;
@@ -566,7 +574,20 @@ public:
     /// provided threshold.
     static constexpr bitwidth_t DefaultStringAbbreviationThresholdBits = 128;
 
+    /// Gets the number of times the calling thread has allocated heap storage
+    /// for an SVInt's words. Values small enough to be stored inline don't count.
+    /// This is intended for profiling; callers should look at the difference
+    /// between two readings.
+    static uint64_t getHeapAllocationCount();
+
 private:
+    // The number of words that can be stored inside the object itself before we need
+    // to go to the heap. This covers two-state values of up to 128 bits and four-state
+    // values of up to 64 bits. It's kept small so that an SVInt is no larger than a
+    // std::string (32 bytes on 64-bit targets), which keeps ConstantValue at its
+    // previous size of 40 bytes.
+    static constexpr uint32_t INLINE_WORDS = 2;
+
     // fast internal constructors to just set fields on new values
     SVInt(uint64_t* data, bitwidth_t bits, bool signFlag, bool unknownFlag) :
         SVIntStorage(data, bits, signFlag, unknownFlag) {}
@@ -580,6 +601,25 @@ private:
     void initSlowCase(std::span<const byte> bytes);
     void initSlowCase(const SVIntStorage& other);
 
+    // Gets (uninitialized) storage for the given number of words,
+    // using the inline buffer if they fit.
+    uint64_t* allocWords(uint32_t numWords) {
+        return numWords <= INLINE_WORDS ? inlineWords : allocHeapWords(numWords);
+    }
+
+    // Allocates (uninitialized) heap storage for the given number of words.
+    static uint64_t* allocHeapWords(uint32_t numWords);
+
+    // Releases our multi-word storage, if it was allocated on the heap.
+    void freeWords() {
+        if (!isSingleWord() && pVal != inlineWords)
+            delete[] pVal;
+    }
+
+    // Moves our multi-word storage to a buffer of a different size, keeping
+    // the first @a keepWords words and zeroing the rest.
+    void resizeWords(uint32_t keepWords, uint32_t newWords);
+
     uint64_t* getRawData() { return isSingleWord() ? &val : pVal; }
     const uint64_t* getRawData() const { return isSingleWord() ? &val : pVal; }
 
@@ -613,15 +653,8 @@ private:
     static SVInt fromPow2Digits(bitwidth_t bits, bool isSigned, bool anyUnknown, uint32_t radix,
                                 uint32_t shift, std::span<logic_t const> digits);
 
-    // Split an integer's data into 32-bit words.
-    static void splitWords(const SVInt& value, uint32_t* dest, uint32_t numWords);
-
-    // Build the output result of a divide (used for both quotients and remainders).
-    static void buildDivideResult(SVInt* result, uint32_t* value, bitwidth_t bitWidth,
-                                  bool signFlag, uint32_t numWords);
-
-    // Entry point for Knuth divide that handles corner cases and splitting the integers into 32-bit
-    // words.
+    // Entry point for division of multi-word values, which picks between
+    // Knuth's algorithm and a recursive algorithm based on operand size.
     static void divide(const SVInt& lhs, uint32_t lhsWords, const SVInt& rhs, uint32_t rhsWords,
                        SVInt* quotient, SVInt* remainder);
 
@@ -638,6 +671,10 @@ private:
         uint32_t value = (bitWidth + BITS_PER_WORD - 1) / BITS_PER_WORD;
         return unknown ? value * 2 : value;
     }
+
+    // Storage for multi-word values that are small enough; pVal points
+    // here when in use, and it's left uninitialized otherwise.
+    uint64_t inlineWords[INLINE_WORDS];
 };
 
 inline logic_t operator||(const SVInt& lhs, logic_t rhs) {
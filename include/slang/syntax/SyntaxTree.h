@@ -195,6 +195,11 @@ public:
     /// Gets the source library with which the syntax tree is associated.
     const SourceLibrary* getSourceLibrary() const { return library; }
 
+    /// Gets the IDs of the source buffers that were parsed to create the tree,
+    /// not including any files they included. This is empty for trees that
+    /// weren't parsed from source buffers.
+    std::span<const BufferID> getSourceBufferIds() const { return sourceBufferIds; }
+
     /// Gets the root of the syntax tree.
     SyntaxNode& root() { return *rootNode; }
 
@@ -240,6 +245,7 @@ private:
     Bag options_;
     std::unique_ptr<parsing::ParserMetadata> metadata;
     std::vector<const DefineDirectiveSyntax*> macros;
+    std::vector<BufferID> sourceBufferIds;
     std::shared_ptr<SyntaxTree> parentTree;
 };
 
@@ -0,0 +1,231 @@
+//------------------------------------------------------------------------------
+//! @file BinaryTree.h
+//! @brief Compact binary encoding of structured data trees
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <system_error>
+#include <vector>
+
+#include "slang/text/StructuredWriter.h"
+#include "slang/util/BumpAllocator.h"
+#include "slang/util/Hash.h"
+#include "slang/util/SmallVector.h"
+
+namespace slang {
+
+/// The kinds of values that can be stored in a binary tree.
+enum class BinaryTreeKind : uint8_t { Invalid, Object, Array, String, Int, UInt, Double, False, True };
+
+/// Writes a tree of objects, arrays, and values in a compact binary format.
+///
+/// The output holds the same information as the equivalent JSON but is much
+/// faster to produce and to consume: numbers are stored as binary, all strings
+/// (property names included) are interned into a single table, and every object
+/// and array records its encoded size so that readers can skip over subtrees
+/// they are not interested in. The result is designed to be memory mapped
+/// and read in place via the BinaryTreeReader class.
+///
+/// Like JsonWriter, it's expected that methods are called in the correct order.
+class SLANG_EXPORT BinaryTreeWriter : public StructuredWriter {
+public:
+    BinaryTreeWriter();
+    ~BinaryTreeWriter() override;
+
+    void startObject() override;
+    void endObject() override;
+    void startArray() override;
+    void endArray() override;
+    void writeProperty(std::string_view name) override;
+    void writeValue(std::string_view value) override;
+    void writeValue(int64_t value) override;
+    void writeValue(uint64_t value) override;
+    void writeValue(double value) override;
+    void writeValue(bool value) override;
+
+    /// Completes the output by appending the string table. No further
+    /// writes are allowed after this is called.
+    /// @return a view of the complete encoded tree, which remains valid
+    /// for the lifetime of the writer.
+    std::string_view finish();
+
+private:
+    void beginValue(BinaryTreeKind kind);
+    void startContainer(BinaryTreeKind kind);
+    void endContainer();
+    void writeVarInt(uint64_t value);
+    void writeFixed(uint64_t value, size_t offset, size_t size = 8);
+    uint32_t internString(std::string_view str);
+
+    std::vector<char> buffer;
+    BumpAllocator alloc;
+    flat_hash_map<std::string_view, uint32_t> stringMap;
+    std::vector<std::string_view> strings;
+
+    struct Container {
+        size_t sizeOffset;
+        uint32_t count = 0;
+    };
+    SmallVector<Container> containerStack;
+    bool finished = false;
+};
+
+class BinaryTreeReader;
+
+/// A lightweight view of a single value stored in a binary tree.
+/// Nodes are cheap to copy and are valid as long as their reader.
+class SLANG_EXPORT BinaryTreeNode {
+public:
+    struct Child;
+
+    /// An iterator over the children of an object or array.
+    class iterator {
+    public:
+        using difference_type = ptrdiff_t;
+        using value_type = Child;
+
+        iterator() = default;
+        iterator(const BinaryTreeReader* reader, const char* ptr, const char* limit,
+                 uint32_t remaining, bool isObject) :
+            reader(reader), ptr(ptr), limit(limit), remaining(remaining), isObject(isObject) {}
+
+        Child operator*() const;
+        iterator& operator++();
+        iterator operator++(int) {
+            auto result = *this;
+            ++*this;
+            return result;
+        }
+
+        bool operator==(const iterator& other) const { return remaining == other.remaining; }
+
+    private:
+        const BinaryTreeReader* reader = nullptr;
+        const char* ptr = nullptr;
+        const char* limit = nullptr;
+        uint32_t remaining = 0;
+        bool isObject = false;
+    };
+
+    BinaryTreeNode() = default;
+
+    /// Constructs a view of the value at @a ptr. If the value's encoding is
+    /// malformed or doesn't fit within the reader's data, the node is invalid.
+    BinaryTreeNode(const BinaryTreeReader& reader, const char* ptr);
+
+    /// Like the constructor above, but the value must also end at or before @a limit.
+    BinaryTreeNode(const BinaryTreeReader& reader, const char* ptr, const char* limit);
+
+    /// @return the kind of value stored in the node.
+    BinaryTreeKind kind() const { return ptr ? BinaryTreeKind(*ptr) : BinaryTreeKind::Invalid; }
+
+    /// @return true if this node refers to a value, and false if it was
+    /// default constructed or returned from a failed lookup.
+    bool valid() const { return kind() != BinaryTreeKind::Invalid; }
+
+    bool isObject() const { return kind() == BinaryTreeKind::Object; }
+    bool isArray() const { return kind() == BinaryTreeKind::Array; }
+    bool isString() const { return kind() == BinaryTreeKind::String; }
+
+    /// @return the string value of the node, or an empty string if it's not a string.
+    std::string_view getString() const;
+
+    /// @return the integer value of the node, converting from unsigned
+    /// if necessary, or zero if it's not an integer.
+    int64_t getInt() const;
+
+    /// @return the unsigned integer value of the node, converting from signed
+    /// if necessary, or zero if it's not an integer.
+    uint64_t getUInt() const;
+
+    /// @return the floating point value of the node, or zero if it's not a number.
+    double getDouble() const;
+
+    /// @return the boolean value of the node, or false if it's not a boolean.
+    bool getBool() const { return kind() == BinaryTreeKind::True; }
+
+    /// @return the number of properties or elements in an object or array node,
+    /// or zero for any other kind of node.
+    size_t size() const;
+
+    /// Finds the property with the given name in an object node.
+    /// @return the property value, or an invalid node if not found.
+    BinaryTreeNode operator[](std::string_view name) const;
+
+    /// Gets the child at the given index in an object or array node.
+    /// This requires skipping all prior children, so prefer iteration.
+    /// @return the child value, or an invalid node if out of range.
+    BinaryTreeNode operator[](size_t index) const;
+
+    iterator begin() const;
+    iterator end() const { return {}; }
+
+    /// @return a pointer one past the end of this node's encoding.
+    const char* getEnd() const { return endPtr; }
+
+private:
+    const BinaryTreeReader* reader = nullptr;
+    const char* ptr = nullptr;
+    const char* endPtr = nullptr;
+};
+
+/// A property of an object or an element of an array.
+/// For array elements the name is empty.
+struct BinaryTreeNode::Child {
+    std::string_view name;
+    BinaryTreeNode node;
+};
+
+/// Reads a tree encoded by BinaryTreeWriter in place, without copying or
+/// decoding it up front. The data can come from a memory mapped file, which
+/// allows many processes to share a single serialized tree.
+class SLANG_EXPORT BinaryTreeReader {
+public:
+    /// Constructs a reader over the given data, which must outlive the reader.
+    /// Check isValid() to see whether the data was recognized.
+    explicit BinaryTreeReader(std::span<const char> data);
+    ~BinaryTreeReader();
+
+    BinaryTreeReader(const BinaryTreeReader&) = delete;
+    BinaryTreeReader& operator=(const BinaryTreeReader&) = delete;
+
+    /// Memory maps the file at the given path and constructs a reader for it.
+    /// The mapping is released when the reader is destroyed.
+    /// @return an error code if the file could not be mapped or does not contain
+    /// a valid binary tree.
+    static std::error_code openFile(const std::filesystem::path& path,
+                                    std::unique_ptr<BinaryTreeReader>& result);
+
+    /// @return true if the data contains a valid binary tree header and string table.
+    bool isValid() const { return valid; }
+
+    /// @return the root node of the tree, or an invalid node if the data is not valid.
+    BinaryTreeNode getRoot() const;
+
+    /// @return the interned string with the given index, or an empty
+    /// string if the index or its offsets are out of range.
+    std::string_view getString(uint64_t index) const;
+
+    /// @return the number of interned strings in the tree.
+    uint64_t getStringCount() const { return stringCount; }
+
+private:
+    friend class BinaryTreeNode;
+
+    std::span<const char> data;
+    const char* treeEnd = nullptr;
+    const char* stringData = nullptr;
+    const char* stringOffsets = nullptr;
+    uint64_t stringDataSize = 0;
+    uint64_t stringCount = 0;
+    bool valid = false;
+    bool mapped = false;
+};
+
+} // namespace slang
@@ -7,8 +7,10 @@
 //------------------------------------------------------------------------------
 #pragma once
 
+#include <iosfwd>
 #include <memory>
 
+#include "slang/text/StructuredWriter.h"
 #include "slang/util/Util.h"
 
 namespace slang {
@@ -20,10 +22,26 @@ class FormatBuffer;
 /// This class is simple and has few features; it's expected that you'll
 /// call its methods in the correct order to generate valid JSON. If not,
 /// it will happily spit out unparseable text.
-class SLANG_EXPORT JsonWriter {
+///
+/// By default all output is accumulated in memory. Alternatively the writer
+/// can be given an output stream, in which case text is flushed to the stream
+/// in fixed size chunks as it's written so that memory usage stays bounded
+/// no matter how large the output gets.
+class SLANG_EXPORT JsonWriter : public StructuredWriter {
 public:
+    /// The default number of bytes buffered before flushing to an output stream.
+    static constexpr size_t DefaultChunkSize = 1 << 20;
+
+    /// Constructs a writer that accumulates all output in memory.
     JsonWriter();
-    ~JsonWriter();
+
+    /// Constructs a writer that flushes its output to the given stream
+    /// whenever at least @a chunkSize bytes have been buffered. The stream
+    /// must outlive the writer, and @a flush must be called once writing
+    /// is finished to emit any remaining text.
+    explicit JsonWriter(std::ostream& stream, size_t chunkSize = DefaultChunkSize);
+
+    ~JsonWriter() override;
 
     /// Sets the number of spaces to indent whenever opening a new
     /// level of structure in the JSON.
@@ -32,61 +50,85 @@ public:
     /// Set whether pretty printing is enabled (off by default).
     /// When pretty printing is on, newlines, additional whitespace,
     /// and indentation are added to make the output more human friendly.
+    /// When it's off no indentation state is tracked at all, which makes
+    /// for the fastest and most compact output.
     void setPrettyPrint(bool enabled) { pretty = enabled; }
 
-    /// @return a view of the emitted JSON text so far.
+    /// @return a view of the emitted JSON text so far. If the writer is
+    /// streaming to an output stream this only includes text that has not
+    /// yet been flushed.
     /// @note the returned view is not guaranteed to remain valid once
     /// additional writes are performed.
     std::string_view view() const;
 
+    /// Writes any buffered text to the output stream, if there is one.
+    void flush();
+
     /// Begins a new JSON object. It's expected that you will write zero or
     /// more properties and then end the object.
-    void startObject();
+    void startObject() override;
 
     /// Ends the currently active object. Output will be messed up
     /// if there is no active object.
-    void endObject();
+    void endObject() override;
 
     /// Begins a new JSON array. It's expected that you will write zero or
     /// more values and then end the array.
-    void startArray();
+    void startArray() override;
 
     /// Ends the currently active array. Output will be messed up
     /// if there is no active object.
-    void endArray();
+    void endArray() override;
 
     /// Writes an object property with the given name. It's expected that you
     /// will immediately write some kind of value for the property.
-    void writeProperty(std::string_view name);
+    void writeProperty(std::string_view name) override;
 
     /// Writes an array or property string value.
-    void writeValue(std::string_view value);
+    void writeValue(std::string_view value) override;
 
     /// Writes an array or property signed integer value.
-    void writeValue(int64_t value);
+    void writeValue(int64_t value) override;
 
     /// Writes an array or property unsigned integer value.
-    void writeValue(uint64_t value);
+    void writeValue(uint64_t value) override;
 
     /// Writes an array or property floating point value.
-    void writeValue(double value);
+    void writeValue(double value) override;
 
     /// Writes an array or property boolean value ("true" or "false").
-    void writeValue(bool value);
+    void writeValue(bool value) override;
 
-    /// Writes a newline character into the buffer.
+    /// Writes a newline character into the buffer. This is meant to be used to
+    /// terminate the output after the last top-level value has been written.
     void writeNewLine();
 
+    /// Creates an in-memory writer with the same formatting settings as this one,
+    /// indented to match the current position in the output.
+    std::unique_ptr<StructuredWriter> createFragment() const override;
+
+    /// Appends the text written to a writer returned from @a createFragment
+    /// as the next array or property value.
+    void writeFragment(const StructuredWriter& fragment) override;
+
 private:
-    void endValue();
-    size_t findLastComma() const;
+    void startItem();
+    void endItem();
+    void writeIndent();
     void writeQuoted(std::string_view str);
 
+    // Separators are written lazily, right before the next item,
+    // so that nothing ever needs to be removed from the buffer.
+    enum class Pending : uint8_t { None, Open, Comma };
+
     std::unique_ptr<FormatBuffer> buffer;
+    std::ostream* stream = nullptr;
+    size_t chunkSize = 0;
 
     int currentIndent = 0;
     int indentSize = 2;
     bool pretty = false;
+    Pending pending = Pending::None;
 };
 
 } // namespace slang
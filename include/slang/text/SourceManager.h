@@ -8,6 +8,7 @@
 #pragma once
 
 #include <atomic>
+#include <bit>
 #include <expected.hpp>
 #include <filesystem>
 #include <memory>
@@ -27,10 +28,6 @@ namespace slang {
 
 enum class DiagnosticSeverity;
 
-template<typename T>
-concept IsLock = std::is_same_v<T, std::shared_lock<std::shared_mutex>> ||
-                 std::is_same_v<T, std::unique_lock<std::shared_mutex>>;
-
 /// SourceManager - Handles loading and tracking source files.
 ///
 /// The source manager abstracts away the differences between
@@ -167,6 +164,14 @@ public:
     /// Returns true if the given file path is already loaded and cached in the source manager.
     bool isCached(const std::filesystem::path& path) const;
 
+    /// Reads every cached file from disk again and removes any whose contents have
+    /// changed (or that can no longer be read) from the cache, so that the next
+    /// @a readSource or @a readHeader call for them gets the new contents. Buffers
+    /// that were created from the old contents remain valid. Failed lookups are
+    /// forgotten as well, in case those files have since been created.
+    /// @returns the full paths of the files that have changed.
+    std::vector<std::filesystem::path> reloadChangedFiles();
+
     /// Sets whether filenames should be made "proximate" to the current directory
     /// for diagnostic reporting purposes. This is on by default but can be
     /// disabled to always use the simple filename.
@@ -234,14 +239,22 @@ private:
     struct FileData {
         const std::string name;                       // name of the file
         const SmallVector<char> mem;                  // file contents
-        std::vector<size_t> lineOffsets;              // cache of compute line offsets
         const std::filesystem::path* const directory; // directory in which the file exists
         const std::filesystem::path fullPath;         // full path to the file
+        const bool fromDisk;                          // whether the data was read from disk
 
         FileData(const std::filesystem::path* directory, std::string name, SmallVector<char>&& data,
-                 std::filesystem::path fullPath) :
+                 std::filesystem::path fullPath, bool fromDisk) :
             name(std::move(name)), mem(std::move(data)), directory(directory),
-            fullPath(std::move(fullPath)) {}
+            fullPath(std::move(fullPath)), fromDisk(fromDisk) {}
+
+        // Gets the offsets at which each line of the file starts, computing
+        // them on first use. This is safe to call from multiple threads.
+        std::span<const size_t> getLineOffsets() const;
+
+    private:
+        mutable std::vector<size_t> lineOffsets;
+        mutable std::once_flag lineOffsetsFlag;
     };
 
     // Stores a pointer to file data along with information about where we included it.
@@ -250,8 +263,13 @@ private:
         FileData* data = nullptr;
         const SourceLibrary* library = nullptr;
         SourceLocation includedFrom;
-        uint64_t sortKey;
+        uint64_t sortKey = 0;
+
+        // Line directives can be added after the entry is created, so they are
+        // protected by the mutex. The flag is set once there are any, letting
+        // lookups skip the lock for the common case of files that have none.
         std::vector<LineDirectiveInfo> lineDirectives;
+        std::atomic<bool> hasLineDirectives = false;
 
         FileInfo() {}
         FileInfo(FileData* data, const SourceLibrary* library, SourceLocation includedFrom,
@@ -286,7 +304,59 @@ private:
             originalLoc(originalLoc), expansionRange(expansionRange), macroName(macroName) {}
     };
 
-    // This mutex protects pretty much everything in this class.
+    // A table of buffer entries indexed by BufferID. Entries are stored in chunks
+    // that double in size and never move once allocated, so existing entries can
+    // be looked up without taking any locks. Adding entries requires holding the
+    // mutex exclusively.
+    class BufferEntryTable {
+    public:
+        using Entry = std::variant<FileInfo, ExpansionInfo>;
+
+        BufferEntryTable() = default;
+        BufferEntryTable(const BufferEntryTable&) = delete;
+        BufferEntryTable& operator=(const BufferEntryTable&) = delete;
+
+        size_t size() const { return count.load(std::memory_order_acquire); }
+
+        const Entry& operator[](size_t index) const {
+            auto [chunk, offset] = locate(index);
+            return chunks[chunk][offset];
+        }
+
+        Entry& operator[](size_t index) {
+            auto [chunk, offset] = locate(index);
+            return chunks[chunk][offset];
+        }
+
+        template<typename T, typename... Args>
+        size_t add(Args&&... args) {
+            const size_t index = count.load(std::memory_order_relaxed);
+            auto [chunk, offset] = locate(index);
+            if (!chunks[chunk])
+                chunks[chunk] = std::make_unique<Entry[]>(FirstChunkSize << chunk);
+
+            chunks[chunk][offset].template emplace<T>(std::forward<Args>(args)...);
+            count.store(index + 1, std::memory_order_release);
+            return index;
+        }
+
+    private:
+        static constexpr size_t FirstChunkSize = 256;
+
+        // Enough chunks to hold every possible 32-bit BufferID.
+        static constexpr size_t MaxChunks = 25;
+
+        static std::pair<size_t, size_t> locate(size_t index) {
+            const size_t chunk = size_t(std::bit_width(index / FirstChunkSize + 1)) - 1;
+            return {chunk, index - FirstChunkSize * ((size_t(1) << chunk) - 1)};
+        }
+
+        std::unique_ptr<Entry[]> chunks[MaxChunks];
+        std::atomic<size_t> count = 0;
+    };
+
+    // This mutex protects everything in this class except for lookups of
+    // existing buffer entries, which are safe to do without a lock.
     mutable std::shared_mutex mutex;
 
     // This mutex is specifically for protecting the system and user
@@ -294,11 +364,15 @@ private:
     mutable std::shared_mutex includeDirMutex;
 
     // index from BufferID to buffer metadata
-    std::vector<std::variant<FileInfo, ExpansionInfo>> bufferEntries;
+    BufferEntryTable bufferEntries;
 
     // cache for file lookups; this holds on to the actual file data
     flat_hash_map<std::string, std::pair<std::unique_ptr<FileData>, std::error_code>> lookupCache;
 
+    // file data that has been removed from the cache by reloadChangedFiles;
+    // it's kept alive because existing buffers still point into it
+    std::vector<std::unique_ptr<FileData>> staleFileData;
+
     // directories for system and user includes
     std::vector<std::filesystem::path> systemDirectories;
     std::vector<std::filesystem::path> userDirectories;
@@ -312,11 +386,8 @@ private:
     std::atomic<uint32_t> unnamedBufferCount = 0;
     bool disableProximatePaths = false;
 
-    template<IsLock TLock>
-    FileInfo* getFileInfo(BufferID buffer, TLock& lock);
-
-    template<IsLock TLock>
-    const FileInfo* getFileInfo(BufferID buffer, TLock& lock) const;
+    FileInfo* getFileInfo(BufferID buffer);
+    const FileInfo* getFileInfo(BufferID buffer) const;
 
     SourceBuffer createBufferEntry(FileData* fd, SourceLocation includedFrom,
                                    const SourceLibrary* library, uint64_t sortKey,
@@ -326,25 +397,14 @@ private:
                              const SourceLibrary* library, uint64_t sortKey = UINT64_MAX);
     SourceBuffer cacheBuffer(std::filesystem::path&& path, std::string&& pathStr,
                              SourceLocation includedFrom, const SourceLibrary* library,
-                             uint64_t sortKey, SmallVector<char>&& buffer);
-
-    template<IsLock TLock>
-    size_t getRawLineNumber(SourceLocation location, TLock& lock) const;
-
-    template<IsLock TLock>
-    bool isMacroLocImpl(SourceLocation location, TLock& lock) const;
-
-    template<IsLock TLock>
-    bool isMacroArgLocImpl(SourceLocation location, TLock& lock) const;
-
-    template<IsLock TLock>
-    SourceLocation getFullyExpandedLocImpl(SourceLocation location, TLock& lock) const;
-
-    template<IsLock TLock>
-    SourceLocation getOriginalLocImpl(SourceLocation location, TLock& lock) const;
-
-    template<IsLock TLock>
-    SourceRange getExpansionRangeImpl(SourceLocation location, TLock& lock) const;
+                             uint64_t sortKey, SmallVector<char>&& buffer, bool fromDisk);
+
+    size_t getRawLineNumber(SourceLocation location) const;
+    bool isMacroLocImpl(SourceLocation location) const;
+    bool isMacroArgLocImpl(SourceLocation location) const;
+    SourceLocation getFullyExpandedLocImpl(SourceLocation location) const;
+    SourceLocation getOriginalLocImpl(SourceLocation location) const;
+    SourceRange getExpansionRangeImpl(SourceLocation location) const;
 
     static void computeLineOffsets(const SmallVector<char>& buffer,
                                    std::vector<size_t>& offsets) noexcept;
@@ -0,0 +1,70 @@
+//------------------------------------------------------------------------------
+//! @file StructuredWriter.h
+//! @brief Base class for writers of structured (object / array / value) data
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <memory>
+#include <string_view>
+
+#include "slang/util/Util.h"
+
+namespace slang {
+
+/// Base class for writers that emit a tree of objects, arrays, and scalar values,
+/// such as the JSON and binary formats used for serializing an AST.
+///
+/// Callers are expected to invoke methods in the correct order to produce
+/// a well formed tree; writers are not required to check for misuse.
+class SLANG_EXPORT StructuredWriter {
+public:
+    virtual ~StructuredWriter() = default;
+
+    /// Begins a new object. It's expected that you will write zero or
+    /// more properties and then end the object.
+    virtual void startObject() = 0;
+
+    /// Ends the currently active object.
+    virtual void endObject() = 0;
+
+    /// Begins a new array. It's expected that you will write zero or
+    /// more values and then end the array.
+    virtual void startArray() = 0;
+
+    /// Ends the currently active array.
+    virtual void endArray() = 0;
+
+    /// Writes an object property with the given name. It's expected that you
+    /// will immediately write some kind of value for the property.
+    virtual void writeProperty(std::string_view name) = 0;
+
+    /// Writes an array or property string value.
+    virtual void writeValue(std::string_view value) = 0;
+
+    /// Writes an array or property signed integer value.
+    virtual void writeValue(int64_t value) = 0;
+
+    /// Writes an array or property unsigned integer value.
+    virtual void writeValue(uint64_t value) = 0;
+
+    /// Writes an array or property floating point value.
+    virtual void writeValue(double value) = 0;
+
+    /// Writes an array or property boolean value.
+    virtual void writeValue(bool value) = 0;
+
+    /// Creates a new, empty writer with the same settings as this one that can
+    /// be used to produce a piece of the output independently, for example on
+    /// another thread. The result is later appended via @a writeFragment.
+    /// @return the new writer, or nullptr if this writer does not support fragments.
+    virtual std::unique_ptr<StructuredWriter> createFragment() const { return nullptr; }
+
+    /// Appends a single value that was written to a writer returned
+    /// from @a createFragment as the next array or property value.
+    virtual void writeFragment(const StructuredWriter&) { SLANG_UNREACHABLE; }
+};
+
+} // namespace slang
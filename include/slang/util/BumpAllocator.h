@@ -69,6 +69,13 @@ public:
     /// The other allocator will be in a moved-from state after the call.
     void steal(BumpAllocator&& other);
 
+    /// Gets the number of memory segments currently owned by the allocator.
+    size_t getSegmentCount() const { return segmentCount; }
+
+    /// Gets the total number of bytes of memory currently owned by the allocator,
+    /// including space at the end of each segment that hasn't been handed out yet.
+    size_t getBytesAllocated() const { return bytesAllocated; }
+
 protected:
     // Allocations are tracked as a linked list of segments.
     struct Segment {
@@ -78,6 +85,8 @@ protected:
 
     Segment* head;
     byte* endPtr;
+    size_t segmentCount = 0;
+    size_t bytesAllocated = 0;
 
     enum { INITIAL_SIZE = 512, SEGMENT_SIZE = 4096 };
 
@@ -89,7 +98,7 @@ protected:
                                        ~(alignment - 1));
     }
 
-    static Segment* allocSegment(Segment* prev, size_t size);
+    Segment* allocSegment(Segment* prev, size_t size);
 };
 
 /// A strongly-typed version of the BumpAllocator, which has the additional
@@ -0,0 +1,106 @@
+//------------------------------------------------------------------------------
+//! @file CancellationToken.h
+//! @brief Cooperative cancellation of long running work
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+#include "slang/util/Util.h"
+
+namespace slang {
+
+/// @brief Cooperatively cancels a long running phase of work, such as parsing
+/// or elaboration.
+///
+/// A token can be cancelled explicitly from any thread, or it can be given
+/// a time and memory budget when a phase starts. The code doing the work
+/// calls @a poll at convenient points and winds down once it returns true.
+/// Polling is cheap enough to do in hot loops: the clock is only sampled
+/// once every @a PollInterval calls.
+class SLANG_EXPORT CancellationToken {
+public:
+    /// The reasons a token can be cancelled.
+    enum class Reason : uint8_t {
+        /// The token has not been cancelled.
+        None,
+
+        /// Cancellation was requested by a call to @a cancel.
+        Requested,
+
+        /// The time limit given to @a start was exceeded.
+        TimeLimit,
+
+        /// The memory limit given to @a start was exceeded.
+        MemoryLimit
+    };
+
+    /// The number of calls to @a poll between samples of the clock.
+    static constexpr uint32_t PollInterval = 256;
+
+    CancellationToken() = default;
+    CancellationToken(const CancellationToken&) = delete;
+    CancellationToken& operator=(const CancellationToken&) = delete;
+
+    /// @brief Starts a new phase of work with the given budget.
+    ///
+    /// This clears any previous cancellation. A limit of zero means there
+    /// is no limit. This must not be called while other threads are polling.
+    ///
+    /// @param timeLimit the wall clock time allowed from now on
+    /// @param memoryLimit the number of bytes of memory allowed, as measured
+    ///                    by the callers of @a poll
+    void start(std::chrono::milliseconds timeLimit, size_t memoryLimit);
+
+    /// Cancels the token, unless it has already been cancelled for another reason.
+    void cancel(Reason why = Reason::Requested);
+
+    /// Indicates whether the token has been cancelled, without checking the budget.
+    bool isCancelled() const { return reason.load(std::memory_order_relaxed) != Reason::None; }
+
+    /// Gets the reason the token was cancelled, or Reason::None if it hasn't been.
+    Reason getReason() const { return reason.load(std::memory_order_relaxed); }
+
+    /// Gets a human readable description of why the token was cancelled,
+    /// such as "time limit of 2.5s exceeded".
+    std::string getReasonString() const;
+
+    /// @brief Checks whether the work should stop.
+    ///
+    /// Cancels the token if it has used up its memory budget or, every so
+    /// often, its time budget.
+    ///
+    /// @param memoryInUse the amount of memory currently used by the phase
+    /// @returns true if the token has been cancelled
+    bool poll(size_t memoryInUse = 0) {
+        if (isCancelled())
+            return true;
+
+        // This counter is shared between threads but it doesn't need to be
+        // exact, so avoid the cost of an atomic read-modify-write.
+        auto count = pollCount.load(std::memory_order_relaxed) + 1;
+        pollCount.store(count, std::memory_order_relaxed);
+        if (count % PollInterval == 0 || (memoryLimit && memoryInUse > memoryLimit))
+            return check(memoryInUse);
+
+        return false;
+    }
+
+    /// Like @a poll, but always samples the clock. This is meant for places
+    /// that check in with the token infrequently, such as once per file.
+    bool check(size_t memoryInUse = 0);
+
+private:
+    std::atomic<Reason> reason = Reason::None;
+    std::atomic<uint32_t> pollCount = 0;
+    std::chrono::milliseconds timeLimit{0};
+    std::chrono::steady_clock::time_point deadline;
+    size_t memoryLimit = 0;
+};
+
+} // namespace slang
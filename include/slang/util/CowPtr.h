@@ -0,0 +1,200 @@
+//------------------------------------------------------------------------------
+//! @file CowPtr.h
+//! @brief Copy-on-write smart pointer
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <atomic>
+#include <compare>
+#include <cstdint>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+namespace slang {
+
+/// A smart pointer that allocates its pointee on the heap and provides value copy
+/// semantics like CopyPtr, except that copies share the pointee until one of them
+/// is modified. This makes copying large values that are mostly read cheap.
+///
+/// Any access through a non-const pointer or reference counts as a modification:
+/// a shared pointee is cloned first so that the caller gets its own instance.
+/// Because the caller may hold on to that reference, later copies of the instance
+/// are made eagerly until the owner calls @a allowSharing to say that the
+/// modification is complete.
+///
+/// Comparisons and hashing are based on the pointed-to values, not their addresses.
+///
+/// The reference count is atomic so copies can be made and destroyed from
+/// multiple threads, as long as no thread modifies a pointer that another
+/// thread is copying at the same time.
+template<typename T>
+class CowPtr {
+public:
+    using pointer = T*;
+
+    CowPtr() {}
+    CowPtr(std::nullptr_t) {}
+    ~CowPtr() { release(); }
+
+    CowPtr(const CowPtr& other) : block(other.share()) {}
+    CowPtr(CowPtr&& other) noexcept : block(std::exchange(other.block, nullptr)) {}
+
+    template<typename U>
+        requires std::is_convertible_v<U*, T*>
+    CowPtr(const U& other) : block(new Block(other)) {}
+
+    template<typename U>
+        requires std::is_convertible_v<U*, T*>
+    CowPtr(U&& other) : block(new Block(std::forward<U>(other))) {}
+
+    /// Gets a pointer to the value for modification, cloning it first
+    /// if it's currently shared with any other copies.
+    T* get() {
+        detach();
+        return block ? &block->value : nullptr;
+    }
+
+    /// Gets a pointer to the value for reading. This never clones the value.
+    const T* get() const { return block ? &block->value : nullptr; }
+
+    T* operator->() { return get(); }
+    const T* operator->() const { return get(); }
+    decltype(auto) operator*() { return *get(); }
+    decltype(auto) operator*() const { return *get(); }
+
+    explicit operator bool() const { return block != nullptr; }
+
+    /// Returns true if the value is currently shared with at least one other copy.
+    bool isShared() const { return block && block->refCount.load(std::memory_order_acquire) > 1; }
+
+    /// Allows the value to be shared with future copies again after it has been
+    /// modified. Only call this once no references obtained through non-const
+    /// access are still in use.
+    void allowSharing() {
+        if (block)
+            block->shareable = true;
+    }
+
+    CowPtr& operator=(std::nullptr_t) {
+        release();
+        return *this;
+    }
+
+    template<typename U>
+        requires std::is_convertible_v<U*, T*>
+    CowPtr& operator=(const U& other) {
+        auto newBlock = new Block(other);
+        release();
+        block = newBlock;
+        return *this;
+    }
+
+    template<typename U>
+        requires std::is_convertible_v<U*, T*>
+    CowPtr& operator=(U&& other) {
+        auto newBlock = new Block(std::forward<U>(other));
+        release();
+        block = newBlock;
+        return *this;
+    }
+
+    CowPtr& operator=(const CowPtr& other) {
+        if (this != &other) {
+            auto newBlock = other.share();
+            release();
+            block = newBlock;
+        }
+        return *this;
+    }
+
+    CowPtr& operator=(CowPtr&& other) noexcept {
+        if (this != &other) {
+            release();
+            block = std::exchange(other.block, nullptr);
+        }
+        return *this;
+    }
+
+    template<typename U>
+    bool operator==(const CowPtr<U>& rhs) const {
+        auto l = get();
+        auto r = rhs.get();
+        if (!l || !r)
+            return !l && !r;
+        return *l == *r;
+    }
+
+    template<typename U>
+    std::compare_three_way_result_t<T, U> operator<=>(const CowPtr<U>& rhs) const {
+        // Null pointers order before everything else.
+        auto l = get();
+        auto r = rhs.get();
+        if (!l || !r)
+            return (l != nullptr) <=> (r != nullptr);
+        return *l <=> *r;
+    }
+
+private:
+    struct Block {
+        template<typename... Args>
+        explicit Block(Args&&... args) : value(std::forward<Args>(args)...) {}
+
+        T value;
+        std::atomic<uint32_t> refCount = 1;
+        bool shareable = true;
+    };
+
+    Block* share() const {
+        if (!block)
+            return nullptr;
+
+        if (!block->shareable)
+            return new Block(block->value);
+
+        block->refCount.fetch_add(1, std::memory_order_relaxed);
+        return block;
+    }
+
+    void detach() {
+        if (!block)
+            return;
+
+        if (block->refCount.load(std::memory_order_acquire) != 1) {
+            auto newBlock = new Block(block->value);
+            release();
+            block = newBlock;
+        }
+        block->shareable = false;
+    }
+
+    void release() {
+        if (block && block->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete block;
+        block = nullptr;
+    }
+
+    Block* block = nullptr;
+};
+
+template<typename T>
+std::ostream& operator<<(std::ostream& os, const CowPtr<T>& val) {
+    os << val.get();
+    return os;
+}
+
+} // namespace slang
+
+namespace std {
+
+template<typename T>
+struct hash<slang::CowPtr<T>> {
+    std::size_t operator()(const slang::CowPtr<T>& value) const {
+        return value ? hash<T>{}(*value) : 0;
+    }
+};
+
+} // namespace std
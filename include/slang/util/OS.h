@@ -42,6 +42,15 @@ public:
     /// Note that the buffer will be null-terminated.
     static std::error_code readFile(const std::filesystem::path& path, SmallVector<char>& buffer);
 
+    /// Maps the file at @a path into memory for reading. If successful, the mapped
+    /// bytes are placed into @a contents and must later be released by calling
+    /// @a unmapFile. Empty files produce an empty span without any mapping.
+    static std::error_code mapFile(const std::filesystem::path& path,
+                                   std::span<const char>& contents);
+
+    /// Releases a mapping previously created by @a mapFile.
+    static void unmapFile(std::span<const char> contents);
+
     /// Writes the given contents to the specified file.
     static void writeFile(const std::filesystem::path& path, std::string_view contents);
 
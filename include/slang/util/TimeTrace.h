@@ -10,6 +10,7 @@
 #include <iosfwd>
 #include <memory>
 #include <string>
+#include <string_view>
 
 #include "slang/util/Function.h"
 #include "slang/util/Util.h"
@@ -45,6 +46,22 @@ public:
     /// Ends tracing a section previously started by @a beginTrace
     static void endTrace();
 
+    /// Adds @a amount to the named counter for the section currently being traced
+    /// on this thread. Each section in the output includes the totals of all counters
+    /// incremented while it was active, including within nested sections.
+    /// Counts made while no section is open on this thread are written out as
+    /// part of a "Thread" event that spans the whole trace.
+    /// @param name the name of the counter, which must have static lifetime
+    /// @param amount the amount to add to the counter
+    static void count(std::string_view name, uint64_t amount = 1);
+
+    /// Adds @a amount to one of a group of related counters, such as the number
+    /// of symbols of each kind. The counters in a group are written together.
+    /// @param group the name of the group, which must have static lifetime
+    /// @param name the name of the counter, which must have static lifetime
+    /// @param amount the amount to add to the counter
+    static void count(std::string_view group, std::string_view name, uint64_t amount = 1);
+
 private:
     TimeTrace() = delete;
 
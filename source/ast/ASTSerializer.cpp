@@ -13,12 +13,13 @@
 #include "slang/syntax/AllSyntax.h"
 #include "slang/text/CharInfo.h"
 #include "slang/text/FormatBuffer.h"
-#include "slang/text/Json.h"
 #include "slang/text/SourceManager.h"
+#include "slang/text/StructuredWriter.h"
+#include "slang/util/ThreadPool.h"
 
 namespace slang::ast {
 
-ASTSerializer::ASTSerializer(Compilation& compilation, JsonWriter& writer) :
+ASTSerializer::ASTSerializer(Compilation& compilation, StructuredWriter& writer) :
     compilation(compilation), writer(writer) {
 }
 
@@ -173,6 +174,39 @@ void ASTSerializer::writeProperty(std::string_view name) {
     writer.writeProperty(name);
 }
 
+bool ASTSerializer::serializeMembersParallel(const Scope& scope) {
+    SmallVector<const Symbol*> members;
+    for (auto& member : scope.members())
+        members.push_back(&member);
+
+    // Fragments must be created after the members array has been
+    // started so that they pick up the correct indentation.
+    std::vector<std::unique_ptr<StructuredWriter>> fragments;
+    for (size_t i = 0; i < members.size(); i++) {
+        auto fragment = writer.createFragment();
+        if (!fragment)
+            return false;
+        fragments.emplace_back(std::move(fragment));
+    }
+
+    threadPool->pushLoop(
+        size_t(0), members.size(),
+        [&](size_t start, size_t end) {
+            for (size_t i = start; i < end; i++) {
+                ASTSerializer serializer(compilation, *fragments[i]);
+                serializer.setIncludeAddresses(includeAddrs);
+                serializer.setIncludeSourceInfo(includeSourceInfo);
+                serializer.serialize(*members[i], /* inMembersArray */ true);
+            }
+        },
+        members.size());
+    threadPool->waitForAll();
+
+    for (auto& fragment : fragments)
+        writer.writeFragment(*fragment);
+    return true;
+}
+
 template<typename T>
 void ASTSerializer::visit(const T& elem, bool inMembersArray) {
     if constexpr (std::is_base_of_v<Expression, T> || std::is_base_of_v<Statement, T> ||
@@ -292,8 +326,16 @@ void ASTSerializer::visit(const T& elem, bool inMembersArray) {
         if constexpr (std::is_base_of_v<Scope, T>) {
             if (!elem.empty()) {
                 startArray("members");
-                for (auto& member : elem.members())
-                    serialize(member, /* inMembersArray */ true);
+                // Serializers used for the members don't have a thread
+                // pool, so only the outermost scope gets split up.
+                bool done = false;
+                if (threadPool && compilation.isFullyElaborated())
+                    done = serializeMembersParallel(elem);
+
+                if (!done) {
+                    for (auto& member : elem.members())
+                        serialize(member, /* inMembersArray */ true);
+                }
                 endArray();
             }
         }
@@ -290,6 +290,7 @@ static ConstantValue constContainer(const Type& type, std::span<ConstantValue> e
     auto& ct = type.getCanonicalType();
     switch (ct.kind) {
         case SymbolKind::FixedSizeUnpackedArrayType:
+            return ConstantValue::createArray(ConstantValue::Elements(elems.begin(), elems.end()));
         case SymbolKind::DynamicArrayType:
         case SymbolKind::UnpackedStructType:
             return ConstantValue::Elements(elems.begin(), elems.end());
@@ -313,14 +314,18 @@ static void packBitstream(ConstantValue& value, SmallVectorBase<ConstantValue*>&
         if (!value.str().empty())
             packed.push_back(&value);
     }
+    else if (value.isDense()) {
+        // The packed storage of a dense array is already its bitstream.
+        value = std::as_const(value).dense()->getPacked();
+        packed.push_back(&value);
+    }
     else if (value.isUnpacked()) {
         for (auto& cv : value.elements())
             packBitstream(cv, packed);
     }
     else if (value.isMap()) {
-        for (auto& kv : *value.map()) {
+        for (auto& kv : *value.map())
             packBitstream(kv.second, packed);
-        }
     }
     else if (value.isQueue()) {
         for (auto& cv : *value.queue())
@@ -341,11 +346,16 @@ static SVInt slicePacked(PackIterator& iter, const PackIterator iterEnd, uint64_
         return SVInt(bitwidth_t(width), 0, false); // filling with zero bits on the right
     }
 
-    ConstantValue cp = **iter;
-    if (cp.isString())
-        cp = cp.convertToInt();
+    // Avoid copying the source value unless it has to be converted; it can be
+    // much wider than the slice being taken from it.
+    const ConstantValue* cp = *iter;
+    ConstantValue converted;
+    if (cp->isString()) {
+        converted = cp->convertToInt();
+        cp = &converted;
+    }
 
-    auto& ci = cp.integer();
+    auto& ci = cp->integer();
     SLANG_ASSERT(bit < ci.getBitWidth());
     uint64_t msb = ci.getBitWidth() - bit - 1;
     uint64_t lsb = std::min<uint64_t>(bit + width, ci.getBitWidth());
@@ -359,7 +369,7 @@ static SVInt slicePacked(PackIterator& iter, const PackIterator iterEnd, uint64_
     }
 
     if (lsb == 0 && msb == ci.getBitWidth() - 1)
-        return std::move(ci);
+        return ci;
 
     return ci.slice(static_cast<int32_t>(msb), static_cast<int32_t>(lsb));
 }
@@ -439,7 +449,15 @@ static ConstantValue unpackBitstream(const Type& type, PackIterator& iter,
         else {
             auto& fsua = ct.as<FixedSizeUnpackedArrayType>();
             auto& elem = fsua.elementType;
-            for (auto width = fsua.range.width(); width > 0; width--)
+            auto count = fsua.range.width();
+            if (elem.isIntegral() && DenseArray::canStore(count, elem.getBitWidth())) {
+                // Dense arrays store exactly their bitstream, so take it all at once.
+                auto bits = concatPacked(bitwidth_t(count * elem.getBitWidth()),
+                                         elem.isFourState());
+                return DenseArray::fromPacked(count, bits, elem.isSigned());
+            }
+
+            for (auto width = count; width > 0; width--)
                 buffer.emplace_back(unpackBitstream(elem, iter, iterEnd, bit, dynamicSize));
         }
 
@@ -937,7 +955,8 @@ ConstantValue Bitstream::resizeToRange(ConstantValue&& value, ConstantRange rang
         upper = std::min(upper + 1, size);
 
         if (value.isUnpacked()) {
-            const auto old = value.elements();
+            value.expandDense();
+            const auto old = std::as_const(value).elements();
             ConstantValue::Elements sliceValue;
             sliceValue.reserve(range.width());
             sliceValue.insert(sliceValue.end(), old.begin() + lower, old.begin() + upper);
@@ -947,9 +966,10 @@ ConstantValue Bitstream::resizeToRange(ConstantValue&& value, ConstantRange rang
         }
         else {
             SLANG_ASSERT(value.isQueue());
-            const auto& old = value.queue();
-            SVQueue sliceValue(old->cbegin() + lower, old->cbegin() + upper);
-            sliceValue.insert(sliceValue.end(), more, defaultValue);
+            auto& old = *std::as_const(value).queue();
+            SVQueue sliceValue(old.begin() + lower, old.begin() + upper);
+            for (size_t i = 0; i < more; i++)
+                sliceValue.push_back(defaultValue);
             SLANG_ASSERT(sliceValue.size() == range.width());
             return sliceValue;
         }
@@ -12,6 +12,9 @@
 #include <fmt/core.h>
 #include <mutex>
 
+#include "slang/ast/ConstEvalProfiler.h"
+#include "slang/ast/ConstFunctionMemo.h"
+#include "slang/ast/EvalProgram.h"
 #include "slang/ast/ScriptSession.h"
 #include "slang/ast/SystemSubroutine.h"
 #include "slang/ast/types/TypePrinter.h"
@@ -43,6 +46,9 @@ Compilation::Compilation(const Bag& options, const SourceLibrary* defaultLib) :
     options(options.getOrDefault<CompilationOptions>()), driverMapAllocator(*this),
     unrollIntervalMapAllocator(*this), tempDiag({}, {}), defaultLibPtr(defaultLib) {
 
+    // Checking this once up front keeps the cost of emplace() down when tracing is off.
+    traceSymbols = TimeTrace::isEnabled();
+
     // Construct all built-in types.
     auto& bi = slang::ast::builtins::Builtins::Instance;
     bitType = &bi.bitType;
@@ -299,6 +305,13 @@ const RootSymbol& Compilation::getRoot(bool skipDefParamsAndBinds) {
     if (finalized)
         return *root;
 
+    // This is where elaboration starts, so start the clock on its budget too,
+    // unless someone has already asked for it to be cancelled.
+    if (!cancellation.isCancelled()) {
+        cancellation.start(std::chrono::milliseconds(options.maxElaborationTime),
+                           size_t(options.maxElaborationMemory));
+    }
+
     // Resolve default lib list now that we have all syntax trees added.
     defaultLiblist.reserve(options.defaultLiblist.size());
     for (auto& libName : options.defaultLiblist) {
@@ -1278,6 +1291,53 @@ std::pair<bool, bool> Compilation::isReferenced(const SyntaxNode& node) const {
     return it->second;
 }
 
+void Compilation::noteSubroutineCall(const SubroutineSymbol& subroutine) {
+    calledSubroutines.emplace(&subroutine);
+}
+
+void Compilation::noteInterfaceMethodImpl(const SubroutineSymbol& ifaceMethod,
+                                          const SubroutineSymbol& impl) {
+    auto& methods = interfaceMethodImpls[&impl];
+    if (std::ranges::find(methods, &ifaceMethod) == methods.end())
+        methods.push_back(&ifaceMethod);
+}
+
+std::span<const SubroutineSymbol* const> Compilation::getImplementedInterfaceMethods(
+    const SubroutineSymbol& impl) const {
+    if (auto it = interfaceMethodImpls.find(&impl); it != interfaceMethodImpls.end())
+        return it->second;
+    return {};
+}
+
+const EvalProgram* Compilation::getEvalProgram(const SubroutineSymbol& subroutine) {
+    if (auto it = evalPrograms.find(&subroutine); it != evalPrograms.end())
+        return it->second.get();
+
+    // Note that compiling can bind the subroutine's body, which can
+    // in turn evaluate other calls, so don't hold on to an iterator.
+    auto program = EvalProgram::compile(subroutine);
+    auto [it, _] = evalPrograms.emplace(&subroutine, std::move(program));
+    return it->second.get();
+}
+
+ConstFunctionMemo* Compilation::getConstFunctionMemo() {
+    if (options.maxConstexprMemoEntries == 0)
+        return nullptr;
+
+    if (!constFunctionMemo)
+        constFunctionMemo = std::make_unique<ConstFunctionMemo>(options.maxConstexprMemoEntries);
+    return constFunctionMemo.get();
+}
+
+ConstEvalProfiler* Compilation::getConstEvalProfiler() {
+    if (!hasFlag(CompilationFlags::ProfileConstEval))
+        return nullptr;
+
+    if (!constEvalProfiler)
+        constEvalProfiler = std::make_unique<ConstEvalProfiler>();
+    return constEvalProfiler.get();
+}
+
 const NameSyntax& Compilation::parseName(std::string_view name) {
     Diagnostics localDiags;
     auto& result = tryParseName(name, localDiags);
@@ -1311,10 +1371,40 @@ void Compilation::elaborate() {
     // we can be sure we have all the diagnostics.
     uint32_t errorLimit = options.errorLimit == 0 ? UINT32_MAX : options.errorLimit;
     DiagnosticVisitor elabVisitor(*this, numErrors, errorLimit);
+    elabVisitor.deferSubroutineBodies = hasFlag(CompilationFlags::LazySubroutineBodies) &&
+                                        !hasFlag(CompilationFlags::LintMode);
     getRoot().visit(elabVisitor);
 
-    if (elabVisitor.finishedEarly())
+    if (elabVisitor.finishedEarly()) {
+        if (cancellation.isCancelled()) {
+            // Point at the innermost instance that was being elaborated
+            // when the cancellation was noticed, if there was one.
+            std::string path;
+            Diagnostic* diag;
+            if (auto inst = elabVisitor.cancelledInstance) {
+                inst->getHierarchicalPath(path);
+                diag = &inst->getParentScope()->addDiag(diag::ElaborationCancelled,
+                                                        inst->location);
+            }
+            else {
+                path = root->name;
+                diag = &root->addDiag(diag::ElaborationCancelled, SourceLocation::NoLocation);
+            }
+            *diag << path << cancellation.getReasonString();
+        }
         return;
+    }
+
+    if (elabVisitor.deferSubroutineBodies) {
+        // DPI exported subroutines can be called from foreign code at any
+        // time so they always need their bodies bound.
+        auto exports = dpiExports;
+        for (auto [syntax, scope] : exports) {
+            auto symbol = scope->find(syntax->name.valueText());
+            if (symbol && symbol->kind == SymbolKind::Subroutine)
+                noteSubroutineCall(symbol->as<SubroutineSymbol>());
+        }
+    }
 
     elabVisitor.finalize();
 
@@ -1452,6 +1542,9 @@ void Compilation::elaborate() {
         PostElabVisitor postElabVisitor(*this);
         getRoot().visit(postElabVisitor);
     }
+
+    fullyElaborated = !elabVisitor.deferSubroutineBodies && !elaborationStopped &&
+                      !cancellation.isCancelled();
 }
 
 const Diagnostics& Compilation::getParseDiagnostics() {
@@ -1474,7 +1567,102 @@ const Diagnostics& Compilation::getSemanticDiagnostics() {
     // Elaborate the design.
     elaborate();
 
+    if (constFunctionMemo && TimeTrace::isEnabled()) {
+        TimeTrace::beginTrace("constFunctionMemo"sv, [&] {
+            auto hits = constFunctionMemo->getHitCount();
+            auto total = hits + constFunctionMemo->getMissCount();
+            return fmt::format("hits: {}, misses: {}, hit rate: {:.1f}%, entries: {}", hits,
+                               total - hits, total ? 100.0 * double(hits) / double(total) : 0.0,
+                               constFunctionMemo->size());
+        });
+        TimeTrace::endTrace();
+    }
+
+    // When streaming, everything found so far gets delivered to the
+    // callback and there will be nothing left to return here.
+    flushDiagnostics();
+
     Diagnostics results;
+    coalesceDiags(results);
+
+    if (sourceManager)
+        results.sort(*sourceManager);
+
+    cachedSemanticDiagnostics.emplace(std::move(results));
+    return *cachedSemanticDiagnostics;
+}
+
+const Diagnostics& Compilation::getAllDiagnostics() {
+    if (cachedAllDiagnostics)
+        return *cachedAllDiagnostics;
+
+    cachedAllDiagnostics.emplace();
+    cachedAllDiagnostics->append_range(getParseDiagnostics());
+    cachedAllDiagnostics->append_range(getSemanticDiagnostics());
+
+    if (sourceManager)
+        cachedAllDiagnostics->sort(*sourceManager);
+    return *cachedAllDiagnostics;
+}
+
+void Compilation::setDiagnosticCallback(DiagnosticCallback callback) {
+    diagCallback = std::move(callback);
+}
+
+// Hashes the arguments of a diagnostic, consistent with Diagnostic::operator==
+// (which only compares the type of custom arguments).
+static size_t diagArgsFingerprint(const Diagnostic& diag) {
+    size_t seed = 0;
+    for (auto& arg : diag.args) {
+        hash_combine(seed, arg.index());
+        std::visit(
+            [&](auto&& a) {
+                using T = std::decay_t<decltype(a)>;
+                if constexpr (!std::is_same_v<T, Diagnostic::CustomArgType>)
+                    hash_combine(seed, a);
+            },
+            arg);
+    }
+    return seed;
+}
+
+void Compilation::flushDiagnostics() {
+    if (!diagCallback || diagMap.empty())
+        return;
+
+    Diagnostics coalesced;
+    coalesceDiags(coalesced);
+    diagMap.clear();
+
+    Diagnostics batch;
+    for (auto& diag : coalesced) {
+        if (diag.location != SourceLocation::NoLocation) {
+            // Drop exact repeats of diagnostics from earlier batches. If the arguments
+            // differ, make sure the instance path gets printed to tell them apart.
+            auto fingerprint = diagArgsFingerprint(diag);
+            auto [it, inserted] = streamedDiags.try_emplace({diag.code, diag.location},
+                                                            fingerprint);
+            if (!inserted) {
+                if (it->second == fingerprint)
+                    continue;
+                if (!diag.coalesceCount)
+                    diag.coalesceCount = 1;
+            }
+        }
+        batch.emplace_back(std::move(diag));
+    }
+
+    if (batch.empty())
+        return;
+
+    if (sourceManager)
+        batch.sort(*sourceManager);
+
+    if (!diagCallback(batch))
+        elaborationStopped = true;
+}
+
+void Compilation::coalesceDiags(Diagnostics& results) {
     for (auto& [key, diagList] : diagMap) {
         // If the location is NoLocation, just issue each diagnostic.
         if (std::get<1>(key) == SourceLocation::NoLocation) {
@@ -1568,24 +1756,6 @@ const Diagnostics& Compilation::getSemanticDiagnostics() {
         }
     }
 
-    if (sourceManager)
-        results.sort(*sourceManager);
-
-    cachedSemanticDiagnostics.emplace(std::move(results));
-    return *cachedSemanticDiagnostics;
-}
-
-const Diagnostics& Compilation::getAllDiagnostics() {
-    if (cachedAllDiagnostics)
-        return *cachedAllDiagnostics;
-
-    cachedAllDiagnostics.emplace();
-    cachedAllDiagnostics->append_range(getParseDiagnostics());
-    cachedAllDiagnostics->append_range(getSemanticDiagnostics());
-
-    if (sourceManager)
-        cachedAllDiagnostics->sort(*sourceManager);
-    return *cachedAllDiagnostics;
 }
 
 void Compilation::addDiagnostics(const Diagnostics& diagnostics) {
@@ -1613,17 +1783,21 @@ Diagnostic& Compilation::addDiag(Diagnostic diag) {
         return tempDiag;
     }
 
+    if (TimeTrace::isEnabled())
+        TimeTrace::count("diagnostics"sv);
+
     // Coalesce diagnostics that are at the same source location and have the same code.
-    if (auto it = diagMap.find({diag.code, diag.location}); it != diagMap.end()) {
+    auto key = std::make_tuple(diag.code, diag.location);
+    if (auto it = diagMap.find(key); it != diagMap.end()) {
         auto& diagList = it->second;
         diagList.emplace_back(std::move(diag));
         return diagList.back();
     }
 
-    if (diag.isError())
+    // Errors that were already streamed out have been counted.
+    if (diag.isError() && !streamedDiags.contains(key))
         numErrors++;
 
-    auto key = std::make_tuple(diag.code, diag.location);
     std::vector<Diagnostic> newEntry;
     newEntry.emplace_back(std::move(diag));
 
@@ -1639,6 +1813,12 @@ ConfigBlockSymbol* Compilation::allocConfigBlock(std::string_view name, SourceLo
     return configBlockAllocator.emplace(*this, name, loc);
 }
 
+void Compilation::noteSymbolCreated(SymbolKind kind) {
+    TimeTrace::count("symbols"sv, toString(kind));
+    if (Type::isKind(kind))
+        TimeTrace::count("types"sv);
+}
+
 Scope::WildcardImportData* Compilation::allocWildcardImportData() {
     return wildcardImportAllocator.emplace();
 }
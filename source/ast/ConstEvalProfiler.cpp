@@ -0,0 +1,120 @@
+//------------------------------------------------------------------------------
+// ConstEvalProfiler.cpp
+// Attribution of constant evaluation cost to functions and parameters
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#include "slang/ast/ConstEvalProfiler.h"
+
+#include <algorithm>
+#include <fmt/format.h>
+
+#include "slang/ast/Symbol.h"
+#include "slang/numeric/SVInt.h"
+#include "slang/util/TimeTrace.h"
+
+using namespace std::chrono;
+
+namespace slang::ast {
+
+ConstEvalProfiler::ConstEvalProfiler() = default;
+ConstEvalProfiler::~ConstEvalProfiler() = default;
+
+void ConstEvalProfiler::enter(const Symbol& symbol) {
+    auto& entry = getEntry(symbol);
+    entry.calls++;
+    entry.activeDepth++;
+
+    if (TimeTrace::isEnabled())
+        TimeTrace::beginTrace("constEval"sv, entry.name);
+
+    active.push_back({&entry, steady_clock::now(), totalSteps, SVInt::getHeapAllocationCount()});
+}
+
+void ConstEvalProfiler::exit() {
+    SLANG_ASSERT(!active.empty());
+    auto scope = active.back();
+    active.pop_back();
+
+    auto time = steady_clock::now() - scope.startTime;
+    auto steps = totalSteps - scope.startSteps;
+    auto allocations = SVInt::getHeapAllocationCount() - scope.startAllocations;
+
+    if (TimeTrace::isEnabled())
+        TimeTrace::endTrace();
+
+    auto& entry = *scope.entry;
+    entry.selfTime += time - scope.childTime;
+    entry.selfSteps += steps - scope.childSteps;
+    entry.selfAllocations += allocations - scope.childAllocations;
+
+    // For recursive calls only the outermost scope counts towards the
+    // inclusive totals, since it already contains all of the inner ones.
+    if (--entry.activeDepth == 0) {
+        entry.time += time;
+        entry.steps += steps;
+        entry.allocations += allocations;
+    }
+
+    if (!active.empty()) {
+        auto& parent = active.back();
+        parent.childTime += time;
+        parent.childSteps += steps;
+        parent.childAllocations += allocations;
+    }
+}
+
+std::vector<const ConstEvalProfiler::Entry*> ConstEvalProfiler::getEntries() const {
+    std::vector<const Entry*> results;
+    results.reserve(entryMap.size());
+    for (auto& [symbol, entry] : entryMap)
+        results.push_back(entry.get());
+
+    // Break ties by name so that the order is deterministic.
+    std::ranges::sort(results, [](const Entry* a, const Entry* b) {
+        if (a->time != b->time)
+            return a->time > b->time;
+        return a->name < b->name;
+    });
+    return results;
+}
+
+std::string ConstEvalProfiler::report(size_t maxEntries) const {
+    auto entries = getEntries();
+    const size_t count = std::min(maxEntries, entries.size());
+
+    auto toMs = [](Duration d) { return duration<double, std::milli>(d).count(); };
+
+    std::string result = fmt::format("Constant evaluation profile ({} of {} entries):\n", count,
+                                     entries.size());
+    result += fmt::format("{:>12} {:>12} {:>12} {:>12} {:>10} {:>10}  {}\n", "time (ms)",
+                          "self (ms)", "steps", "self steps", "calls", "allocs", "name");
+
+    for (size_t i = 0; i < count; i++) {
+        auto& entry = *entries[i];
+        result += fmt::format("{:>12.3f} {:>12.3f} {:>12} {:>12} {:>10} {:>10}  {} {}\n",
+                              toMs(entry.time), toMs(entry.selfTime), entry.steps,
+                              entry.selfSteps, entry.calls, entry.allocations,
+                              toString(entry.symbol->kind), entry.name);
+    }
+    return result;
+}
+
+ConstEvalProfiler::Entry& ConstEvalProfiler::getEntry(const Symbol& symbol) {
+    auto& ptr = entryMap[&symbol];
+    if (!ptr) {
+        // Subroutines are identified by where they're declared, while parameters
+        // get a distinct entry per instance so they're named by their full path.
+        std::string name;
+        if (symbol.kind == SymbolKind::Parameter)
+            symbol.getHierarchicalPath(name);
+        else
+            symbol.getLexicalPath(name);
+
+        ptr = std::make_unique<Entry>(symbol, std::move(name));
+    }
+    return *ptr;
+}
+
+} // namespace slang::ast
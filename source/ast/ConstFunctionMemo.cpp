@@ -0,0 +1,171 @@
+//------------------------------------------------------------------------------
+// ConstFunctionMemo.cpp
+// Memoization of pure constant function calls
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#include "slang/ast/ConstFunctionMemo.h"
+
+#include "slang/ast/ASTVisitor.h"
+#include "slang/ast/expressions/CallExpression.h"
+#include "slang/ast/expressions/LiteralExpressions.h"
+#include "slang/ast/expressions/MiscExpressions.h"
+#include "slang/ast/symbols/SubroutineSymbols.h"
+#include "slang/ast/symbols/VariableSymbols.h"
+
+namespace slang::ast {
+
+namespace {
+
+// Walks a subroutine body, and the bodies of everything it calls, looking
+// for anything that could make the result depend on more than the values
+// of the arguments.
+struct PurityVisitor : public ASTVisitor<PurityVisitor, true, true> {
+    const SubroutineSymbol& root;
+    flat_hash_set<const SubroutineSymbol*> visited;
+    flat_hash_set<const ValueSymbol*> declOrderChecked;
+    const SubroutineSymbol* current = nullptr;
+    bool isPure = true;
+
+    explicit PurityVisitor(const SubroutineSymbol& root) : root(root) {}
+
+    void visitBody(const SubroutineSymbol& subroutine) {
+        if (!isPure || !visited.insert(&subroutine).second)
+            return;
+
+        if (subroutine.flags.has(MethodFlags::DPIImport) || !subroutine.returnValVar ||
+            subroutine.getReturnType().isVoid()) {
+            isPure = false;
+            return;
+        }
+
+        for (auto arg : subroutine.getArguments()) {
+            if (arg->direction != ArgumentDirection::In) {
+                isPure = false;
+                return;
+            }
+        }
+
+        auto saved = std::exchange(current, &subroutine);
+        subroutine.getBody().visit(*this);
+        current = saved;
+    }
+
+    void handle(const VariableDeclStatement& stmt) {
+        if (auto init = stmt.symbol.getInitializer())
+            init->visit(*this);
+    }
+
+    void handle(const NamedValueExpression& expr) {
+        switch (expr.symbol.kind) {
+            case SymbolKind::Parameter:
+            case SymbolKind::EnumValue:
+                // These must be declared before the call site, which is checked
+                // relative to the frame of the function that references them.
+                // Nested calls are made from fixed locations within the body so
+                // only the root function's references depend on the caller.
+                if (current == &root)
+                    declOrderChecked.insert(&expr.symbol);
+                break;
+            case SymbolKind::Specparam:
+                isPure = false;
+                break;
+            default:
+                break;
+        }
+    }
+
+    void handle(const CallExpression& expr) {
+        if (!expr.isSystemCall()) {
+            if (expr.thisClass()) {
+                isPure = false;
+                return;
+            }
+            visitBody(*std::get<0>(expr.subroutine));
+        }
+        visitDefault(expr);
+    }
+
+    // Hierarchical references are allowed or not depending on the context of
+    // the top-level evaluation, and a bare '$' depends on the evaluation flags.
+    void handle(const HierarchicalValueExpression&) { isPure = false; }
+    void handle(const ArbitrarySymbolExpression&) { isPure = false; }
+    void handle(const UnboundedLiteral&) { isPure = false; }
+};
+
+} // namespace
+
+size_t ConstFunctionMemo::KeyHash::operator()(const KeyView& key) const {
+    size_t h = 0;
+    hash_combine(h, key.subroutine);
+    for (auto& arg : key.args)
+        hash_combine(h, arg.hash());
+    return h;
+}
+
+bool ConstFunctionMemo::KeyEqual::operator()(const KeyView& lhs, const KeyView& rhs) const {
+    return lhs.subroutine == rhs.subroutine && std::ranges::equal(lhs.args, rhs.args);
+}
+
+const ConstFunctionMemo::Purity& ConstFunctionMemo::getPurity(const SubroutineSymbol& subroutine) {
+    if (auto it = purityCache.find(&subroutine); it != purityCache.end())
+        return it->second;
+
+    PurityVisitor visitor(subroutine);
+    visitor.visitBody(subroutine);
+
+    Purity purity;
+    purity.isPure = visitor.isPure;
+    if (purity.isPure) {
+        purity.declOrderChecked.assign(visitor.declOrderChecked.begin(),
+                                       visitor.declOrderChecked.end());
+    }
+
+    return purityCache.emplace(&subroutine, std::move(purity)).first->second;
+}
+
+bool ConstFunctionMemo::canMemoize(const SubroutineSymbol& subroutine,
+                                   LookupLocation lookupLocation,
+                                   std::span<const ConstantValue> args) {
+    if (maxEntries == 0)
+        return false;
+
+    // Real values are excluded since equality doesn't
+    // distinguish between positive and negative zero.
+    for (auto& arg : args) {
+        if (!arg.isInteger() && !arg.isString())
+            return false;
+    }
+
+    auto& purity = getPurity(subroutine);
+    if (!purity.isPure)
+        return false;
+
+    for (auto symbol : purity.declOrderChecked) {
+        if (!symbol->isDeclaredBefore(lookupLocation).value_or(true))
+            return false;
+    }
+    return true;
+}
+
+const ConstantValue* ConstFunctionMemo::find(const SubroutineSymbol& subroutine,
+                                             std::span<const ConstantValue> args) {
+    if (auto it = results.find(KeyView{&subroutine, args}); it != results.end()) {
+        hits++;
+        return &it->second;
+    }
+
+    misses++;
+    return nullptr;
+}
+
+void ConstFunctionMemo::insert(const SubroutineSymbol& subroutine,
+                               std::span<const ConstantValue> args, const ConstantValue& result) {
+    if (results.size() >= maxEntries)
+        return;
+
+    results.emplace(Key{&subroutine, {args.begin(), args.end()}}, result);
+}
+
+} // namespace slang::ast
@@ -22,7 +22,10 @@ struct DiagnosticVisitor : public ASTVisitor<DiagnosticVisitor, false, false> {
     DiagnosticVisitor(Compilation& compilation, const size_t& numErrors, uint32_t errorLimit) :
         compilation(compilation), numErrors(numErrors), errorLimit(errorLimit) {}
 
-    bool finishedEarly() const { return numErrors > errorLimit || hierarchyProblem; }
+    bool finishedEarly() const {
+        return numErrors > errorLimit || hierarchyProblem || compilation.isElaborationStopped() ||
+               compilation.isCancelled();
+    }
 
     template<typename T>
     void handle(const T& symbol) {
@@ -30,7 +33,7 @@ struct DiagnosticVisitor : public ASTVisitor<DiagnosticVisitor, false, false> {
     }
 
     template<typename T>
-    bool handleDefault(const T& symbol) {
+    bool handleDefault(const T& symbol, bool bindBody = true) {
         if (finishedEarly())
             return false;
 
@@ -51,11 +54,13 @@ struct DiagnosticVisitor : public ASTVisitor<DiagnosticVisitor, false, false> {
         }
 
         if constexpr (requires { symbol.getBody().bad(); }) {
-            auto& body = symbol.getBody();
-            if (body.bad())
-                return true;
+            if (bindBody) {
+                auto& body = symbol.getBody();
+                if (body.bad())
+                    return true;
 
-            body.visit(*this);
+                body.visit(*this);
+            }
         }
 
         visitDefault(symbol);
@@ -336,14 +341,30 @@ struct DiagnosticVisitor : public ASTVisitor<DiagnosticVisitor, false, false> {
             return;
         }
 
-        if (visitInstances)
+        if (visitInstances) {
             visit(symbol.body);
+
+            // Unwinding from a cancellation passes through the innermost
+            // instance first, so that's the one that gets remembered.
+            if (!cancelledInstance && compilation.getCancellationToken().isCancelled())
+                cancelledInstance = &symbol;
+
+            // If diagnostics are being streamed, everything from this
+            // instance can be handed off now.
+            compilation.flushDiagnostics();
+        }
     }
 
     void handle(const SubroutineSymbol& symbol) {
-        if (!handleDefault(symbol))
+        // Only binding the body itself is deferred; everything else about
+        // the subroutine is still checked now.
+        bool deferBody = deferSubroutineBodies && canDeferBody(symbol);
+        if (!handleDefault(symbol, /* bindBody */ !deferBody))
             return;
 
+        if (deferBody)
+            deferredSubroutines.push_back(&symbol);
+
         if (symbol.flags.has(MethodFlags::DPIImport))
             dpiImports.push_back(&symbol);
     }
@@ -429,7 +450,9 @@ struct DiagnosticVisitor : public ASTVisitor<DiagnosticVisitor, false, false> {
         SmallVector<const Type*> toVisit;
         bool didSomething;
         do {
-            didSomething = false;
+            // Binding deferred subroutine bodies can also create new specializations,
+            // and visiting specializations can note calls to more subroutines.
+            didSomething = visitNeededSubroutines();
             for (auto symbol : genericClasses) {
                 for (auto& spec : symbol->specializations()) {
                     if (visitedSpecs.emplace(&spec).second)
@@ -454,15 +477,70 @@ struct DiagnosticVisitor : public ASTVisitor<DiagnosticVisitor, false, false> {
         }
     }
 
+    static bool canDeferBody(const SubroutineSymbol& symbol) {
+        // Constructors and the randomize callbacks are invoked implicitly,
+        // and DPI imports don't have a body to bind anyway.
+        if (symbol.flags.has(MethodFlags::Constructor | MethodFlags::DPIImport) ||
+            symbol.name == "pre_randomize"sv || symbol.name == "post_randomize"sv) {
+            return false;
+        }
+
+        auto kind = symbol.getParentScope()->asSymbol().kind;
+        return kind == SymbolKind::Package || kind == SymbolKind::ClassType;
+    }
+
+    bool isBodyNeeded(const SubroutineSymbol& symbol) const {
+        if (symbol.isBodyBound())
+            return true;
+
+        // Calls to a virtual method can dispatch to any override of it,
+        // and calls to an interface class method to any implementation of it.
+        for (auto sub = &symbol; sub; sub = sub->getOverride()) {
+            if (compilation.isSubroutineCalled(*sub))
+                return true;
+
+            for (auto ifaceMethod : compilation.getImplementedInterfaceMethods(*sub)) {
+                if (compilation.isSubroutineCalled(*ifaceMethod))
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    bool visitNeededSubroutines() {
+        bool didSomething = false;
+        bool changed;
+        do {
+            changed = false;
+            for (size_t i = 0; i < deferredSubroutines.size(); i++) {
+                if (finishedEarly())
+                    return didSomething;
+
+                auto sub = deferredSubroutines[i];
+                if (sub && isBodyNeeded(*sub)) {
+                    deferredSubroutines[i] = nullptr;
+                    if (auto& body = sub->getBody(); !body.bad())
+                        body.visit(*this);
+                    changed = didSomething = true;
+                }
+            }
+        } while (changed);
+
+        return didSomething;
+    }
+
     Compilation& compilation;
     const size_t& numErrors;
     uint32_t errorLimit;
     bool visitInstances = true;
+    bool deferSubroutineBodies = false;
     bool hierarchyProblem = false;
+    const InstanceSymbol* cancelledInstance = nullptr;
     flat_hash_set<const InstanceBodySymbol*> activeInstanceBodies;
     flat_hash_set<const DefinitionSymbol*> usedIfacePorts;
     SmallVector<const GenericClassDefSymbol*> genericClasses;
     SmallVector<const SubroutineSymbol*> dpiImports;
+    SmallVector<const SubroutineSymbol*> deferredSubroutines;
     SmallVector<const MethodPrototypeSymbol*> externIfaceProtos;
     SmallVector<std::pair<const InterfacePortSymbol*, const ModportSymbol*>> modportsWithExports;
     TimingPathMap timingPathMap;
@@ -597,6 +675,11 @@ struct PostElabVisitor : public ASTVisitor<PostElabVisitor, false, false> {
             return;
         }
 
+        // Bodies that were deferred and never bound have no reference
+        // information, so we can't say anything about their contents.
+        if (!symbol.isBodyBound())
+            return;
+
         visitDefault(symbol);
     }
 
@@ -9,19 +9,49 @@
 
 #include "slang/ast/ASTContext.h"
 #include "slang/ast/Compilation.h"
+#include "slang/ast/ConstEvalProfiler.h"
 #include "slang/ast/symbols/SubroutineSymbols.h"
 #include "slang/ast/symbols/VariableSymbols.h"
 #include "slang/ast/types/Type.h"
 #include "slang/diagnostics/ConstEvalDiags.h"
 #include "slang/text/FormatBuffer.h"
+#include "slang/util/TimeTrace.h"
 
 namespace slang::ast {
 
+namespace {
+
+// Returns the slot storage for the given symbol in the given
+// frame, or nullptr if the symbol doesn't have a slot there.
+std::optional<ConstantValue>* findSlot(const EvalContext::Frame& frame,
+                                       const ValueSymbol& symbol) {
+    if (frame.slots.empty() || !VariableSymbol::isKind(symbol.kind))
+        return nullptr;
+
+    auto index = symbol.as<VariableSymbol>().localSlot;
+    if (index >= frame.slots.size() || frame.subroutine->getLocalSlots()[index] != &symbol)
+        return nullptr;
+
+    return &frame.slots[index];
+}
+
+// The minimum number of slots in each block of slot storage.
+constexpr size_t MinSlotBlockSize = 64;
+
+} // namespace
+
+EvalContext::EvalContext(const ASTContext& astCtx, bitmask<EvalFlags> flags) :
+    astCtx(astCtx), flags(flags), profiler(astCtx.getCompilation().getConstEvalProfiler()) {
+    if (TimeTrace::isEnabled())
+        TimeTrace::count("constantEvals"sv);
+}
+
 void EvalContext::reset() {
     steps = 0;
     disableTarget = nullptr;
     queueTarget = nullptr;
-    stack.clear();
+    while (!stack.empty())
+        popFrame();
     lvalStack.clear();
     diags.clear();
     warnings.clear();
@@ -31,7 +61,9 @@ void EvalContext::reset() {
 
 ConstantValue* EvalContext::createLocal(const ValueSymbol* symbol, ConstantValue value) {
     SLANG_ASSERT(!stack.empty());
-    ConstantValue& result = stack.back().temporaries[symbol];
+    auto& frame = stack.back();
+    auto slot = findSlot(frame, *symbol);
+    ConstantValue& result = slot ? slot->emplace() : frame.temporaries[symbol];
     if (!value) {
         result = symbol->getType().getDefaultValue();
     }
@@ -50,6 +82,9 @@ ConstantValue* EvalContext::findLocal(const ValueSymbol* symbol) {
         return nullptr;
 
     auto& frame = stack.back();
+    if (auto slot = findSlot(frame, *symbol))
+        return *slot ? &**slot : nullptr;
+
     auto it = frame.temporaries.find(symbol);
     if (it == frame.temporaries.end())
         return nullptr;
@@ -59,7 +94,10 @@ ConstantValue* EvalContext::findLocal(const ValueSymbol* symbol) {
 void EvalContext::deleteLocal(const ValueSymbol* symbol) {
     if (!stack.empty()) {
         auto& frame = stack.back();
-        frame.temporaries.erase(symbol);
+        if (auto slot = findSlot(frame, *symbol))
+            slot->reset();
+        else
+            frame.temporaries.erase(symbol);
     }
 }
 
@@ -72,21 +110,71 @@ bool EvalContext::pushFrame(const SubroutineSymbol& subroutine, SourceLocation c
     }
 
     Frame frame;
+    frame.slots = allocateSlots(subroutine.getLocalSlots().size());
     frame.subroutine = &subroutine;
     frame.callLocation = callLocation;
     frame.lookupLocation = lookupLocation;
     stack.emplace_back(std::move(frame));
+
+    if (profiler)
+        profiler->enter(subroutine);
     return true;
 }
 
 void EvalContext::pushEmptyFrame() {
+    allocateSlots(0);
     stack.emplace_back(Frame{});
 }
 
 void EvalContext::popFrame() {
+    auto& frame = stack.back();
+    if (profiler && frame.subroutine)
+        profiler->exit();
+
+    for (auto& slot : frame.slots)
+        slot.reset();
+
+    auto mark = slotMarks.back();
+    slotMarks.pop_back();
+    if (!frame.slots.empty())
+        slotBlocks[mark.block].used = mark.offset;
+    currentSlotBlock = mark.prevBlock;
+
     stack.pop_back();
 }
 
+std::span<std::optional<ConstantValue>> EvalContext::allocateSlots(size_t count) {
+    const size_t prevBlock = currentSlotBlock;
+    if (count == 0) {
+        slotMarks.push_back({prevBlock, 0, prevBlock});
+        return {};
+    }
+
+    // Blocks past the current one are always unused, so the first one
+    // we find with enough room is free to hand out.
+    while (true) {
+        if (currentSlotBlock == slotBlocks.size()) {
+            size_t capacity = slotBlocks.empty() ? MinSlotBlockSize
+                                                 : slotBlocks.back().capacity * 2;
+            capacity = std::max(capacity, count);
+
+            auto& block = slotBlocks.emplace_back();
+            block.data = std::make_unique<std::optional<ConstantValue>[]>(capacity);
+            block.capacity = capacity;
+        }
+
+        auto& block = slotBlocks[currentSlotBlock];
+        if (block.capacity - block.used >= count) {
+            slotMarks.push_back({currentSlotBlock, block.used, prevBlock});
+            std::span<std::optional<ConstantValue>> result(block.data.get() + block.used, count);
+            block.used += count;
+            return result;
+        }
+
+        currentSlotBlock++;
+    }
+}
+
 void EvalContext::pushLValue(LValue& lval) {
     lvalStack.push_back(&lval);
 }
@@ -103,7 +191,16 @@ LValue* EvalContext::getTopLValue() const {
 }
 
 bool EvalContext::step(SourceLocation loc) {
-    if (++steps < getCompilation().getOptions().maxConstexprSteps)
+    if (profiler)
+        profiler->step();
+
+    auto& comp = getCompilation();
+    if (comp.isCancelled()) {
+        addDiag(diag::ConstEvalCancelled, loc) << comp.getCancellationToken().getReasonString();
+        return false;
+    }
+
+    if (++steps < comp.getOptions().maxConstexprSteps)
         return true;
 
     addDiag(diag::ConstEvalExceededMaxSteps, loc);
@@ -115,6 +212,13 @@ std::string EvalContext::dumpStack() const {
     int index = 0;
     for (const Frame& frame : stack) {
         buffer.format("{}: {}\n", index++, frame.subroutine ? frame.subroutine->name : "<global>");
+        if (!frame.slots.empty()) {
+            auto symbols = frame.subroutine->getLocalSlots();
+            for (size_t i = 0; i < frame.slots.size(); i++) {
+                if (auto& value = frame.slots[i])
+                    buffer.format("    {} = {}\n", symbols[i]->name, value->toString());
+            }
+        }
         for (auto& [symbol, value] : frame.temporaries)
             buffer.format("    {} = {}\n", symbol->name, value.toString());
     }
@@ -171,10 +275,15 @@ static void reportFrame(Diagnostic& diag, const EvalContext::Frame& frame) {
     buffer.format("{}(", frame.subroutine->name);
 
     for (auto arg : frame.subroutine->getArguments()) {
-        auto it = frame.temporaries.find(arg);
-        SLANG_ASSERT(it != frame.temporaries.end());
-
-        buffer.append(it->second.toString());
+        if (auto slot = findSlot(frame, *arg)) {
+            SLANG_ASSERT(*slot);
+            buffer.append((*slot)->toString());
+        }
+        else {
+            auto it = frame.temporaries.find(arg);
+            SLANG_ASSERT(it != frame.temporaries.end());
+            buffer.append(it->second.toString());
+        }
         if (arg != frame.subroutine->getArguments().last(1)[0])
             buffer.append(", ");
     }
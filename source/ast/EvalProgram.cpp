@@ -0,0 +1,878 @@
+//------------------------------------------------------------------------------
+// EvalProgram.cpp
+// Bytecode compilation of constant functions
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#include "slang/ast/EvalProgram.h"
+
+#include "slang/ast/ASTVisitor.h"
+#include "slang/ast/EvalContext.h"
+#include "slang/ast/expressions/AssignmentExpressions.h"
+#include "slang/ast/expressions/LiteralExpressions.h"
+#include "slang/ast/expressions/MiscExpressions.h"
+#include "slang/ast/expressions/OperatorExpressions.h"
+#include "slang/ast/symbols/SubroutineSymbols.h"
+#include "slang/ast/symbols/VariableSymbols.h"
+#include "slang/ast/types/Type.h"
+#include "slang/diagnostics/NumericDiags.h"
+#include "slang/util/Hash.h"
+#include "slang/util/SmallVector.h"
+
+namespace {
+
+using namespace slang;
+using namespace slang::ast;
+
+// Instruction operands refer to either a register, the storage for a local
+// variable, or an entry in the constant pool. The kind lives in the top bits.
+constexpr uint32_t OperandKindShift = 30;
+constexpr uint32_t OperandIndexMask = (1u << OperandKindShift) - 1;
+constexpr uint32_t RegisterOperand = 0;
+constexpr uint32_t LocalOperand = 1;
+constexpr uint32_t ConstantOperand = 2;
+
+constexpr uint32_t NoOperand = UINT32_MAX;
+constexpr uint32_t NoTarget = UINT32_MAX;
+
+constexpr uint32_t makeOperand(uint32_t kind, size_t index) {
+    return (kind << OperandKindShift) | uint32_t(index);
+}
+
+constexpr uint32_t operandKind(uint32_t operand) {
+    return operand >> OperandKindShift;
+}
+
+bool isIncDecOp(UnaryOperator op) {
+    switch (op) {
+        case UnaryOperator::Preincrement:
+        case UnaryOperator::Predecrement:
+        case UnaryOperator::Postincrement:
+        case UnaryOperator::Postdecrement:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Determines whether evaluating the given expression could modify a local
+// variable, in which case operands evaluated before it must be copied out.
+bool mayModifyLocals(const Expression& expr) {
+    bool result = false;
+    expr.visit(makeVisitor(
+        [&](auto& visitor, const UnaryExpression& unary) {
+            if (isIncDecOp(unary.op))
+                result = true;
+            else
+                visitor.visitDefault(unary);
+        },
+        [&](auto&, const AssignmentExpression&) { result = true; },
+        [&](auto&, const CallExpression&) { result = true; }));
+    return result;
+}
+
+bool hasLValueReference(const Expression& expr) {
+    bool result = false;
+    expr.visit(makeVisitor([&](auto&, const LValueReferenceExpression&) { result = true; }));
+    return result;
+}
+
+} // namespace
+
+namespace slang::ast {
+
+using ER = Statement::EvalResult;
+
+class EvalProgram::Compiler {
+public:
+    uint32_t returnSlot = 0;
+
+    explicit Compiler(EvalProgram& program) : program(program) {}
+
+    void addLocal(const ValueSymbol& symbol) {
+        slots[&symbol] = uint32_t(program.localSymbols.size());
+        program.localSymbols.push_back(&symbol);
+    }
+
+    void statement(const Statement& stmt) {
+        if (stmt.bad()) {
+            fallback(stmt);
+            return;
+        }
+
+        // Registers only hold temporaries for the duration of a single statement.
+        auto savedRegisters = nextRegister;
+        switch (stmt.kind) {
+            case StatementKind::Empty:
+                step(stmt);
+                break;
+            case StatementKind::List:
+                step(stmt);
+                for (auto item : stmt.as<StatementList>().list)
+                    statement(*item);
+                break;
+            case StatementKind::Block: {
+                auto& block = stmt.as<BlockStatement>();
+                if (block.blockKind != StatementBlockKind::Sequential) {
+                    fallback(stmt);
+                    break;
+                }
+                step(stmt);
+                statement(block.body);
+                break;
+            }
+            case StatementKind::VariableDeclaration:
+                variableDecl(stmt.as<VariableDeclStatement>());
+                break;
+            case StatementKind::ExpressionStatement: {
+                // Calls are left to the AST so that system task
+                // invocations get skipped with the appropriate warning.
+                auto& expr = stmt.as<ExpressionStatement>().expr;
+                if (expr.kind == ExpressionKind::Call) {
+                    fallback(stmt);
+                    break;
+                }
+                step(stmt);
+                expression(expr, true);
+                break;
+            }
+            case StatementKind::Return: {
+                step(stmt);
+                if (auto expr = stmt.as<ReturnStatement>().expr) {
+                    auto value = expression(*expr);
+                    emit(OpCode::Store, makeOperand(LocalOperand, returnSlot), value);
+                }
+                exit(ER::Return);
+                break;
+            }
+            case StatementKind::Break:
+            case StatementKind::Continue:
+                step(stmt);
+                jumpOut(stmt.kind == StatementKind::Break);
+                break;
+            case StatementKind::Conditional:
+                conditional(stmt.as<ConditionalStatement>());
+                break;
+            case StatementKind::ForLoop:
+                forLoop(stmt.as<ForLoopStatement>());
+                break;
+            case StatementKind::RepeatLoop:
+                repeatLoop(stmt.as<RepeatLoopStatement>());
+                break;
+            case StatementKind::WhileLoop:
+                whileLoop(stmt.as<WhileLoopStatement>());
+                break;
+            case StatementKind::DoWhileLoop:
+                doWhileLoop(stmt.as<DoWhileLoopStatement>());
+                break;
+            case StatementKind::ForeverLoop:
+                foreverLoop(stmt.as<ForeverLoopStatement>());
+                break;
+            default:
+                fallback(stmt);
+                break;
+        }
+        nextRegister = savedRegisters;
+    }
+
+    void exit(ER result) {
+        auto& instr = emit(OpCode::Exit);
+        instr.subop = uint8_t(result);
+    }
+
+private:
+    // Jumps that leave a loop (either directly or from a statement that
+    // falls back to the AST) and need their targets patched once the
+    // loop has been fully emitted.
+    struct Loop {
+        SmallVector<std::pair<size_t, uint32_t Instruction::*>> breaks;
+        SmallVector<std::pair<size_t, uint32_t Instruction::*>> continues;
+    };
+
+    EvalProgram& program;
+    flat_hash_map<const ValueSymbol*, uint32_t> slots;
+    SmallVector<Loop*> loops;
+    uint32_t nextRegister = 0;
+    uint32_t lvalueTarget = NoOperand;
+    bool lvalueInFallback = false;
+
+    Instruction& emit(OpCode op, uint32_t dst = 0, uint32_t a = 0, uint32_t b = 0) {
+        auto& instr = program.code.emplace_back();
+        instr.op = op;
+        instr.dst = dst;
+        instr.a = a;
+        instr.b = b;
+        return instr;
+    }
+
+    size_t emitJump(OpCode op, uint32_t cond = 0) {
+        emit(op, 0, cond, NoTarget);
+        return program.code.size() - 1;
+    }
+
+    uint32_t here() const { return uint32_t(program.code.size()); }
+
+    void patch(size_t jump) { program.code[jump].b = here(); }
+
+    uint32_t allocRegister() {
+        uint32_t reg = nextRegister++;
+        program.numRegisters = std::max(program.numRegisters, nextRegister);
+        return makeOperand(RegisterOperand, reg);
+    }
+
+    uint32_t constant(ConstantValue value) {
+        program.constants.emplace_back(std::move(value));
+        return makeOperand(ConstantOperand, program.constants.size() - 1);
+    }
+
+    void step(const Statement& stmt) { emit(OpCode::Step).stmt = &stmt; }
+
+    void fallback(const Statement& stmt) {
+        auto& instr = emit(OpCode::Exec, 0, NoTarget, NoTarget);
+        instr.stmt = &stmt;
+        program.numFallbacks++;
+
+        if (!loops.empty()) {
+            auto index = program.code.size() - 1;
+            loops.back()->breaks.emplace_back(index, &Instruction::a);
+            loops.back()->continues.emplace_back(index, &Instruction::b);
+        }
+    }
+
+    void jumpOut(bool isBreak) {
+        if (loops.empty()) {
+            exit(isBreak ? ER::Break : ER::Continue);
+            return;
+        }
+
+        auto index = emitJump(OpCode::Jump);
+        auto& list = isBreak ? loops.back()->breaks : loops.back()->continues;
+        list.emplace_back(index, &Instruction::b);
+    }
+
+    void loopBody(const Statement& body, Loop& loop) {
+        loops.push_back(&loop);
+        statement(body);
+        loops.pop_back();
+    }
+
+    void finishLoop(Loop& loop, uint32_t continueTarget) {
+        auto breakTarget = here();
+        for (auto [index, field] : loop.breaks)
+            program.code[index].*field = breakTarget;
+        for (auto [index, field] : loop.continues)
+            program.code[index].*field = continueTarget;
+    }
+
+    void variableDecl(const VariableDeclStatement& stmt) {
+        auto& symbol = stmt.symbol;
+        auto initializer = symbol.getInitializer();
+        if (initializer && symbol.lifetime == VariableLifetime::Static) {
+            // Let the AST issue the warning about skipped initialization.
+            fallback(stmt);
+            addLocal(symbol);
+            emit(OpCode::BindLocal, makeOperand(LocalOperand, slots[&symbol])).symbol = &symbol;
+            return;
+        }
+
+        step(stmt);
+        uint32_t value = initializer ? expression(*initializer) : NoOperand;
+
+        // The slot is only created after compiling the initializer, since
+        // the variable doesn't have storage while that's being evaluated.
+        addLocal(symbol);
+        emit(OpCode::DeclLocal, makeOperand(LocalOperand, slots[&symbol]), value).symbol = &symbol;
+    }
+
+    void conditional(const ConditionalStatement& stmt) {
+        // Only plain if / else-if chains are compiled. The AST evaluates every
+        // condition in the chain before choosing a branch so we do the same.
+        SmallVector<const ConditionalStatement*> chain;
+        const Statement* elseBody = nullptr;
+        for (auto curr = &stmt;;) {
+            if (curr->bad() || curr->conditions.size() != 1 || curr->conditions[0].pattern ||
+                curr->ifTrue.kind == StatementKind::Conditional) {
+                fallback(stmt);
+                return;
+            }
+
+            chain.push_back(curr);
+            if (curr->ifFalse && curr->ifFalse->kind == StatementKind::Conditional) {
+                curr = &curr->ifFalse->as<ConditionalStatement>();
+                continue;
+            }
+
+            elseBody = curr->ifFalse;
+            break;
+        }
+
+        if (stmt.check != UniquePriorityCheck::None) {
+            fallback(stmt);
+            return;
+        }
+
+        step(stmt);
+
+        SmallVector<uint32_t> conds;
+        for (size_t i = 0; i < chain.size(); i++) {
+            auto cond = expression(*chain[i]->conditions[0].expr);
+            if (operandKind(cond) == LocalOperand) {
+                for (size_t j = i + 1; j < chain.size(); j++) {
+                    if (mayModifyLocals(*chain[j]->conditions[0].expr)) {
+                        cond = copyToRegister(cond);
+                        break;
+                    }
+                }
+            }
+            conds.push_back(cond);
+        }
+
+        SmallVector<size_t> bodyJumps;
+        for (auto cond : conds)
+            bodyJumps.push_back(emitJump(OpCode::JumpIfTrue, cond));
+
+        SmallVector<size_t> endJumps;
+        if (elseBody)
+            statement(*elseBody);
+        endJumps.push_back(emitJump(OpCode::Jump));
+
+        for (size_t i = 0; i < chain.size(); i++) {
+            patch(bodyJumps[i]);
+            statement(chain[i]->ifTrue);
+            endJumps.push_back(emitJump(OpCode::Jump));
+        }
+
+        for (auto jump : endJumps)
+            patch(jump);
+    }
+
+    void forLoop(const ForLoopStatement& stmt) {
+        step(stmt);
+        for (auto init : stmt.initializers)
+            expression(*init, true);
+
+        auto top = here();
+        std::optional<size_t> exitJump;
+        if (stmt.stopExpr)
+            exitJump = emitJump(OpCode::JumpIfFalse, expression(*stmt.stopExpr));
+
+        Loop loop;
+        loopBody(stmt.body, loop);
+
+        auto continueTarget = here();
+        for (auto stepExpr : stmt.steps)
+            expression(*stepExpr, true);
+        emit(OpCode::Jump, 0, 0, top);
+
+        if (exitJump)
+            patch(*exitJump);
+        finishLoop(loop, continueTarget);
+    }
+
+    void repeatLoop(const RepeatLoopStatement& stmt) {
+        if (!stmt.count.type->isIntegral()) {
+            fallback(stmt);
+            return;
+        }
+
+        step(stmt);
+        auto counter = program.numCounters++;
+        auto& init = emit(OpCode::RepeatInit, 0, expression(stmt.count));
+        init.c = counter;
+        init.stmt = &stmt;
+
+        auto top = here();
+        auto exitJump = emitJump(OpCode::RepeatNext);
+        program.code[exitJump].c = counter;
+
+        Loop loop;
+        loopBody(stmt.body, loop);
+        emit(OpCode::Jump, 0, 0, top);
+
+        patch(exitJump);
+        finishLoop(loop, top);
+    }
+
+    void whileLoop(const WhileLoopStatement& stmt) {
+        step(stmt);
+        auto top = here();
+        auto exitJump = emitJump(OpCode::JumpIfFalse, expression(stmt.cond));
+
+        Loop loop;
+        loopBody(stmt.body, loop);
+        emit(OpCode::Jump, 0, 0, top);
+
+        patch(exitJump);
+        finishLoop(loop, top);
+    }
+
+    void doWhileLoop(const DoWhileLoopStatement& stmt) {
+        step(stmt);
+        auto top = here();
+
+        Loop loop;
+        loopBody(stmt.body, loop);
+
+        auto continueTarget = here();
+        emit(OpCode::JumpIfTrue, 0, expression(stmt.cond), top);
+        finishLoop(loop, continueTarget);
+    }
+
+    void foreverLoop(const ForeverLoopStatement& stmt) {
+        step(stmt);
+        auto top = here();
+
+        Loop loop;
+        loopBody(stmt.body, loop);
+        emit(OpCode::Jump, 0, 0, top);
+        finishLoop(loop, top);
+    }
+
+    uint32_t copyToRegister(uint32_t operand) {
+        auto dst = allocRegister();
+        emit(OpCode::Move, dst, operand);
+        return dst;
+    }
+
+    // If the given operand refers to a local that might be modified by
+    // evaluating @a later, copies it into a register first.
+    uint32_t protect(uint32_t operand, const Expression& later) {
+        if (operandKind(operand) == LocalOperand && mayModifyLocals(later))
+            return copyToRegister(operand);
+        return operand;
+    }
+
+    uint32_t local(const Expression& expr) {
+        if (expr.kind != ExpressionKind::NamedValue)
+            return NoOperand;
+
+        // Class and covergroup typed values are rejected when referenced,
+        // so those always go through the AST to get the diagnostic.
+        auto& nv = expr.as<NamedValueExpression>();
+        if (nv.type->isClass() || nv.type->isCovergroup())
+            return NoOperand;
+
+        auto it = slots.find(&nv.symbol);
+        if (it == slots.end())
+            return NoOperand;
+
+        return makeOperand(LocalOperand, it->second);
+    }
+
+    uint32_t fallback(const Expression& expr) {
+        if (lvalueTarget != NoOperand && hasLValueReference(expr))
+            lvalueInFallback = true;
+
+        auto dst = allocRegister();
+        emit(OpCode::Eval, dst).expr = &expr;
+        program.numFallbacks++;
+        return dst;
+    }
+
+    uint32_t expression(const Expression& expr, bool discard = false) {
+        if (expr.constant)
+            return constant(*expr.constant);
+
+        if (expr.bad())
+            return fallback(expr);
+
+        switch (expr.kind) {
+            case ExpressionKind::IntegerLiteral:
+                return constant(expr.as<IntegerLiteral>().getValue());
+            case ExpressionKind::RealLiteral:
+                return constant(real_t(expr.as<RealLiteral>().getValue()));
+            case ExpressionKind::UnbasedUnsizedIntegerLiteral:
+                return constant(expr.as<UnbasedUnsizedIntegerLiteral>().getValue());
+            case ExpressionKind::StringLiteral:
+                return constant(expr.as<StringLiteral>().getIntValue());
+            case ExpressionKind::NamedValue:
+                if (auto operand = local(expr); operand != NoOperand)
+                    return operand;
+                return fallback(expr);
+            case ExpressionKind::LValueReference:
+                if (lvalueTarget != NoOperand)
+                    return lvalueTarget;
+                return fallback(expr);
+            case ExpressionKind::UnaryOp:
+                return unary(expr.as<UnaryExpression>(), discard);
+            case ExpressionKind::BinaryOp:
+                return binary(expr.as<BinaryExpression>());
+            case ExpressionKind::ConditionalOp:
+                return conditional(expr.as<ConditionalExpression>());
+            case ExpressionKind::Conversion: {
+                auto& conv = expr.as<ConversionExpression>();
+                auto operand = expression(conv.operand());
+                auto dst = allocRegister();
+                emit(OpCode::Convert, dst, operand).expr = &conv;
+                return dst;
+            }
+            case ExpressionKind::Assignment:
+                return assignment(expr.as<AssignmentExpression>(), discard);
+            default:
+                return fallback(expr);
+        }
+    }
+
+    uint32_t unary(const UnaryExpression& expr, bool discard) {
+        if (isIncDecOp(expr.op)) {
+            auto target = local(expr.operand());
+            if (target == NoOperand || !expr.operand().type->isNumeric())
+                return fallback(expr);
+
+            auto dst = discard ? NoOperand : allocRegister();
+            auto& instr = emit(OpCode::IncDec, dst, target);
+            instr.subop = uint8_t(expr.op);
+            return dst;
+        }
+
+        auto operand = expression(expr.operand());
+        auto dst = allocRegister();
+        auto& instr = emit(OpCode::Unary, dst, operand);
+        instr.subop = uint8_t(expr.op);
+        return dst;
+    }
+
+    uint32_t binary(const BinaryExpression& expr) {
+        if (expr.left().kind == ExpressionKind::TypeReference &&
+            expr.right().kind == ExpressionKind::TypeReference) {
+            return fallback(expr);
+        }
+
+        auto lhs = protect(expression(expr.left()), expr.right());
+        auto dst = allocRegister();
+
+        std::optional<size_t> shortCircuit;
+        switch (expr.op) {
+            case BinaryOperator::LogicalAnd:
+            case BinaryOperator::LogicalOr:
+            case BinaryOperator::LogicalImplication:
+                shortCircuit = emitJump(OpCode::ShortCircuit, lhs);
+                program.code[*shortCircuit].dst = dst;
+                program.code[*shortCircuit].subop = uint8_t(expr.op);
+                break;
+            default:
+                break;
+        }
+
+        auto rhs = expression(expr.right());
+        auto& instr = emit(OpCode::Binary, dst, lhs, rhs);
+        instr.subop = uint8_t(expr.op);
+
+        if (shortCircuit)
+            patch(*shortCircuit);
+        return dst;
+    }
+
+    uint32_t conditional(const ConditionalExpression& expr) {
+        // Only simple integral conditionals are compiled, so that the result
+        // for an unknown predicate can always be computed by combining bits.
+        if (expr.conditions.size() != 1 || expr.conditions[0].pattern ||
+            !expr.type->isIntegral()) {
+            return fallback(expr);
+        }
+
+        auto cond = expression(*expr.conditions[0].expr);
+        if (operandKind(cond) == LocalOperand &&
+            (mayModifyLocals(expr.left()) || mayModifyLocals(expr.right()))) {
+            cond = copyToRegister(cond);
+        }
+
+        auto dst = allocRegister();
+        auto unknownJump = emitJump(OpCode::JumpIfUnknown, cond);
+        auto falseJump = emitJump(OpCode::JumpIfFalse, cond);
+
+        emit(OpCode::Move, dst, expression(expr.left()));
+        auto endJump1 = emitJump(OpCode::Jump);
+
+        patch(falseJump);
+        emit(OpCode::Move, dst, expression(expr.right()));
+        auto endJump2 = emitJump(OpCode::Jump);
+
+        patch(unknownJump);
+        auto lhs = protect(expression(expr.left()), expr.right());
+        auto rhs = expression(expr.right());
+        auto& select = emit(OpCode::Select, dst, lhs, rhs);
+        select.c = cond;
+        select.expr = &expr;
+
+        patch(endJump1);
+        patch(endJump2);
+        return dst;
+    }
+
+    uint32_t assignment(const AssignmentExpression& expr, bool discard) {
+        auto target = local(expr.left());
+        if (target == NoOperand || expr.timingControl || expr.left().type->isQueue())
+            return fallback(expr);
+
+        auto codeMark = program.code.size();
+        auto fallbackMark = program.numFallbacks;
+        auto registerMark = nextRegister;
+
+        // Compound assignments refer back to their target via LValueReference
+        // expressions. If any of those end up being evaluated by the AST there
+        // won't be an lvalue pushed for them, so give up on the whole assignment.
+        auto savedTarget = std::exchange(lvalueTarget, expr.isCompound() ? target : NoOperand);
+        auto savedInFallback = std::exchange(lvalueInFallback, false);
+
+        auto value = expression(expr.right());
+        bool needsLValue = lvalueInFallback;
+
+        lvalueTarget = savedTarget;
+        lvalueInFallback = savedInFallback;
+
+        if (needsLValue) {
+            program.code.resize(codeMark);
+            program.numFallbacks = fallbackMark;
+            nextRegister = registerMark;
+            return fallback(expr);
+        }
+
+        emit(OpCode::Store, target, value);
+        return discard ? NoOperand : target;
+    }
+};
+
+std::unique_ptr<EvalProgram> EvalProgram::compile(const SubroutineSymbol& subroutine) {
+    if (!subroutine.returnValVar)
+        return nullptr;
+
+    // Disable statements unwind through enclosing blocks until
+    // they find their target, which the bytecode doesn't model.
+    auto& body = subroutine.getBody();
+    bool hasDisable = false;
+    body.visit(makeVisitor([&](auto&, const DisableStatement&) { hasDisable = true; }));
+    if (hasDisable)
+        return nullptr;
+
+    auto program = std::make_unique<EvalProgram>();
+    Compiler compiler(*program);
+    for (auto arg : subroutine.getArguments())
+        compiler.addLocal(*arg);
+
+    compiler.returnSlot = uint32_t(program->localSymbols.size());
+    compiler.addLocal(*subroutine.returnValVar);
+    program->numEntryLocals = uint32_t(program->localSymbols.size());
+
+    compiler.statement(body);
+    compiler.exit(ER::Success);
+    return program;
+}
+
+ER EvalProgram::run(EvalContext& context) const {
+    SmallVector<ConstantValue, 8> registers;
+    registers.resize(numRegisters);
+
+    SmallVector<ConstantValue*, 8> locals;
+    locals.resize(localSymbols.size(), nullptr);
+    for (uint32_t i = 0; i < numEntryLocals; i++) {
+        locals[i] = context.findLocal(localSymbols[i]);
+        SLANG_ASSERT(locals[i]);
+    }
+
+    SmallVector<int64_t, 2> counters;
+    counters.resize(numCounters);
+
+    auto get = [&](uint32_t operand) -> const ConstantValue& {
+        auto index = operand & OperandIndexMask;
+        switch (operandKind(operand)) {
+            case RegisterOperand:
+                return registers[index];
+            case LocalOperand:
+                return *locals[index];
+            default:
+                return constants[index];
+        }
+    };
+
+    // Registers hold single-use temporaries so their values can be
+    // moved out; locals and constants must be copied.
+    auto take = [&](uint32_t operand) -> ConstantValue {
+        if (operand == NoOperand)
+            return nullptr;
+        if (operandKind(operand) == RegisterOperand)
+            return std::move(registers[operand & OperandIndexMask]);
+        return get(operand);
+    };
+
+    auto localRef = [&](uint32_t operand) -> ConstantValue& {
+        SLANG_ASSERT(operandKind(operand) == LocalOperand);
+        return *locals[operand & OperandIndexMask];
+    };
+
+    size_t pc = 0;
+    while (true) {
+        auto& instr = code[pc++];
+        switch (instr.op) {
+            case OpCode::Step:
+                if (!context.step(instr.stmt->sourceRange.start()))
+                    return ER::Fail;
+                break;
+            case OpCode::Eval: {
+                auto& dst = registers[instr.dst];
+                dst = instr.expr->eval(context);
+                if (!dst)
+                    return ER::Fail;
+                break;
+            }
+            case OpCode::Exec: {
+                ER result = instr.stmt->eval(context);
+                if (result == ER::Break && instr.a != NoTarget)
+                    pc = instr.a;
+                else if (result == ER::Continue && instr.b != NoTarget)
+                    pc = instr.b;
+                else if (result != ER::Success)
+                    return result;
+                break;
+            }
+            case OpCode::Move:
+                registers[instr.dst & OperandIndexMask] = take(instr.a);
+                break;
+            case OpCode::Store:
+                localRef(instr.dst) = take(instr.a);
+                break;
+            case OpCode::Unary: {
+                auto& dst = registers[instr.dst];
+                dst = Expression::evalUnaryOperator(UnaryOperator(instr.subop), get(instr.a));
+                break;
+            }
+            case OpCode::Binary: {
+                auto& dst = registers[instr.dst];
+                dst = Expression::evalBinaryOperator(BinaryOperator(instr.subop), get(instr.a),
+                                                     get(instr.b));
+                if (!dst)
+                    return ER::Fail;
+                break;
+            }
+            case OpCode::Convert: {
+                auto result = instr.expr->as<ConversionExpression>().applyTo(context,
+                                                                             take(instr.a));
+                if (!result)
+                    return ER::Fail;
+                registers[instr.dst] = std::move(result);
+                break;
+            }
+            case OpCode::IncDec: {
+                auto& target = localRef(instr.a);
+                ConstantValue prev;
+                bool isPost = instr.subop == uint8_t(UnaryOperator::Postincrement) ||
+                              instr.subop == uint8_t(UnaryOperator::Postdecrement);
+                bool isInc = instr.subop == uint8_t(UnaryOperator::Preincrement) ||
+                             instr.subop == uint8_t(UnaryOperator::Postincrement);
+                if (isPost && instr.dst != NoOperand)
+                    prev = target;
+
+                if (target.isInteger()) {
+                    if (isInc)
+                        ++target.integer();
+                    else
+                        --target.integer();
+                }
+                else if (target.isReal()) {
+                    target = real_t(target.real() + (isInc ? 1 : -1));
+                }
+                else if (target.isShortReal()) {
+                    target = shortreal_t(target.shortReal() + (isInc ? 1 : -1));
+                }
+                else {
+                    SLANG_UNREACHABLE;
+                }
+
+                if (instr.dst != NoOperand)
+                    registers[instr.dst] = isPost ? std::move(prev) : target;
+                break;
+            }
+            case OpCode::Select: {
+                auto& cond = get(instr.c);
+                auto& lhs = get(instr.a);
+                auto& rhs = get(instr.b);
+                auto& dst = registers[instr.dst];
+                if (lhs.isInteger() && rhs.isInteger())
+                    dst = SVInt::conditional(cond.integer(), lhs.integer(), rhs.integer());
+                else
+                    dst = instr.expr->type->getDefaultValue();
+                break;
+            }
+            case OpCode::ShortCircuit: {
+                auto& lhs = get(instr.a);
+                bool taken;
+                bool value;
+                switch (BinaryOperator(instr.subop)) {
+                    case BinaryOperator::LogicalOr:
+                        taken = lhs.isTrue();
+                        value = true;
+                        break;
+                    case BinaryOperator::LogicalAnd:
+                        taken = lhs.isFalse();
+                        value = false;
+                        break;
+                    case BinaryOperator::LogicalImplication:
+                        taken = lhs.isFalse();
+                        value = true;
+                        break;
+                    default:
+                        SLANG_UNREACHABLE;
+                }
+
+                if (taken) {
+                    registers[instr.dst] = SVInt(value);
+                    pc = instr.b;
+                }
+                break;
+            }
+            case OpCode::Jump:
+                pc = instr.b;
+                break;
+            case OpCode::JumpIfFalse:
+                if (!get(instr.a).isTrue())
+                    pc = instr.b;
+                break;
+            case OpCode::JumpIfTrue:
+                if (get(instr.a).isTrue())
+                    pc = instr.b;
+                break;
+            case OpCode::JumpIfUnknown: {
+                auto& cv = get(instr.a);
+                if (cv.isInteger() && cv.integer().hasUnknown())
+                    pc = instr.b;
+                break;
+            }
+            case OpCode::DeclLocal:
+                locals[instr.dst & OperandIndexMask] = context.createLocal(instr.symbol,
+                                                                           take(instr.a));
+                break;
+            case OpCode::BindLocal:
+                locals[instr.dst & OperandIndexMask] = context.findLocal(instr.symbol);
+                SLANG_ASSERT(locals[instr.dst & OperandIndexMask]);
+                break;
+            case OpCode::RepeatInit: {
+                auto& cv = get(instr.a);
+                std::optional<int64_t> oc = cv.integer().as<int64_t>();
+                if (!oc || oc < 0) {
+                    if (cv.integer().hasUnknown()) {
+                        oc = 0;
+                    }
+                    else {
+                        auto& count = instr.stmt->as<RepeatLoopStatement>().count;
+                        auto& diag = context.addDiag(diag::ValueOutOfRange, count.sourceRange);
+                        diag << cv << 0 << INT64_MAX;
+                        return ER::Fail;
+                    }
+                }
+                counters[instr.c] = *oc;
+                break;
+            }
+            case OpCode::RepeatNext:
+                if (counters[instr.c] <= 0)
+                    pc = instr.b;
+                else
+                    counters[instr.c]--;
+                break;
+            case OpCode::Exit:
+                return ER(instr.subop);
+        }
+    }
+}
+
+} // namespace slang::ast
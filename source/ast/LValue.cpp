@@ -83,7 +83,7 @@ ConstantValue LValue::load() const {
                     else {
                         // Be careful not to assign to the result while
                         // still referencing its elements.
-                        ConstantValue temp(std::move(result.at(size_t(arg.index))));
+                        ConstantValue temp = std::move(result).getElement(size_t(arg.index));
                         result = std::move(temp);
                     }
                 }
@@ -92,15 +92,17 @@ ConstantValue LValue::load() const {
                                              arg.defaultValue);
                 }
                 else if constexpr (std::is_same_v<T, ArrayLookup>) {
-                    auto& map = *result.map();
-                    if (auto it = map.find(arg.index); it != map.end()) {
+                    // The map is only read here so that loading an element
+                    // doesn't force a copy of a map that is shared.
+                    auto& map = *std::as_const(result).map();
+                    if (auto value = map.find(arg.index)) {
                         // If we find the index in the target map, return the value.
-                        ConstantValue temp(std::move(it->second));
+                        ConstantValue temp(*value);
                         result = std::move(temp);
                     }
                     else if (map.defaultValue) {
                         // Otherwise, if the map itself has a default set, use that.
-                        ConstantValue temp(std::move(map.defaultValue));
+                        ConstantValue temp(map.defaultValue);
                         result = std::move(temp);
                     }
                     else {
@@ -118,43 +120,14 @@ ConstantValue LValue::load() const {
     return result;
 }
 
-void LValue::store(const ConstantValue& newValue) {
-    if (bad())
-        return;
-
-    auto concat = std::get_if<Concat>(&value);
-    if (concat) {
-        if (concat->kind == Concat::Packed) {
-            // Divide up the value among all of the concatenated lvalues.
-            auto& sv = newValue.integer();
-            int32_t msb = (int32_t)sv.getBitWidth() - 1;
-            for (auto& elem : concat->elems) {
-                int32_t width = (int32_t)elem.load().integer().getBitWidth();
-                elem.store(sv.slice(msb, msb - width + 1));
-                msb -= width;
-            }
-        }
-        else {
-            auto newElems = newValue.elements();
-            auto& lvalElems = concat->elems;
-            SLANG_ASSERT(newElems.size() == lvalElems.size());
-            for (size_t i = 0; i < lvalElems.size(); i++)
-                lvalElems[i].store(newElems[i]);
-        }
-        return;
-    }
-
-    std::optional<ConstantRange> range;
-    ConstantValue* target = resolveInternal(range);
-    if (!target || target->bad())
-        return;
-
+static void assign(ConstantValue& target, const std::optional<ConstantRange>& range,
+                   const ConstantValue& newValue) {
     // We have the final target, now assign to it.
     // If there is no range specified, we should be able to assign straight to the target.
     if (!range) {
         // If this is a queue with a max bound make sure to limit the assigned value.
-        if (target->isQueue()) {
-            auto& dest = *target->queue();
+        if (target.isQueue()) {
+            auto& dest = *target.queue();
             if (dest.maxBound) {
                 auto& src = *newValue.queue();
                 size_t size = std::min<size_t>(dest.maxBound + 1, src.size());
@@ -165,28 +138,32 @@ void LValue::store(const ConstantValue& newValue) {
             }
         }
 
-        *target = newValue;
+        target = newValue;
         return;
     }
 
     // Otherwise, assign to the slice.
-    if (target->isInteger()) {
-        target->integer().set(range->upper(), range->lower(), newValue.integer());
+    if (target.isInteger()) {
+        target.integer().set(range->upper(), range->lower(), newValue.integer());
     }
-    else if (target->isString()) {
+    else if (target.isDense()) {
+        // The range is in terms of bits of the packed storage.
+        target.dense()->setBits(size_t(range->lower()), newValue.integer());
+    }
+    else if (target.isString()) {
         SLANG_ASSERT(range->left == range->right);
         SLANG_ASSERT(range->left >= 0);
 
         char c = (char)*newValue.integer().as<uint8_t>();
         if (c)
-            target->str()[size_t(range->left)] = c;
+            target.str()[size_t(range->left)] = c;
     }
-    else if (target->isQueue()) {
+    else if (target.isQueue()) {
         int32_t l = range->lower();
         int32_t u = range->upper();
 
         auto& src = *newValue.queue();
-        auto& dest = *target->queue();
+        auto& dest = *target.queue();
 
         u = std::min(u, int32_t(dest.size()));
         for (int32_t i = std::max(l, 0); i <= u; i++)
@@ -196,16 +173,56 @@ void LValue::store(const ConstantValue& newValue) {
         int32_t l = range->lower();
         int32_t u = range->upper();
 
-        auto src = newValue.elements();
-        auto dest = target->elements();
+        auto dest = target.elements();
 
         u = std::min(u, int32_t(dest.size()));
         for (int32_t i = std::max(l, 0); i <= u; i++)
-            dest[size_t(i)] = src[size_t(i - l)];
+            dest[size_t(i)] = newValue.getElement(size_t(i - l));
     }
 }
 
-ConstantValue* LValue::resolveInternal(std::optional<ConstantRange>& range) {
+void LValue::store(const ConstantValue& newValue) {
+    if (bad())
+        return;
+
+    auto concat = std::get_if<Concat>(&value);
+    if (concat) {
+        if (concat->kind == Concat::Packed) {
+            // Divide up the value among all of the concatenated lvalues.
+            auto& sv = newValue.integer();
+            int32_t msb = (int32_t)sv.getBitWidth() - 1;
+            for (auto& elem : concat->elems) {
+                int32_t width = (int32_t)elem.load().integer().getBitWidth();
+                elem.store(sv.slice(msb, msb - width + 1));
+                msb -= width;
+            }
+        }
+        else {
+            auto& lvalElems = concat->elems;
+            SLANG_ASSERT(newValue.size() == lvalElems.size());
+            for (size_t i = 0; i < lvalElems.size(); i++)
+                lvalElems[i].store(newValue.getElement(i));
+        }
+        return;
+    }
+
+    std::optional<ConstantRange> range;
+    SmallVector<ConstantValue*> visited;
+    ConstantValue* target = resolveInternal(range, &visited);
+    if (!target || target->bad())
+        return;
+
+    assign(*target, range, newValue);
+
+    // The values along the path were detached from any copies so that they could
+    // be modified. Nothing refers into them anymore, so they can be shared again.
+    for (auto cv : visited)
+        cv->allowSharing();
+    target->allowSharing();
+}
+
+ConstantValue* LValue::resolveInternal(std::optional<ConstantRange>& range,
+                                       SmallVectorBase<ConstantValue*>* visited) {
     auto& path = std::get<Path>(value);
     ConstantValue* target = path.base;
 
@@ -213,6 +230,9 @@ ConstantValue* LValue::resolveInternal(std::optional<ConstantRange>& range) {
         if (!target || target->bad())
             break;
 
+        if (visited)
+            visited->push_back(target);
+
         std::visit(
             [&target, &range](auto&& arg) {
                 using T = std::decay_t<decltype(arg)>;
@@ -259,6 +279,19 @@ ConstantValue* LValue::resolveInternal(std::optional<ConstantRange>& range) {
                         else
                             range = ConstantRange{arg.index, arg.index};
                     }
+                    else if (target->isDense()) {
+                        // Dense arrays have no element values to point at, so like with
+                        // strings the target stays the array and the element's bits in
+                        // its packed storage become the range to assign.
+                        auto& dense = *std::as_const(*target).dense();
+                        if (arg.index < 0 || size_t(arg.index) >= dense.size()) {
+                            target = nullptr;
+                        }
+                        else {
+                            auto lsb = int32_t(dense.getElementOffset(size_t(arg.index)));
+                            range = ConstantRange{lsb + int32_t(dense.getElementWidth()) - 1, lsb};
+                        }
+                    }
                     else {
                         auto elems = target->elements();
                         if (arg.index < 0 || size_t(arg.index) >= elems.size())
@@ -268,14 +301,14 @@ ConstantValue* LValue::resolveInternal(std::optional<ConstantRange>& range) {
                     }
                 }
                 else if constexpr (std::is_same_v<T, ArraySlice>) {
+                    // Slices of dense arrays are assigned element by element.
+                    target->expandDense();
                     range = arg.range;
                 }
                 else if constexpr (std::is_same_v<T, ArrayLookup>) {
                     auto& map = *target->map();
-                    auto [it, inserted] = map.try_emplace(std::move(arg.index),
-                                                          std::move(arg.defaultValue));
-
-                    target = &it->second;
+                    target = map.try_emplace(std::move(arg.index), std::move(arg.defaultValue))
+                                 .first;
                 }
                 else {
                     static_assert(always_false<T>::value, "Missing case");
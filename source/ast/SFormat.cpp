@@ -263,7 +263,7 @@ static void formatString(std::string& result, const std::string& value,
 
 static void formatRaw2(std::string& result, const ConstantValue& value) {
     if (value.isUnpacked()) {
-        for (auto& elem : value.elements())
+        for (const auto& elem : value)
             formatRaw2(result, elem);
         return;
     }
@@ -286,7 +286,7 @@ static void formatRaw2(std::string& result, const ConstantValue& value) {
 
 static void formatRaw4(std::string& result, const ConstantValue& value) {
     if (value.isUnpacked()) {
-        for (auto& elem : value.elements())
+        for (const auto& elem : value)
             formatRaw4(result, elem);
         return;
     }
@@ -1199,7 +1199,7 @@ static bool checkMatch(CaseStatementCondition condition, const ConstantValue& cv
     if (condition == CaseStatementCondition::Inside) {
         // Unpacked arrays get unwrapped into their members for comparison.
         if (cvr.isContainer()) {
-            for (auto& elem : cvr) {
+            for (const auto& elem : cvr) {
                 if (checkMatch(condition, cvl, elem))
                     return true;
             }
@@ -2080,8 +2080,10 @@ ER ForeachLoopStatement::evalRecursive(EvalContext& context, const ConstantValue
         }
     }
     else {
+        // The elements of dense arrays are integers, so any further dimensions
+        // are packed and have fixed ranges that don't need the element values.
         std::span<const ConstantValue> elements;
-        if (cv.isUnpacked())
+        if (cv.isUnpacked() && !cv.isDense())
             elements = cv.elements();
 
         ConstantRange range;
@@ -10,6 +10,7 @@
 #include "slang/ast/Compilation.h"
 #include "slang/ast/EvalContext.h"
 #include "slang/ast/SystemSubroutine.h"
+#include "slang/ast/expressions/AssignmentExpressions.h"
 #include "slang/ast/expressions/MiscExpressions.h"
 #include "slang/ast/symbols/VariableSymbols.h"
 #include "slang/ast/types/AllTypes.h"
@@ -63,7 +64,7 @@ public:
 
     ConstantValue eval(EvalContext& context, const Args& args, SourceRange,
                        const CallExpression::SystemCallInfo& callInfo) const final {
-        ConstantValue arr = args[0]->eval(context);
+        const ConstantValue arr = args[0]->eval(context);
         if (!arr)
             return nullptr;
 
@@ -185,8 +186,8 @@ public:
                 sortTarget(*target->queue());
             }
             else {
-                auto& vec = std::get<ConstantValue::Elements>(target->getVariant());
-                sortTarget(vec);
+                auto elems = target->elements();
+                sortTarget(elems);
             }
         }
         else {
@@ -201,12 +202,12 @@ public:
                 sortTarget(*target->queue());
             }
             else {
-                auto& vec = std::get<ConstantValue::Elements>(target->getVariant());
-                sortTarget(vec);
+                auto elems = target->elements();
+                sortTarget(elems);
             }
         }
 
-        return nullptr;
+        return ConstantValue::NullPlaceholder{};
     }
 
 private:
@@ -242,9 +243,9 @@ public:
         if (target->isQueue())
             std::ranges::reverse(*target->queue());
         else
-            std::ranges::reverse(std::get<ConstantValue::Elements>(target->getVariant()));
+            std::ranges::reverse(target->elements());
 
-        return nullptr;
+        return ConstantValue::NullPlaceholder{};
     }
 };
 
@@ -316,7 +317,7 @@ public:
                 }
             };
 
-            auto& cont = *arr.map();
+            auto& cont = *std::as_const(arr).map();
             if (mode == Last)
                 doFind(std::rbegin(cont), std::rend(cont));
             else
@@ -352,10 +353,14 @@ public:
                     doFind(std::begin(cont), std::end(cont));
             };
 
-            if (arr.isQueue())
-                find(*arr.queue());
-            else
-                find(std::get<ConstantValue::Elements>(arr.getVariant()));
+            if (arr.isQueue()) {
+                find(*std::as_const(arr).queue());
+            }
+            else {
+                // Searching needs element values that the iterators can point at.
+                arr.expandDense();
+                find(*std::get<ConstantValue::Unpacked>(std::as_const(arr).getVariant()));
+            }
         }
 
         return results;
@@ -394,7 +399,7 @@ public:
 
     ConstantValue eval(EvalContext& context, const Args& args, SourceRange,
                        const CallExpression::SystemCallInfo& callInfo) const final {
-        ConstantValue arr = args[0]->eval(context);
+        const ConstantValue arr = args[0]->eval(context);
         if (!arr)
             return nullptr;
 
@@ -485,7 +490,7 @@ public:
 
     ConstantValue eval(EvalContext& context, const Args& args, SourceRange,
                        const CallExpression::SystemCallInfo& callInfo) const final {
-        ConstantValue arr = args[0]->eval(context);
+        const ConstantValue arr = args[0]->eval(context);
         if (!arr)
             return nullptr;
 
@@ -562,7 +567,7 @@ public:
             return nullptr;
 
         lval.store(args[0]->type->getDefaultValue());
-        return nullptr;
+        return ConstantValue::NullPlaceholder{};
     }
 };
 
@@ -624,7 +629,7 @@ public:
             // No argument means we should empty the array.
             lval.store(args[0]->type->getDefaultValue());
         }
-        return nullptr;
+        return ConstantValue::NullPlaceholder{};
     }
 };
 
@@ -670,34 +675,22 @@ public:
         if (!array || !index)
             return nullptr;
 
-        bool exists = array.map()->count(index);
+        bool exists = std::as_const(array).map()->contains(index);
         return SVInt(32, exists ? 1 : 0, true);
     }
 };
 
 class AssocArrayTraversalMethod : public SystemSubroutine {
 public:
-    explicit AssocArrayTraversalMethod(const std::string& name) :
-        SystemSubroutine(name, SubroutineKind::Function) {
-        hasOutputArgs = true;
-    }
+    enum Mode { First, Last, Next, Prev } mode;
 
-    const Expression& bindArgument(size_t argIndex, const ASTContext& context,
-                                   const ExpressionSyntax& syntax, const Args& args) const final {
-        // Argument type comes from the index type of the previous argument.
-        if (argIndex == 1) {
-            auto indexType = args[0]->type->getAssociativeIndexType();
-            if (indexType) {
-                return Expression::bindArgument(*indexType, ArgumentDirection::Ref, {}, syntax,
-                                                context);
-            }
-        }
-
-        return SystemSubroutine::bindArgument(argIndex, context, syntax, args);
+    AssocArrayTraversalMethod(const std::string& name, Mode mode) :
+        SystemSubroutine(name, SubroutineKind::Function), mode(mode) {
+        hasOutputArgs = true;
     }
 
-    // Return type is 'int' but the actual value is always either 0 or 1
-    std::optional<bitwidth_t> getEffectiveWidth() const final { return 1; }
+    // Return type is 'int' but the actual value is always -1, 0, or 1
+    std::optional<bitwidth_t> getEffectiveWidth() const final { return 2; }
 
     const Type& checkArguments(const ASTContext& context, const Args& args, SourceRange range,
                                const Expression*) const final {
@@ -712,13 +705,84 @@ public:
             return context.getCompilation().getErrorType();
         }
 
+        // The argument only needs to be assignment compatible with the index type;
+        // if it's smaller the index gets truncated [7.9.4].
+        auto& argType = *args[1]->type;
+        if (!argType.isAssignmentCompatible(*indexType) ||
+            !indexType->isAssignmentCompatible(argType)) {
+            return badArg(context, *args[1]);
+        }
+
+        if (!registerLValue(*args[1], context))
+            return comp.getErrorType();
+
         return comp.getIntType();
     }
 
-    ConstantValue eval(EvalContext& context, const Args&, SourceRange range,
+    ConstantValue eval(EvalContext& context, const Args& args, SourceRange,
                        const CallExpression::SystemCallInfo&) const final {
-        notConst(context, range);
-        return nullptr;
+        auto array = args[0]->eval(context);
+        if (!array)
+            return nullptr;
+
+        auto lval = args[1]->evalLValue(context);
+        if (!lval)
+            return nullptr;
+
+        auto& indexType = *args[0]->type->getAssociativeIndexType();
+        auto& argType = *args[1]->type;
+        auto loadKey = [&] {
+            return ConversionExpression::convert(context, argType, indexType,
+                                                 args[1]->sourceRange, lval.load(),
+                                                 ConversionKind::Implicit);
+        };
+
+        // Entries are visited in key order using the array's sorted view.
+        auto& map = *std::as_const(array).map();
+        auto it = map.end();
+        switch (mode) {
+            case First:
+                it = map.begin();
+                break;
+            case Last:
+                if (!map.empty())
+                    it = std::prev(map.end());
+                break;
+            case Next: {
+                auto key = loadKey();
+                if (!key)
+                    return nullptr;
+                it = map.upper_bound(key);
+                break;
+            }
+            case Prev: {
+                auto key = loadKey();
+                if (!key)
+                    return nullptr;
+                it = map.lower_bound(key);
+                it = it == map.begin() ? map.end() : std::prev(it);
+                break;
+            }
+        }
+
+        if (it == map.end())
+            return SVInt(32, 0, true);
+
+        auto value = ConversionExpression::convert(context, indexType, argType,
+                                                   args[1]->sourceRange, ConstantValue(it->first),
+                                                   ConversionKind::Implicit);
+        if (!value)
+            return nullptr;
+
+        lval.store(std::move(value));
+
+        // An argument smaller than the index gets as much of it as fits,
+        // and the method returns -1 to say that it was truncated.
+        if (argType.isIntegral() && indexType.isIntegral() &&
+            argType.getBitWidth() < indexType.getBitWidth()) {
+            return SVInt(32, uint64_t(-1), true);
+        }
+        return SVInt(32, 1, true);
     }
 };
 
@@ -815,7 +879,7 @@ public:
             q.push_back(std::move(cv));
 
         q.resizeToBound();
-        return nullptr;
+        return ConstantValue::NullPlaceholder{};
     }
 
 private:
@@ -876,7 +940,7 @@ public:
 
         q.insert(q.begin() + *index, std::move(cv));
         q.resizeToBound();
-        return nullptr;
+        return ConstantValue::NullPlaceholder{};
     }
 };
 
@@ -914,10 +978,13 @@ public:
         // If no arguments, clear the queue.
         if (args.size() == 1) {
             q.clear();
-            return nullptr;
+            return ConstantValue::NullPlaceholder{};
         }
 
         auto ci = args[1]->eval(context);
+        if (!ci)
+            return nullptr;
+
         std::optional<int32_t> index = ci.integer().as<int32_t>();
         if (!index || *index < 0 || size_t(*index) >= q.size()) {
             context.addDiag(diag::ConstEvalDynamicArrayIndex, args[1]->sourceRange)
@@ -926,7 +993,7 @@ public:
         }
 
         q.erase(q.begin() + *index);
-        return nullptr;
+        return ConstantValue::NullPlaceholder{};
     }
 };
 
@@ -1009,7 +1076,7 @@ public:
 
     ConstantValue eval(EvalContext& context, const Args& args, SourceRange,
                        const CallExpression::SystemCallInfo& callInfo) const final {
-        ConstantValue arr = args[0]->eval(context);
+        const ConstantValue arr = args[0]->eval(context);
         if (!arr)
             return nullptr;
 
@@ -1019,19 +1086,19 @@ public:
 
         if (arr.isMap()) {
             AssociativeArray results;
-            for (auto& [key, val] : *arr.map()) {
+            for (auto& [key, val] : *std::as_const(arr).map()) {
                 *iterVal = val;
                 ConstantValue cv = iterExpr->eval(context);
                 if (!cv)
                     return nullptr;
 
-                results.emplace(key, std::move(cv));
+                results.try_emplace(key, std::move(cv));
             }
             return results;
         }
         else {
             auto doMap = [&, ie = iterExpr](auto& container, auto& results) {
-                for (auto& elem : container) {
+                for (const auto& elem : container) {
                     *iterVal = elem;
                     ConstantValue cv = ie->eval(context);
                     if (!cv)
@@ -1044,13 +1111,13 @@ public:
 
             if (arr.isQueue()) {
                 SVQueue results;
-                if (!doMap(*arr.queue(), results))
+                if (!doMap(*std::as_const(arr).queue(), results))
                     return nullptr;
                 return results;
             }
             else {
                 ConstantValue::Elements results;
-                if (!doMap(std::get<ConstantValue::Elements>(arr.getVariant()), results))
+                if (!doMap(arr, results))
                     return nullptr;
                 return results;
             }
@@ -1110,10 +1177,14 @@ void Builtins::registerArrayMethods() {
 
     // Associative array methods.
     REGISTER(SymbolKind::AssociativeArrayType, AssocArrayExists, );
-    REGISTER(SymbolKind::AssociativeArrayType, AssocArrayTraversal, "first");
-    REGISTER(SymbolKind::AssociativeArrayType, AssocArrayTraversal, "last");
-    REGISTER(SymbolKind::AssociativeArrayType, AssocArrayTraversal, "next");
-    REGISTER(SymbolKind::AssociativeArrayType, AssocArrayTraversal, "prev");
+    REGISTER(SymbolKind::AssociativeArrayType, AssocArrayTraversal, "first",
+             AssocArrayTraversalMethod::First);
+    REGISTER(SymbolKind::AssociativeArrayType, AssocArrayTraversal, "last",
+             AssocArrayTraversalMethod::Last);
+    REGISTER(SymbolKind::AssociativeArrayType, AssocArrayTraversal, "next",
+             AssocArrayTraversalMethod::Next);
+    REGISTER(SymbolKind::AssociativeArrayType, AssocArrayTraversal, "prev",
+             AssocArrayTraversalMethod::Prev);
 
     // Queue methods
     REGISTER(SymbolKind::QueueType, QueuePop, "pop_front", true);
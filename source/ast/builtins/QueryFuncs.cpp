@@ -219,7 +219,7 @@ public:
 
 protected:
     struct DimResult {
-        AssociativeArray map;
+        ConstantValue::Map map;
         const Type* indexType = nullptr;
         ConstantRange range;
         bool hardFail = false;
@@ -229,7 +229,7 @@ protected:
         DimResult() : hardFail(true) {}
         DimResult(ConstantRange range) : range(range) {}
         DimResult(size_t dynamicSize) : range{0, int32_t(dynamicSize) - 1}, isDynamic(true) {}
-        DimResult(AssociativeArray&& map, const Type* indexType) :
+        DimResult(ConstantValue::Map map, const Type* indexType) :
             map(std::move(map)), indexType(indexType) {}
 
         static DimResult OutOfRange() {
@@ -305,10 +305,10 @@ protected:
         if (cv.isString())
             return cv.str().size();
 
-        // This silly collection of std::moves is to avoid copying the array out
-        // when the constant value owning it will not survive this function.
+        // Copying the map pointer shares the array instead of copying it out.
         if (cv.isMap())
-            return DimResult(std::move(*std::move(cv).map()), indexType);
+            return DimResult(std::get<ConstantValue::Map>(std::as_const(cv).getVariant()),
+                             indexType);
 
         return cv.size();
     }
@@ -386,9 +386,10 @@ ConstantValue LowFunction::eval(EvalContext& context, const Args& args, SourceRa
 
     // For associative arrays, $low returns the first key, or 'x if no elements.
     if (dim.indexType) {
-        if (dim.map.empty())
+        auto& map = *std::as_const(dim.map);
+        if (map.empty())
             return SVInt::createFillX(dim.indexType->getBitWidth(), dim.indexType->isSigned());
-        return dim.map.begin()->first;
+        return map.begin()->first;
     }
 
     return SVInt(32, uint64_t(dim.range.lower()), true);
@@ -408,9 +409,10 @@ ConstantValue HighFunction::eval(EvalContext& context, const Args& args, SourceR
 
     // For associative arrays, $high returns the last key, or 'x if no elements.
     if (dim.indexType) {
-        if (dim.map.empty())
+        auto& map = *std::as_const(dim.map);
+        if (map.empty())
             return SVInt::createFillX(dim.indexType->getBitWidth(), dim.indexType->isSigned());
-        return dim.map.rbegin()->first;
+        return map.rbegin()->first;
     }
 
     return SVInt(32, uint64_t(dim.range.upper()), true);
@@ -463,7 +465,8 @@ ConstantValue SizeFunction::eval(EvalContext& context, const Args& args, SourceR
         return SVInt(32, uint64_t(dim.range.right + 1), true);
 
     if (dim.indexType)
-        return SVInt(dim.indexType->getBitWidth(), dim.map.size(), dim.indexType->isSigned());
+        return SVInt(dim.indexType->getBitWidth(), std::as_const(dim.map)->size(),
+                     dim.indexType->isSigned());
 
     return SVInt(32, dim.range.width(), true);
 }
@@ -924,9 +924,13 @@ Expression& ConversionExpression::makeImplicit(const ASTContext& context, const
     return *result;
 }
 
+ConstantValue ConversionExpression::applyTo(EvalContext& context, ConstantValue&& value) const {
+    return convert(context, *operand().type, *type, sourceRange, std::move(value), conversionKind,
+                   &operand(), implicitOpRange);
+}
+
 ConstantValue ConversionExpression::evalImpl(EvalContext& context) const {
-    return convert(context, *operand().type, *type, sourceRange, operand().eval(context),
-                   conversionKind, &operand(), implicitOpRange);
+    return applyTo(context, operand().eval(context));
 }
 
 ConstantValue ConversionExpression::convert(EvalContext& context, const Type& from, const Type& to,
@@ -1022,14 +1026,14 @@ ConstantValue ConversionExpression::convert(EvalContext& context, const Type& fr
 
         if (!to.isQueue() && from.isQueue()) {
             // Convert from queue to vector.
-            auto& q = *value.queue();
+            auto& q = *std::as_const(value).queue();
             return std::vector(q.begin(), q.end());
         }
 
         if (to.isQueue() && !from.isQueue()) {
             // Convert from vector to queue.
-            auto elems = value.elements();
-            SVQueue result(elems.begin(), elems.end());
+            auto& cv = std::as_const(value);
+            SVQueue result(begin(cv), end(cv));
             result.maxBound = to.getCanonicalType().as<QueueType>().maxBound;
             result.resizeToBound();
             return result;
@@ -1128,9 +1132,8 @@ ConstantValue NewArrayExpression::evalImpl(EvalContext& context) const {
         if (!iv)
             return nullptr;
 
-        auto elems = iv.elements();
-        for (; index < count && index < elems.size(); index++)
-            result[index] = elems[index];
+        for (; index < count && index < iv.size(); index++)
+            result[index] = std::as_const(iv).getElement(index);
     }
 
     // Any remaining elements are default initialized.
@@ -1515,6 +1518,9 @@ ConstantValue AssignmentPatternExpressionBase::evalImpl(EvalContext& context) co
             }
         }
 
+        if (type->getCanonicalType().kind == SymbolKind::FixedSizeUnpackedArrayType)
+            return ConstantValue::createArray(std::move(values));
+
         return values;
     }
 }
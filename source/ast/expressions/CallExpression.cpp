@@ -9,8 +9,10 @@
 
 #include "slang/ast/ASTVisitor.h"
 #include "slang/ast/Compilation.h"
+#include "slang/ast/ConstFunctionMemo.h"
 #include "slang/ast/Constraints.h"
 #include "slang/ast/EvalContext.h"
+#include "slang/ast/EvalProgram.h"
 #include "slang/ast/SystemSubroutine.h"
 #include "slang/ast/expressions/MiscExpressions.h"
 #include "slang/ast/expressions/SelectExpressions.h"
@@ -353,6 +355,9 @@ Expression& CallExpression::fromArgs(Compilation& compilation, const Subroutine&
     if (bad)
         return badExpr(compilation, result);
 
+    if (compilation.hasFlag(CompilationFlags::LazySubroutineBodies))
+        compilation.noteSubroutineCall(symbol);
+
     if (context.flags.has(ASTFlags::Function | ASTFlags::Final) &&
         symbol.subroutineKind == SubroutineKind::Task) {
         const Scope* scope = context.scope;
@@ -740,6 +745,24 @@ ConstantValue CallExpression::evalImpl(EvalContext& context) const {
     if (!context.pushFrame(symbol, sourceRange.start(), lookupLocation))
         return nullptr;
 
+    // Pure functions always produce the same result for the same argument
+    // values, so reuse the result of a previous identical call if we have one.
+    // This is checked after pushing the frame so that the depth limit still applies.
+    auto& comp = context.getCompilation();
+    ConstFunctionMemo* memo = nullptr;
+    if (!context.flags.has(EvalFlags::IsScript | EvalFlags::CovergroupExpr)) {
+        memo = comp.getConstFunctionMemo();
+        if (memo && !memo->canMemoize(symbol, lookupLocation, args))
+            memo = nullptr;
+    }
+
+    if (memo) {
+        if (auto cached = memo->find(symbol, args)) {
+            context.popFrame();
+            return *cached;
+        }
+    }
+
     std::span<const FormalArgumentSymbol* const> formals = symbol.getArguments();
     for (size_t i = 0; i < formals.size(); i++)
         context.createLocal(formals[i], args[i]);
@@ -747,8 +770,18 @@ ConstantValue CallExpression::evalImpl(EvalContext& context) const {
     SLANG_ASSERT(symbol.returnValVar);
     context.createLocal(symbol.returnValVar);
 
+    const size_t diagCount = context.getDiagnosticCount();
+
     using ER = Statement::EvalResult;
-    ER er = symbol.getBody().eval(context);
+    ER er;
+    const EvalProgram* program = nullptr;
+    if (!comp.hasFlag(CompilationFlags::DisableConstBytecode))
+        program = comp.getEvalProgram(symbol);
+
+    if (program)
+        er = program->run(context);
+    else
+        er = symbol.getBody().eval(context);
 
     // If we got a disable result, it means a disable statement was evaluated that
     // targeted a block that wasn't executing. This isn't allowed in a constant expression.
@@ -756,13 +789,22 @@ ConstantValue CallExpression::evalImpl(EvalContext& context) const {
     if (er == ER::Disable)
         context.addDiag(diag::ConstEvalDisableTarget, context.getDisableRange());
 
+    // Once the frame is gone nothing can still be referring into the return
+    // value's storage, so it's safe to share it with copies again.
     ConstantValue result = std::move(*context.findLocal(symbol.returnValVar));
     context.popFrame();
+    result.allowSharing();
 
     if (er == ER::Fail || er == ER::Disable)
         return nullptr;
 
     SLANG_ASSERT(er == ER::Success || er == ER::Return);
+
+    // Results that came with diagnostics aren't recorded, since a later
+    // call that reused them would silently skip issuing those diagnostics.
+    if (memo && context.getDiagnosticCount() == diagCount)
+        memo->insert(symbol, args, result);
+
     return result;
 }
 
@@ -546,50 +546,7 @@ ConstantValue UnaryExpression::evalImpl(EvalContext& context) const {
     if (!cv)
         return nullptr;
 
-#define OP(k, v)           \
-    case UnaryOperator::k: \
-        return v;
-
-    if (cv.isInteger()) {
-        SVInt v = std::move(cv).integer();
-        switch (op) {
-            OP(Plus, v);
-            OP(Minus, -v);
-            OP(BitwiseNot, ~v);
-            OP(BitwiseAnd, SVInt(v.reductionAnd()));
-            OP(BitwiseOr, SVInt(v.reductionOr()));
-            OP(BitwiseXor, SVInt(v.reductionXor()));
-            OP(BitwiseNand, SVInt(!v.reductionAnd()));
-            OP(BitwiseNor, SVInt(!v.reductionOr()));
-            OP(BitwiseXnor, SVInt(!v.reductionXor()));
-            OP(LogicalNot, SVInt(!v));
-            default:
-                break;
-        }
-    }
-    else if (cv.isReal()) {
-        double v = cv.real();
-        switch (op) {
-            OP(Plus, real_t(v));
-            OP(Minus, real_t(-v));
-            OP(LogicalNot, SVInt(!(bool)v));
-            default:
-                break;
-        }
-    }
-    else if (cv.isShortReal()) {
-        float v = cv.shortReal();
-        switch (op) {
-            OP(Plus, shortreal_t(v));
-            OP(Minus, shortreal_t(-v));
-            OP(LogicalNot, SVInt(!(bool)v));
-            default:
-                break;
-        }
-    }
-
-#undef OP
-    SLANG_UNREACHABLE;
+    return evalUnaryOperator(op, cv);
 }
 
 void UnaryExpression::serializeTo(ASTSerializer& serializer) const {
@@ -1445,8 +1402,10 @@ ConstantValue ConditionalExpression::evalImpl(EvalContext& context) const {
 
         if (cvl.isUnpacked()) {
             // Sizes here might differ for dynamic arrays.
-            std::span<const ConstantValue> la = cvl.elements();
-            std::span<const ConstantValue> ra = cvr.elements();
+            cvl.expandDense();
+            cvr.expandDense();
+            std::span<const ConstantValue> la = std::as_const(cvl).elements();
+            std::span<const ConstantValue> ra = std::as_const(cvr).elements();
             if (la.size() == ra.size() && type->isArray()) {
                 std::vector<ConstantValue> result(la.size());
                 return combineArrays(result, la, ra);
@@ -1511,7 +1470,7 @@ static logic_t checkInsideMatch(const ConstantValue& cvl, const ConstantValue& c
     // Unpacked arrays get unwrapped into their members for comparison.
     if (cvr.isContainer()) {
         bool anyUnknown = false;
-        for (auto& elem : cvr) {
+        for (const auto& elem : cvr) {
             logic_t result = checkInsideMatch(cvl, elem);
             if (result)
                 return logic_t(true);
@@ -2496,6 +2455,53 @@ BinaryOperator Expression::getBinaryOperator(SyntaxKind kind) {
     }
 }
 
+ConstantValue Expression::evalUnaryOperator(UnaryOperator op, const ConstantValue& cv) {
+#define OP(k, v)           \
+    case UnaryOperator::k: \
+        return v;
+
+    if (cv.isInteger()) {
+        const SVInt& v = cv.integer();
+        switch (op) {
+            OP(Plus, v);
+            OP(Minus, -v);
+            OP(BitwiseNot, ~v);
+            OP(BitwiseAnd, SVInt(v.reductionAnd()));
+            OP(BitwiseOr, SVInt(v.reductionOr()));
+            OP(BitwiseXor, SVInt(v.reductionXor()));
+            OP(BitwiseNand, SVInt(!v.reductionAnd()));
+            OP(BitwiseNor, SVInt(!v.reductionOr()));
+            OP(BitwiseXnor, SVInt(!v.reductionXor()));
+            OP(LogicalNot, SVInt(!v));
+            default:
+                break;
+        }
+    }
+    else if (cv.isReal()) {
+        double v = cv.real();
+        switch (op) {
+            OP(Plus, real_t(v));
+            OP(Minus, real_t(-v));
+            OP(LogicalNot, SVInt(!(bool)v));
+            default:
+                break;
+        }
+    }
+    else if (cv.isShortReal()) {
+        float v = cv.shortReal();
+        switch (op) {
+            OP(Plus, shortreal_t(v));
+            OP(Minus, shortreal_t(-v));
+            OP(LogicalNot, SVInt(!(bool)v));
+            default:
+                break;
+        }
+    }
+
+#undef OP
+    SLANG_UNREACHABLE;
+}
+
 ConstantValue Expression::evalBinaryOperator(BinaryOperator op, const ConstantValue& cvl,
                                              const ConstantValue& cvr) {
     if (!cvl || !cvr)
@@ -242,16 +242,16 @@ ConstantValue ElementSelectExpression::evalImpl(EvalContext& context) const {
     if (valType.hasFixedRange()) {
         // For fixed types, we know we will always be in range, so just do the selection.
         if (valType.isUnpackedArray())
-            return cv.elements()[size_t(range->left)];
+            return std::move(cv).getElement(size_t(range->left));
         else
             return cv.integer().slice(range->left, range->right);
     }
 
     // Handling for associative arrays.
     if (valType.isAssociativeArray()) {
-        auto& map = *cv.map();
-        if (auto it = map.find(associativeIndex); it != map.end())
-            return it->second;
+        auto& map = *std::as_const(cv).map();
+        if (auto value = map.find(associativeIndex))
+            return *value;
 
         // If there is a user specified default, return that without warning.
         if (map.defaultValue)
@@ -268,7 +268,7 @@ ConstantValue ElementSelectExpression::evalImpl(EvalContext& context) const {
     if (valType.isString())
         return cv.getSlice(range->left, range->right, nullptr);
 
-    return std::move(cv).at(size_t(range->left));
+    return std::move(cv).getElement(size_t(range->left));
 }
 
 LValue ElementSelectExpression::evalLValueImpl(EvalContext& context) const {
@@ -1226,7 +1226,7 @@ ConstantValue MemberAccessExpression::evalImpl(EvalContext& context) const {
     auto& field = member.as<FieldSymbol>();
     auto& valueType = value().type->getCanonicalType();
     if (valueType.isUnpackedStruct()) {
-        return cv.elements()[field.fieldIndex];
+        return std::as_const(cv).elements()[field.fieldIndex];
     }
     else if (valueType.isUnpackedUnion()) {
         auto& unionVal = cv.unionVal();
@@ -548,6 +548,73 @@ void GenerateBlockSymbol::serializeTo(ASTSerializer& serializer) const {
     serializer.write("isUninstantiated", isUninstantiated);
 }
 
+const Symbol* GenerateBlockSymbol::findPrototypeMember(const Symbol& member) {
+    auto scope = member.getParentScope();
+    if (!scope || member.name.empty())
+        return nullptr;
+
+    auto& parentSym = scope->asSymbol();
+    if (parentSym.kind != SymbolKind::GenerateBlock)
+        return nullptr;
+
+    auto proto = parentSym.as<GenerateBlockSymbol>().prototype;
+    if (!proto)
+        return nullptr;
+
+    // The member must have been created from the exact same declaration,
+    // otherwise we can't assume anything about it.
+    auto result = proto->find(member.name);
+    if (!result || result->kind != member.kind || !member.getSyntax() ||
+        result->getSyntax() != member.getSyntax()) {
+        return nullptr;
+    }
+
+    return result;
+}
+
+// Determines whether the body of a loop generate resolves to the same types and
+// parameter values on every iteration. That is the case if the genvar is only named
+// in places that can't affect declarations (continuous assignments, procedural
+// blocks and instance port connections) and the body doesn't declare any types
+// of its own, since those would be distinct types for each iteration.
+static bool isGenvarInvariant(const SyntaxNode& node, std::string_view genvar) {
+    switch (node.kind) {
+        case SyntaxKind::ContinuousAssign:
+        case SyntaxKind::InitialBlock:
+        case SyntaxKind::FinalBlock:
+        case SyntaxKind::AlwaysBlock:
+        case SyntaxKind::AlwaysCombBlock:
+        case SyntaxKind::AlwaysFFBlock:
+        case SyntaxKind::AlwaysLatchBlock:
+        case SyntaxKind::HierarchicalInstance:
+            return true;
+        case SyntaxKind::TypedefDeclaration:
+        case SyntaxKind::ForwardTypedefDeclaration:
+        case SyntaxKind::NetTypeDeclaration:
+        case SyntaxKind::TypeParameterDeclaration:
+        case SyntaxKind::ClassDeclaration:
+        case SyntaxKind::CovergroupDeclaration:
+        case SyntaxKind::StructType:
+        case SyntaxKind::UnionType:
+        case SyntaxKind::EnumType:
+            return false;
+        default:
+            break;
+    }
+
+    for (size_t i = 0; i < node.getChildCount(); i++) {
+        if (auto child = node.childNode(i)) {
+            if (!isGenvarInvariant(*child, genvar))
+                return false;
+        }
+        else if (auto token = node.childToken(i);
+                 token.kind == TokenKind::Identifier && token.valueText() == genvar) {
+            return false;
+        }
+    }
+    return true;
+}
+
 static uint64_t getGenerateLoopCount(const Scope& parent) {
     uint64_t count = 0;
     const Scope* cur = &parent;
@@ -609,6 +676,14 @@ GenerateBlockArraySymbol& GenerateBlockArraySymbol::fromSyntax(Compilation& comp
         compilation.noteReference(*symbol);
     }
 
+    // If the body doesn't depend on the genvar, every iteration after the first
+    // can share declared types and parameter values with the first one. This can't
+    // be done if hierarchical references are allowed in constant expressions since
+    // those can observe differences between the iterations.
+    const bool invariant =
+        !compilation.hasFlag(CompilationFlags::AllowHierarchicalConst) &&
+        isGenvarInvariant(*syntax.block, genvar.valueText());
+
     SmallVector<const GenerateBlockSymbol*> entries;
     auto createBlock = [&, blockLoc = loc](ConstantValue value, bool isUninstantiated) {
         // Spec: each generate block gets their own scope, with an implicit
@@ -616,6 +691,9 @@ GenerateBlockArraySymbol& GenerateBlockArraySymbol::fromSyntax(Compilation& comp
         auto block = compilation.emplace<GenerateBlockSymbol>(compilation, "", blockLoc,
                                                               (uint32_t)entries.size(),
                                                               isUninstantiated);
+        if (invariant && !entries.empty())
+            block->prototype = entries[0];
+
         auto implicitParam = compilation.emplace<ParameterSymbol>(
             genvar.valueText(), genvar.location(), true /* isLocal */, false /* isPort */);
 
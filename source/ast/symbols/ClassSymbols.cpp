@@ -813,6 +813,26 @@ void ClassType::handleImplements(const ImplementsClauseSyntax& implementsClause,
             declaredIfacesBuf.push_back(iface);
             findIfaces(*iface, implementsIfacesBuf, seenIfaces);
         }
+
+        // Calls made through a handle to any of the implemented interfaces can
+        // end up in our methods, which matters when subroutine bodies are bound lazily.
+        if (comp.hasFlag(CompilationFlags::LazySubroutineBodies)) {
+            for (auto iface : implementsIfacesBuf) {
+                for (auto& member : iface->as<ClassType>().members()) {
+                    const Symbol* unwrapped = &member;
+                    if (member.kind == SymbolKind::TransparentMember)
+                        unwrapped = &member.as<TransparentMemberSymbol>().wrapped;
+
+                    if (unwrapped->kind != SymbolKind::MethodPrototype)
+                        continue;
+
+                    auto methodSub = unwrapped->as<MethodPrototypeSymbol>().getSubroutine();
+                    auto impl = find(unwrapped->name);
+                    if (methodSub && impl && impl->kind == SymbolKind::Subroutine)
+                        comp.noteInterfaceMethodImpl(*methodSub, impl->as<SubroutineSymbol>());
+                }
+            }
+        }
     }
 
     declaredIfaces = declaredIfacesBuf.copy(comp);
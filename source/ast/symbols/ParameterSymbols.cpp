@@ -9,8 +9,10 @@
 
 #include "slang/ast/ASTSerializer.h"
 #include "slang/ast/Compilation.h"
+#include "slang/ast/ConstEvalProfiler.h"
 #include "slang/ast/Expression.h"
 #include "slang/ast/expressions/MiscExpressions.h"
+#include "slang/ast/symbols/BlockSymbols.h"
 #include "slang/ast/symbols/InstanceSymbols.h"
 #include "slang/ast/symbols/PortSymbols.h"
 #include "slang/ast/symbols/SpecifySymbols.h"
@@ -139,12 +141,22 @@ const ConstantValue& ParameterSymbol::getValue(SourceRange referencingRange) con
         evaluating = true;
         auto guard = ScopeGuard([this] { evaluating = false; });
 
+        // Parameters in an iteration of a genvar-invariant generate loop
+        // always have the same value as in the first iteration.
+        if (auto protoMember = GenerateBlockSymbol::findPrototypeMember(*this)) {
+            auto& protoParam = protoMember->as<ParameterSymbol>();
+            value = &protoParam.getValue(referencingRange);
+            fromStringLit = protoParam.fromStringLit;
+            return *value;
+        }
+
         // If no value has been explicitly set, try to set it
         // from our initializer.
         auto init = getInitializer();
         if (init) {
-            value = scope->getCompilation().allocConstant(
-                ctx.eval(*init, EvalFlags::AllowUnboundedPlaceholder));
+            auto& comp = scope->getCompilation();
+            ConstEvalProfiler::Scope profileScope(comp.getConstEvalProfiler(), *this);
+            value = comp.allocConstant(ctx.eval(*init, EvalFlags::AllowUnboundedPlaceholder));
 
             // If this parameter has an implicit type declared and it was assigned
             // a string literal, make a note so that this parameter gets treated
@@ -11,6 +11,7 @@
 #include "slang/ast/ASTVisitor.h"
 #include "slang/ast/Compilation.h"
 #include "slang/ast/expressions/MiscExpressions.h"
+#include "slang/ast/symbols/BlockSymbols.h"
 #include "slang/ast/symbols/ClassSymbols.h"
 #include "slang/ast/symbols/CompilationUnitSymbols.h"
 #include "slang/ast/symbols/InstanceSymbols.h"
@@ -55,10 +56,39 @@ const Statement& SubroutineSymbol::getBody() const {
             stmt = &Statement::bindItems(syntax->as<FunctionDeclarationSyntax>().items, context,
                                          stmtCtx);
         }
+
+        assignLocalSlots();
     }
     return *stmt;
 }
 
+std::span<const VariableSymbol* const> SubroutineSymbol::getLocalSlots() const {
+    getBody();
+    return localSlots;
+}
+
+void SubroutineSymbol::assignLocalSlots() const {
+    // Every variable declared in the subroutine, including ones in nested
+    // blocks, gets its own slot. Blocks that execute more than once simply
+    // reuse the same slots since only one instance of them is ever live.
+    SmallVector<const VariableSymbol*> vars;
+    auto addScope = [&](auto& self, const Scope& scope) -> void {
+        for (auto& member : scope.members()) {
+            if (member.kind == SymbolKind::Variable || member.kind == SymbolKind::FormalArgument) {
+                auto& var = member.as<VariableSymbol>();
+                var.localSlot = uint32_t(vars.size());
+                vars.push_back(&var);
+            }
+            else if (member.kind == SymbolKind::StatementBlock) {
+                self(self, member.as<StatementBlockSymbol>());
+            }
+        }
+    };
+    addScope(addScope, *this);
+
+    localSlots = vars.copy(getCompilation());
+}
+
 SubroutineSymbol* SubroutineSymbol::fromSyntax(Compilation& compilation,
                                                const FunctionDeclarationSyntax& syntax,
                                                const Scope& parent, bool outOfBlock) {
@@ -720,7 +720,7 @@ const Type& FixedSizeUnpackedArrayType::fromDim(const Scope& scope, const Type&
 }
 
 ConstantValue FixedSizeUnpackedArrayType::getDefaultValueImpl() const {
-    return std::vector<ConstantValue>(range.width(), elementType.getDefaultValue());
+    return ConstantValue::createArray(range.width(), elementType.getDefaultValue());
 }
 
 DynamicArrayType::DynamicArrayType(const Type& elementType) :
@@ -11,6 +11,7 @@
 #include "slang/ast/Expression.h"
 #include "slang/ast/Scope.h"
 #include "slang/ast/Symbol.h"
+#include "slang/ast/symbols/BlockSymbols.h"
 #include "slang/ast/symbols/InstanceSymbols.h"
 #include "slang/ast/symbols/ParameterSymbols.h"
 #include "slang/ast/symbols/SubroutineSymbols.h"
@@ -142,9 +143,20 @@ void DeclaredType::resolveType(const ASTContext& typeContext,
                 typedefTarget = &parent.as<Type>();
         }
 
-        type = &comp.getType(*syntax, typeContext, typedefTarget);
-        if (dimensions)
-            type = &comp.getType(*type, *dimensions, typeContext);
+        // Members of a genvar-invariant generate block iteration resolve to
+        // the same type as the matching member in the first iteration.
+        const Symbol* protoMember = nullptr;
+        if (!typedefTarget)
+            protoMember = GenerateBlockSymbol::findPrototypeMember(parent);
+
+        if (protoMember && protoMember->getDeclaredType()) {
+            type = &protoMember->getDeclaredType()->getType();
+        }
+        else {
+            type = &comp.getType(*syntax, typeContext, typedefTarget);
+            if (dimensions)
+                type = &comp.getType(*type, *dimensions, typeContext);
+        }
     }
 
     if (flags.has(DeclaredTypeFlags::NeedsTypeCheck) && !type->isError())
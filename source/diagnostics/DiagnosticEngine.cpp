@@ -48,7 +48,8 @@ void DiagnosticEngine::clearClients() {
 void DiagnosticEngine::clearCounts() {
     numErrors = 0;
     numWarnings = 0;
-    clients.clear();
+    issuedOverLimitErr = false;
+    reportedIncludeStack.clear();
 }
 
 void DiagnosticEngine::setSeverity(DiagCode code, DiagnosticSeverity severity) {
@@ -246,7 +247,9 @@ bool DiagnosticEngine::issueImpl(const Diagnostic& diagnostic, DiagnosticSeverit
         }
     }
 
-    std::string message = formatMessage(diagnostic);
+    std::string message;
+    if (std::ranges::any_of(clients, [](auto& c) { return c->wantsFormattedMessage(); }))
+        message = formatMessage(diagnostic);
 
     ReportedDiagnostic report(diagnostic);
     report.expansionLocs = std::span<SourceLocation>(expansionLocs).subspan(ignoreExpansionsUntil);
@@ -290,10 +293,7 @@ std::string DiagnosticEngine::formatMessage(const Diagnostic& diag) const {
                 // If the argument is a pointer, the fmtlib API needs it unwrapped into a reference.
                 using T = std::decay_t<decltype(t)>;
                 if constexpr (std::is_same_v<Diagnostic::CustomArgType, T>) {
-                    if (auto it = formatters.find(t.first); it != formatters.end())
-                        args.push_back(it->second->format(t.second));
-                    else
-                        SLANG_THROW(std::runtime_error("No diagnostic formatter for type"));
+                    args.push_back(formatCustomArg(t));
                 }
                 else if constexpr (std::is_same_v<ConstantValue, T>) {
                     if (t.isReal())
@@ -313,6 +313,43 @@ std::string DiagnosticEngine::formatMessage(const Diagnostic& diag) const {
     return fmt::vformat(getMessage(diag.code), args);
 }
 
+std::string DiagnosticEngine::formatArg(const Diagnostic& diag, size_t index) const {
+    SLANG_ASSERT(index < diag.args.size());
+    return std::visit(
+        [&](auto&& t) -> std::string {
+            using T = std::decay_t<decltype(t)>;
+            if constexpr (std::is_same_v<Diagnostic::CustomArgType, T>) {
+                if (formatters.empty())
+                    formatters = defaultFormatters;
+
+                for (auto& [key, formatter] : formatters)
+                    formatter->startMessage(diag);
+
+                return formatCustomArg(t);
+            }
+            else if constexpr (std::is_same_v<ConstantValue, T>) {
+                return t.toString();
+            }
+            else if constexpr (std::is_same_v<std::string, T>) {
+                return t;
+            }
+            else if constexpr (std::is_same_v<char, T>) {
+                return std::string(1, t);
+            }
+            else {
+                return fmt::to_string(t);
+            }
+        },
+        diag.args[index]);
+}
+
+std::string DiagnosticEngine::formatCustomArg(const Diagnostic::CustomArgType& arg) const {
+    if (auto it = formatters.find(arg.first); it != formatters.end())
+        return it->second->format(arg.second);
+
+    SLANG_THROW(std::runtime_error("No diagnostic formatter for type"));
+}
+
 // Walks up a chain of macro argument expansions and collects their buffer IDs.
 static void getMacroArgExpansions(const SourceManager& sm, SourceLocation loc, bool isStart,
                                   SmallVectorBase<BufferID>& results) {
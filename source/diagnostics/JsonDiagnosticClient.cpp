@@ -0,0 +1,358 @@
+//------------------------------------------------------------------------------
+// JsonDiagnosticClient.cpp
+// Diagnostic client that writes machine-readable JSON
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#include "slang/diagnostics/JsonDiagnosticClient.h"
+
+#include <filesystem>
+#include <fmt/format.h>
+
+#include "slang/numeric/ConstantValue.h"
+#include "slang/text/CharInfo.h"
+#include "slang/text/SourceManager.h"
+#include "slang/util/VersionInfo.h"
+
+namespace slang {
+
+JsonDiagnosticClient::JsonDiagnosticClient(std::ostream& stream, Format format,
+                                           size_t chunkSize) :
+    writer(stream, chunkSize), format(format) {
+}
+
+JsonDiagnosticClient::~JsonDiagnosticClient() = default;
+
+static std::string_view getSarifLevel(DiagnosticSeverity severity) {
+    switch (severity) {
+        case DiagnosticSeverity::Ignored:
+            return "none";
+        case DiagnosticSeverity::Note:
+            return "note";
+        case DiagnosticSeverity::Warning:
+            return "warning";
+        case DiagnosticSeverity::Error:
+        case DiagnosticSeverity::Fatal:
+            return "error";
+        default:
+            SLANG_UNREACHABLE;
+    }
+}
+
+// Converts a message format string to a SARIF message string, which
+// refers to its arguments by index instead of by position.
+static std::string toSarifMessageString(std::string_view message) {
+    std::string result;
+    result.reserve(message.size());
+
+    size_t argIndex = 0;
+    for (size_t i = 0; i < message.size(); i++) {
+        char c = message[i];
+        if ((c == '{' || c == '}') && i + 1 < message.size() && message[i + 1] == c) {
+            // Escaped braces are written the same way in both formats.
+            result.append(2, c);
+            i++;
+        }
+        else if (c == '{') {
+            auto end = message.find('}', i);
+            if (end == std::string_view::npos)
+                end = message.size();
+
+            result += fmt::format("{{{}}}", argIndex++);
+            i = end;
+        }
+        else {
+            result.push_back(c);
+        }
+    }
+    return result;
+}
+
+// Percent-encodes a path for use in a URI, leaving the path separators alone.
+static std::string encodeUriPath(std::string_view path) {
+    std::string result;
+    result.reserve(path.size());
+    for (char c : path) {
+        if (isAlphaNumeric(c) || c == '-' || c == '.' || c == '_' || c == '~' || c == '/')
+            result.push_back(c);
+        else
+            result += fmt::format("%{:02X}", (unsigned char)c);
+    }
+    return result;
+}
+
+void JsonDiagnosticClient::writeArtifactUri(std::string_view fileName) {
+    // Absolute paths become file URIs. Anything else is written as a relative
+    // reference that consumers resolve against the source root.
+    std::filesystem::path path(fileName);
+    auto generic = path.generic_string();
+    writer.writeProperty("uri");
+    if (!path.is_absolute()) {
+        writer.writeValue(encodeUriPath(generic));
+        writer.writeProperty("uriBaseId");
+        writer.writeValue("%SRCROOT%"sv);
+    }
+    else if (generic.starts_with("//")) {
+        // A UNC path, where the server name becomes the URI authority.
+        writer.writeValue("file:" + encodeUriPath(generic));
+    }
+    else if (path.has_root_name()) {
+        // A Windows drive letter, which is kept as is after an empty authority.
+        auto rootName = path.root_name().generic_string();
+        writer.writeValue("file:///" + rootName +
+                          encodeUriPath(std::string_view(generic).substr(rootName.size())));
+    }
+    else {
+        writer.writeValue("file://" + encodeUriPath(generic));
+    }
+}
+
+void JsonDiagnosticClient::report(const ReportedDiagnostic& diag) {
+    SLANG_ASSERT(!finished);
+    if (format == Format::Sarif)
+        writeSarifResult(diag);
+    else
+        writeJsonLine(diag);
+}
+
+void JsonDiagnosticClient::finish() {
+    if (finished)
+        return;
+
+    finished = true;
+    if (format == Format::Sarif) {
+        startSarif();
+
+        // The results are written as they're reported. Now that we've seen all
+        // of them, the tables of files and rules they refer to can be filled in.
+        writer.endArray();
+
+        writer.writeProperty("artifacts");
+        writer.startArray();
+        for (auto& file : files) {
+            writer.startObject();
+            writer.writeProperty("location");
+            writer.startObject();
+            writeArtifactUri(file);
+            writer.endObject();
+            writer.endObject();
+        }
+        writer.endArray();
+
+        writer.writeProperty("tool");
+        writer.startObject();
+        writer.writeProperty("driver");
+        writer.startObject();
+        writer.writeProperty("name");
+        writer.writeValue("slang"sv);
+        writer.writeProperty("version");
+        writer.writeValue(fmt::format("{}.{}.{}", VersionInfo::getMajor(), VersionInfo::getMinor(),
+                                      VersionInfo::getPatch()));
+        writer.writeProperty("informationUri");
+        writer.writeValue("https://sv-lang.com"sv);
+        writer.writeProperty("rules");
+        writer.startArray();
+        for (auto code : rules) {
+            writer.startObject();
+            writer.writeProperty("id");
+            writer.writeValue(toString(code));
+
+            if (auto option = engine->getOptionName(code); !option.empty()) {
+                writer.writeProperty("name");
+                writer.writeValue(option);
+            }
+
+            writer.writeProperty("messageStrings");
+            writer.startObject();
+            writer.writeProperty("default");
+            writer.startObject();
+            writer.writeProperty("text");
+            writer.writeValue(toSarifMessageString(engine->getMessage(code)));
+            writer.endObject();
+            writer.endObject();
+            writer.endObject();
+        }
+        writer.endArray();
+        writer.endObject();
+        writer.endObject();
+
+        writer.endObject();
+        writer.endArray();
+        writer.endObject();
+        writer.writeNewLine();
+    }
+
+    writer.flush();
+}
+
+void JsonDiagnosticClient::writeArgs(const Diagnostic& diag, bool asStrings) {
+    writer.startArray();
+    for (size_t i = 0; i < diag.args.size(); i++) {
+        // Numbers are kept as numbers unless the format only supports strings;
+        // everything else is converted the same way it would be in the message.
+        auto& arg = diag.args[i];
+        if (!asStrings) {
+            if (auto val = std::get_if<int64_t>(&arg)) {
+                writer.writeValue(*val);
+                continue;
+            }
+            if (auto val = std::get_if<uint64_t>(&arg)) {
+                writer.writeValue(*val);
+                continue;
+            }
+            if (auto val = std::get_if<ConstantValue>(&arg)) {
+                if (val->isReal()) {
+                    writer.writeValue(double(val->real()));
+                    continue;
+                }
+                if (val->isShortReal()) {
+                    writer.writeValue(double(val->shortReal()));
+                    continue;
+                }
+            }
+        }
+
+        if (auto str = std::get_if<std::string>(&arg))
+            writer.writeValue(*str);
+        else
+            writer.writeValue(engine->formatArg(diag, i));
+    }
+    writer.endArray();
+}
+
+void JsonDiagnosticClient::writeJsonLine(const ReportedDiagnostic& diag) {
+    auto& od = diag.originalDiagnostic;
+
+    writer.startObject();
+    writer.writeProperty("severity");
+    writer.writeValue(getSeverityString(diag.severity));
+    writer.writeProperty("code");
+    writer.writeValue(toString(od.code));
+
+    if (auto option = engine->getOptionName(od.code); !option.empty()) {
+        writer.writeProperty("option");
+        writer.writeValue(option);
+    }
+
+    if (diag.location != SourceLocation::NoLocation) {
+        writer.writeProperty("file");
+        writer.writeValue(sourceManager->getFileName(diag.location));
+        writer.writeProperty("line");
+        writer.writeValue(uint64_t(sourceManager->getLineNumber(diag.location)));
+        if (includeColumn) {
+            writer.writeProperty("column");
+            writer.writeValue(uint64_t(sourceManager->getColumnNumber(diag.location)));
+        }
+    }
+
+    writer.writeProperty("args");
+    writeArgs(od, /* asStrings */ false);
+
+    if (od.coalesceCount) {
+        writer.writeProperty("instances");
+        writer.writeValue(uint64_t(*od.coalesceCount));
+    }
+
+    if (includeMessage) {
+        writer.writeProperty("message");
+        writer.writeValue(diag.formattedMessage);
+    }
+
+    writer.endObject();
+    writer.writeNewLine();
+}
+
+void JsonDiagnosticClient::writeSarifResult(const ReportedDiagnostic& diag) {
+    startSarif();
+
+    auto& od = diag.originalDiagnostic;
+
+    writer.startObject();
+    writer.writeProperty("ruleId");
+    writer.writeValue(toString(od.code));
+    writer.writeProperty("ruleIndex");
+    writer.writeValue(uint64_t(getRuleIndex(od.code)));
+    writer.writeProperty("level");
+    writer.writeValue(getSarifLevel(diag.severity));
+
+    writer.writeProperty("message");
+    writer.startObject();
+    if (includeMessage) {
+        writer.writeProperty("text");
+        writer.writeValue(diag.formattedMessage);
+    }
+    writer.writeProperty("id");
+    writer.writeValue("default"sv);
+    writer.writeProperty("arguments");
+    writeArgs(od, /* asStrings */ true);
+    writer.endObject();
+
+    if (diag.location != SourceLocation::NoLocation) {
+        auto fileName = sourceManager->getFileName(diag.location);
+
+        writer.writeProperty("locations");
+        writer.startArray();
+        writer.startObject();
+        writer.writeProperty("physicalLocation");
+        writer.startObject();
+        writer.writeProperty("artifactLocation");
+        writer.startObject();
+        writeArtifactUri(fileName);
+        writer.writeProperty("index");
+        writer.writeValue(uint64_t(getFileIndex(fileName)));
+        writer.endObject();
+        writer.writeProperty("region");
+        writer.startObject();
+        writer.writeProperty("startLine");
+        writer.writeValue(uint64_t(sourceManager->getLineNumber(diag.location)));
+        if (includeColumn) {
+            writer.writeProperty("startColumn");
+            writer.writeValue(uint64_t(sourceManager->getColumnNumber(diag.location)));
+        }
+        writer.endObject();
+        writer.endObject();
+        writer.endObject();
+        writer.endArray();
+    }
+
+    writer.endObject();
+}
+
+void JsonDiagnosticClient::startSarif() {
+    if (started)
+        return;
+
+    // Results are streamed out as they arrive, so the header is written up front
+    // and everything that has to come after the results waits for finish().
+    started = true;
+    writer.startObject();
+    writer.writeProperty("$schema");
+    writer.writeValue("https://json.schemastore.org/sarif-2.1.0.json"sv);
+    writer.writeProperty("version");
+    writer.writeValue("2.1.0"sv);
+    writer.writeProperty("runs");
+    writer.startArray();
+    writer.startObject();
+    writer.writeProperty("results");
+    writer.startArray();
+}
+
+uint32_t JsonDiagnosticClient::getFileIndex(std::string_view fileName) {
+    if (auto it = fileIndices.find(fileName); it != fileIndices.end())
+        return it->second;
+
+    auto index = uint32_t(files.size());
+    auto& name = files.emplace_back(fileName);
+    fileIndices.emplace(name, index);
+    return index;
+}
+
+uint32_t JsonDiagnosticClient::getRuleIndex(DiagCode code) {
+    auto [it, inserted] = ruleIndices.try_emplace(code, uint32_t(rules.size()));
+    if (inserted)
+        rules.push_back(code);
+    return it->second;
+}
+
+} // namespace slang
@@ -8,22 +8,29 @@
 //------------------------------------------------------------------------------
 #include "slang/driver/Driver.h"
 
+#include <cmath>
 #include <fmt/color.h>
+#include <ostream>
 
 #include "slang/ast/Compilation.h"
+#include "slang/ast/ConstEvalProfiler.h"
 #include "slang/ast/symbols/CompilationUnitSymbols.h"
 #include "slang/ast/symbols/InstanceSymbols.h"
 #include "slang/diagnostics/DeclarationsDiags.h"
 #include "slang/diagnostics/ExpressionsDiags.h"
 #include "slang/diagnostics/LookupDiags.h"
 #include "slang/diagnostics/ParserDiags.h"
+#include "slang/diagnostics/PreprocessorDiags.h"
 #include "slang/diagnostics/StatementsDiags.h"
 #include "slang/diagnostics/SysFuncsDiags.h"
 #include "slang/diagnostics/TextDiagnosticClient.h"
 #include "slang/parsing/Parser.h"
 #include "slang/parsing/Preprocessor.h"
+#include "slang/syntax/AllSyntax.h"
 #include "slang/syntax/SyntaxPrinter.h"
 #include "slang/syntax/SyntaxTree.h"
+#include "slang/syntax/SyntaxVisitor.h"
+#include "slang/text/Json.h"
 #include "slang/util/Random.h"
 #include "slang/util/String.h"
 #include "slang/util/ThreadPool.h"
@@ -36,6 +43,26 @@ using namespace ast;
 using namespace parsing;
 using namespace syntax;
 
+// Returns the top-level source file that the given buffer was
+// included into, through however many levels of nested includes.
+static BufferID getIncludingFile(const SourceManager& sourceManager, BufferID buffer) {
+    while (auto includedFrom = sourceManager.getIncludedFrom(buffer))
+        buffer = sourceManager.getFullyExpandedLoc(includedFrom).buffer();
+    return buffer;
+}
+
+// Flags that are turned on by default when trying to be compatible with vcs.
+static constexpr CompilationFlags VcsCompatFlags[] = {
+    CompilationFlags::AllowHierarchicalConst,
+    CompilationFlags::AllowUseBeforeDeclare,
+    CompilationFlags::RelaxEnumConversions,
+    CompilationFlags::RelaxStringConversions,
+    CompilationFlags::AllowRecursiveImplicitCall,
+    CompilationFlags::AllowBareValParamAssignment,
+    CompilationFlags::AllowSelfDeterminedStreamConcat,
+    CompilationFlags::AllowMultiDrivenLocals,
+    CompilationFlags::AllowMergingAnsiPorts};
+
 Driver::Driver() : diagEngine(sourceManager), sourceLoader(sourceManager) {
     // Construct a compilation object here before the TextDiagnosticClient
     // to ensure that static formatter callbacks are registered.
@@ -111,6 +138,12 @@ void Driver::addStandardArgs() {
                 "<count>");
     cmdLine.add("-j,--threads", options.numThreads,
                 "The number of threads to use to parallelize parsing", "<count>");
+    cmdLine.add("--max-parse-time", options.maxParseTime,
+                "Maximum wall clock time to spend loading and parsing sources before giving up",
+                "<seconds>");
+    cmdLine.add("--max-parse-memory", options.maxParseMemory,
+                "Maximum amount of memory that parsed syntax trees can use before giving up",
+                "<megabytes>");
 
     cmdLine.add(
         "-C",
@@ -140,8 +173,18 @@ void Driver::addStandardArgs() {
                 "Maximum number of frames to show when printing a constant evaluation "
                 "backtrace; the rest will be abbreviated",
                 "<limit>");
+    cmdLine.add("--max-constexpr-memo", options.maxConstexprMemoEntries,
+                "Maximum number of pure constant function call results to remember "
+                "for reuse; set to zero to disable memoization",
+                "<entries>");
     cmdLine.add("--max-instance-array", options.maxInstanceArray,
                 "Maximum number of instances allowed in a single instance array", "<limit>");
+    cmdLine.add("--max-elab-time", options.maxElabTime,
+                "Maximum wall clock time to spend elaborating the design before giving up",
+                "<seconds>");
+    cmdLine.add("--max-elab-memory", options.maxElabMemory,
+                "Maximum amount of memory that the elaborated design can use before giving up",
+                "<megabytes>");
     cmdLine.add("--compat", options.compat,
                 "Attempt to increase compatibility with the specified tool", "vcs");
     cmdLine.add("-T,--timing", options.minTypMax,
@@ -188,6 +231,15 @@ void Driver::addStandardArgs() {
     addCompFlag(CompilationFlags::StrictDriverChecking, "--strict-driver-checking",
                 "Perform strict driver checking, which currently means disabling "
                 "procedural 'for' loop unrolling.");
+    addCompFlag(CompilationFlags::LazySubroutineBodies, "--lazy-subroutine-bodies",
+                "Only bind the bodies of package and class subroutines that are actually "
+                "called, override or implement a called method, or are exported.");
+    addCompFlag(CompilationFlags::DisableConstBytecode, "--disable-const-bytecode",
+                "Evaluate constant function calls by walking their AST instead of "
+                "compiling them to bytecode.");
+    addCompFlag(CompilationFlags::ProfileConstEval, "--profile-const-eval",
+                "Record the time and steps spent evaluating each constant function and "
+                "parameter and print a report of the most expensive ones.");
     addCompFlag(CompilationFlags::LintMode, "--lint-only",
                 "Only perform linting of code, don't try to elaborate a full hierarchy");
 
@@ -227,6 +279,10 @@ void Driver::addStandardArgs() {
                 "Limit on the number of errors that will be printed. Setting this to zero will "
                 "disable the limit.",
                 "<limit>");
+    cmdLine.add("--stream-diagnostics", options.streamDiags,
+                "Print elaboration diagnostics as soon as each instance has been elaborated "
+                "instead of waiting for the whole design. Identical diagnostics from different "
+                "instances are only merged when they are found close together.");
 
     cmdLine.add(
         "--suppress-warnings",
@@ -336,6 +392,16 @@ void Driver::addStandardArgs() {
         "One or more command files containing additional program options. "
         "Paths in the file are considered relative to the file itself.",
         "<file-pattern>[,...]", CommandLineFlags::CommaList);
+
+    cmdLine.add(
+        "--batch",
+        [this](std::string_view value) {
+            loadBatchFiles(value);
+            return "";
+        },
+        "One or more files listing configurations (top modules, parameter overrides, "
+        "and compatibility modes) to elaborate from the same parsed sources, one per line.",
+        "<file-pattern>[,...]", CommandLineFlags::CommaList);
 }
 
 [[nodiscard]] bool Driver::parseCommandLine(std::string_view argList,
@@ -383,6 +449,7 @@ bool Driver::processCommandFiles(std::string_view pattern, bool makeRelative, bo
         SLANG_ASSERT(!buffer.empty());
         buffer.pop_back();
         std::string_view argStr(buffer.data(), buffer.size());
+        commandFiles.push_back({path, std::string(argStr)});
 
         bool result;
         if (separateUnit) {
@@ -411,6 +478,43 @@ bool Driver::processCommandFiles(std::string_view pattern, bool makeRelative, bo
     return true;
 }
 
+bool Driver::loadBatchFiles(std::string_view pattern) {
+    auto onError = [this](const auto& name, std::error_code ec) {
+        printError(fmt::format("batch file '{}': {}", name, ec.message()));
+        anyFailedLoads = true;
+        return false;
+    };
+
+    SmallVector<fs::path> files;
+    std::error_code globEc;
+    svGlob({}, pattern, GlobMode::Files, files, /* expandEnvVars */ false, globEc);
+    if (globEc)
+        return onError(pattern, globEc);
+
+    for (auto& path : files) {
+        SmallVector<char> buffer;
+        if (auto readEc = OS::readFile(path, buffer))
+            return onError(getU8Str(path), readEc);
+
+        SLANG_ASSERT(!buffer.empty());
+        buffer.pop_back();
+        std::string_view text(buffer.data(), buffer.size());
+
+        auto fileName = getU8Str(path);
+        for (size_t lineNum = 1; !text.empty(); lineNum++) {
+            auto line = text.substr(0, text.find('\n'));
+            text.remove_prefix(std::min(line.size() + 1, text.size()));
+
+            if (!parseBatchConfig(line, fmt::format("{}:{}", fileName, lineNum))) {
+                anyFailedLoads = true;
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
 bool Driver::processOptions() {
     bool showColors;
     if (options.colorDiags.has_value())
@@ -436,26 +540,15 @@ bool Driver::processOptions() {
         }
     }
 
-    if (options.compat.has_value()) {
-        if (options.compat == "vcs") {
-            auto vcsCompatFlags = {CompilationFlags::AllowHierarchicalConst,
-                                   CompilationFlags::AllowUseBeforeDeclare,
-                                   CompilationFlags::RelaxEnumConversions,
-                                   CompilationFlags::RelaxStringConversions,
-                                   CompilationFlags::AllowRecursiveImplicitCall,
-                                   CompilationFlags::AllowBareValParamAssignment,
-                                   CompilationFlags::AllowSelfDeterminedStreamConcat,
-                                   CompilationFlags::AllowMultiDrivenLocals,
-                                   CompilationFlags::AllowMergingAnsiPorts};
+    if (options.compat.has_value() && options.compat != "vcs") {
+        printError(fmt::format("invalid value for compat option: '{}'", *options.compat));
+        return false;
+    }
 
-            for (auto flag : vcsCompatFlags) {
-                auto& option = options.compilationFlags.at(flag);
-                if (!option.has_value())
-                    option = true;
-            }
-        }
-        else {
-            printError(fmt::format("invalid value for compat option: '{}'", *options.compat));
+    for (auto& config : batchConfigs) {
+        if (config.compat.has_value() && config.compat != "vcs") {
+            printError(fmt::format("invalid value for compat option in configuration '{}': '{}'",
+                                   config.name, *config.compat));
             return false;
         }
     }
@@ -478,6 +571,11 @@ bool Driver::processOptions() {
         return false;
     }
 
+    if (options.maxParseTime.value_or(0) < 0 || options.maxElabTime.value_or(0) < 0) {
+        printError("time limits must not be negative");
+        return false;
+    }
+
     if (options.timeScale.has_value() && !TimeScale::fromString(*options.timeScale)) {
         printError(fmt::format("invalid value for time scale option: '{}'", *options.timeScale));
         return false;
@@ -511,6 +609,14 @@ bool Driver::processOptions() {
     else if (options.diagHierarchy == "never")
         dc.showHierarchyInstance(ShowHierarchyPathOption::Never);
 
+    Diagnostics optionDiags = setDiagSeverities(options.compat == "vcs");
+    for (auto& diag : optionDiags)
+        diagEngine.issue(diag);
+
+    return true;
+}
+
+Diagnostics Driver::setDiagSeverities(bool vcsCompat) {
     diagEngine.setErrorLimit((int)options.errorLimit.value_or(20));
     diagEngine.setDefaultWarnings();
 
@@ -523,7 +629,7 @@ bool Driver::processOptions() {
     diagEngine.setSeverity(diag::BadProceduralForce, DiagnosticSeverity::Error);
     diagEngine.setSeverity(diag::UnknownSystemName, DiagnosticSeverity::Error);
 
-    if (options.compat == "vcs") {
+    if (vcsCompat) {
         diagEngine.setSeverity(diag::StaticInitializerMustBeExplicit, DiagnosticSeverity::Ignored);
         diagEngine.setSeverity(diag::ImplicitConvert, DiagnosticSeverity::Ignored);
         diagEngine.setSeverity(diag::BadFinishNum, DiagnosticSeverity::Ignored);
@@ -543,11 +649,8 @@ bool Driver::processOptions() {
         diagEngine.setSeverity(diag::SpecifyPathConditionExpr, DiagnosticSeverity::Error);
     }
 
-    Diagnostics optionDiags = diagEngine.setWarningOptions(options.warningOptions);
-    for (auto& diag : optionDiags)
-        diagEngine.issue(diag);
-
-    return true;
+    // The user's warning options get the final say.
+    return diagEngine.setWarningOptions(options.warningOptions);
 }
 
 template<typename TGenerator>
@@ -666,6 +769,470 @@ void Driver::reportMacros() {
     }
 }
 
+std::vector<Driver::UnitDependencies> Driver::scanDependencies() const {
+    std::vector<UnitDependencies> results(syntaxTrees.size());
+
+    // Index the names declared at the top level of each unit. Packages
+    // are kept separate since they live in their own name space.
+    flat_hash_map<BufferID, size_t> unitsByBuffer;
+    flat_hash_map<std::string_view, std::vector<size_t>> definitionUnits;
+    flat_hash_map<std::string_view, std::vector<size_t>> packageUnits;
+    for (size_t i = 0; i < syntaxTrees.size(); i++) {
+        auto& unit = results[i];
+        unit.tree = syntaxTrees[i];
+        for (auto id : unit.tree->getSourceBufferIds()) {
+            unitsByBuffer.emplace(id, i);
+            unit.files.emplace_back(sourceManager.getRawFileName(id));
+        }
+
+        auto& root = unit.tree->root();
+        if (root.kind != SyntaxKind::CompilationUnit)
+            continue;
+
+        for (auto member : root.as<CompilationUnitSyntax>().members) {
+            std::string_view name;
+            auto* nameMap = &definitionUnits;
+            switch (member->kind) {
+                case SyntaxKind::ModuleDeclaration:
+                case SyntaxKind::InterfaceDeclaration:
+                case SyntaxKind::ProgramDeclaration:
+                    name = member->as<ModuleDeclarationSyntax>().header->name.valueText();
+                    break;
+                case SyntaxKind::PackageDeclaration:
+                    name = member->as<ModuleDeclarationSyntax>().header->name.valueText();
+                    nameMap = &packageUnits;
+                    break;
+                case SyntaxKind::UdpDeclaration:
+                    name = member->as<UdpDeclarationSyntax>().name.valueText();
+                    break;
+                default:
+                    break;
+            }
+
+            if (!name.empty()) {
+                unit.definitions.push_back(name);
+                (*nameMap)[name].push_back(i);
+            }
+        }
+    }
+
+    // Every included file leads back to the unit it was included into.
+    std::vector<flat_hash_set<std::string_view>> seenIncludes(results.size());
+    for (auto buffer : sourceManager.getAllBuffers()) {
+        auto root = getIncludingFile(sourceManager, buffer);
+        if (root == buffer)
+            continue;
+
+        if (auto it = unitsByBuffer.find(root); it != unitsByBuffer.end()) {
+            auto name = sourceManager.getRawFileName(buffer);
+            if (seenIncludes[it->second].insert(name).second)
+                results[it->second].includes.emplace_back(name);
+        }
+    }
+
+    for (size_t i = 0; i < results.size(); i++) {
+        auto& unit = results[i];
+        flat_hash_set<std::string_view> seenDefinitions;
+        flat_hash_set<std::string_view> seenPackages;
+        flat_hash_set<size_t> seenUnits;
+
+        auto addName = [&](std::string_view name, bool isPackage, bool mustExist) {
+            auto& nameMap = isPackage ? packageUnits : definitionUnits;
+            auto& seen = isPackage ? seenPackages : seenDefinitions;
+            if (name.empty() || seen.contains(name))
+                return;
+
+            auto it = nameMap.find(name);
+            if (it == nameMap.end()) {
+                // Names that might just as well refer to a class
+                // or a type parameter aren't worth reporting.
+                if (mustExist) {
+                    seen.insert(name);
+                    unit.unresolved.push_back(name);
+                }
+                return;
+            }
+
+            seen.insert(name);
+            if (std::ranges::find(it->second, i) != it->second.end())
+                return;
+
+            (isPackage ? unit.packages : unit.instances).push_back(name);
+            for (auto index : it->second) {
+                if (seenUnits.insert(index).second)
+                    unit.dependsOn.push_back(index);
+            }
+        };
+
+        auto& meta = unit.tree->getMetadata();
+        for (auto name : meta.globalInstances)
+            addName(name, /* isPackage */ false, /* mustExist */ true);
+
+        for (auto intf : meta.interfacePorts) {
+            if (intf->nameOrKeyword.kind == TokenKind::Identifier)
+                addName(intf->nameOrKeyword.valueText(), /* isPackage */ false,
+                        /* mustExist */ true);
+        }
+
+        for (auto importDecl : meta.packageImports) {
+            for (auto item : importDecl->items) {
+                // The std package is built in, so there's nothing to depend on.
+                auto name = item->package.valueText();
+                if (name != "std"sv)
+                    addName(name, /* isPackage */ true, /* mustExist */ true);
+            }
+        }
+
+        for (auto idName : meta.classPackageNames)
+            addName(idName->identifier.valueText(), /* isPackage */ true, /* mustExist */ false);
+
+        // The metadata doesn't keep names in any particular order, so
+        // sort everything to make the results the same from run to run.
+        std::ranges::sort(unit.packages);
+        std::ranges::sort(unit.instances);
+        std::ranges::sort(unit.unresolved);
+        std::ranges::sort(unit.dependsOn);
+    }
+
+    return results;
+}
+
+static std::string escapeDepfilePath(std::string_view path) {
+    std::string result;
+    for (char c : path) {
+        if (c == ' ' || c == '#')
+            result.push_back('\\');
+        else if (c == '$')
+            result.push_back('$');
+        result.push_back(c);
+    }
+    return result;
+}
+
+void Driver::writeDepfile(std::ostream& stream, std::span<const UnitDependencies> deps,
+                          std::string_view target) const {
+    flat_hash_set<std::string_view> seen;
+    std::vector<std::string_view> prereqs;
+    auto addPrereqs = [&](std::span<const std::string> files) {
+        for (auto& file : files) {
+            if (seen.insert(file).second)
+                prereqs.push_back(file);
+        }
+    };
+
+    auto writeRule = [&](std::string_view ruleTarget) {
+        stream << escapeDepfilePath(ruleTarget) << ':';
+        for (auto prereq : prereqs)
+            stream << " \\\n  " << escapeDepfilePath(prereq);
+        stream << '\n';
+
+        seen.clear();
+        prereqs.clear();
+    };
+
+    if (!target.empty()) {
+        std::vector<std::string> mapFiles;
+        for (auto& tree : sourceLoader.getLibraryMaps()) {
+            for (auto id : tree->getSourceBufferIds())
+                mapFiles.emplace_back(sourceManager.getRawFileName(id));
+        }
+
+        addPrereqs(mapFiles);
+        for (auto& unit : deps) {
+            addPrereqs(unit.files);
+            addPrereqs(unit.includes);
+        }
+        writeRule(target);
+        return;
+    }
+
+    for (auto& unit : deps) {
+        if (unit.files.empty())
+            continue;
+
+        // The target doesn't need to depend on itself.
+        seen.insert(unit.files[0]);
+        addPrereqs(std::span(unit.files).subspan(1));
+        addPrereqs(unit.includes);
+        for (auto index : unit.dependsOn)
+            addPrereqs(deps[index].files);
+        writeRule(unit.files[0]);
+    }
+}
+
+void Driver::writeDependencyGraph(JsonWriter& writer, std::span<const UnitDependencies> deps) {
+    auto writeList = [&](std::string_view name, const auto& list) {
+        writer.writeProperty(name);
+        writer.startArray();
+        for (auto& item : list)
+            writer.writeValue(std::string_view(item));
+        writer.endArray();
+    };
+
+    writer.startObject();
+    writer.writeProperty("units");
+    writer.startArray();
+    for (auto& unit : deps) {
+        writer.startObject();
+        if (auto library = unit.tree->getSourceLibrary()) {
+            writer.writeProperty("library");
+            writer.writeValue(library->name);
+        }
+
+        writer.writeProperty("isLibraryUnit");
+        writer.writeValue(unit.tree->isLibraryUnit);
+
+        writeList("files", unit.files);
+        writeList("includes", unit.includes);
+        writeList("definitions", unit.definitions);
+        writeList("packages", unit.packages);
+        writeList("instances", unit.instances);
+        writeList("unresolved", unit.unresolved);
+
+        writer.writeProperty("dependsOn");
+        writer.startArray();
+        for (auto index : unit.dependsOn)
+            writer.writeValue(uint64_t(index));
+        writer.endArray();
+
+        writer.endObject();
+    }
+    writer.endArray();
+    writer.endObject();
+}
+
+namespace {
+
+// Collects the names of the definitions and packages referred to by a piece of syntax.
+class ReferenceCollector : public SyntaxVisitor<ReferenceCollector> {
+public:
+    std::vector<std::string_view> definitions;
+    std::vector<std::string_view> importedPackages;
+    std::vector<std::string_view> scopedNames;
+    flat_hash_set<std::string_view> nestedDefinitions;
+
+    explicit ReferenceCollector(const SyntaxNode& root) : root(root) {}
+
+    void handle(const ModuleDeclarationSyntax& syntax) {
+        if (&syntax != &root)
+            nestedDefinitions.insert(syntax.header->name.valueText());
+        visitDefault(syntax);
+    }
+
+    void handle(const HierarchyInstantiationSyntax& syntax) {
+        definitions.push_back(syntax.type.valueText());
+        visitDefault(syntax);
+    }
+
+    void handle(const InterfacePortHeaderSyntax& syntax) {
+        if (syntax.nameOrKeyword.kind == TokenKind::Identifier)
+            definitions.push_back(syntax.nameOrKeyword.valueText());
+        visitDefault(syntax);
+    }
+
+    void handle(const VirtualInterfaceTypeSyntax& syntax) {
+        definitions.push_back(syntax.name.valueText());
+        visitDefault(syntax);
+    }
+
+    void handle(const PackageImportItemSyntax& syntax) {
+        importedPackages.push_back(syntax.package.valueText());
+    }
+
+    void handle(const ScopedNameSyntax& syntax) {
+        if (syntax.left->kind == SyntaxKind::IdentifierName &&
+            syntax.separator.kind == TokenKind::DoubleColon) {
+            scopedNames.push_back(syntax.left->as<IdentifierNameSyntax>().identifier.valueText());
+        }
+        visitDefault(syntax);
+    }
+
+private:
+    const SyntaxNode& root;
+};
+
+} // namespace
+
+Driver::RequiredSources Driver::findRequiredSources(const Compilation& compilation) const {
+    RequiredSources result;
+    auto units = compilation.getCompilationUnits();
+    if (units.empty())
+        return result;
+
+    // Definitions are looked up from the root of the design, where
+    // nothing but the top modules have been instantiated yet.
+    auto& lookupScope = *units[0];
+
+    flat_hash_map<BufferID, size_t> treesByBuffer;
+    for (size_t i = 0; i < syntaxTrees.size(); i++) {
+        for (auto id : syntaxTrees[i]->getSourceBufferIds())
+            treesByBuffer.emplace(id, i);
+    }
+
+    std::vector<bool> neededTrees(syntaxTrees.size());
+    std::vector<const SyntaxNode*> worklist;
+    flat_hash_set<const SyntaxNode*> visited;
+    flat_hash_set<std::string_view> seenUnresolved;
+
+    // Everything in a tree outside of its definitions and packages is visible to
+    // (or in the case of bind directives, reaches into) the rest of the tree,
+    // so it all needs to be searched as soon as the tree is needed.
+    auto addTree = [&](size_t index) {
+        if (neededTrees[index])
+            return;
+
+        neededTrees[index] = true;
+        auto& root = syntaxTrees[index]->root();
+        if (root.kind != SyntaxKind::CompilationUnit)
+            return;
+
+        for (auto member : root.as<CompilationUnitSyntax>().members) {
+            switch (member->kind) {
+                case SyntaxKind::ModuleDeclaration:
+                case SyntaxKind::InterfaceDeclaration:
+                case SyntaxKind::ProgramDeclaration:
+                case SyntaxKind::PackageDeclaration:
+                case SyntaxKind::UdpDeclaration:
+                    break;
+                default:
+                    worklist.push_back(member);
+                    break;
+            }
+        }
+    };
+
+    auto addSymbol = [&](const Symbol& symbol) {
+        auto syntax = symbol.getSyntax();
+        if (!syntax || !visited.insert(syntax).second)
+            return;
+
+        // Built-in packages don't come from any of the syntax trees.
+        auto file = getIncludingFile(sourceManager,
+                                     sourceManager.getFullyExpandedLoc(symbol.location).buffer());
+        if (auto it = treesByBuffer.find(file); it != treesByBuffer.end()) {
+            addTree(it->second);
+            worklist.push_back(syntax);
+        }
+    };
+
+    auto addUnresolved = [&](std::string_view name) {
+        if (!name.empty() && seenUnresolved.insert(name).second)
+            result.unresolved.push_back(name);
+    };
+
+    auto addDefinition = [&](std::string_view name) {
+        if (auto def = compilation.tryGetDefinition(name, lookupScope).definition)
+            addSymbol(*def);
+        else
+            addUnresolved(name);
+    };
+
+    for (auto& name : options.topModules) {
+        // Top modules can be qualified with the name of their library.
+        std::string_view topName = name;
+        if (!compilation.tryGetDefinition(topName, lookupScope).definition) {
+            if (auto index = topName.find('.'); index != std::string_view::npos)
+                topName = topName.substr(index + 1);
+        }
+        addDefinition(topName);
+    }
+
+    for (size_t i = 0; i < syntaxTrees.size(); i++) {
+        auto& root = syntaxTrees[i]->root();
+        if (root.kind != SyntaxKind::CompilationUnit)
+            continue;
+
+        for (auto member : root.as<CompilationUnitSyntax>().members) {
+            if (member->kind == SyntaxKind::BindDirective) {
+                addTree(i);
+                break;
+            }
+        }
+    }
+
+    while (!worklist.empty()) {
+        auto node = worklist.back();
+        worklist.pop_back();
+
+        ReferenceCollector collector(*node);
+        node->visit(collector);
+
+        for (auto name : collector.definitions) {
+            if (!collector.nestedDefinitions.contains(name))
+                addDefinition(name);
+        }
+
+        for (auto name : collector.importedPackages) {
+            if (auto package = compilation.getPackage(name))
+                addSymbol(*package);
+            else
+                addUnresolved(name);
+        }
+
+        // Names that aren't packages might just as well refer to classes or type
+        // parameters, so there's no telling whether they're actually missing.
+        for (auto name : collector.scopedNames) {
+            if (auto package = compilation.getPackage(name))
+                addSymbol(*package);
+        }
+    }
+
+    flat_hash_set<BufferID> neededFiles;
+    for (size_t i = 0; i < syntaxTrees.size(); i++) {
+        if (neededTrees[i]) {
+            for (auto id : syntaxTrees[i]->getSourceBufferIds()) {
+                result.files.push_back(id);
+                neededFiles.insert(id);
+            }
+        }
+    }
+
+    flat_hash_set<std::string_view> seenIncludes;
+    for (auto buffer : sourceManager.getAllBuffers()) {
+        auto root = getIncludingFile(sourceManager, buffer);
+        if (root != buffer && neededFiles.contains(root) &&
+            seenIncludes.insert(sourceManager.getRawFileName(buffer)).second) {
+            result.includes.push_back(buffer);
+        }
+    }
+
+    return result;
+}
+
+void Driver::writeFilelist(std::ostream& stream, const RequiredSources& sources) const {
+    auto quote = [](const std::string& path) {
+        if (path.find_first_of(" \t") == std::string::npos)
+            return path;
+        return fmt::format("\"{}\"", path);
+    };
+
+    flat_hash_set<BufferID> libraryUnitFiles;
+    for (auto& tree : syntaxTrees) {
+        if (tree->isLibraryUnit) {
+            for (auto id : tree->getSourceBufferIds())
+                libraryUnitFiles.insert(id);
+        }
+    }
+
+    stream << "// Source files needed to elaborate the design\n";
+    for (auto buffer : sources.files) {
+        auto path = quote(getU8Str(sourceManager.getFullPath(buffer)));
+        auto library = sourceManager.getLibraryFor(buffer);
+        if (library && !library->isDefault)
+            stream << "-v " << library->name << '=' << path << '\n';
+        else if (libraryUnitFiles.contains(buffer))
+            stream << "-v " << path << '\n';
+        else
+            stream << path << '\n';
+    }
+
+    if (!sources.includes.empty()) {
+        stream << "\n// Included files, which are found through the include paths\n";
+        for (auto buffer : sources.includes)
+            stream << "// " << getU8Str(sourceManager.getFullPath(buffer)) << '\n';
+    }
+}
+
 bool Driver::parseAllSources() {
     Bag optionBag;
     addParseOptions(optionBag);
@@ -681,19 +1248,108 @@ bool Driver::parseAllSources() {
     return true;
 }
 
+bool Driver::reparseChangedSources() {
+    auto changedFiles = sourceManager.reloadChangedFiles();
+
+    // Find the top-level buffers that depend on the changed files,
+    // either directly or through some chain of includes.
+    flat_hash_set<BufferID> staleBuffers;
+    auto allBuffers = sourceManager.getAllBuffers();
+    if (!changedFiles.empty()) {
+        flat_hash_set<std::filesystem::path> changedSet(changedFiles.begin(), changedFiles.end());
+        for (auto buffer : allBuffers) {
+            if (changedSet.contains(sourceManager.getFullPath(buffer)))
+                staleBuffers.insert(getIncludingFile(sourceManager, buffer));
+        }
+    }
+
+    auto dependsOnChanges = [&](const SyntaxTree& tree) {
+        return std::ranges::any_of(tree.getSourceBufferIds(),
+                                   [&](BufferID id) { return staleBuffers.contains(id); });
+    };
+
+    // Trees that failed to open an include file also get reparsed,
+    // in case the file has been created since then.
+    auto isStale = [&](const std::shared_ptr<SyntaxTree>& tree) {
+        return dependsOnChanges(*tree) ||
+               std::ranges::any_of(tree->diagnostics(), [](const Diagnostic& diag) {
+                   return diag.code == diag::CouldNotOpenIncludeFile;
+               });
+    };
+
+    if (std::ranges::any_of(sourceLoader.getLibraryMaps(),
+                            [&](auto& tree) { return dependsOnChanges(*tree); })) {
+        return false;
+    }
+
+    if (std::ranges::none_of(syntaxTrees, isStale))
+        return true;
+
+    // Trees that were parsed together as a single unit, or that inherit
+    // macros from one, can't be reparsed independently of each other.
+    if (options.singleUnit == true || options.librariesInheritMacros == true)
+        return false;
+
+    // Each remaining tree stands on its own, so it can be reparsed from
+    // the new contents of its files using its original options.
+    for (auto& tree : syntaxTrees) {
+        if (!isStale(tree))
+            continue;
+
+        SmallVector<SourceBuffer> buffers;
+        for (auto id : tree->getSourceBufferIds()) {
+            auto buffer = sourceManager.readSource(sourceManager.getFullPath(id),
+                                                   tree->getSourceLibrary(),
+                                                   sourceManager.getSortKey(id));
+            if (!buffer)
+                return false;
+
+            buffers.push_back(*buffer);
+        }
+
+        auto newTree = SyntaxTree::fromBuffers(buffers, sourceManager, tree->options());
+        newTree->isLibraryUnit = tree->isLibraryUnit;
+        tree = std::move(newTree);
+    }
+
+    // Apply any diagnostic pragmas from the files we just read.
+    std::vector<BufferID> pragmaBuffers;
+    sourceManager.visitDiagnosticDirectives([&](BufferID buffer, auto&) {
+        if (buffer.getId() > allBuffers.size())
+            pragmaBuffers.push_back(buffer);
+    });
+
+    for (auto buffer : pragmaBuffers) {
+        for (auto& diag : diagEngine.setMappingsFromPragmas(buffer))
+            diagEngine.issue(diag);
+    }
+
+    return true;
+}
+
 Bag Driver::createOptionBag() const {
     Bag bag;
     addParseOptions(bag);
-    addCompilationOptions(bag);
+    addCompilationOptions(bag, {});
     return bag;
 }
 
+// Time limits are given in seconds on the command line. Any nonzero limit
+// is rounded up to at least a millisecond so it doesn't turn into "no limit".
+static uint32_t toMilliseconds(std::optional<double> seconds) {
+    if (!seconds)
+        return 0;
+    return uint32_t(std::min(std::ceil(*seconds * 1000.0), double(UINT32_MAX)));
+}
+
 void Driver::addParseOptions(Bag& bag) const {
     SourceOptions soptions;
     soptions.numThreads = options.numThreads;
     soptions.singleUnit = options.singleUnit == true;
     soptions.onlyLint = options.lintMode();
     soptions.librariesInheritMacros = options.librariesInheritMacros == true;
+    soptions.maxParseTime = toMilliseconds(options.maxParseTime);
+    soptions.maxParseMemory = options.maxParseMemory.value_or(0) * 1024 * 1024;
 
     PreprocessorOptions ppoptions;
     ppoptions.predefines = options.defines;
@@ -722,7 +1378,7 @@ void Driver::addParseOptions(Bag& bag) const {
     bag.set(poptions);
 }
 
-void Driver::addCompilationOptions(Bag& bag) const {
+void Driver::addCompilationOptions(Bag& bag, const BatchConfig& config) const {
     CompilationOptions coptions;
     coptions.flags = CompilationFlags::None;
     coptions.languageVersion = languageVersion;
@@ -736,21 +1392,37 @@ void Driver::addCompilationOptions(Bag& bag) const {
         coptions.maxConstexprSteps = *options.maxConstexprSteps;
     if (options.maxConstexprBacktrace.has_value())
         coptions.maxConstexprBacktrace = *options.maxConstexprBacktrace;
+    if (options.maxConstexprMemoEntries.has_value())
+        coptions.maxConstexprMemoEntries = *options.maxConstexprMemoEntries;
     if (options.maxInstanceArray.has_value())
         coptions.maxInstanceArray = *options.maxInstanceArray;
     if (options.errorLimit.has_value())
         coptions.errorLimit = *options.errorLimit * 2;
 
+    coptions.maxElaborationTime = toMilliseconds(options.maxElabTime);
+    coptions.maxElaborationMemory = options.maxElabMemory.value_or(0) * 1024 * 1024;
+
+    // Compatibility modes turn on a set of flags, unless
+    // the user has explicitly said otherwise.
+    bool vcsCompat = config.compat.value_or(options.compat.value_or("")) == "vcs";
     for (auto& [flag, value] : options.compilationFlags) {
-        if (value == true)
+        bool compatFlag = vcsCompat && std::ranges::find(VcsCompatFlags, flag) !=
+                                           std::ranges::end(VcsCompatFlags);
+        if (value == true || (!value.has_value() && compatFlag))
             coptions.flags |= flag;
     }
 
     if (options.lintMode())
         coptions.flags |= CompilationFlags::SuppressUnused;
 
-    for (auto& name : options.topModules)
+    auto& topModules = config.topModules.empty() ? options.topModules : config.topModules;
+    for (auto& name : topModules)
         coptions.topModules.emplace(name);
+
+    // The first override for a given parameter is the one that gets used,
+    // so the configuration's overrides go ahead of the driver's.
+    for (auto& opt : config.paramOverrides)
+        coptions.paramOverrides.emplace_back(opt);
     for (auto& opt : options.paramOverrides)
         coptions.paramOverrides.emplace_back(opt);
     for (auto& lib : options.libraryOrder)
@@ -772,6 +1444,10 @@ void Driver::addCompilationOptions(Bag& bag) const {
 }
 
 std::unique_ptr<Compilation> Driver::createCompilation() {
+    return createCompilation(BatchConfig{});
+}
+
+std::unique_ptr<Compilation> Driver::createCompilation(const BatchConfig& config) {
     SourceLibrary* defaultLib;
     if (options.defaultLibName && !options.defaultLibName->empty())
         defaultLib = sourceLoader.getOrAddLibrary(*options.defaultLibName);
@@ -781,7 +1457,11 @@ std::unique_ptr<Compilation> Driver::createCompilation() {
     SLANG_ASSERT(defaultLib);
     defaultLib->isDefault = true;
 
-    auto compilation = std::make_unique<Compilation>(createOptionBag(), defaultLib);
+    Bag bag;
+    addParseOptions(bag);
+    addCompilationOptions(bag, config);
+
+    auto compilation = std::make_unique<Compilation>(bag, defaultLib);
     for (auto& tree : sourceLoader.getLibraryMaps())
         compilation->addSyntaxTree(tree);
     for (auto& tree : syntaxTrees)
@@ -816,16 +1496,45 @@ bool Driver::reportCompilation(Compilation& compilation, bool quiet) {
         }
     }
 
-    for (auto& diag : compilation.getAllDiagnostics())
-        diagEngine.issue(diag);
+    bool anyDiagsPrinted = false;
+    auto printDiags = [&] {
+        std::string diagStr = diagClient->getString();
+        OS::printE(fmt::format("{}", diagStr));
+        anyDiagsPrinted |= diagStr.size() > 1;
+        diagClient->clear();
+    };
 
-    bool succeeded = diagEngine.getNumErrors() == 0;
+    if (options.streamDiags == true) {
+        // Parse diagnostics are all known up front. After that, print each batch of
+        // elaboration diagnostics as it arrives and stop elaborating once we've hit
+        // the error limit, since nothing more would be printed anyway.
+        for (auto& diag : compilation.getParseDiagnostics())
+            diagEngine.issue(diag);
+        printDiags();
+
+        compilation.setDiagnosticCallback([&](const Diagnostics& batch) {
+            for (auto& diag : batch)
+                diagEngine.issue(diag);
+            printDiags();
+
+            int limit = diagEngine.getErrorLimit();
+            return limit == 0 || diagEngine.getNumErrors() < limit;
+        });
+
+        for (auto& diag : compilation.getSemanticDiagnostics())
+            diagEngine.issue(diag);
+        compilation.setDiagnosticCallback(nullptr);
+    }
+    else {
+        for (auto& diag : compilation.getAllDiagnostics())
+            diagEngine.issue(diag);
+    }
 
-    std::string diagStr = diagClient->getString();
-    OS::printE(fmt::format("{}", diagStr));
+    bool succeeded = diagEngine.getNumErrors() == 0;
+    printDiags();
 
     if (!quiet) {
-        if (diagStr.size() > 1)
+        if (anyDiagsPrinted)
             OS::print("\n");
 
         if (succeeded)
@@ -839,9 +1548,88 @@ bool Driver::reportCompilation(Compilation& compilation, bool quiet) {
                               diagEngine.getNumWarnings() == 1 ? "" : "s"));
     }
 
+    // The report was explicitly asked for, so print it even in quiet mode.
+    if (auto profiler = compilation.getConstEvalProfiler()) {
+        const size_t maxEntries = 25;
+        OS::print(fmt::format("\n{}", profiler->report(maxEntries)));
+    }
+
     return succeeded;
 }
 
+bool Driver::runBatch(bool quiet) {
+    auto isVcsCompat = [&](const BatchConfig& config) {
+        return config.compat.value_or(options.compat.value_or("")) == "vcs";
+    };
+
+    // Each compilation is independent of the others, so they can all be elaborated
+    // at the same time. Reporting their diagnostics goes through the one engine
+    // though, so that happens one configuration at a time as each one finishes.
+    std::optional<ThreadPool> threadPool;
+    if (options.numThreads != 1u && batchConfigs.size() > 1)
+        threadPool.emplace(options.numThreads.value_or(0u));
+
+    std::vector<std::unique_ptr<Compilation>> compilations;
+    std::vector<std::future<void>> elaborated;
+    for (auto& config : batchConfigs) {
+        auto& compilation = compilations.emplace_back(createCompilation(config));
+        if (threadPool) {
+            elaborated.emplace_back(
+                threadPool->submit([comp = compilation.get()] { comp->getAllDiagnostics(); }));
+        }
+    }
+
+    bool driverVcsCompat = options.compat == "vcs";
+    bool currVcsCompat = driverVcsCompat;
+    size_t numFailed = 0;
+    for (size_t i = 0; i < batchConfigs.size(); i++) {
+        auto& config = batchConfigs[i];
+        if (threadPool)
+            elaborated[i].get();
+
+        if (i > 0) {
+            diagEngine.clearCounts();
+            if (!quiet)
+                OS::print("\n");
+        }
+
+        // Compatibility modes also change the severity of some diagnostics.
+        // Any problems with the warning options were already reported
+        // when the options were first processed.
+        if (bool vcsCompat = isVcsCompat(config); vcsCompat != currVcsCompat) {
+            diagEngine.clearMappings();
+            setDiagSeverities(vcsCompat);
+            currVcsCompat = vcsCompat;
+        }
+
+        if (!quiet)
+            OS::print(fg(diagClient->highlightColor),
+                      fmt::format("Configuration '{}':\n", config.name));
+
+        if (!reportCompilation(*compilations[i], quiet))
+            numFailed++;
+
+        // Nothing else needs the compilation, so free up its memory right away.
+        compilations[i].reset();
+    }
+
+    if (currVcsCompat != driverVcsCompat) {
+        diagEngine.clearMappings();
+        setDiagSeverities(driverVcsCompat);
+    }
+
+    if (!quiet && batchConfigs.size() > 1) {
+        if (numFailed == 0)
+            OS::print(fg(diagClient->highlightColor), "\nBatch succeeded: ");
+        else
+            OS::print(fg(diagClient->errorColor), "\nBatch failed: ");
+
+        OS::print(fmt::format("{} of {} configurations failed\n", numFailed, batchConfigs.size()));
+    }
+
+    return numFailed == 0;
+}
+
 bool Driver::parseUnitListing(std::string_view text) {
     CommandLine unitCmdLine;
     std::vector<std::string> includes;
@@ -895,6 +1683,35 @@ bool Driver::parseUnitListing(std::string_view text) {
     return true;
 }
 
+bool Driver::parseBatchConfig(std::string_view text, std::string_view location) {
+    BatchConfig config;
+    std::optional<std::string> name;
+    CommandLine configCmdLine;
+    configCmdLine.add("--name", name, "");
+    configCmdLine.add("--top", config.topModules, "", "", CommandLineFlags::CommaList);
+    configCmdLine.add("-G", config.paramOverrides, "");
+    configCmdLine.add("--compat", config.compat, "");
+
+    CommandLine::ParseOptions parseOpts;
+    parseOpts.expandEnvVars = true;
+    parseOpts.ignoreProgramName = true;
+    parseOpts.supportComments = true;
+
+    if (!configCmdLine.parse(text, parseOpts)) {
+        for (auto& err : configCmdLine.getErrors())
+            OS::printE(fmt::format("{}: {}\n", location, err));
+        return false;
+    }
+
+    // Blank lines and lines that only have comments on them are skipped.
+    if (!name && config.topModules.empty() && config.paramOverrides.empty() && !config.compat)
+        return true;
+
+    config.name = name ? std::move(*name) : std::string(location);
+    batchConfigs.emplace_back(std::move(config));
+    return true;
+}
+
 void Driver::addLibraryFiles(std::string_view pattern) {
     // Parse the pattern; there's an optional leading library name
     // followed by an equals sign. If not there, we use the default
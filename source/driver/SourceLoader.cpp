@@ -13,6 +13,7 @@
 #include "slang/syntax/AllSyntax.h"
 #include "slang/syntax/SyntaxTree.h"
 #include "slang/text/SourceManager.h"
+#include "slang/util/CancellationToken.h"
 #include "slang/util/String.h"
 #include "slang/util/ThreadPool.h"
 
@@ -37,6 +38,14 @@ void SourceLoader::addFiles(std::string_view pattern) {
                      /* expandEnvVars */ false);
 }
 
+std::vector<fs::path> SourceLoader::getFilePaths() const {
+    std::vector<fs::path> results;
+    results.reserve(fileEntries.size());
+    for (auto& entry : fileEntries)
+        results.push_back(entry.path);
+    return results;
+}
+
 void SourceLoader::addLibraryFiles(std::string_view libName, std::string_view pattern) {
     addFilesInternal(pattern, {}, /* isLibraryFile */ true, getOrAddLibrary(libName),
                      /* unit */ nullptr,
@@ -181,6 +190,19 @@ SourceLoader::SyntaxTreeList SourceLoader::loadAndParseSources(const Bag& option
 
     auto srcOptions = optionBag.getOrDefault<SourceOptions>();
 
+    // Parsing is checked against its budget before starting on each file. Memory
+    // is measured as the total size of the syntax trees parsed so far.
+    CancellationToken cancellation;
+    cancellation.start(std::chrono::milliseconds(srcOptions.maxParseTime),
+                       size_t(srcOptions.maxParseMemory));
+
+    std::atomic<size_t> parsedBytes = 0;
+    auto isCancelled = [&] { return cancellation.check(parsedBytes.load()); };
+    auto noteParsed = [&](const LoadResult& result) {
+        if (result.index() == 0)
+            parsedBytes += std::get<0>(result)->allocator().getBytesAllocated();
+    };
+
     auto handleLoadResult = [&](LoadResult&& result) {
         switch (result.index()) {
             case 0:
@@ -215,7 +237,7 @@ SourceLoader::SyntaxTreeList SourceLoader::loadAndParseSources(const Bag& option
 
     auto parseSingleUnit = [&](std::span<const SourceBuffer> buffers) {
         // If we waited to parse direct buffers due to wanting a single unit, parse that unit now.
-        if (!buffers.empty()) {
+        if (!buffers.empty() && !isCancelled()) {
             auto tree = SyntaxTree::fromBuffers(buffers, sourceManager, optionBag);
             if (srcOptions.onlyLint)
                 tree->isLibraryUnit = true;
@@ -249,8 +271,10 @@ SourceLoader::SyntaxTreeList SourceLoader::loadAndParseSources(const Bag& option
         // Load all source files that were specified on the command line
         // or via library maps.
         threadPool.pushLoop(size_t(0), fileEntries.size(), [&](size_t start, size_t end) {
-            for (size_t i = start; i < end; i++)
+            for (size_t i = start; i < end && !isCancelled(); i++) {
                 loadResults[i] = loadAndParse(fileEntries[i], optionBag, srcOptions, i);
+                noteParsed(loadResults[i]);
+            }
         });
         threadPool.waitForAll();
 
@@ -270,9 +294,10 @@ SourceLoader::SyntaxTreeList SourceLoader::loadAndParseSources(const Bag& option
             syntaxTrees.resize(numTrees + unitList.size());
 
             threadPool.pushLoop(size_t(0), unitList.size(), [&](size_t start, size_t end) {
-                for (size_t i = start; i < end; i++) {
+                for (size_t i = start; i < end && !isCancelled(); i++) {
                     syntaxTrees[i + numTrees] = parseSeparateUnit(*unitList[i]->first,
                                                                   unitList[i]->second);
+                    parsedBytes += syntaxTrees[i + numTrees]->allocator().getBytesAllocated();
                 }
             });
             threadPool.waitForAll();
@@ -285,11 +310,12 @@ SourceLoader::SyntaxTreeList SourceLoader::loadAndParseSources(const Bag& option
 
             threadPool.pushLoop(size_t(0), deferredLibBuffers.size(),
                                 [&](size_t start, size_t end) {
-                                    for (size_t i = start; i < end; i++) {
+                                    for (size_t i = start; i < end && !isCancelled(); i++) {
                                         auto tree = SyntaxTree::fromBuffer(deferredLibBuffers[i],
                                                                            sourceManager, optionBag,
                                                                            inheritedMacros);
                                         tree->isLibraryUnit = true;
+                                        parsedBytes += tree->allocator().getBytesAllocated();
                                         syntaxTrees[i + numTrees] = std::move(tree);
                                     }
                                 });
@@ -299,29 +325,44 @@ SourceLoader::SyntaxTreeList SourceLoader::loadAndParseSources(const Bag& option
     else {
         // Load all source files that were specified on the command line
         // or via library maps.
-        for (auto& entry : fileEntries)
-            handleLoadResult(loadAndParse(entry, optionBag, srcOptions));
+        for (auto& entry : fileEntries) {
+            if (isCancelled())
+                break;
+
+            auto result = loadAndParse(entry, optionBag, srcOptions);
+            noteParsed(result);
+            handleLoadResult(std::move(result));
+        }
 
         parseSingleUnit(singleUnitBuffers);
 
         // Parse separate unit groups into their own syntax trees.
         if (!unitToBufferMap.empty()) {
-            for (auto& [unit, buffers] : unitToBufferMap)
-                syntaxTrees.emplace_back(parseSeparateUnit(*unit, buffers));
+            for (auto& [unit, buffers] : unitToBufferMap) {
+                if (isCancelled())
+                    break;
+
+                auto& tree = syntaxTrees.emplace_back(parseSeparateUnit(*unit, buffers));
+                parsedBytes += tree->allocator().getBytesAllocated();
+            }
         }
 
         // If we deferred libraries due to wanting to inherit macros, parse them now.
         if (!deferredLibBuffers.empty()) {
             for (auto& buffer : deferredLibBuffers) {
+                if (isCancelled())
+                    break;
+
                 auto tree = SyntaxTree::fromBuffer(buffer, sourceManager, optionBag,
                                                    inheritedMacros);
                 tree->isLibraryUnit = true;
+                parsedBytes += tree->allocator().getBytesAllocated();
                 syntaxTrees.emplace_back(std::move(tree));
             }
         }
     }
 
-    if (!searchDirectories.empty()) {
+    if (!searchDirectories.empty() && !isCancelled()) {
         // If library directories are specified, see if we have any unknown instantiations
         // or package names for which we should search for additional source files to load.
         flat_hash_set<std::string_view> knownNames;
@@ -381,6 +422,9 @@ SourceLoader::SyntaxTreeList SourceLoader::loadAndParseSources(const Bag& option
         flat_hash_set<std::string_view> nextMissingNames;
         while (true) {
             for (auto name : missingNames) {
+                if (isCancelled())
+                    break;
+
                 SourceBuffer buffer;
                 for (auto& dir : searchDirectories) {
                     fs::path path(dir);
@@ -407,6 +451,7 @@ SourceLoader::SyntaxTreeList SourceLoader::loadAndParseSources(const Bag& option
                     auto tree = SyntaxTree::fromBuffer(buffer, sourceManager, optionBag,
                                                        inheritedMacros);
                     tree->isLibraryUnit = true;
+                    parsedBytes += tree->allocator().getBytesAllocated();
                     syntaxTrees.emplace_back(tree);
 
                     addKnownNames(tree);
@@ -422,6 +467,14 @@ SourceLoader::SyntaxTreeList SourceLoader::loadAndParseSources(const Bag& option
         }
     }
 
+    cancelled = cancellation.isCancelled();
+    if (cancelled) {
+        // Files that were skipped in parallel have no tree to return.
+        std::erase(syntaxTrees, nullptr);
+        errors.emplace_back(fmt::format("loading and parsing sources was cancelled: {}",
+                                        cancellation.getReasonString()));
+    }
+
     return syntaxTrees;
 }
 
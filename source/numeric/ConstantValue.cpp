@@ -8,10 +8,12 @@
 #include "slang/numeric/ConstantValue.h"
 
 #include <ostream>
+#include <stdexcept>
 
 #include "slang/numeric/MathUtils.h"
 #include "slang/text/FormatBuffer.h"
 #include "slang/util/Hash.h"
+#include "slang/util/SmallVector.h"
 
 namespace slang {
 
@@ -37,16 +39,16 @@ std::string ConstantValue::toString(bitwidth_t abbreviateThresholdBits, bool exa
                 return "null"s;
             else if constexpr (std::is_same_v<T, ConstantValue::UnboundedPlaceholder>)
                 return "$"s;
-            else if constexpr (std::is_same_v<T, Elements>) {
+            else if constexpr (std::is_same_v<T, Unpacked>) {
                 FormatBuffer buffer;
                 buffer.append(useAssignmentPatterns ? "'{"sv : "["sv);
-                for (auto& element : arg) {
+                for (auto& element : *arg) {
                     buffer.append(element.toString(abbreviateThresholdBits, exactUnknowns,
                                                    useAssignmentPatterns));
                     buffer.append(",");
                 }
 
-                if (!arg.empty())
+                if (!arg->empty())
                     buffer.pop_back();
                 buffer.append(useAssignmentPatterns ? "}"sv : "]"sv);
                 return buffer.str();
@@ -95,6 +97,19 @@ std::string ConstantValue::toString(bitwidth_t abbreviateThresholdBits, bool exa
                                    arg->value.toString(abbreviateThresholdBits, exactUnknowns,
                                                        useAssignmentPatterns));
             }
+            else if constexpr (std::is_same_v<T, Dense>) {
+                FormatBuffer buffer;
+                buffer.append(useAssignmentPatterns ? "'{"sv : "["sv);
+                for (size_t i = 0; i < arg->size(); i++) {
+                    buffer.append(arg->get(i).toString(abbreviateThresholdBits, exactUnknowns));
+                    buffer.append(",");
+                }
+
+                if (arg->size())
+                    buffer.pop_back();
+                buffer.append(useAssignmentPatterns ? "}"sv : "]"sv);
+                return buffer.str();
+            }
             else {
                 static_assert(always_false<T>::value, "Missing case");
             }
@@ -103,7 +118,8 @@ std::string ConstantValue::toString(bitwidth_t abbreviateThresholdBits, bool exa
 }
 
 size_t ConstantValue::hash() const {
-    size_t h = value.index();
+    // Dense arrays hash the same as the equivalent array with a value per element.
+    size_t h = isDense() ? Variant(std::in_place_type<Unpacked>).index() : value.index();
     std::visit(
         [&h](auto&& arg) noexcept {
             using T = std::decay_t<decltype(arg)>;
@@ -119,8 +135,8 @@ size_t ConstantValue::hash() const {
                 hash_combine(h, 0);
             else if constexpr (std::is_same_v<T, ConstantValue::UnboundedPlaceholder>)
                 hash_combine(h, '$');
-            else if constexpr (std::is_same_v<T, Elements>) {
-                for (auto& element : arg)
+            else if constexpr (std::is_same_v<T, Unpacked>) {
+                for (auto& element : *arg)
                     hash_combine(h, element.hash());
             }
             else if constexpr (std::is_same_v<T, std::string>)
@@ -143,6 +159,10 @@ size_t ConstantValue::hash() const {
                     hash_combine(h, arg->value.hash());
                 }
             }
+            else if constexpr (std::is_same_v<T, Dense>) {
+                for (size_t i = 0; i < arg->size(); i++)
+                    hash_combine(h, ConstantValue(arg->get(i)).hash());
+            }
             else {
                 static_assert(always_false<T>::value, "Missing case");
             }
@@ -151,6 +171,19 @@ size_t ConstantValue::hash() const {
     return h;
 }
 
+void ConstantValue::allowSharing() {
+    std::visit(
+        [](auto&& arg) {
+            using T = std::decay_t<decltype(arg)>;
+            if constexpr (std::is_same_v<T, Unpacked> || std::is_same_v<T, Map> ||
+                          std::is_same_v<T, Queue> || std::is_same_v<T, Union> ||
+                          std::is_same_v<T, Dense>) {
+                arg.allowSharing();
+            }
+        },
+        value);
+}
+
 bool ConstantValue::empty() const {
     return size() == 0;
 }
@@ -159,12 +192,14 @@ size_t ConstantValue::size() const {
     return std::visit(
         [](auto&& arg) noexcept {
             using T = std::decay_t<decltype(arg)>;
-            if constexpr (std::is_same_v<T, Elements>)
-                return arg.size();
+            if constexpr (std::is_same_v<T, Unpacked>)
+                return arg->size();
             else if constexpr (std::is_same_v<T, Map>)
                 return arg->size();
             else if constexpr (std::is_same_v<T, Queue>)
                 return arg->size();
+            else if constexpr (std::is_same_v<T, Dense>)
+                return arg->size();
             else if constexpr (std::is_same_v<T, std::string>)
                 return arg.size();
             else
@@ -174,11 +209,12 @@ size_t ConstantValue::size() const {
 }
 
 ConstantValue& ConstantValue::at(size_t index) {
+    expandDense();
     return std::visit(
         [index](auto&& arg) -> ConstantValue& {
             using T = std::decay_t<decltype(arg)>;
-            if constexpr (std::is_same_v<T, Elements>)
-                return arg.at(index);
+            if constexpr (std::is_same_v<T, Unpacked>)
+                return arg->at(index);
             else if constexpr (std::is_same_v<T, Queue>)
                 return arg->at(index);
             else
@@ -188,11 +224,13 @@ ConstantValue& ConstantValue::at(size_t index) {
 }
 
 const ConstantValue& ConstantValue::at(size_t index) const {
+    // Dense arrays have no element values to refer to; see getElement.
+    SLANG_ASSERT(!isDense());
     return std::visit(
         [index](auto&& arg) -> const ConstantValue& {
             using T = std::decay_t<decltype(arg)>;
-            if constexpr (std::is_same_v<T, Elements>)
-                return arg.at(index);
+            if constexpr (std::is_same_v<T, Unpacked>)
+                return arg->at(index);
             else if constexpr (std::is_same_v<T, Queue>)
                 return arg->at(index);
             else
@@ -201,11 +239,73 @@ const ConstantValue& ConstantValue::at(size_t index) const {
         value);
 }
 
+ConstantValue ConstantValue::getElement(size_t index) const& {
+    if (auto dense = std::get_if<Dense>(&value))
+        return (*dense)->get(index);
+
+    return at(index);
+}
+
+ConstantValue ConstantValue::getElement(size_t index) && {
+    return std::visit(
+        [index](auto&& arg) -> ConstantValue {
+            using T = std::decay_t<decltype(arg)>;
+            if constexpr (std::is_same_v<T, Dense>) {
+                return std::as_const(arg)->get(index);
+            }
+            else if constexpr (std::is_same_v<T, Unpacked> || std::is_same_v<T, Queue>) {
+                // Only move the element out if no other value shares the storage.
+                if (arg.isShared())
+                    return std::as_const(arg)->at(index);
+                return std::move(arg->at(index));
+            }
+            else {
+                SLANG_UNREACHABLE;
+            }
+        },
+        value);
+}
+
+void ConstantValue::expandDense() {
+    if (auto dense = std::get_if<Dense>(&value)) {
+        auto elems = std::as_const(*dense)->expand();
+        value = Unpacked(std::move(elems));
+    }
+}
+
+ConstantValue ConstantValue::createArray(Elements&& elements) {
+    if (DenseArray::canStore(elements))
+        return DenseArray(elements);
+
+    return std::move(elements);
+}
+
+ConstantValue ConstantValue::createArray(size_t count, const ConstantValue& element) {
+    if (element.isInteger() && DenseArray::canStore(count, element.integer().getBitWidth()))
+        return DenseArray(count, element.integer());
+
+    return Elements(count, element);
+}
+
 ConstantValue ConstantValue::getSlice(int32_t upper, int32_t lower,
                                       const ConstantValue& defaultValue) const {
     if (isInteger())
         return integer().slice(upper, lower);
 
+    if (isDense()) {
+        auto& arr = *dense();
+        std::vector<ConstantValue> result;
+        result.reserve(size_t(upper - lower + 1));
+        for (int32_t i = lower; i <= upper; i++) {
+            if (i < 0 || size_t(i) >= arr.size())
+                result.push_back(defaultValue);
+            else
+                result.push_back(arr.get(size_t(i)));
+        }
+
+        return createArray(std::move(result));
+    }
+
     if (isUnpacked()) {
         std::span<const ConstantValue> elems = elements();
         std::vector<ConstantValue> result{size_t(upper - lower + 1)};
@@ -286,8 +386,8 @@ bool ConstantValue::hasUnknown() const {
             if constexpr (std::is_same_v<T, SVInt>) {
                 return arg.hasUnknown();
             }
-            else if constexpr (std::is_same_v<T, Elements>) {
-                for (auto& element : arg) {
+            else if constexpr (std::is_same_v<T, Unpacked>) {
+                for (auto& element : *arg) {
                     if (element.hasUnknown())
                         return true;
                 }
@@ -307,6 +407,9 @@ bool ConstantValue::hasUnknown() const {
                 }
                 return false;
             }
+            else if constexpr (std::is_same_v<T, Dense>) {
+                return arg->hasUnknown();
+            }
             else {
                 return false;
             }
@@ -490,7 +593,11 @@ uint64_t ConstantValue::getBitstreamWidth() const {
         return str().length() * CHAR_BIT;
 
     uint64_t width = 0;
-    if (isUnpacked()) {
+    if (isDense()) {
+        auto& arr = *dense();
+        width = arr.size() * arr.getElementWidth();
+    }
+    else if (isUnpacked()) {
         for (const auto& cv : elements())
             width += cv.getBitstreamWidth();
     }
@@ -513,6 +620,28 @@ std::ostream& operator<<(std::ostream& os, const ConstantValue& cv) {
     return os << cv.toString();
 }
 
+// Compares unpacked arrays element by element, for when one of them is stored densely.
+static bool elementsEqual(const ConstantValue& lhs, const ConstantValue& rhs) {
+    if (lhs.size() != rhs.size())
+        return false;
+
+    for (size_t i = 0; i < lhs.size(); i++) {
+        if (!(lhs.getElement(i) == rhs.getElement(i)))
+            return false;
+    }
+    return true;
+}
+
+static std::partial_ordering compareElements(const ConstantValue& lhs, const ConstantValue& rhs) {
+    size_t count = std::min(lhs.size(), rhs.size());
+    for (size_t i = 0; i < count; i++) {
+        auto result = lhs.getElement(i) <=> rhs.getElement(i);
+        if (result != 0)
+            return result;
+    }
+    return lhs.size() <=> rhs.size();
+}
+
 bool operator==(const ConstantValue& lhs, const ConstantValue& rhs) {
     return std::visit(
         [&](auto&& arg) {
@@ -529,11 +658,14 @@ bool operator==(const ConstantValue& lhs, const ConstantValue& rhs) {
                 return rhs.isNullHandle();
             else if constexpr (std::is_same_v<T, ConstantValue::UnboundedPlaceholder>)
                 return rhs.isUnbounded();
-            else if constexpr (std::is_same_v<T, ConstantValue::Elements>) {
+            else if constexpr (std::is_same_v<T, ConstantValue::Unpacked>) {
                 if (!rhs.isUnpacked())
                     return false;
 
-                return arg == std::get<ConstantValue::Elements>(rhs.value);
+                if (rhs.isDense())
+                    return elementsEqual(lhs, rhs);
+
+                return *arg == *std::get<ConstantValue::Unpacked>(rhs.value);
             }
             else if constexpr (std::is_same_v<T, std::string>)
                 return rhs.isString() && arg == rhs.str();
@@ -556,6 +688,15 @@ bool operator==(const ConstantValue& lhs, const ConstantValue& rhs) {
                 auto& ru = rhs.unionVal();
                 return arg->activeMember == ru->activeMember && arg->value == ru->value;
             }
+            else if constexpr (std::is_same_v<T, ConstantValue::Dense>) {
+                if (!rhs.isUnpacked())
+                    return false;
+
+                if (rhs.isDense())
+                    return *arg == *rhs.dense();
+
+                return elementsEqual(lhs, rhs);
+            }
             else {
                 static_assert(always_false<T>::value, "Missing case");
             }
@@ -590,11 +731,14 @@ std::partial_ordering operator<=>(const ConstantValue& lhs, const ConstantValue&
                 return unordered;
             else if constexpr (std::is_same_v<T, ConstantValue::UnboundedPlaceholder>)
                 return unordered;
-            else if constexpr (std::is_same_v<T, ConstantValue::Elements>) {
+            else if constexpr (std::is_same_v<T, ConstantValue::Unpacked>) {
                 if (!rhs.isUnpacked())
                     return unordered;
 
-                return arg <=> std::get<ConstantValue::Elements>(rhs.value);
+                if (rhs.isDense())
+                    return compareElements(lhs, rhs);
+
+                return *arg <=> *std::get<ConstantValue::Unpacked>(rhs.value);
             }
             else if constexpr (std::is_same_v<T, std::string>) {
                 if (!rhs.isString())
@@ -620,6 +764,12 @@ std::partial_ordering operator<=>(const ConstantValue& lhs, const ConstantValue&
 
                 return *arg <=> *rhs.unionVal();
             }
+            else if constexpr (std::is_same_v<T, ConstantValue::Dense>) {
+                if (!rhs.isUnpacked())
+                    return unordered;
+
+                return compareElements(lhs, rhs);
+            }
             else {
                 static_assert(always_false<T>::value, "Missing case");
             }
@@ -627,6 +777,445 @@ std::partial_ordering operator<=>(const ConstantValue& lhs, const ConstantValue&
         lhs.value);
 }
 
+AssociativeArray::AssociativeArray(const AssociativeArray& other) :
+    defaultValue(other.defaultValue), table(other.table) {
+}
+
+AssociativeArray::AssociativeArray(AssociativeArray&& other) noexcept :
+    defaultValue(std::move(other.defaultValue)), table(std::move(other.table)),
+    sorted(std::move(other.sorted)), sortedValid(other.sortedValid.exchange(false)) {
+    // Moving the table hands over its storage, so the sorted view stays valid.
+}
+
+AssociativeArray::~AssociativeArray() = default;
+
+AssociativeArray& AssociativeArray::operator=(const AssociativeArray& other) {
+    if (this != &other) {
+        defaultValue = other.defaultValue;
+        table = other.table;
+        sorted.clear();
+        sortedValid = false;
+    }
+    return *this;
+}
+
+AssociativeArray& AssociativeArray::operator=(AssociativeArray&& other) noexcept {
+    if (this != &other) {
+        defaultValue = std::move(other.defaultValue);
+        table = std::move(other.table);
+        sorted = std::move(other.sorted);
+        sortedValid = other.sortedValid.exchange(false);
+    }
+    return *this;
+}
+
+ConstantValue* AssociativeArray::find(const ConstantValue& key) {
+    auto it = table.find(key);
+    return it == table.end() ? nullptr : &it->second;
+}
+
+const ConstantValue* AssociativeArray::find(const ConstantValue& key) const {
+    auto it = table.find(key);
+    return it == table.end() ? nullptr : &it->second;
+}
+
+std::pair<ConstantValue*, bool> AssociativeArray::try_emplace(ConstantValue key,
+                                                              ConstantValue value) {
+    auto buckets = table.bucket_count();
+    auto [it, inserted] = table.try_emplace(std::move(key), std::move(value));
+    if (inserted && sortedValid) {
+        if (table.bucket_count() != buckets) {
+            // The table was rehashed, which moves every entry.
+            sortedValid = false;
+        }
+        else {
+            auto entry = &*it;
+            auto pos = std::upper_bound(sorted.begin(), sorted.end(), entry->first,
+                                        [](const ConstantValue& key, const value_type* e) {
+                                            return key < e->first;
+                                        });
+            sorted.insert(pos, entry);
+        }
+    }
+    return {&it->second, inserted};
+}
+
+bool AssociativeArray::erase(const ConstantValue& key) {
+    auto it = table.find(key);
+    if (it == table.end())
+        return false;
+
+    // Erasing doesn't move any of the other entries.
+    if (sortedValid)
+        sorted.erase(std::ranges::find(sorted, &*it));
+
+    table.erase(it);
+    return true;
+}
+
+void AssociativeArray::clear() {
+    table.clear();
+    sorted.clear();
+    sortedValid = true;
+}
+
+AssociativeArray::const_iterator AssociativeArray::lower_bound(const ConstantValue& key) const {
+    auto first = getSorted();
+    return std::lower_bound(first, first + table.size(), key,
+                            [](const value_type* e, const ConstantValue& key) {
+                                return e->first < key;
+                            });
+}
+
+AssociativeArray::const_iterator AssociativeArray::upper_bound(const ConstantValue& key) const {
+    auto first = getSorted();
+    return std::upper_bound(first, first + table.size(), key,
+                            [](const ConstantValue& key, const value_type* e) {
+                                return key < e->first;
+                            });
+}
+
+AssociativeArray::value_type* const* AssociativeArray::getSorted() const {
+    if (!sortedValid.load(std::memory_order_acquire)) {
+        std::unique_lock lock(sortedMutex);
+        if (!sortedValid.load(std::memory_order_relaxed)) {
+            sorted.clear();
+            sorted.reserve(table.size());
+            for (auto& entry : const_cast<Table&>(table))
+                sorted.push_back(&entry);
+
+            std::ranges::sort(sorted, [](const value_type* l, const value_type* r) {
+                return l->first < r->first;
+            });
+            sortedValid.store(true, std::memory_order_release);
+        }
+    }
+    return sorted.data();
+}
+
+size_t AssociativeArray::KeyHash::operator()(const ConstantValue& key) const {
+    if (!key.isInteger())
+        return key.hash();
+
+    // Skip leading zero words so that the hash doesn't depend on the width.
+    // Keys with unknown bits can't be looked up anyway so they all share a hash.
+    auto& value = key.integer();
+    if (value.hasUnknown())
+        return 0;
+
+    size_t words = (value.getActiveBits() + 63) / 64;
+    return detail::hashing::hash(value.getRawPtr(), words * sizeof(uint64_t));
+}
+
+bool AssociativeArray::KeyEqual::operator()(const ConstantValue& lhs,
+                                            const ConstantValue& rhs) const {
+    if (!lhs.isInteger() || !rhs.isInteger())
+        return lhs == rhs;
+
+    auto& l = lhs.integer();
+    auto& r = rhs.integer();
+    if (l.getBitWidth() == r.getBitWidth())
+        return exactlyEqual(l, r);
+
+    // Only wildcard index types allow keys of different widths,
+    // and the LRM says to treat those as unsigned.
+    auto width = std::max(l.getBitWidth(), r.getBitWidth());
+    return exactlyEqual(l.zext(width), r.zext(width));
+}
+
+bool operator==(const AssociativeArray& lhs, const AssociativeArray& rhs) {
+    if (lhs.size() != rhs.size())
+        return false;
+
+    for (auto& [key, value] : lhs.table) {
+        auto it = rhs.table.find(key);
+        if (it == rhs.table.end() || it->second != value)
+            return false;
+    }
+    return true;
+}
+
+std::partial_ordering operator<=>(const AssociativeArray& lhs, const AssociativeArray& rhs) {
+    return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(), rhs.begin(),
+                                                  rhs.end());
+}
+
+void SVQueue::push_back(ConstantValue value) {
+    if (count == storage.size())
+        grow(count + 1);
+
+    slot(count++) = std::move(value);
+}
+
+void SVQueue::push_front(ConstantValue value) {
+    if (count == storage.size())
+        grow(count + 1);
+
+    head = (head - 1) & (storage.size() - 1);
+    slot(0) = std::move(value);
+    count++;
+}
+
+ConstantValue& SVQueue::emplace_back(ConstantValue value) {
+    push_back(std::move(value));
+    return back();
+}
+
+void SVQueue::pop_back() {
+    SLANG_ASSERT(count);
+    slot(--count) = ConstantValue();
+}
+
+void SVQueue::pop_front() {
+    SLANG_ASSERT(count);
+    slot(0) = ConstantValue();
+    head = (head + 1) & (storage.size() - 1);
+    count--;
+}
+
+SVQueue::iterator SVQueue::insert(const_iterator pos, ConstantValue value) {
+    auto index = ptrdiff_t(pos.index);
+    SLANG_ASSERT(pos.index <= count);
+
+    if (pos.index < count / 2) {
+        push_front(std::move(value));
+        std::rotate(begin(), begin() + 1, begin() + index + 1);
+    }
+    else {
+        push_back(std::move(value));
+        std::rotate(begin() + index, end() - 1, end());
+    }
+    return {*this, pos.index};
+}
+
+SVQueue::iterator SVQueue::erase(const_iterator pos) {
+    auto index = ptrdiff_t(pos.index);
+    SLANG_ASSERT(pos.index < count);
+
+    if (pos.index < count / 2) {
+        std::move_backward(begin(), begin() + index, begin() + index + 1);
+        pop_front();
+    }
+    else {
+        std::move(begin() + index + 1, end(), begin() + index);
+        pop_back();
+    }
+    return {*this, pos.index};
+}
+
+void SVQueue::resize(size_t newSize) {
+    if (newSize > storage.size())
+        grow(newSize);
+
+    for (size_t i = newSize; i < count; i++)
+        slot(i) = ConstantValue();
+    count = newSize;
+}
+
+void SVQueue::reserve(size_t capacity) {
+    if (capacity > storage.size())
+        grow(capacity);
+}
+
+void SVQueue::clear() {
+    storage.clear();
+    head = 0;
+    count = 0;
+}
+
+void SVQueue::checkIndex(size_t index) const {
+    if (index >= count)
+        SLANG_THROW(std::out_of_range("SVQueue index out of range"));
+}
+
+void SVQueue::grow(size_t capacity) {
+    std::vector<ConstantValue> newStorage(std::bit_ceil(std::max<size_t>(capacity, 8)));
+    for (size_t i = 0; i < count; i++)
+        newStorage[i] = std::move(slot(i));
+
+    storage = std::move(newStorage);
+    head = 0;
+}
+
+bool operator==(const SVQueue& lhs, const SVQueue& rhs) {
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+std::partial_ordering operator<=>(const SVQueue& lhs, const SVQueue& rhs) {
+    return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(), rhs.begin(),
+                                                  rhs.end());
+}
+
+// Reads up to 64 bits starting at the given bit offset.
+static uint64_t readBits(const uint64_t* src, size_t offset, bitwidth_t count) {
+    size_t word = offset / 64;
+    bitwidth_t bit = bitwidth_t(offset % 64);
+    uint64_t result = src[word] >> bit;
+    if (bit + count > 64)
+        result |= src[word + 1] << (64 - bit);
+
+    return count == 64 ? result : result & ((1ull << count) - 1);
+}
+
+// Writes up to 64 bits starting at the given bit offset.
+static void writeBits(uint64_t* dest, size_t offset, bitwidth_t count, uint64_t value) {
+    size_t word = offset / 64;
+    bitwidth_t bit = bitwidth_t(offset % 64);
+    uint64_t mask = count == 64 ? UINT64_MAX : (1ull << count) - 1;
+    value &= mask;
+
+    dest[word] = (dest[word] & ~(mask << bit)) | (value << bit);
+    if (bit + count > 64) {
+        uint64_t highMask = mask >> (64 - bit);
+        dest[word + 1] = (dest[word + 1] & ~highMask) | (value >> (64 - bit));
+    }
+}
+
+DenseArray::DenseArray(size_t count, bitwidth_t elementWidth, bool isSigned) :
+    count(count), elementWidth(elementWidth), signFlag(isSigned) {
+    SLANG_ASSERT(count * elementWidth <= SVInt::MAX_BITS);
+    words.resize(planeWords());
+}
+
+DenseArray::DenseArray(size_t count, const SVInt& element) :
+    DenseArray(count, element.getBitWidth(), element.isSigned()) {
+    for (size_t i = 0; i < count; i++)
+        set(i, element);
+}
+
+DenseArray::DenseArray(std::span<const ConstantValue> elements) :
+    DenseArray(elements.size(), elements.front().integer().getBitWidth(),
+               elements.front().integer().isSigned()) {
+    for (size_t i = 0; i < count; i++)
+        set(i, elements[i].integer());
+}
+
+DenseArray DenseArray::fromPacked(size_t count, const SVInt& packed, bool isSigned) {
+    SLANG_ASSERT(count && packed.getBitWidth() % count == 0);
+    DenseArray result(count, bitwidth_t(packed.getBitWidth() / count), isSigned);
+    result.setBits(0, packed);
+    return result;
+}
+
+bool DenseArray::canStore(size_t count, bitwidth_t elementWidth) {
+    return count >= MinElements && count * elementWidth <= SVInt::MAX_BITS;
+}
+
+bool DenseArray::canStore(std::span<const ConstantValue> elements) {
+    if (elements.empty() || !elements.front().isInteger())
+        return false;
+
+    auto& first = elements.front().integer();
+    if (!canStore(elements.size(), first.getBitWidth()))
+        return false;
+
+    for (auto& elem : elements) {
+        if (!elem.isInteger() || elem.integer().getBitWidth() != first.getBitWidth() ||
+            elem.integer().isSigned() != first.isSigned()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DenseArray::hasUnknown() const {
+    if (!unknownFlag)
+        return false;
+
+    return std::any_of(words.begin() + ptrdiff_t(planeWords()), words.end(),
+                       [](uint64_t word) { return word != 0; });
+}
+
+SVInt DenseArray::get(size_t index) const {
+    return extract(getElementOffset(index), elementWidth, signFlag);
+}
+
+void DenseArray::setBits(size_t offset, const SVInt& value) {
+    bitwidth_t width = value.getBitWidth();
+    SLANG_ASSERT(offset + width <= count * elementWidth);
+
+    if (value.hasUnknown() && !unknownFlag) {
+        words.resize(planeWords() * 2);
+        unknownFlag = true;
+    }
+
+    auto src = value.getRawPtr();
+    auto unknownSrc = src + (width + 63) / 64;
+    auto unknownDest = words.data() + planeWords();
+    for (bitwidth_t i = 0; i < width; i += 64) {
+        bitwidth_t chunk = std::min(width - i, 64u);
+        writeBits(words.data(), offset + i, chunk, src[i / 64]);
+        if (unknownFlag)
+            writeBits(unknownDest, offset + i, chunk, value.hasUnknown() ? unknownSrc[i / 64] : 0);
+    }
+}
+
+SVInt DenseArray::extract(size_t offset, bitwidth_t width, bool isSigned) const {
+    if (width <= 64 && !unknownFlag)
+        return SVInt(width, readBits(words.data(), offset, width), isSigned);
+
+    // Gather both planes into a buffer laid out like the storage of an SVInt.
+    uint32_t numWords = (width + 63) / 64;
+    SmallVector<uint64_t, 8> buffer;
+    buffer.resize(numWords * 2);
+
+    bool anyUnknown = false;
+    auto unknownSrc = words.data() + planeWords();
+    for (bitwidth_t i = 0; i < width; i += 64) {
+        bitwidth_t chunk = std::min(width - i, 64u);
+        buffer[i / 64] = readBits(words.data(), offset + i, chunk);
+        if (unknownFlag) {
+            buffer[numWords + i / 64] = readBits(unknownSrc, offset + i, chunk);
+            anyUnknown |= buffer[numWords + i / 64] != 0;
+        }
+    }
+
+    if (!anyUnknown && width <= 64)
+        return SVInt(width, buffer[0], isSigned);
+
+    return SVInt(SVIntStorage(buffer.data(), width, isSigned, anyUnknown));
+}
+
+SVInt DenseArray::getPacked() const {
+    return extract(0, bitwidth_t(count * elementWidth), false);
+}
+
+std::vector<ConstantValue> DenseArray::expand() const {
+    std::vector<ConstantValue> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; i++)
+        result.emplace_back(get(i));
+    return result;
+}
+
+bool DenseArray::operator==(const DenseArray& rhs) const {
+    if (count != rhs.count)
+        return false;
+
+    if (elementWidth != rhs.elementWidth) {
+        for (size_t i = 0; i < count; i++) {
+            if (!exactlyEqual(get(i), rhs.get(i)))
+                return false;
+        }
+        return true;
+    }
+
+    // With the same layout the storage can be compared directly; a missing
+    // plane of unknown bits is the same as one that's all zeros.
+    auto planeEqual = [](std::span<const uint64_t> lhs, std::span<const uint64_t> rhs) {
+        if (lhs.empty())
+            return std::ranges::all_of(rhs, [](uint64_t word) { return word == 0; });
+        if (rhs.empty())
+            return std::ranges::all_of(lhs, [](uint64_t word) { return word == 0; });
+        return std::ranges::equal(lhs, rhs);
+    };
+
+    std::span<const uint64_t> lw = words, rw = rhs.words;
+    size_t n = planeWords();
+    return std::ranges::equal(lw.first(n), rw.first(n)) &&
+           planeEqual(lw.subspan(n), rw.subspan(n));
+}
+
 ConstantRange ConstantRange::subrange(ConstantRange select) const {
     int32_t l = lower();
     ConstantRange result;
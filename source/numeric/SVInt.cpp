@@ -430,10 +430,10 @@ void SVInt::setAllZeros() {
 void SVInt::setAllOnes() {
     // we don't have unknown digits anymore, so reallocate if necessary
     if (unknownFlag) {
+        freeWords();
         unknownFlag = false;
-        delete[] pVal;
         if (getNumWords() > 1)
-            pVal = new uint64_t[getNumWords()];
+            pVal = allocWords(getNumWords());
     }
 
     if (isSingleWord())
@@ -451,11 +451,10 @@ void SVInt::setAllX() {
     if (unknownFlag)
         memset(pVal, 0, words * WORD_SIZE);
     else {
-        if (!isSingleWord())
-            delete[] pVal;
-
+        freeWords();
         unknownFlag = true;
-        pVal = new uint64_t[words * 2]();
+        pVal = allocWords(words * 2);
+        memset(pVal, 0, words * WORD_SIZE);
     }
 
     // now set upper half to ones (for unknown)
@@ -466,11 +465,9 @@ void SVInt::setAllX() {
 
 void SVInt::setAllZ() {
     if (!unknownFlag) {
-        if (!isSingleWord())
-            delete[] pVal;
-
+        freeWords();
         unknownFlag = true;
-        pVal = new uint64_t[getNumWords()];
+        pVal = allocWords(getNumWords());
     }
 
     // everything set to 1 (for Z in the low half and for unknown in the upper half)
@@ -919,10 +916,8 @@ logic_t SVInt::reductionAnd() const {
 
     if (unknownFlag) {
         uint32_t words = getNumWords(bitWidth, false);
-        for (uint32_t i = 0; i < words - 1; i++) {
-            if ((pVal[i] | pVal[i + words]) != UINT64_MAX)
-                return logic_t(false);
-        }
+        if (anyWords(pVal, pVal + words, words - 1, [](auto v, auto u) { return ~(v | u); }))
+            return logic_t(false);
         if ((pVal[words - 1] | pVal[words * 2 - 1]) != mask)
             return logic_t(false);
         return logic_t::x;
@@ -931,33 +926,25 @@ logic_t SVInt::reductionAnd() const {
     if (isSingleWord())
         return logic_t(val == mask);
     else {
-        for (uint32_t i = 0; i < getNumWords() - 1; i++) {
-            if (pVal[i] != UINT64_MAX)
-                return logic_t(false);
-        }
-        return logic_t(pVal[getNumWords() - 1] == mask);
+        uint32_t words = getNumWords();
+        if (anyWords(pVal, pVal, words - 1, [](auto v, auto) { return ~v; }))
+            return logic_t(false);
+        return logic_t(pVal[words - 1] == mask);
     }
 }
 
 logic_t SVInt::reductionOr() const {
     if (unknownFlag) {
         uint32_t words = getNumWords(bitWidth, false);
-        for (uint32_t i = 0; i < words; i++) {
-            if (pVal[i] & ~pVal[i + words])
-                return logic_t(true);
-        }
+        if (anyWords(pVal, pVal + words, words, [](auto v, auto u) { return v & ~u; }))
+            return logic_t(true);
         return logic_t::x;
     }
 
     if (isSingleWord())
         return logic_t(val != 0);
-    else {
-        for (uint32_t i = 0; i < getNumWords(); i++) {
-            if (pVal[i] != 0)
-                return logic_t(true);
-        }
-    }
-    return logic_t(false);
+
+    return logic_t(anyWords(pVal, pVal, getNumWords(), [](auto v, auto) { return v; }));
 }
 
 logic_t SVInt::reductionXor() const {
@@ -965,12 +952,10 @@ logic_t SVInt::reductionXor() const {
         return logic_t::x;
 
     // reduction xor basically determines whether the number of set
-    // bits in the number is even or odd
-    uint32_t count = countOnes();
-    if (count % 2 == 0)
-        return logic_t(0);
-
-    return logic_t(1);
+    // bits in the number is even or odd, which is unaffected by
+    // folding all of the words together first
+    uint64_t folded = isSingleWord() ? val : xorWords(pVal, getNumWords());
+    return logic_t(std::popcount(folded) % 2 != 0);
 }
 
 SVInt SVInt::operator-() const {
@@ -1093,14 +1078,12 @@ SVInt& SVInt::operator*=(const SVInt& rhs) {
             }
 
             // allocate result space and do the multiply
-            uint32_t destWords = lhsWords + rhsWords;
+            uint32_t destWords = getNumWords();
             TempBuffer<uint64_t, 128> dst(destWords);
-            mul(dst.get(), pVal, lhsWords, rhs.pVal, rhsWords);
+            mulLow(dst.get(), destWords, pVal, lhsWords, rhs.pVal, rhsWords);
 
             // copy the result back into *this
-            setAllZeros();
-            uint32_t wordsToCopy = destWords >= getNumWords() ? getNumWords() : destWords;
-            memcpy(pVal, dst.get(), wordsToCopy * WORD_SIZE);
+            memcpy(pVal, dst.get(), destWords * WORD_SIZE);
         }
         clearUnusedBits();
     }
@@ -1134,30 +1117,19 @@ SVInt& SVInt::operator&=(const SVInt& rhs) {
     else {
         uint32_t words = getNumWords(bitWidth, false);
         if (unknownFlag) {
-            if (rhs.isSingleWord()) {
-                pVal[1] &= rhs.val;
-                pVal[0] = ~pVal[1] & pVal[0] & rhs.val;
-            }
-            else {
-                if (rhs.hasUnknown()) {
-                    for (uint32_t i = 0; i < words; i++) {
-                        pVal[i + words] = (pVal[i + words] | rhs.pVal[i + words]) &
-                                          (pVal[i + words] | pVal[i]) &
-                                          (rhs.pVal[i + words] | rhs.pVal[i]);
-                    }
-                }
-                else {
-                    for (uint32_t i = 0; i < words; i++)
-                        pVal[i + words] &= rhs.pVal[i];
-                }
+            auto op = [](auto& v, auto& u, auto rv, auto ru) {
+                u = (u | ru) & (u | v) & (ru | rv);
+                v = ~u & v & rv;
+            };
 
-                for (uint32_t i = 0; i < words; i++)
-                    pVal[i] = ~pVal[i + words] & pVal[i] & rhs.pVal[i];
-            }
+            auto rp = rhs.getRawData();
+            if (rhs.hasUnknown())
+                bitwiseWords4State<true>(pVal, pVal + words, rp, rp + words, words, op);
+            else
+                bitwiseWords4State<false>(pVal, pVal + words, rp, nullptr, words, op);
         }
         else {
-            for (uint32_t i = 0; i < words; i++)
-                pVal[i] &= rhs.pVal[i];
+            bitwiseWords(pVal, pVal, rhs.pVal, words, [](auto a, auto b) { return a & b; });
         }
     }
     clearUnusedBits();
@@ -1182,29 +1154,19 @@ SVInt& SVInt::operator|=(const SVInt& rhs) {
     else {
         uint32_t words = getNumWords(bitWidth, false);
         if (unknownFlag) {
-            if (rhs.isSingleWord()) {
-                pVal[1] &= ~rhs.val;
-                pVal[0] = ~pVal[1] & (pVal[0] | rhs.val);
-            }
-            else {
-                if (rhs.hasUnknown()) {
-                    for (uint32_t i = 0; i < words; i++) {
-                        pVal[i + words] = (pVal[i + words] & (rhs.pVal[i + words] | ~rhs.pVal[i])) |
-                                          (~pVal[i] & rhs.pVal[i + words]);
-                    }
-                }
-                else {
-                    for (uint32_t i = 0; i < words; i++)
-                        pVal[i + words] &= ~rhs.pVal[i];
-                }
+            auto op = [](auto& v, auto& u, auto rv, auto ru) {
+                u = (u & (ru | ~rv)) | (~v & ru);
+                v = ~u & (v | rv);
+            };
 
-                for (uint32_t i = 0; i < words; i++)
-                    pVal[i] = ~pVal[i + words] & (pVal[i] | rhs.pVal[i]);
-            }
+            auto rp = rhs.getRawData();
+            if (rhs.hasUnknown())
+                bitwiseWords4State<true>(pVal, pVal + words, rp, rp + words, words, op);
+            else
+                bitwiseWords4State<false>(pVal, pVal + words, rp, nullptr, words, op);
         }
         else {
-            for (uint32_t i = 0; i < words; i++)
-                pVal[i] |= rhs.pVal[i];
+            bitwiseWords(pVal, pVal, rhs.pVal, words, [](auto a, auto b) { return a | b; });
         }
     }
     clearUnusedBits();
@@ -1229,21 +1191,19 @@ SVInt& SVInt::operator^=(const SVInt& rhs) {
     else {
         uint32_t words = getNumWords(bitWidth, false);
         if (unknownFlag) {
-            if (rhs.isSingleWord())
-                pVal[0] = ~pVal[1] & (pVal[0] ^ rhs.val);
-            else {
-                if (rhs.hasUnknown()) {
-                    for (uint32_t i = 0; i < words; i++)
-                        pVal[i + words] |= rhs.pVal[i + words];
-                }
+            auto op = [](auto& v, auto& u, auto rv, auto ru) {
+                u = u | ru;
+                v = ~u & (v ^ rv);
+            };
 
-                for (uint32_t i = 0; i < words; i++)
-                    pVal[i] = ~pVal[i + words] & (pVal[i] ^ rhs.pVal[i]);
-            }
+            auto rp = rhs.getRawData();
+            if (rhs.hasUnknown())
+                bitwiseWords4State<true>(pVal, pVal + words, rp, rp + words, words, op);
+            else
+                bitwiseWords4State<false>(pVal, pVal + words, rp, nullptr, words, op);
         }
         else {
-            for (uint32_t i = 0; i < words; i++)
-                pVal[i] ^= rhs.pVal[i];
+            bitwiseWords(pVal, pVal, rhs.pVal, words, [](auto a, auto b) { return a ^ b; });
         }
     }
     clearUnusedBits();
@@ -1267,22 +1227,21 @@ SVInt SVInt::xnor(const SVInt& rhs) const {
         result.val = ~(result.val ^ rhs.val);
     else {
         uint32_t words = getNumWords(bitWidth, false);
+        uint64_t* dst = result.pVal;
         if (result.hasUnknown()) {
-            if (rhs.isSingleWord())
-                result.pVal[0] = ~result.pVal[1] & ~(result.pVal[0] ^ rhs.val);
-            else {
-                if (rhs.hasUnknown()) {
-                    for (uint32_t i = 0; i < words; i++)
-                        result.pVal[i + words] |= rhs.pVal[i + words];
-                }
+            auto op = [](auto& v, auto& u, auto rv, auto ru) {
+                u = u | ru;
+                v = ~u & ~(v ^ rv);
+            };
 
-                for (uint32_t i = 0; i < words; i++)
-                    result.pVal[i] = ~result.pVal[i + words] & ~(result.pVal[i] ^ rhs.pVal[i]);
-            }
+            auto rp = rhs.getRawData();
+            if (rhs.hasUnknown())
+                bitwiseWords4State<true>(dst, dst + words, rp, rp + words, words, op);
+            else
+                bitwiseWords4State<false>(dst, dst + words, rp, nullptr, words, op);
         }
         else {
-            for (uint32_t i = 0; i < words; i++)
-                result.pVal[i] = ~(result.pVal[i] ^ rhs.pVal[i]);
+            bitwiseWords(dst, dst, rhs.pVal, words, [](auto a, auto b) { return ~(a ^ b); });
         }
     }
     result.clearUnusedBits();
@@ -1508,16 +1467,8 @@ void SVInt::set(int32_t msb, int32_t lsb, const SVInt& value) {
     uint32_t backOOB = bitwidth_t(msb) >= bitWidth ? bitwidth_t(msb - int32_t(bitWidth) + 1) : 0;
     uint32_t validSelectWidth = selectWidth - frontOOB - backOOB;
 
-    if (!hasUnknown() && value.hasUnknown()) {
-        uint64_t* newData = new uint64_t[getNumWords(bitWidth, true)]();
-        memcpy(newData, getRawData(), getNumWords());
-
-        if (!isSingleWord())
-            delete[] pVal;
-
-        unknownFlag = true;
-        pVal = newData;
-    }
+    if (!hasUnknown() && value.hasUnknown())
+        makeUnknown();
 
     bitcpy(getRawData(), (uint32_t)std::max(lsb, 0), value.getRawData(), validSelectWidth,
            frontOOB);
@@ -1774,33 +1725,46 @@ SVInt SVInt::concat(std::span<SVInt const> operands) {
     return result;
 }
 
+// Kept per thread so that counting doesn't require synchronization.
+static thread_local uint64_t heapAllocationCount = 0;
+
+uint64_t SVInt::getHeapAllocationCount() {
+    return heapAllocationCount;
+}
+
+uint64_t* SVInt::allocHeapWords(uint32_t numWords) {
+    heapAllocationCount++;
+    return new uint64_t[numWords];
+}
+
 SVInt SVInt::allocUninitialized(bitwidth_t bits, bool signFlag, bool unknownFlag) {
     SLANG_ASSERT(bits && (bits > 64 || unknownFlag));
-    return SVInt(new uint64_t[getNumWords(bits, unknownFlag)], bits, signFlag, unknownFlag);
+    SVInt result(nullptr, bits, signFlag, unknownFlag);
+    result.pVal = result.allocWords(result.getNumWords());
+    return result;
 }
 
 SVInt SVInt::allocZeroed(bitwidth_t bits, bool signFlag, bool unknownFlag) {
-    SLANG_ASSERT(bits && (bits > 64 || unknownFlag));
-    return SVInt(new uint64_t[getNumWords(bits, unknownFlag)](), bits, signFlag, unknownFlag);
+    SVInt result = allocUninitialized(bits, signFlag, unknownFlag);
+    memset(result.pVal, 0, result.getNumWords() * WORD_SIZE);
+    return result;
 }
 
 void SVInt::initSlowCase(logic_t bit) {
-    pVal = new uint64_t[getNumWords()](); // allocation is zero cleared
+    pVal = allocWords(getNumWords());
+    pVal[0] = exactlyEqual(bit, logic_t::z) ? 1 : 0;
     pVal[1] = 1;
-    if (exactlyEqual(bit, logic_t::z))
-        pVal[0] = 1;
 }
 
 void SVInt::initSlowCase(uint64_t value) {
     uint32_t words = getNumWords();
-    pVal = new uint64_t[words](); // allocation is zero cleared
+    pVal = allocWords(words);
     pVal[0] = value;
 
     // sign extend if necessary
-    if (signFlag && int64_t(value) < 0) {
-        for (uint32_t i = 1; i < words; i++)
-            pVal[i] = (uint64_t)(-1);
-    }
+    uint64_t fill = signFlag && int64_t(value) < 0 ? UINT64_MAX : 0;
+    for (uint32_t i = 1; i < words; i++)
+        pVal[i] = fill;
 }
 
 void SVInt::initSlowCase(std::span<const byte> bytes) {
@@ -1810,7 +1774,8 @@ void SVInt::initSlowCase(std::span<const byte> bytes) {
     }
     else {
         uint32_t words = getNumWords();
-        pVal = new uint64_t[words](); // allocation is zero cleared
+        pVal = allocWords(words);
+        memset(pVal, 0, words * WORD_SIZE);
         memcpy(pVal, bytes.data(), std::min<size_t>(words * WORD_SIZE, bytes.size()));
     }
     clearUnusedBits();
@@ -1818,25 +1783,44 @@ void SVInt::initSlowCase(std::span<const byte> bytes) {
 
 void SVInt::initSlowCase(const SVIntStorage& other) {
     uint32_t words = getNumWords();
-    pVal = new uint64_t[words];
+    pVal = allocWords(words);
     std::ranges::copy(other.pVal, other.pVal + words, pVal);
 }
 
+void SVInt::resizeWords(uint32_t keepWords, uint32_t newWords) {
+    SLANG_ASSERT(keepWords <= newWords);
+    if (newWords <= INLINE_WORDS) {
+        if (pVal != inlineWords) {
+            std::copy_n(pVal, keepWords, inlineWords);
+            delete[] pVal;
+            pVal = inlineWords;
+        }
+    }
+    else {
+        uint64_t* newMem = allocHeapWords(newWords);
+        std::copy_n(pVal, keepWords, newMem);
+        if (pVal != inlineWords)
+            delete[] pVal;
+        pVal = newMem;
+    }
+    std::fill(pVal + keepWords, pVal + newWords, 0);
+}
+
 SVInt& SVInt::assignSlowCase(const SVInt& rhs) {
     if (this == &rhs)
         return *this;
 
     if (rhs.isSingleWord()) {
-        delete[] pVal;
+        freeWords();
         val = rhs.val;
     }
     else {
         if (isSingleWord()) {
-            pVal = new uint64_t[rhs.getNumWords()];
+            pVal = allocWords(rhs.getNumWords());
         }
         else if (getNumWords() != rhs.getNumWords()) {
-            delete[] pVal;
-            pVal = new uint64_t[rhs.getNumWords()];
+            freeWords();
+            pVal = allocWords(rhs.getNumWords());
         }
         memcpy(pVal, rhs.pVal, rhs.getNumWords() * WORD_SIZE);
     }
@@ -2034,19 +2018,16 @@ void SVInt::checkUnknown() {
     if (!unknownFlag || countLeadingZeros() < bitWidth)
         return;
 
-    unknownFlag = false;
-    uint32_t words = getNumWords();
+    uint32_t words = getNumWords(bitWidth, false);
     if (words == 1) {
         uint64_t newVal = pVal[0];
-        delete[] pVal;
+        freeWords();
         val = newVal;
     }
     else {
-        uint64_t* newMem = new uint64_t[words];
-        memcpy(newMem, pVal, words * WORD_SIZE);
-        delete[] pVal;
-        pVal = newMem;
+        resizeWords(words, words);
     }
+    unknownFlag = false;
 }
 
 void SVInt::makeUnknown() {
@@ -2054,19 +2035,16 @@ void SVInt::makeUnknown() {
         return;
 
     uint32_t words = getNumWords();
-    unknownFlag = true;
     if (words == 1) {
         auto value = val;
-        pVal = new uint64_t[2];
+        pVal = allocWords(2);
         pVal[0] = value;
         pVal[1] = 0;
     }
     else {
-        uint64_t* newMem = new uint64_t[words * 2]();
-        memcpy(newMem, pVal, words * WORD_SIZE);
-        delete[] pVal;
-        pVal = newMem;
+        resizeWords(words, words * 2);
     }
+    unknownFlag = true;
 }
 
 SVInt SVInt::createFillX(bitwidth_t bitWidth, bool isSigned) {
@@ -2081,110 +2059,30 @@ SVInt SVInt::createFillZ(bitwidth_t bitWidth, bool isSigned) {
     return result;
 }
 
-void SVInt::splitWords(const SVInt& value, uint32_t* dest, uint32_t numWords) {
-    for (uint32_t i = 0; i < numWords; i++) {
-        uint64_t val = value.getRawData()[i];
-        dest[i * 2] = uint32_t(val);
-        dest[i * 2 + 1] = uint32_t(val >> 32);
-    }
-}
-
-void SVInt::buildDivideResult(SVInt* result, uint32_t* value, bitwidth_t bitWidth, bool signFlag,
-                              uint32_t numWords) {
-    if (!result)
-        return;
-
-    if (numWords == 1) {
-        uint64_t val = uint64_t(value[0]) | (uint64_t(value[1]) << (BITS_PER_WORD / 2));
-        *result = SVInt(bitWidth, val, signFlag);
-    }
-    else {
-        *result = SVInt(bitWidth, 0, signFlag);
-        for (uint32_t i = 0; i < numWords; i++)
-            result->pVal[i] = uint64_t(value[i * 2]) |
-                              (uint64_t(value[i * 2 + 1]) << (BITS_PER_WORD / 2));
-    }
-}
-
-SLANG_NO_SANITIZE("unsigned-integer-overflow")
 void SVInt::divide(const SVInt& lhs, uint32_t lhsWords, const SVInt& rhs, uint32_t rhsWords,
                    SVInt* quotient, SVInt* remainder) {
     SLANG_ASSERT(lhsWords >= rhsWords);
 
-    // The Knuth algorithm requires arrays of 32-bit words (because results of operations
-    // need to fit natively into 64 bits). Allocate space for the backing memory, either on
-    // the stack if it's small or on the heap if it's not.
-    uint32_t divisorWords = rhsWords * 2;
-    uint32_t extraWords = (lhsWords * 2) - divisorWords;
-    uint32_t dividendWords = divisorWords + extraWords;
-
-    size_t totalWordsNeeded = (remainder ? 4 : 3) * divisorWords + 2 * extraWords + 1;
-    TempBuffer<uint32_t, 128> scratch(totalWordsNeeded);
-    uint32_t* u = scratch.get();
-    uint32_t* v = u + dividendWords + 1;
-    uint32_t* q = v + divisorWords;
-    uint32_t* r = remainder ? q + dividendWords : nullptr;
-
-    // Initialize the dividend and divisor
-    memset(u, 0, (dividendWords + 1) * sizeof(uint32_t));
-    splitWords(lhs, u, lhsWords);
-
-    memset(v, 0, divisorWords * sizeof(uint32_t));
-    splitWords(rhs, v, rhsWords);
-
-    // Initialize quotient and remainder
-    memset(q, 0, dividendWords * sizeof(uint32_t));
-    if (remainder)
-        memset(r, 0, divisorWords * sizeof(uint32_t));
-
-    // extra word for spill space in Knuth algorithm
-    u[dividendWords] = 0;
-
-    // Adjust sizes for division. The Knuth algorithm will fail if there
-    // are empty words in the input.
-    for (uint32_t i = divisorWords; i > 0 && v[i - 1] == 0; i--) {
-        divisorWords--;
-        extraWords++;
-    }
-    for (uint32_t i = dividendWords; i > 0 && u[i - 1] == 0; i--)
-        extraWords--;
-
-    // If we're left with only a single divisor word, Knuth won't work.
-    // We can use a sequence of standard 64 bit divides for this.
-    dividendWords = divisorWords + extraWords;
-    if (divisorWords == 1) {
-        uint32_t divisor = v[0];
-        uint32_t rem = 0;
-        for (int i = int(dividendWords - 1); i >= 0; i--) {
-            uint64_t partial_dividend = uint64_t(rem) << 32 | u[i];
-            if (partial_dividend == 0) {
-                q[i] = 0;
-                rem = 0;
-            }
-            else if (partial_dividend < divisor) {
-                q[i] = 0;
-                rem = (uint32_t)partial_dividend;
-            }
-            else if (partial_dividend == divisor) {
-                q[i] = 1;
-                rem = 0;
-            }
-            else {
-                q[i] = (uint32_t)(partial_dividend / divisor);
-                rem = (uint32_t)(partial_dividend - (q[i] * divisor));
-            }
-        }
-        if (r)
-            r[0] = rem;
-    }
-    else {
-        // otherwise invoke Knuth
-        knuthDiv(u, v, q, r, extraWords, divisorWords);
-    }
+    TempBuffer<uint64_t, 64> scratch(lhsWords + rhsWords);
+    uint64_t* q = scratch.get();
+    uint64_t* r = remainder ? q + lhsWords : nullptr;
+
+    // Knuth's algorithm takes time proportional to the product of the sizes of the
+    // divisor and the quotient, so only use it when one of them is small.
+    if (rhsWords >= BurnikelZieglerThreshold && lhsWords - rhsWords >= BurnikelZieglerOffset)
+        divideRecursive(lhs.getRawData(), lhsWords, rhs.getRawData(), rhsWords, q, r);
+    else
+        divideKnuth(lhs.getRawData(), lhsWords, rhs.getRawData(), rhsWords, q, r);
 
     bool bothSigned = lhs.signFlag && rhs.signFlag;
-    buildDivideResult(quotient, q, lhs.bitWidth, bothSigned, lhsWords);
-    buildDivideResult(remainder, r, rhs.bitWidth, bothSigned, rhsWords);
+    if (quotient) {
+        *quotient = SVInt(lhs.bitWidth, 0, bothSigned);
+        memcpy(quotient->getRawData(), q, lhsWords * WORD_SIZE);
+    }
+    if (remainder) {
+        *remainder = SVInt(rhs.bitWidth, 0, bothSigned);
+        memcpy(remainder->getRawData(), r, rhsWords * WORD_SIZE);
+    }
 }
 
 SVInt SVInt::udiv(const SVInt& lhs, const SVInt& rhs, bool bothSigned) {
@@ -2252,10 +2150,9 @@ SVInt SVInt::modPow(const SVInt& base, const SVInt& exponent, bool bothSigned) {
     // https://en.wikipedia.org/wiki/Modular_exponentiation
     //
     // The result value will have the same bit width as the lhs. That's the value we'll
-    // be using as the modulus in the (a * b) mod m equation.
-    // Allocate a temporary scratch buffer that has 2x the number of bits so that we can
-    // handle any possible intermediate multiply.
-    TempBuffer<uint64_t, 128> scratch(getNumWords(base.bitWidth * 2, false));
+    // be using as the modulus in the (a * b) mod m equation. Since that's a power of two
+    // only the low words of each intermediate product need to be computed.
+    TempBuffer<uint64_t, 128> scratch(getNumWords(base.bitWidth, false));
     SVInt baseCopy = base;
     SVInt result(base.bitWidth, 1, false);
 
@@ -2265,18 +2162,12 @@ SVInt SVInt::modPow(const SVInt& base, const SVInt& exponent, bool bothSigned) {
         uint32_t lhsWords = !lhsBits ? 0 : whichWord(lhsBits - 1) + 1;
         uint32_t rhsWords = !rhsBits ? 0 : whichWord(rhsBits - 1) + 1;
 
-        scratch.fill(0);
-        mul(scratch.get(), left.getRawData(), lhsWords, right.getRawData(), rhsWords);
+        uint32_t destWords = result.getNumWords();
+        mulLow(scratch.get(), destWords, left.getRawData(), lhsWords, right.getRawData(),
+               rhsWords);
 
-        uint32_t destWords = lhsWords + rhsWords;
-        if (destWords >= result.getNumWords()) {
-            memcpy(result.getRawData(), scratch.get(), result.getNumWords() * sizeof(uint64_t));
-            result.clearUnusedBits();
-        }
-        else {
-            memcpy(result.getRawData(), scratch.get(), destWords * sizeof(uint64_t));
-            result.clearUnusedBits();
-        }
+        memcpy(result.getRawData(), scratch.get(), destWords * sizeof(uint64_t));
+        result.clearUnusedBits();
     };
 
     // Loop through each bit of the exponent.
@@ -67,6 +67,14 @@ uint64_t _umul128(uint64_t multiplier, uint64_t multiplicand, uint64_t* product_
 }
 #endif
 
+#if defined(__AVX2__)
+#    include <immintrin.h>
+#    define SLANG_SVINT_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define SLANG_SVINT_SSE2
+#endif
+
 namespace slang {
 
 /// Provides a temporary storage region of dynamic size. If that size is less than
@@ -101,6 +109,148 @@ private:
     alignas(T) char stackBase[StackCount * sizeof(T)];
 };
 
+// A small group of words that can be operated on together, used to write the
+// bulk bitwise and reduction kernels below once for all targets. This uses AVX2
+// when the compiler is targeting it, SSE2 (which every x86-64 target has) otherwise,
+// and falls back to plain words on everything else.
+struct WordVec {
+#if defined(SLANG_SVINT_AVX2)
+    static constexpr uint32_t Lanes = 4;
+    __m256i v;
+
+    static WordVec load(const uint64_t* p) { return {_mm256_loadu_si256((const __m256i*)p)}; }
+    static WordVec zero() { return {_mm256_setzero_si256()}; }
+    void store(uint64_t* p) const { _mm256_storeu_si256((__m256i*)p, v); }
+    bool isZero() const { return _mm256_testz_si256(v, v) != 0; }
+
+    uint64_t foldXor() const {
+        uint64_t words[4];
+        store(words);
+        return words[0] ^ words[1] ^ words[2] ^ words[3];
+    }
+
+    friend WordVec operator&(WordVec a, WordVec b) { return {_mm256_and_si256(a.v, b.v)}; }
+    friend WordVec operator|(WordVec a, WordVec b) { return {_mm256_or_si256(a.v, b.v)}; }
+    friend WordVec operator^(WordVec a, WordVec b) { return {_mm256_xor_si256(a.v, b.v)}; }
+    friend WordVec operator~(WordVec a) { return {_mm256_xor_si256(a.v, _mm256_set1_epi32(-1))}; }
+#elif defined(SLANG_SVINT_SSE2)
+    static constexpr uint32_t Lanes = 2;
+    __m128i v;
+
+    static WordVec load(const uint64_t* p) { return {_mm_loadu_si128((const __m128i*)p)}; }
+    static WordVec zero() { return {_mm_setzero_si128()}; }
+    void store(uint64_t* p) const { _mm_storeu_si128((__m128i*)p, v); }
+    bool isZero() const {
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())) == 0xffff;
+    }
+
+    uint64_t foldXor() const {
+        uint64_t words[2];
+        store(words);
+        return words[0] ^ words[1];
+    }
+
+    friend WordVec operator&(WordVec a, WordVec b) { return {_mm_and_si128(a.v, b.v)}; }
+    friend WordVec operator|(WordVec a, WordVec b) { return {_mm_or_si128(a.v, b.v)}; }
+    friend WordVec operator^(WordVec a, WordVec b) { return {_mm_xor_si128(a.v, b.v)}; }
+    friend WordVec operator~(WordVec a) { return {_mm_xor_si128(a.v, _mm_set1_epi32(-1))}; }
+#else
+    static constexpr uint32_t Lanes = 1;
+    uint64_t v;
+
+    static WordVec load(const uint64_t* p) { return {*p}; }
+    static WordVec zero() { return {0}; }
+    void store(uint64_t* p) const { *p = v; }
+    bool isZero() const { return v == 0; }
+    uint64_t foldXor() const { return v; }
+
+    friend WordVec operator&(WordVec a, WordVec b) { return {a.v & b.v}; }
+    friend WordVec operator|(WordVec a, WordVec b) { return {a.v | b.v}; }
+    friend WordVec operator^(WordVec a, WordVec b) { return {a.v ^ b.v}; }
+    friend WordVec operator~(WordVec a) { return {~a.v}; }
+#endif
+};
+
+// Applies a bitwise operation to each pair of words in x and y, storing
+// the results in dst (which is allowed to be the same as either input).
+template<typename TOp>
+static void bitwiseWords(uint64_t* dst, const uint64_t* x, const uint64_t* y, uint32_t len,
+                         TOp&& op) {
+    uint32_t i = 0;
+    for (; i + WordVec::Lanes <= len; i += WordVec::Lanes)
+        op(WordVec::load(x + i), WordVec::load(y + i)).store(dst + i);
+    for (; i < len; i++)
+        dst[i] = op(x[i], y[i]);
+}
+
+// Applies a four-state bitwise operation in place to the value and unknown planes
+// of the lhs, in a single pass. If the rhs has no unknown bits its unknown plane
+// can be omitted, in which case the operation sees it as all zeros.
+template<bool RhsUnknown, typename TOp>
+static void bitwiseWords4State(uint64_t* val, uint64_t* unk, const uint64_t* rval,
+                               const uint64_t* runk, uint32_t len, TOp&& op) {
+    uint32_t i = 0;
+    for (; i + WordVec::Lanes <= len; i += WordVec::Lanes) {
+        auto v = WordVec::load(val + i);
+        auto u = WordVec::load(unk + i);
+        auto ru = WordVec::zero();
+        if constexpr (RhsUnknown)
+            ru = WordVec::load(runk + i);
+
+        op(v, u, WordVec::load(rval + i), ru);
+        v.store(val + i);
+        u.store(unk + i);
+    }
+
+    for (; i < len; i++) {
+        uint64_t v = val[i];
+        uint64_t u = unk[i];
+        uint64_t ru = 0;
+        if constexpr (RhsUnknown)
+            ru = runk[i];
+
+        op(v, u, rval[i], ru);
+        val[i] = v;
+        unk[i] = u;
+    }
+}
+
+// Checks whether the given operation returns a nonzero result for any pair of words in
+// x and y. The words are checked in blocks so that we can bail out early without
+// giving up the benefit of operating on many words at a time.
+template<typename TOp>
+static bool anyWords(const uint64_t* x, const uint64_t* y, uint32_t len, TOp&& op) {
+    constexpr uint32_t BlockSize = WordVec::Lanes * 4;
+    uint32_t i = 0;
+    for (; i + BlockSize <= len; i += BlockSize) {
+        auto acc = WordVec::zero();
+        for (uint32_t j = i; j < i + BlockSize; j += WordVec::Lanes)
+            acc = acc | op(WordVec::load(x + j), WordVec::load(y + j));
+
+        if (!acc.isZero())
+            return true;
+    }
+
+    for (; i < len; i++) {
+        if (op(x[i], y[i]))
+            return true;
+    }
+    return false;
+}
+
+// Combines all of the given words together via xor.
+static uint64_t xorWords(const uint64_t* x, uint32_t len) {
+    auto acc = WordVec::zero();
+    uint32_t i = 0;
+    for (; i + WordVec::Lanes <= len; i += WordVec::Lanes)
+        acc = acc ^ WordVec::load(x + i);
+
+    uint64_t result = acc.foldXor();
+    for (; i < len; i++)
+        result ^= x[i];
+    return result;
+}
+
 static void lshrNear(uint64_t* dst, uint64_t* src, uint32_t words, uint32_t amount) {
     // fast case for logical right shift of a small amount (less than 64 bits)
     uint64_t carry = 0;
@@ -290,28 +440,99 @@ static uint64_t mulOne(uint64_t* dst, const uint64_t* x, uint32_t len, uint64_t
     return carry;
 }
 
+// Operand sizes, in words, at which multiplication and division switch from
+// the schoolbook algorithms to the recursive ones. The SVInt benchmarks measure
+// both sides of each of these crossovers.
+static constexpr uint32_t KaratsubaThreshold = 8;
+static constexpr uint32_t BurnikelZieglerThreshold = 40;
+static constexpr uint32_t BurnikelZieglerOffset = 20;
+
 static void mulKaratsuba(uint64_t* dst, const uint64_t* x, uint32_t xlen, const uint64_t* y,
                          uint32_t ylen);
 
-// Generalized multiplier
+// Schoolbook multiplier, which writes all xlen + ylen words of the product
 SLANG_NO_SANITIZE("unsigned-integer-overflow")
+static void mulSchoolbook(uint64_t* dst, const uint64_t* x, uint32_t xlen, const uint64_t* y,
+                          uint32_t ylen) {
+    dst[xlen] = mulOne(dst, x, xlen, y[0]);
+    for (uint32_t i = 1; i < ylen; i++) {
+        uint64_t carry = 0;
+        for (uint32_t j = 0; j < xlen; j++) {
+            calc_out_t result;
+            uint8_t c = addcarry64(0, mulTerm(x[j], y[i], carry), dst[i + j], &result);
+
+            dst[i + j] = result;
+            carry += c;
+        }
+        dst[i + xlen] = carry;
+    }
+}
+
+// Generalized multiplier
 static void mul(uint64_t* dst, const uint64_t* x, uint32_t xlen, const uint64_t* y, uint32_t ylen) {
-    if (xlen > 7 && ylen > 7) {
+    if (xlen >= KaratsubaThreshold && ylen >= KaratsubaThreshold)
         mulKaratsuba(dst, x, xlen, y, ylen);
+    else
+        mulSchoolbook(dst, x, xlen, y, ylen);
+}
+
+// Computes only the low dstLen words of x * y. SVInt products are truncated to
+// the width of the operands, so there's no need to compute the upper half.
+SLANG_NO_SANITIZE("unsigned-integer-overflow")
+static void mulLow(uint64_t* dst, uint32_t dstLen, const uint64_t* x, uint32_t xlen,
+                   const uint64_t* y, uint32_t ylen) {
+    xlen = std::min(xlen, dstLen);
+    ylen = std::min(ylen, dstLen);
+    if (!xlen || !ylen) {
+        memset(dst, 0, dstLen * sizeof(uint64_t));
         return;
     }
 
-    dst[xlen] = mulOne(dst, x, xlen, y[0]);
-    for (uint32_t i = 1; i < ylen; i++) {
+    if (xlen + ylen <= dstLen) {
+        mul(dst, x, xlen, y, ylen);
+        memset(dst + xlen + ylen, 0, (dstLen - xlen - ylen) * sizeof(uint64_t));
+        return;
+    }
+
+    if (xlen >= KaratsubaThreshold && ylen >= KaratsubaThreshold) {
+        // Split each operand at h words. The product of the low halves is
+        // needed in full but the cross terms only need their low words, and
+        // the product of the high halves doesn't contribute at all.
+        uint32_t h = (dstLen + 1) / 2;
+        uint32_t xlSize = std::min(xlen, h);
+        uint32_t ylSize = std::min(ylen, h);
+
+        TempBuffer<uint64_t, 128> t(std::max(xlSize + ylSize, dstLen - h));
+        mul(t.get(), x, xlSize, y, ylSize);
+        uint32_t lowWords = std::min(xlSize + ylSize, dstLen);
+        memcpy(dst, t.get(), lowWords * sizeof(uint64_t));
+        memset(dst + lowWords, 0, (dstLen - lowWords) * sizeof(uint64_t));
+
+        if (xlen > h) {
+            mulLow(t.get(), dstLen - h, x + h, xlen - h, y, ylSize);
+            addGeneral(dst + h, dst + h, t.get(), dstLen - h);
+        }
+        if (ylen > h) {
+            mulLow(t.get(), dstLen - h, x, xlSize, y + h, ylen - h);
+            addGeneral(dst + h, dst + h, t.get(), dstLen - h);
+        }
+        return;
+    }
+
+    // Schoolbook multiply that stops each row at the end of the destination.
+    memset(dst, 0, dstLen * sizeof(uint64_t));
+    for (uint32_t i = 0; i < ylen; i++) {
         uint64_t carry = 0;
-        for (uint32_t j = 0; j < xlen; j++) {
+        uint32_t rowLen = std::min(xlen, dstLen - i);
+        for (uint32_t j = 0; j < rowLen; j++) {
             calc_out_t result;
             uint8_t c = addcarry64(0, mulTerm(x[j], y[i], carry), dst[i + j], &result);
 
             dst[i + j] = result;
             carry += c;
         }
-        dst[i + xlen] = carry;
+        if (i + rowLen < dstLen)
+            dst[i + rowLen] = carry;
     }
 }
 
@@ -345,6 +566,18 @@ static void mulKaratsuba(uint64_t* dst, const uint64_t* x, uint32_t xlen, const
     }
 
     uint32_t shift = ylen >> 1;
+    if (xlen <= shift) {
+        // The operands are too unbalanced to split at the same point, so
+        // multiply x by each xlen sized piece of y and accumulate.
+        memset(dst, 0, (xlen + ylen) * sizeof(uint64_t));
+        TempBuffer<uint64_t, 128> t(2 * xlen);
+        for (uint32_t i = 0; i < ylen; i += xlen) {
+            uint32_t len = std::min(xlen, ylen - i);
+            mul(t.get(), x, xlen, y + i, len);
+            addGeneral(dst + i, dst + i, t.get(), xlen + len);
+        }
+        return;
+    }
 
     uint32_t xlSize = std::min(xlen, shift);
     uint32_t xhSize = xlen - xlSize;
@@ -508,6 +741,219 @@ static void knuthDiv(uint32_t* u, uint32_t* v, uint32_t* q, uint32_t* r, uint32_
     }
 }
 
+// Divides the aLen word value in a by the bLen word value in b, which must be nonzero.
+// Writes aLen words of quotient to q and, if r is provided, bLen words of remainder.
+SLANG_NO_SANITIZE("unsigned-integer-overflow")
+static void divideKnuth(const uint64_t* a, uint32_t aLen, const uint64_t* b, uint32_t bLen,
+                        uint64_t* q, uint64_t* r) {
+    SLANG_ASSERT(aLen >= bLen);
+
+    // The Knuth algorithm requires arrays of 32-bit words (because results of operations
+    // need to fit natively into 64 bits). Allocate space for the backing memory, either on
+    // the stack if it's small or on the heap if it's not.
+    uint32_t divisorWords = bLen * 2;
+    uint32_t dividendWords = aLen * 2;
+
+    size_t totalWordsNeeded = 2 * dividendWords + (r ? 2 : 1) * divisorWords + 1;
+    TempBuffer<uint32_t, 128> scratch(totalWordsNeeded);
+    uint32_t* u = scratch.get();
+    uint32_t* v = u + dividendWords + 1;
+    uint32_t* qd = v + divisorWords;
+    uint32_t* rd = r ? qd + dividendWords : nullptr;
+    scratch.fill(0);
+
+    for (uint32_t i = 0; i < aLen; i++) {
+        u[i * 2] = uint32_t(a[i]);
+        u[i * 2 + 1] = uint32_t(a[i] >> 32);
+    }
+    for (uint32_t i = 0; i < bLen; i++) {
+        v[i * 2] = uint32_t(b[i]);
+        v[i * 2 + 1] = uint32_t(b[i] >> 32);
+    }
+
+    // Adjust sizes for division. The Knuth algorithm will fail if there
+    // are empty words in the input.
+    while (divisorWords > 0 && v[divisorWords - 1] == 0)
+        divisorWords--;
+    while (dividendWords > 0 && u[dividendWords - 1] == 0)
+        dividendWords--;
+    SLANG_ASSERT(divisorWords);
+
+    if (dividendWords < divisorWords) {
+        // The dividend is smaller than the divisor so it's also the remainder.
+        memset(q, 0, aLen * sizeof(uint64_t));
+        if (r)
+            memcpy(r, a, bLen * sizeof(uint64_t));
+        return;
+    }
+
+    // If we're left with only a single divisor word, Knuth won't work.
+    // We can use a sequence of standard 64 bit divides for this.
+    if (divisorWords == 1) {
+        uint32_t divisor = v[0];
+        uint32_t rem = 0;
+        for (int i = int(dividendWords - 1); i >= 0; i--) {
+            uint64_t partial_dividend = uint64_t(rem) << 32 | u[i];
+            if (partial_dividend == 0) {
+                qd[i] = 0;
+                rem = 0;
+            }
+            else if (partial_dividend < divisor) {
+                qd[i] = 0;
+                rem = (uint32_t)partial_dividend;
+            }
+            else if (partial_dividend == divisor) {
+                qd[i] = 1;
+                rem = 0;
+            }
+            else {
+                qd[i] = (uint32_t)(partial_dividend / divisor);
+                rem = (uint32_t)(partial_dividend - (qd[i] * divisor));
+            }
+        }
+        if (rd)
+            rd[0] = rem;
+    }
+    else {
+        // otherwise invoke Knuth
+        knuthDiv(u, v, qd, rd, dividendWords - divisorWords, divisorWords);
+    }
+
+    for (uint32_t i = 0; i < aLen; i++)
+        q[i] = uint64_t(qd[i * 2]) | (uint64_t(qd[i * 2 + 1]) << 32);
+    if (r) {
+        for (uint32_t i = 0; i < bLen; i++)
+            r[i] = uint64_t(rd[i * 2]) | (uint64_t(rd[i * 2 + 1]) << 32);
+    }
+}
+
+static void divide3n2n(const uint64_t* a, const uint64_t* b, uint32_t h, uint64_t* q,
+                       uint64_t* r);
+
+// Divides the 2n word value in a by the n word value in b, where b has its top bit
+// set and a < b * 2^(64n). Writes n words each of quotient and remainder.
+static void divide2n1n(const uint64_t* a, const uint64_t* b, uint32_t n, uint64_t* q,
+                       uint64_t* r) {
+    if ((n & 1) || n < BurnikelZieglerThreshold) {
+        TempBuffer<uint64_t, 128> quotient(2 * n);
+        divideKnuth(a, 2 * n, b, n, quotient.get(), r);
+        memcpy(q, quotient.get(), n * sizeof(uint64_t));
+        return;
+    }
+
+    // Treat a as four half-size digits and b as two, and find each
+    // half of the quotient by dividing three digits of a by b.
+    uint32_t h = n / 2;
+    TempBuffer<uint64_t, 128> temp(3 * h);
+    divide3n2n(a + h, b, h, q + h, temp.get() + h);
+    memcpy(temp.get(), a, h * sizeof(uint64_t));
+    divide3n2n(temp.get(), b, h, q, r);
+}
+
+// Divides the 3h word value in a by the 2h word value in b, where b has its top bit
+// set and a < b * 2^(64h). Writes h words of quotient and 2h words of remainder.
+SLANG_NO_SANITIZE("unsigned-integer-overflow")
+static void divide3n2n(const uint64_t* a, const uint64_t* b, uint32_t h, uint64_t* q,
+                       uint64_t* r) {
+    // Estimate the quotient by dividing the top two digits of a by the top digit of b.
+    // The remainder estimate is kept in two's complement with an extra word so that
+    // it can go negative when the estimate is too large.
+    const uint64_t* a1 = a + 2 * h;
+    const uint64_t* b1 = b + h;
+    TempBuffer<uint64_t, 128> rem(2 * h + 1);
+    memcpy(rem.get(), a, h * sizeof(uint64_t));
+
+    bool a1Less = false;
+    for (uint32_t i = h; i > 0; i--) {
+        if (a1[i - 1] != b1[i - 1]) {
+            a1Less = a1[i - 1] < b1[i - 1];
+            break;
+        }
+    }
+
+    if (a1Less) {
+        divide2n1n(a + h, b1, h, q, rem.get() + h);
+        rem.get()[2 * h] = 0;
+    }
+    else {
+        // The top digits are equal, so the estimate is the largest
+        // digit and its remainder is the middle digit of a plus b1.
+        memset(q, 0xff, h * sizeof(uint64_t));
+        rem.get()[2 * h] = addGeneral(rem.get() + h, a + h, b1, h);
+    }
+
+    // Subtract the estimate times the low digit of b and correct
+    // the estimate, which is at most two too large.
+    TempBuffer<uint64_t, 128> temp(2 * h + 1);
+    mul(temp.get(), q, h, b, h);
+    temp.get()[2 * h] = 0;
+    subGeneral(rem.get(), rem.get(), temp.get(), 2 * h + 1);
+
+    if (int64_t(rem.get()[2 * h]) < 0) {
+        memcpy(temp.get(), b, 2 * h * sizeof(uint64_t));
+        do {
+            addGeneral(rem.get(), rem.get(), temp.get(), 2 * h + 1);
+            subOne(q, q, h, 1);
+        } while (int64_t(rem.get()[2 * h]) < 0);
+    }
+
+    memcpy(r, rem.get(), 2 * h * sizeof(uint64_t));
+}
+
+// Divides using the recursive algorithm from Burnikel and Ziegler, "Fast Recursive
+// Division", which does most of its work with multiplications and so is much faster
+// than Knuth's algorithm for large divisors. Arguments are the same as for divideKnuth,
+// except that the top words of both a and b must be nonzero.
+static void divideRecursive(const uint64_t* a, uint32_t aLen, const uint64_t* b, uint32_t bLen,
+                            uint64_t* q, uint64_t* r) {
+    constexpr uint32_t BITS = SVInt::BITS_PER_WORD;
+    SLANG_ASSERT(aLen >= bLen && a[aLen - 1] && b[bLen - 1]);
+
+    // Pick a block size at least as large as the divisor that
+    // can be halved evenly until it falls below the threshold.
+    uint32_t m = 1u << std::bit_width(bLen / BurnikelZieglerThreshold);
+    uint32_t n = (bLen + m - 1) / m * m;
+
+    // Shift both operands so that the divisor fills a whole block and has its top bit
+    // set, and split the dividend into enough blocks that the top one has a zero top bit.
+    uint32_t shift = n * BITS - (bLen * BITS - (uint32_t)std::countl_zero(b[bLen - 1]));
+    uint32_t aBits = aLen * BITS - (uint32_t)std::countl_zero(a[aLen - 1]);
+    uint32_t t = std::max((aBits + shift + 1 + n * BITS - 1) / (n * BITS), 2u);
+
+    TempBuffer<uint64_t, 128> scratch(n + t * n + 2 * n + (t - 1) * n + n);
+    scratch.fill(0);
+    uint64_t* bs = scratch.get();
+    uint64_t* as = bs + n;
+    uint64_t* z = as + t * n;
+    uint64_t* qs = z + 2 * n;
+    uint64_t* rs = qs + (t - 1) * n;
+
+    memcpy(bs + shift / BITS, b, bLen * sizeof(uint64_t));
+    shlFar(bs, bs, shift % BITS, 0, 0, n);
+    memcpy(as + shift / BITS, a, aLen * sizeof(uint64_t));
+    shlFar(as, as, shift % BITS, 0, 0, t * n);
+
+    // Divide two blocks at a time from the top, carrying the remainder of each step
+    // into the next one as its upper block.
+    memcpy(z, as + (t - 2) * n, 2 * n * sizeof(uint64_t));
+    for (uint32_t i = t - 1; i-- > 0;) {
+        divide2n1n(z, bs, n, qs + i * n, rs);
+        if (i > 0) {
+            memcpy(z, as + (i - 1) * n, n * sizeof(uint64_t));
+            memcpy(z + n, rs, n * sizeof(uint64_t));
+        }
+    }
+
+    uint32_t quotientWords = std::min(aLen, (t - 1) * n);
+    memcpy(q, qs, quotientWords * sizeof(uint64_t));
+    memset(q + quotientWords, 0, (aLen - quotientWords) * sizeof(uint64_t));
+
+    if (r) {
+        lshrFar(rs, rs, shift % BITS, shift / BITS, 0, n);
+        memcpy(r, rs, bLen * sizeof(uint64_t));
+    }
+}
+
 // Does a word-by-word copy, but using bit offsets and lengths.
 static void bitcpy(uint64_t* dest, uint32_t destOffset, const uint64_t* src, uint32_t length,
                    uint32_t srcOffset = 0) {
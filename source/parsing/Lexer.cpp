@@ -19,6 +19,7 @@
 #include "slang/util/BumpAllocator.h"
 #include "slang/util/ScopeGuard.h"
 #include "slang/util/String.h"
+#include "slang/util/TimeTrace.h"
 
 static_assert(std::numeric_limits<double>::is_iec559, "SystemVerilog requires IEEE 754");
 
@@ -233,6 +234,8 @@ Token Lexer::lex(KeywordVersion keywordVersion) {
     // lex the next token
     mark();
     Token token = lexToken(keywordVersion);
+    if (TimeTrace::isEnabled())
+        TimeTrace::count("tokens"sv);
 
     if (token.kind != TokenKind::EndOfFile && errorCount > options.maxErrors) {
         // Stop any further lexing by claiming to be at the end of the buffer.
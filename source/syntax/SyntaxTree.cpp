@@ -17,6 +17,15 @@ namespace slang::syntax {
 
 using namespace parsing;
 
+static uint64_t countNodes(const SyntaxNode& node) {
+    uint64_t count = 1;
+    for (size_t i = 0; i < node.getChildCount(); i++) {
+        if (auto child = node.childNode(i))
+            count += countNodes(*child);
+    }
+    return count;
+}
+
 SyntaxTree::SyntaxTree(SyntaxNode* root, SourceManager& sourceManager, BumpAllocator&& alloc,
                        const SourceLibrary* library, std::shared_ptr<SyntaxTree> parent) :
     rootNode(root), library(library), sourceMan(sourceManager), alloc(std::move(alloc)),
@@ -163,9 +172,20 @@ std::shared_ptr<SyntaxTree> SyntaxTree::create(SourceManager& sourceManager,
             return create(sourceManager, sources, options, inheritedMacros, false);
     }
 
-    return std::shared_ptr<SyntaxTree>(
+    // Nodes are counted after the fact so that constructing them stays free
+    // of any tracing overhead.
+    if (TimeTrace::isEnabled()) {
+        TimeTrace::count("syntaxNodes"sv, countNodes(*root));
+        TimeTrace::count("diagnostics"sv, diagnostics.size());
+    }
+
+    auto tree = std::shared_ptr<SyntaxTree>(
         new SyntaxTree(root, library, sourceManager, std::move(alloc), std::move(diagnostics),
                        parser.getMetadata(), preprocessor.getDefinedMacros(), options));
+
+    for (auto& source : sources)
+        tree->sourceBufferIds.push_back(source.id);
+    return tree;
 }
 
 std::shared_ptr<SyntaxTree> SyntaxTree::fromLibraryMapFile(std::string_view path,
@@ -204,9 +224,12 @@ std::shared_ptr<SyntaxTree> SyntaxTree::fromLibraryMapBuffer(const SourceBuffer&
     Parser parser(preprocessor, options);
     auto& root = parser.parseLibraryMap();
 
-    return std::shared_ptr<SyntaxTree>(
+    auto tree = std::shared_ptr<SyntaxTree>(
         new SyntaxTree(&root, nullptr, sourceManager, std::move(alloc), std::move(diagnostics),
                        parser.getMetadata(), preprocessor.getDefinedMacros(), options));
+
+    tree->sourceBufferIds.push_back(buffer.id);
+    return tree;
 }
 
 } // namespace slang::syntax
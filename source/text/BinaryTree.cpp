@@ -0,0 +1,440 @@
+//------------------------------------------------------------------------------
+// BinaryTree.cpp
+// Compact binary encoding of structured data trees
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#include "slang/text/BinaryTree.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#include "slang/util/OS.h"
+
+// Layout of the encoded data:
+//   header:  magic (4 bytes), format version (u32)
+//   root value
+//   string data: all interned strings, concatenated
+//   string offsets: (count + 1) u64 offsets into the string data
+//   trailer: string data offset (u64), string offsets offset (u64),
+//            string count (u64), magic (4 bytes)
+//
+// Values are a kind byte followed by:
+//   Object / Array: encoded size of the rest (u64), child count (u32), children;
+//                   object children are a string index (varint) followed by a value
+//   String: string index (varint)
+//   Int: zigzag encoded varint
+//   UInt: varint
+//   Double: IEEE bits (u64)
+//   False / True: nothing
+//
+// All fixed size integers are little endian.
+
+namespace slang {
+
+static constexpr char Magic[4] = {'S', 'L', 'B', 'T'};
+static constexpr uint32_t FormatVersion = 1;
+static constexpr size_t HeaderSize = 8;
+static constexpr size_t TrailerSize = 28;
+
+static uint64_t readFixed(const char* ptr, size_t size) {
+    uint64_t result = 0;
+    for (size_t i = 0; i < size; i++)
+        result |= uint64_t(uint8_t(ptr[i])) << (i * 8);
+    return result;
+}
+
+// Reads a varint that must end before the given limit. Returns false if it
+// doesn't, or if it's too long to fit in 64 bits.
+static bool readVarInt(const char*& ptr, const char* limit, uint64_t& result) {
+    result = 0;
+    for (uint32_t shift = 0; shift < 64 && ptr < limit; shift += 7) {
+        auto byte = uint8_t(*ptr++);
+        result |= uint64_t(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+BinaryTreeWriter::BinaryTreeWriter() {
+    buffer.insert(buffer.end(), std::begin(Magic), std::end(Magic));
+    buffer.resize(HeaderSize);
+    writeFixed(FormatVersion, 4, 4);
+}
+
+BinaryTreeWriter::~BinaryTreeWriter() = default;
+
+void BinaryTreeWriter::startObject() {
+    startContainer(BinaryTreeKind::Object);
+}
+
+void BinaryTreeWriter::endObject() {
+    endContainer();
+}
+
+void BinaryTreeWriter::startArray() {
+    startContainer(BinaryTreeKind::Array);
+}
+
+void BinaryTreeWriter::endArray() {
+    endContainer();
+}
+
+void BinaryTreeWriter::writeProperty(std::string_view name) {
+    writeVarInt(internString(name));
+}
+
+void BinaryTreeWriter::writeValue(std::string_view value) {
+    beginValue(BinaryTreeKind::String);
+    writeVarInt(internString(value));
+}
+
+void BinaryTreeWriter::writeValue(int64_t value) {
+    beginValue(BinaryTreeKind::Int);
+    writeVarInt((uint64_t(value) << 1) ^ uint64_t(value >> 63));
+}
+
+void BinaryTreeWriter::writeValue(uint64_t value) {
+    beginValue(BinaryTreeKind::UInt);
+    writeVarInt(value);
+}
+
+void BinaryTreeWriter::writeValue(double value) {
+    beginValue(BinaryTreeKind::Double);
+    size_t offset = buffer.size();
+    buffer.resize(offset + 8);
+    writeFixed(std::bit_cast<uint64_t>(value), offset);
+}
+
+void BinaryTreeWriter::writeValue(bool value) {
+    beginValue(value ? BinaryTreeKind::True : BinaryTreeKind::False);
+}
+
+std::string_view BinaryTreeWriter::finish() {
+    if (!finished) {
+        SLANG_ASSERT(containerStack.empty());
+        finished = true;
+
+        size_t dataOffset = buffer.size();
+        for (auto str : strings)
+            buffer.insert(buffer.end(), str.begin(), str.end());
+
+        size_t offsetsOffset = buffer.size();
+        buffer.resize(offsetsOffset + (strings.size() + 1) * 8);
+
+        uint64_t curr = 0;
+        size_t offset = offsetsOffset;
+        for (auto str : strings) {
+            writeFixed(curr, offset);
+            curr += str.size();
+            offset += 8;
+        }
+        writeFixed(curr, offset);
+
+        offset = buffer.size();
+        buffer.resize(offset + TrailerSize);
+        writeFixed(dataOffset, offset);
+        writeFixed(offsetsOffset, offset + 8);
+        writeFixed(strings.size(), offset + 16);
+        memcpy(buffer.data() + offset + 24, Magic, sizeof(Magic));
+    }
+
+    return std::string_view(buffer.data(), buffer.size());
+}
+
+void BinaryTreeWriter::beginValue(BinaryTreeKind kind) {
+    SLANG_ASSERT(!finished);
+    if (!containerStack.empty())
+        containerStack.back().count++;
+    buffer.push_back(char(kind));
+}
+
+void BinaryTreeWriter::startContainer(BinaryTreeKind kind) {
+    beginValue(kind);
+    containerStack.push_back({buffer.size()});
+    buffer.resize(buffer.size() + 12);
+}
+
+void BinaryTreeWriter::endContainer() {
+    SLANG_ASSERT(!containerStack.empty());
+    auto container = containerStack.back();
+    containerStack.pop_back();
+
+    writeFixed(buffer.size() - container.sizeOffset - 8, container.sizeOffset);
+    writeFixed(container.count, container.sizeOffset + 8, 4);
+}
+
+void BinaryTreeWriter::writeVarInt(uint64_t value) {
+    while (value >= 0x80) {
+        buffer.push_back(char((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(char(value));
+}
+
+void BinaryTreeWriter::writeFixed(uint64_t value, size_t offset, size_t size) {
+    for (size_t i = 0; i < size; i++)
+        buffer[offset + i] = char((value >> (i * 8)) & 0xff);
+}
+
+uint32_t BinaryTreeWriter::internString(std::string_view str) {
+    if (auto it = stringMap.find(str); it != stringMap.end())
+        return it->second;
+
+    auto copy = alloc.copyFrom(std::span<const char>(str));
+    std::string_view key(copy.data(), copy.size());
+
+    auto index = uint32_t(strings.size());
+    strings.push_back(key);
+    stringMap.emplace(key, index);
+    return index;
+}
+
+BinaryTreeNode::BinaryTreeNode(const BinaryTreeReader& reader, const char* ptr) :
+    BinaryTreeNode(reader, ptr, reader.treeEnd) {
+}
+
+BinaryTreeNode::BinaryTreeNode(const BinaryTreeReader& reader, const char* ptr,
+                               const char* limit) {
+    // Work out where the value ends, making sure that everything we'll
+    // read from it later lies within the limit. Nodes that don't stay invalid.
+    auto begin = reader.data.data() + HeaderSize;
+    limit = std::min(limit, reader.treeEnd);
+    if (!ptr || ptr < begin || ptr >= limit)
+        return;
+
+    auto p = ptr + 1;
+    uint64_t unused;
+    switch (BinaryTreeKind(*ptr)) {
+        case BinaryTreeKind::Object:
+        case BinaryTreeKind::Array: {
+            if (limit - p < 12)
+                return;
+
+            uint64_t size = readFixed(p, 8);
+            if (size < 4 || size > uint64_t(limit - p - 8))
+                return;
+            p += 8 + size;
+            break;
+        }
+        case BinaryTreeKind::String:
+        case BinaryTreeKind::Int:
+        case BinaryTreeKind::UInt:
+            if (!readVarInt(p, limit, unused))
+                return;
+            break;
+        case BinaryTreeKind::Double:
+            if (limit - p < 8)
+                return;
+            p += 8;
+            break;
+        case BinaryTreeKind::False:
+        case BinaryTreeKind::True:
+            break;
+        default:
+            return;
+    }
+
+    this->reader = &reader;
+    this->ptr = ptr;
+    this->endPtr = p;
+}
+
+std::string_view BinaryTreeNode::getString() const {
+    if (kind() != BinaryTreeKind::String)
+        return {};
+
+    auto p = ptr + 1;
+    uint64_t index;
+    if (!readVarInt(p, endPtr, index))
+        return {};
+    return reader->getString(index);
+}
+
+int64_t BinaryTreeNode::getInt() const {
+    auto p = ptr + 1;
+    uint64_t v;
+    switch (kind()) {
+        case BinaryTreeKind::Int:
+            if (!readVarInt(p, endPtr, v))
+                return 0;
+            return int64_t(v >> 1) ^ -int64_t(v & 1);
+        case BinaryTreeKind::UInt:
+            if (!readVarInt(p, endPtr, v))
+                return 0;
+            return int64_t(v);
+        default:
+            return 0;
+    }
+}
+
+uint64_t BinaryTreeNode::getUInt() const {
+    switch (kind()) {
+        case BinaryTreeKind::Int:
+            return uint64_t(getInt());
+        case BinaryTreeKind::UInt: {
+            auto p = ptr + 1;
+            uint64_t v;
+            if (!readVarInt(p, endPtr, v))
+                return 0;
+            return v;
+        }
+        default:
+            return 0;
+    }
+}
+
+double BinaryTreeNode::getDouble() const {
+    switch (kind()) {
+        case BinaryTreeKind::Double:
+            return std::bit_cast<double>(readFixed(ptr + 1, 8));
+        case BinaryTreeKind::Int:
+            return double(getInt());
+        case BinaryTreeKind::UInt:
+            return double(getUInt());
+        default:
+            return 0.0;
+    }
+}
+
+size_t BinaryTreeNode::size() const {
+    if (!isObject() && !isArray())
+        return 0;
+    return size_t(readFixed(ptr + 9, 4));
+}
+
+BinaryTreeNode BinaryTreeNode::operator[](std::string_view name) const {
+    if (!isObject())
+        return {};
+
+    for (auto child : *this) {
+        if (child.name == name)
+            return child.node;
+    }
+    return {};
+}
+
+BinaryTreeNode BinaryTreeNode::operator[](size_t index) const {
+    if (index >= size())
+        return {};
+
+    auto it = begin();
+    while (index-- && it != end())
+        ++it;
+    return (*it).node;
+}
+
+BinaryTreeNode::iterator BinaryTreeNode::begin() const {
+    if (!isObject() && !isArray())
+        return {};
+    return iterator(reader, ptr + 13, endPtr, uint32_t(size()), isObject());
+}
+
+BinaryTreeNode::Child BinaryTreeNode::iterator::operator*() const {
+    if (!remaining)
+        return {};
+
+    auto p = ptr;
+    std::string_view name;
+    if (isObject) {
+        uint64_t index;
+        if (!readVarInt(p, limit, index))
+            return {};
+        name = reader->getString(index);
+    }
+    return {name, BinaryTreeNode(*reader, p, limit)};
+}
+
+BinaryTreeNode::iterator& BinaryTreeNode::iterator::operator++() {
+    // A child that can't be read ends the iteration, since there's
+    // no way to know where the next one would start.
+    uint64_t unused;
+    if (isObject && !readVarInt(ptr, limit, unused)) {
+        remaining = 0;
+        return *this;
+    }
+
+    BinaryTreeNode node(*reader, ptr, limit);
+    if (!node.valid()) {
+        remaining = 0;
+        return *this;
+    }
+
+    // Likewise a count that runs past the end of the parent is truncated.
+    ptr = node.getEnd();
+    remaining = ptr < limit ? remaining - 1 : 0;
+    return *this;
+}
+
+BinaryTreeReader::BinaryTreeReader(std::span<const char> data) : data(data) {
+    if (data.size() < HeaderSize + TrailerSize || memcmp(data.data(), Magic, 4) != 0 ||
+        readFixed(data.data() + 4, 4) != FormatVersion) {
+        return;
+    }
+
+    auto trailer = data.data() + data.size() - TrailerSize;
+    if (memcmp(trailer + 24, Magic, 4) != 0)
+        return;
+
+    uint64_t dataOffset = readFixed(trailer, 8);
+    uint64_t offsetsOffset = readFixed(trailer + 8, 8);
+    stringCount = readFixed(trailer + 16, 8);
+
+    // There are stringCount + 1 offsets; the check is written this
+    // way so that a huge count can't overflow.
+    uint64_t limit = data.size() - TrailerSize;
+    if (dataOffset < HeaderSize || dataOffset > offsetsOffset || offsetsOffset > limit ||
+        stringCount >= (limit - offsetsOffset) / 8) {
+        return;
+    }
+
+    treeEnd = data.data() + dataOffset;
+    stringData = data.data() + dataOffset;
+    stringDataSize = offsetsOffset - dataOffset;
+    stringOffsets = data.data() + offsetsOffset;
+    valid = true;
+}
+
+BinaryTreeReader::~BinaryTreeReader() {
+    if (mapped)
+        OS::unmapFile(data);
+}
+
+std::error_code BinaryTreeReader::openFile(const std::filesystem::path& path,
+                                           std::unique_ptr<BinaryTreeReader>& result) {
+    std::span<const char> contents;
+    if (auto ec = OS::mapFile(path, contents))
+        return ec;
+
+    result = std::make_unique<BinaryTreeReader>(contents);
+    result->mapped = true;
+    if (!result->valid) {
+        result.reset();
+        return make_error_code(std::errc::illegal_byte_sequence);
+    }
+
+    return {};
+}
+
+BinaryTreeNode BinaryTreeReader::getRoot() const {
+    if (!valid)
+        return {};
+    return BinaryTreeNode(*this, data.data() + HeaderSize);
+}
+
+std::string_view BinaryTreeReader::getString(uint64_t index) const {
+    if (index >= stringCount)
+        return {};
+
+    auto start = readFixed(stringOffsets + index * 8, 8);
+    auto end = readFixed(stringOffsets + (index + 1) * 8, 8);
+    if (start > end || end > stringDataSize)
+        return {};
+
+    return std::string_view(stringData + start, size_t(end - start));
+}
+
+} // namespace slang
@@ -8,6 +8,7 @@
 #include "slang/text/Json.h"
 
 #include <climits>
+#include <ostream>
 
 #include "slang/text/FormatBuffer.h"
 #include "slang/util/SmallVector.h"
@@ -18,88 +19,146 @@ namespace slang {
 JsonWriter::JsonWriter() : buffer(std::make_unique<FormatBuffer>()) {
 }
 
+JsonWriter::JsonWriter(std::ostream& stream, size_t chunkSize) :
+    buffer(std::make_unique<FormatBuffer>()), stream(&stream), chunkSize(chunkSize) {
+}
+
 JsonWriter::~JsonWriter() = default;
 
 std::string_view JsonWriter::view() const {
-    return std::string_view(buffer->data(), findLastComma());
+    return std::string_view(buffer->data(), buffer->size());
+}
+
+void JsonWriter::flush() {
+    if (stream && !buffer->empty()) {
+        stream->write(buffer->data(), (std::streamsize)buffer->size());
+        buffer->clear();
+    }
 }
 
 void JsonWriter::startObject() {
+    startItem();
     buffer->append("{");
-    if (pretty) {
+    pending = Pending::Open;
+    if (pretty)
         currentIndent += indentSize;
-        buffer->format("\n{:{}}", "", currentIndent);
-    }
 }
 
 void JsonWriter::endObject() {
-    buffer->resize(findLastComma());
     if (pretty) {
         currentIndent -= indentSize;
-        buffer->format("\n{:{}}}}", "", currentIndent);
-        endValue();
-    }
-    else {
-        buffer->append("},");
+        writeIndent();
     }
+    buffer->append("}");
+    endItem();
 }
 
 void JsonWriter::startArray() {
+    startItem();
     buffer->append("[");
-    if (pretty) {
+    pending = Pending::Open;
+    if (pretty)
         currentIndent += indentSize;
-        buffer->format("\n{:{}}", "", currentIndent);
-    }
 }
 
 void JsonWriter::endArray() {
-    buffer->resize(findLastComma());
     if (pretty) {
         currentIndent -= indentSize;
-        buffer->format("\n{:{}}]", "", currentIndent);
-        endValue();
-    }
-    else {
-        buffer->append("],");
+        writeIndent();
     }
+    buffer->append("]");
+    endItem();
 }
 
 void JsonWriter::writeProperty(std::string_view name) {
+    startItem();
     writeQuoted(name);
-    buffer->append(":");
-    if (pretty)
-        buffer->append(" ");
+    buffer->append(pretty ? ": "sv : ":"sv);
 }
 
 void JsonWriter::writeValue(std::string_view value) {
+    startItem();
     writeQuoted(value);
-    endValue();
+    endItem();
 }
 
 void JsonWriter::writeValue(int64_t value) {
+    startItem();
     buffer->format("{}", value);
-    endValue();
+    endItem();
 }
 
 void JsonWriter::writeValue(uint64_t value) {
+    startItem();
     buffer->format("{}", value);
-    endValue();
+    endItem();
 }
 
 void JsonWriter::writeValue(double value) {
+    startItem();
     buffer->format("{}", value);
-    endValue();
+    endItem();
 }
 
 void JsonWriter::writeValue(bool value) {
-    buffer->append(value ? "true" : "false");
-    endValue();
+    startItem();
+    buffer->append(value ? "true"sv : "false"sv);
+    endItem();
 }
 
 void JsonWriter::writeNewLine() {
+    pending = Pending::None;
     buffer->append("\n");
 }
 
+std::unique_ptr<StructuredWriter> JsonWriter::createFragment() const {
+    auto result = std::make_unique<JsonWriter>();
+    result->indentSize = indentSize;
+    result->pretty = pretty;
+    result->currentIndent = currentIndent;
+    return result;
+}
+
+void JsonWriter::writeFragment(const StructuredWriter& fragment) {
+    startItem();
+    buffer->append(static_cast<const JsonWriter&>(fragment).view());
+    endItem();
+}
+
+void JsonWriter::startItem() {
+    switch (pending) {
+        case Pending::None:
+            return;
+        case Pending::Open:
+            break;
+        case Pending::Comma:
+            buffer->append(",");
+            break;
+    }
+
+    pending = Pending::None;
+    if (pretty)
+        writeIndent();
+}
+
+void JsonWriter::endItem() {
+    pending = Pending::Comma;
+    if (stream && buffer->size() >= chunkSize)
+        flush();
+}
+
+void JsonWriter::writeIndent() {
+    static constexpr std::string_view spaces = "                                ";
+
+    buffer->append("\n");
+    auto remaining = size_t(currentIndent);
+    while (remaining) {
+        auto count = std::min(remaining, spaces.size());
+        buffer->append(spaces.substr(0, count));
+        remaining -= count;
+    }
+}
+
 void JsonWriter::writeQuoted(std::string_view str) {
     SmallVector<char> vec(str.size() + 2, UninitializedTag());
     vec.push_back('"');
@@ -158,23 +217,4 @@ void JsonWriter::writeQuoted(std::string_view str) {
     buffer->append(toStringView(vec));
 }
 
-void JsonWriter::endValue() {
-    buffer->append(",");
-    if (pretty)
-        buffer->format("\n{:{}}", "", currentIndent);
-}
-
-size_t JsonWriter::findLastComma() const {
-    size_t size = buffer->size();
-    if (pretty) {
-        while (size && (buffer->data()[size - 1] == ' ' || buffer->data()[size - 1] == '\n'))
-            size--;
-    }
-
-    if (size && buffer->data()[size - 1] == ',')
-        size--;
-
-    return size;
-}
-
 } // namespace slang
@@ -7,22 +7,67 @@
 //------------------------------------------------------------------------------
 #include "slang/text/SourceManager.h"
 
+#include <bit>
 #include <string>
 
 #include "slang/text/Glob.h"
 #include "slang/util/OS.h"
 #include "slang/util/String.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define SLANG_SOURCE_SSE2
+#endif
+
 namespace fs = std::filesystem;
 
 namespace slang {
 
 static const fs::path emptyPath;
 
+namespace {
+
+#ifdef SLANG_SOURCE_SSE2
+
+// The number of bytes searched at once for newlines, and the number
+// of bits in the resulting mask that correspond to each byte.
+constexpr size_t NewlineBlockSize = 16;
+constexpr int NewlineMaskStride = 1;
+
+// Returns a mask of the bytes in the block at ptr that are '\n' or '\r'.
+uint64_t findNewlines(const char* ptr) {
+    auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+    auto matches = _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('\n')),
+                                _mm_cmpeq_epi8(block, _mm_set1_epi8('\r')));
+    return uint32_t(_mm_movemask_epi8(matches));
+}
+
+#else
+
+constexpr size_t NewlineBlockSize = 8;
+constexpr int NewlineMaskStride = 8;
+
+uint64_t findNewlines(const char* ptr) {
+    // Compilers turn this into a single load on little endian targets.
+    uint64_t word = 0;
+    for (size_t i = 0; i < NewlineBlockSize; i++)
+        word |= uint64_t(uint8_t(ptr[i])) << (i * 8);
+
+    // Sets the high bit of each byte of v that is zero, and no other bits.
+    constexpr uint64_t low7 = 0x7f7f7f7f7f7f7f7full;
+    auto zeroBytes = [](uint64_t v) { return ~(((v & low7) + low7) | v | low7); };
+
+    constexpr uint64_t ones = 0x0101010101010101ull;
+    return zeroBytes(word ^ (ones * '\n')) | zeroBytes(word ^ (ones * '\r'));
+}
+
+#endif
+
+} // namespace
+
 SourceManager::SourceManager() {
     // add a dummy entry to the start of the directory list so that our file IDs line up
-    FileInfo file;
-    bufferEntries.emplace_back(file);
+    bufferEntries.add<FileInfo>();
 }
 
 std::error_code SourceManager::addSystemDirectories(std::string_view pattern) {
@@ -48,14 +93,16 @@ std::error_code SourceManager::addUserDirectories(std::string_view pattern) {
 }
 
 size_t SourceManager::getLineNumber(SourceLocation location) const {
-    std::shared_lock lock(mutex);
-    SourceLocation fileLocation = getFullyExpandedLocImpl(location, lock);
-    size_t rawLineNumber = getRawLineNumber(fileLocation, lock);
+    SourceLocation fileLocation = getFullyExpandedLocImpl(location);
+    size_t rawLineNumber = getRawLineNumber(fileLocation);
     if (rawLineNumber == 0)
         return 0;
 
-    auto info = getFileInfo(fileLocation.buffer(), lock);
+    auto info = getFileInfo(fileLocation.buffer());
+    if (!info->hasLineDirectives.load(std::memory_order_acquire))
+        return rawLineNumber;
 
+    std::shared_lock lock(mutex);
     auto lineDirective = info->getPreviousLineDirective(rawLineNumber);
     if (!lineDirective)
         return rawLineNumber;
@@ -64,8 +111,7 @@ size_t SourceManager::getLineNumber(SourceLocation location) const {
 }
 
 size_t SourceManager::getColumnNumber(SourceLocation location) const {
-    std::shared_lock lock(mutex);
-    auto info = getFileInfo(location.buffer(), lock);
+    auto info = getFileInfo(location.buffer());
     if (!info || !info->data)
         return 0;
 
@@ -80,17 +126,18 @@ size_t SourceManager::getColumnNumber(SourceLocation location) const {
 }
 
 std::string_view SourceManager::getFileName(SourceLocation location) const {
-    std::shared_lock lock(mutex);
-    SourceLocation fileLocation = getFullyExpandedLocImpl(location, lock);
-    auto info = getFileInfo(fileLocation.buffer(), lock);
+    SourceLocation fileLocation = getFullyExpandedLocImpl(location);
+    auto info = getFileInfo(fileLocation.buffer());
     if (!info || !info->data)
         return "";
 
     // Avoid computing line offsets if we just need a name of `line-less file
-    if (info->lineDirectives.empty())
+    if (!info->hasLineDirectives.load(std::memory_order_acquire))
         return info->data->name;
 
-    size_t rawLine = getRawLineNumber(fileLocation, lock);
+    size_t rawLine = getRawLineNumber(fileLocation);
+
+    std::shared_lock lock(mutex);
     auto lineDirective = info->getPreviousLineDirective(rawLine);
     if (!lineDirective)
         return info->data->name;
@@ -99,8 +146,7 @@ std::string_view SourceManager::getFileName(SourceLocation location) const {
 }
 
 std::string_view SourceManager::getRawFileName(BufferID buffer) const {
-    std::shared_lock lock(mutex);
-    auto info = getFileInfo(buffer, lock);
+    auto info = getFileInfo(buffer);
     if (!info || !info->data)
         return "";
 
@@ -108,8 +154,7 @@ std::string_view SourceManager::getRawFileName(BufferID buffer) const {
 }
 
 const fs::path& SourceManager::getFullPath(BufferID buffer) const {
-    std::shared_lock lock(mutex);
-    auto info = getFileInfo(buffer, lock);
+    auto info = getFileInfo(buffer);
     if (!info || !info->data)
         return emptyPath;
 
@@ -117,8 +162,7 @@ const fs::path& SourceManager::getFullPath(BufferID buffer) const {
 }
 
 SourceLocation SourceManager::getIncludedFrom(BufferID buffer) const {
-    std::shared_lock lock(mutex);
-    auto info = getFileInfo(buffer, lock);
+    auto info = getFileInfo(buffer);
     if (!info)
         return SourceLocation();
 
@@ -126,8 +170,7 @@ SourceLocation SourceManager::getIncludedFrom(BufferID buffer) const {
 }
 
 const SourceLibrary* SourceManager::getLibraryFor(BufferID buffer) const {
-    std::shared_lock lock(mutex);
-    auto info = getFileInfo(buffer, lock);
+    auto info = getFileInfo(buffer);
     if (!info)
         return nullptr;
 
@@ -135,9 +178,8 @@ const SourceLibrary* SourceManager::getLibraryFor(BufferID buffer) const {
 }
 
 std::string_view SourceManager::getMacroName(SourceLocation location) const {
-    std::shared_lock lock(mutex);
-    while (isMacroArgLocImpl(location, lock))
-        location = getExpansionRangeImpl(location, lock).start();
+    while (isMacroArgLocImpl(location))
+        location = getExpansionRangeImpl(location).start();
 
     auto buffer = location.buffer();
     if (!buffer)
@@ -155,18 +197,15 @@ bool SourceManager::isFileLoc(SourceLocation location) const {
     if (location.buffer() == SourceLocation::NoLocation.buffer())
         return false;
 
-    std::shared_lock lock(mutex);
-    return getFileInfo(location.buffer(), lock) != nullptr;
+    return getFileInfo(location.buffer()) != nullptr;
 }
 
 bool SourceManager::isMacroLoc(SourceLocation location) const {
-    std::shared_lock lock(mutex);
-    return isMacroLocImpl(location, lock);
+    return isMacroLocImpl(location);
 }
 
 bool SourceManager::isMacroArgLoc(SourceLocation location) const {
-    std::shared_lock lock(mutex);
-    return isMacroArgLocImpl(location, lock);
+    return isMacroArgLocImpl(location);
 }
 
 bool SourceManager::isIncludedFileLoc(SourceLocation location) const {
@@ -178,35 +217,29 @@ bool SourceManager::isPreprocessedLoc(SourceLocation location) const {
 }
 
 SourceLocation SourceManager::getExpansionLoc(SourceLocation location) const {
-    std::shared_lock lock(mutex);
-    return getExpansionRangeImpl(location, lock).start();
+    return getExpansionRangeImpl(location).start();
 }
 
 SourceRange SourceManager::getExpansionRange(SourceLocation location) const {
-    std::shared_lock lock(mutex);
-    return getExpansionRangeImpl(location, lock);
+    return getExpansionRangeImpl(location);
 }
 
 SourceLocation SourceManager::getOriginalLoc(SourceLocation location) const {
-    std::shared_lock lock(mutex);
-    return getOriginalLocImpl(location, lock);
+    return getOriginalLocImpl(location);
 }
 
 SourceLocation SourceManager::getFullyOriginalLoc(SourceLocation location) const {
-    std::shared_lock lock(mutex);
-    while (isMacroLocImpl(location, lock))
-        location = getOriginalLocImpl(location, lock);
+    while (isMacroLocImpl(location))
+        location = getOriginalLocImpl(location);
     return location;
 }
 
 SourceLocation SourceManager::getFullyExpandedLoc(SourceLocation location) const {
-    std::shared_lock lock(mutex);
-    return getFullyExpandedLocImpl(location, lock);
+    return getFullyExpandedLocImpl(location);
 }
 
 std::string_view SourceManager::getSourceText(BufferID buffer) const {
-    std::shared_lock lock(mutex);
-    auto info = getFileInfo(buffer, lock);
+    auto info = getFileInfo(buffer);
     if (!info || !info->data)
         return "";
 
@@ -215,8 +248,7 @@ std::string_view SourceManager::getSourceText(BufferID buffer) const {
 }
 
 uint64_t SourceManager::getSortKey(BufferID buffer) const {
-    std::shared_lock lock(mutex);
-    auto info = getFileInfo(buffer, lock);
+    auto info = getFileInfo(buffer);
     if (!info)
         return uint64_t(buffer.getId()) << 32;
 
@@ -227,8 +259,8 @@ SourceLocation SourceManager::createExpansionLoc(SourceLocation originalLoc,
                                                  SourceRange expansionRange, bool isMacroArg) {
     std::unique_lock lock(mutex);
 
-    bufferEntries.emplace_back(ExpansionInfo(originalLoc, expansionRange, isMacroArg));
-    return SourceLocation(BufferID((uint32_t)(bufferEntries.size() - 1), ""sv), 0);
+    auto index = bufferEntries.add<ExpansionInfo>(originalLoc, expansionRange, isMacroArg);
+    return SourceLocation(BufferID((uint32_t)index, ""sv), 0);
 }
 
 SourceLocation SourceManager::createExpansionLoc(SourceLocation originalLoc,
@@ -236,8 +268,8 @@ SourceLocation SourceManager::createExpansionLoc(SourceLocation originalLoc,
                                                  std::string_view macroName) {
     std::unique_lock lock(mutex);
 
-    bufferEntries.emplace_back(ExpansionInfo(originalLoc, expansionRange, macroName));
-    return SourceLocation(BufferID((uint32_t)(bufferEntries.size() - 1), macroName), 0);
+    auto index = bufferEntries.add<ExpansionInfo>(originalLoc, expansionRange, macroName);
+    return SourceLocation(BufferID((uint32_t)index, macroName), 0);
 }
 
 SourceBuffer SourceManager::assignText(std::string_view text, SourceLocation includedFrom,
@@ -278,7 +310,7 @@ SourceBuffer SourceManager::assignBuffer(std::string_view bufferPath, SmallVecto
     }
 
     return cacheBuffer(std::move(path), std::move(pathStr), includedFrom, library, UINT64_MAX,
-                       std::move(buffer));
+                       std::move(buffer), /* fromDisk */ false);
 }
 
 SourceManager::BufferOrError SourceManager::readSource(const fs::path& path,
@@ -313,12 +345,8 @@ SourceManager::BufferOrError SourceManager::readHeader(
 
     // search relative to the current file
     const fs::path* currFileDir = nullptr;
-    {
-        std::shared_lock lock(mutex);
-        auto info = getFileInfo(includedFrom.buffer(), lock);
-        if (info && info->data)
-            currFileDir = info->data->directory;
-    }
+    if (auto info = getFileInfo(includedFrom.buffer()); info && info->data)
+        currFileDir = info->data->directory;
 
     if (currFileDir) {
         auto result = openCached(*currFileDir / p, includedFrom, library);
@@ -355,8 +383,8 @@ SourceManager::BufferOrError SourceManager::readHeader(
 void SourceManager::addLineDirective(SourceLocation location, size_t lineNum, std::string_view name,
                                      uint8_t level) {
     std::unique_lock lock(mutex);
-    SourceLocation fileLocation = getFullyExpandedLocImpl(location, lock);
-    FileInfo* info = getFileInfo(fileLocation.buffer(), lock);
+    SourceLocation fileLocation = getFullyExpandedLocImpl(location);
+    FileInfo* info = getFileInfo(fileLocation.buffer());
     if (!info || !info->data)
         return;
 
@@ -368,14 +396,15 @@ void SourceManager::addLineDirective(SourceLocation location, size_t lineNum, st
     else
         full = fs::path(info->data->name).replace_filename(linePath);
 
-    size_t sourceLineNum = getRawLineNumber(fileLocation, lock);
+    size_t sourceLineNum = getRawLineNumber(fileLocation);
     info->lineDirectives.emplace_back(std::string(getU8Str(full)), sourceLineNum, lineNum, level);
+    info->hasLineDirectives.store(true, std::memory_order_release);
 }
 
 void SourceManager::addDiagnosticDirective(SourceLocation location, std::string_view name,
                                            DiagnosticSeverity severity) {
     std::unique_lock lock(mutex);
-    SourceLocation fileLocation = getFullyExpandedLocImpl(location, lock);
+    SourceLocation fileLocation = getFullyExpandedLocImpl(location);
 
     size_t offset = fileLocation.offset();
     auto& vec = diagDirectives[fileLocation.buffer()];
@@ -398,24 +427,22 @@ std::span<const SourceManager::DiagnosticDirectiveInfo> SourceManager::getDiagno
 }
 
 std::vector<BufferID> SourceManager::getAllBuffers() const {
-    std::shared_lock lock(mutex);
     std::vector<BufferID> result;
-    for (size_t i = 1; i < bufferEntries.size(); i++)
+    const size_t count = bufferEntries.size();
+    for (size_t i = 1; i < count; i++)
         result.push_back(BufferID((uint32_t)i, ""sv));
 
     return result;
 }
 
-template<IsLock TLock>
-SourceManager::FileInfo* SourceManager::getFileInfo(BufferID buffer, TLock&) {
+SourceManager::FileInfo* SourceManager::getFileInfo(BufferID buffer) {
     if (!buffer || buffer.getId() >= bufferEntries.size())
         return nullptr;
 
     return std::get_if<FileInfo>(&bufferEntries[buffer.getId()]);
 }
 
-template<IsLock TLock>
-const SourceManager::FileInfo* SourceManager::getFileInfo(BufferID buffer, TLock&) const {
+const SourceManager::FileInfo* SourceManager::getFileInfo(BufferID buffer) const {
     if (!buffer || buffer.getId() >= bufferEntries.size())
         return nullptr;
 
@@ -432,9 +459,9 @@ SourceBuffer SourceManager::createBufferEntry(FileData* fd, SourceLocation inclu
     if (sortKey == UINT64_MAX)
         sortKey = bufferEntries.size() << 32;
 
-    bufferEntries.emplace_back(FileInfo(fd, library, includedFrom, sortKey));
+    auto index = bufferEntries.add<FileInfo>(fd, library, includedFrom, sortKey);
     return SourceBuffer{std::string_view(fd->mem.data(), fd->mem.size()), library,
-                        BufferID((uint32_t)(bufferEntries.size() - 1), fd->name)};
+                        BufferID((uint32_t)index, fd->name)};
 }
 
 bool SourceManager::isCached(const fs::path& path) const {
@@ -454,6 +481,37 @@ bool SourceManager::isCached(const fs::path& path) const {
     return it != lookupCache.end();
 }
 
+std::vector<fs::path> SourceManager::reloadChangedFiles() {
+    std::unique_lock lock(mutex);
+
+    std::vector<fs::path> changed;
+    std::vector<std::string> toRemove;
+    for (auto& [pathStr, entry] : lookupCache) {
+        auto& fd = entry.first;
+        if (!fd) {
+            toRemove.push_back(pathStr);
+            continue;
+        }
+
+        // Buffers that were assigned directly have nothing to compare against.
+        if (!fd->fromDisk)
+            continue;
+
+        SmallVector<char> buffer;
+        if (OS::readFile(fd->fullPath, buffer) ||
+            !std::ranges::equal(std::span<const char>(buffer), std::span<const char>(fd->mem))) {
+            changed.push_back(fd->fullPath);
+            staleFileData.emplace_back(std::move(fd));
+            toRemove.push_back(pathStr);
+        }
+    }
+
+    for (auto& pathStr : toRemove)
+        lookupCache.erase(pathStr);
+
+    return changed;
+}
+
 SourceManager::BufferOrError SourceManager::openCached(const fs::path& fullPath,
                                                        SourceLocation includedFrom,
                                                        const SourceLibrary* library,
@@ -493,12 +551,13 @@ SourceManager::BufferOrError SourceManager::openCached(const fs::path& fullPath,
     }
 
     return cacheBuffer(std::move(absPath), std::move(pathStr), includedFrom, library, sortKey,
-                       std::move(buffer));
+                       std::move(buffer), /* fromDisk */ true);
 }
 
 SourceBuffer SourceManager::cacheBuffer(fs::path&& path, std::string&& pathStr,
                                         SourceLocation includedFrom, const SourceLibrary* library,
-                                        uint64_t sortKey, SmallVector<char>&& buffer) {
+                                        uint64_t sortKey, SmallVector<char>&& buffer,
+                                        bool fromDisk) {
     std::string name;
     if (!disableProximatePaths) {
         std::error_code ec;
@@ -514,7 +573,7 @@ SourceBuffer SourceManager::cacheBuffer(fs::path&& path, std::string&& pathStr,
 
     auto directory = &*directories.insert(path.parent_path()).first;
     auto fd = std::make_unique<FileData>(directory, std::move(name), std::move(buffer),
-                                         std::move(path));
+                                         std::move(path), fromDisk);
 
     // Note: it's possible that insertion here fails due to another thread
     // racing against us to open and insert the same file. We do a lookup
@@ -528,63 +587,36 @@ SourceBuffer SourceManager::cacheBuffer(fs::path&& path, std::string&& pathStr,
     return createBufferEntry(fdPtr, includedFrom, library, sortKey, lock);
 }
 
-template<IsLock TLock>
-size_t SourceManager::getRawLineNumber(SourceLocation location, TLock& readLock) const {
-    FileData* fd;
-    {
-        // Separate scope so that info isn't used after it may potentially
-        // get invalidated when we briefly unloack a read lock and grab a
-        // write lock below.
-        const FileInfo* info = getFileInfo(location.buffer(), readLock);
-        if (!info || !info->data)
-            return 0;
-
-        fd = info->data;
-    }
-
-    if (fd->lineOffsets.empty()) {
-        // We need to compute line offsets. If the lock is a write lock then
-        // we can just go ahead and do that; if not we need to unlock the
-        // read lock and grab a write lock.
-        if constexpr (std::is_same_v<TLock, std::shared_lock<std::shared_mutex>>) {
-            readLock.unlock();
-
-            std::unique_lock writeLock(mutex);
-            computeLineOffsets(fd->mem, fd->lineOffsets);
+size_t SourceManager::getRawLineNumber(SourceLocation location) const {
+    const FileInfo* info = getFileInfo(location.buffer());
+    if (!info || !info->data)
+        return 0;
 
-            writeLock.unlock();
-            readLock.lock();
-        }
-        else {
-            computeLineOffsets(fd->mem, fd->lineOffsets);
-        }
-    }
+    auto lineOffsets = info->data->getLineOffsets();
 
     // Find the first line offset that is greater than the given location offset. That iterator
     // then tells us how many lines away from the beginning we are.
-    auto it = std::ranges::lower_bound(fd->lineOffsets, location.offset());
+    auto it = std::ranges::lower_bound(lineOffsets, location.offset());
 
     // We want to ensure the line we return is strictly greater than the given location offset.
     // So if it is equal, add one to the lower bound we got.
-    size_t line = size_t(it - fd->lineOffsets.begin());
-    if (it != fd->lineOffsets.end() && *it == location.offset())
+    size_t line = size_t(it - lineOffsets.begin());
+    if (it != lineOffsets.end() && *it == location.offset())
         line++;
     return line;
 }
 
-template<IsLock TLock>
-SourceLocation SourceManager::getFullyExpandedLocImpl(SourceLocation location, TLock& lock) const {
-    while (isMacroLocImpl(location, lock)) {
-        if (isMacroArgLocImpl(location, lock))
-            location = getOriginalLocImpl(location, lock);
+SourceLocation SourceManager::getFullyExpandedLocImpl(SourceLocation location) const {
+    while (isMacroLocImpl(location)) {
+        if (isMacroArgLocImpl(location))
+            location = getOriginalLocImpl(location);
         else
-            location = getExpansionRangeImpl(location, lock).start();
+            location = getExpansionRangeImpl(location).start();
     }
     return location;
 }
 
-template<IsLock TLock>
-bool SourceManager::isMacroLocImpl(SourceLocation location, TLock&) const {
+bool SourceManager::isMacroLocImpl(SourceLocation location) const {
     if (location.buffer() == SourceLocation::NoLocation.buffer())
         return false;
 
@@ -596,8 +628,7 @@ bool SourceManager::isMacroLocImpl(SourceLocation location, TLock&) const {
     return std::get_if<ExpansionInfo>(&bufferEntries[buffer.getId()]) != nullptr;
 }
 
-template<IsLock TLock>
-bool SourceManager::isMacroArgLocImpl(SourceLocation location, TLock&) const {
+bool SourceManager::isMacroArgLocImpl(SourceLocation location) const {
     if (location == SourceLocation::NoLocation)
         return false;
 
@@ -610,8 +641,7 @@ bool SourceManager::isMacroArgLocImpl(SourceLocation location, TLock&) const {
     return info && info->isMacroArg;
 }
 
-template<IsLock TLock>
-SourceRange SourceManager::getExpansionRangeImpl(SourceLocation location, TLock&) const {
+SourceRange SourceManager::getExpansionRangeImpl(SourceLocation location) const {
     auto buffer = location.buffer();
     if (!buffer)
         return SourceRange();
@@ -620,8 +650,7 @@ SourceRange SourceManager::getExpansionRangeImpl(SourceLocation location, TLock&
     return std::get<ExpansionInfo>(bufferEntries[buffer.getId()]).expansionRange;
 }
 
-template<IsLock TLock>
-SourceLocation SourceManager::getOriginalLocImpl(SourceLocation location, TLock&) const {
+SourceLocation SourceManager::getOriginalLocImpl(SourceLocation location) const {
     auto buffer = location.buffer();
     if (!buffer)
         return SourceLocation();
@@ -630,24 +659,47 @@ SourceLocation SourceManager::getOriginalLocImpl(SourceLocation location, TLock&
     return std::get<ExpansionInfo>(bufferEntries[buffer.getId()]).originalLoc + location.offset();
 }
 
+std::span<const size_t> SourceManager::FileData::getLineOffsets() const {
+    std::call_once(lineOffsetsFlag, [this] { computeLineOffsets(mem, lineOffsets); });
+    return lineOffsets;
+}
+
 void SourceManager::computeLineOffsets(const SmallVector<char>& buffer,
                                        std::vector<size_t>& offsets) noexcept {
     // first line always starts at offset 0
     offsets.push_back(0);
 
-    const char* ptr = buffer.data();
-    const char* end = buffer.data() + buffer.size();
-    while (ptr != end) {
-        if (ptr[0] == '\n' || ptr[0] == '\r') {
-            // if we see \r\n or \n\r skip both chars
-            if ((ptr[1] == '\n' || ptr[1] == '\r') && ptr[0] != ptr[1])
-                ptr++;
-            ptr++;
-            offsets.push_back((size_t)(ptr - buffer.data()));
-        }
-        else {
-            ptr++;
+    const char* data = buffer.data();
+    const size_t size = buffer.size();
+
+    // Records the start of the line following the line break at the given
+    // offset and returns it. If we see \r\n or \n\r we skip both chars.
+    auto lineBreak = [&](size_t i) {
+        if (i + 1 < size && (data[i + 1] == '\n' || data[i + 1] == '\r') && data[i] != data[i + 1])
+            i++;
+        offsets.push_back(++i);
+        return i;
+    };
+
+    // Search a block at a time and only look at the individual characters
+    // that were found to be newlines.
+    size_t i = 0;
+    while (i + NewlineBlockSize <= size) {
+        const size_t blockStart = i;
+        for (uint64_t mask = findNewlines(data + blockStart); mask; mask &= mask - 1) {
+            // Skip the second character of a pair handled by the previous break.
+            size_t pos = blockStart + size_t(std::countr_zero(mask)) / NewlineMaskStride;
+            if (pos >= i)
+                i = lineBreak(pos);
         }
+        i = std::max(i, blockStart + NewlineBlockSize);
+    }
+
+    while (i < size) {
+        if (data[i] == '\n' || data[i] == '\r')
+            i = lineBreak(i);
+        else
+            i++;
     }
 }
 
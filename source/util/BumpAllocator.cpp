@@ -9,6 +9,8 @@
 
 #include <new>
 
+#include "slang/util/TimeTrace.h"
+
 namespace slang {
 
 BumpAllocator::BumpAllocator() {
@@ -26,7 +28,9 @@ BumpAllocator::~BumpAllocator() {
 }
 
 BumpAllocator::BumpAllocator(BumpAllocator&& other) noexcept :
-    head(std::exchange(other.head, nullptr)), endPtr(other.endPtr) {
+    head(std::exchange(other.head, nullptr)), endPtr(other.endPtr),
+    segmentCount(std::exchange(other.segmentCount, 0)),
+    bytesAllocated(std::exchange(other.bytesAllocated, 0)) {
 }
 
 BumpAllocator& BumpAllocator::operator=(BumpAllocator&& other) noexcept {
@@ -47,6 +51,8 @@ void BumpAllocator::steal(BumpAllocator&& other) {
 
     seg->prev = head->prev;
     head->prev = std::exchange(other.head, nullptr);
+    segmentCount += std::exchange(other.segmentCount, 0);
+    bytesAllocated += std::exchange(other.bytesAllocated, 0);
 }
 
 byte* BumpAllocator::allocateSlow(size_t size, size_t alignment) {
@@ -64,6 +70,13 @@ byte* BumpAllocator::allocateSlow(size_t size, size_t alignment) {
 }
 
 BumpAllocator::Segment* BumpAllocator::allocSegment(Segment* prev, size_t size) {
+    segmentCount++;
+    bytesAllocated += size;
+    if (TimeTrace::isEnabled()) {
+        TimeTrace::count("allocatorSegments"sv);
+        TimeTrace::count("allocatedBytes"sv, size);
+    }
+
     auto seg = (Segment*)::operator new(size);
     seg->prev = prev;
     seg->current = (byte*)seg + sizeof(Segment);
@@ -0,0 +1,58 @@
+//------------------------------------------------------------------------------
+// CancellationToken.cpp
+// Cooperative cancellation of long running work
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#include "slang/util/CancellationToken.h"
+
+#include <fmt/core.h>
+
+using namespace std::chrono;
+
+namespace slang {
+
+void CancellationToken::start(milliseconds newTimeLimit, size_t newMemoryLimit) {
+    reason.store(Reason::None, std::memory_order_relaxed);
+    pollCount.store(0, std::memory_order_relaxed);
+    timeLimit = newTimeLimit;
+    deadline = steady_clock::now() + timeLimit;
+    memoryLimit = newMemoryLimit;
+}
+
+void CancellationToken::cancel(Reason why) {
+    // The first reason sticks, since that's the one that actually stopped the work.
+    auto expected = Reason::None;
+    reason.compare_exchange_strong(expected, why, std::memory_order_relaxed);
+}
+
+bool CancellationToken::check(size_t memoryInUse) {
+    if (isCancelled())
+        return true;
+
+    if (memoryLimit && memoryInUse > memoryLimit)
+        cancel(Reason::MemoryLimit);
+    else if (timeLimit.count() && steady_clock::now() >= deadline)
+        cancel(Reason::TimeLimit);
+
+    return isCancelled();
+}
+
+std::string CancellationToken::getReasonString() const {
+    switch (getReason()) {
+        case Reason::None:
+            return "not cancelled";
+        case Reason::Requested:
+            return "cancellation was requested";
+        case Reason::TimeLimit:
+            return fmt::format("time limit of {}s exceeded",
+                               duration<double>(timeLimit).count());
+        case Reason::MemoryLimit:
+            return fmt::format("memory limit of {} MB exceeded",
+                               double(memoryLimit) / (1024 * 1024));
+    }
+    SLANG_UNREACHABLE;
+}
+
+} // namespace slang
@@ -26,6 +26,7 @@
 #    include <io.h>
 #else
 #    include <fcntl.h>
+#    include <sys/mman.h>
 #    include <sys/stat.h>
 #    include <unistd.h>
 #endif
@@ -177,6 +178,45 @@ std::error_code OS::readFile(const fs::path& path, SmallVector<char>& buffer) {
     return ec;
 }
 
+std::error_code OS::mapFile(const fs::path& path, std::span<const char>& contents) {
+    contents = {};
+    HANDLE handle = ::CreateFileW(path.native().c_str(), GENERIC_READ,
+                                  FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (handle == INVALID_HANDLE_VALUE)
+        return std::error_code(::GetLastError(), std::system_category());
+
+    std::error_code ec;
+    LARGE_INTEGER fileSize;
+    if (!::GetFileSizeEx(handle, &fileSize)) {
+        ec.assign(::GetLastError(), std::system_category());
+    }
+    else if (fileSize.QuadPart > 0) {
+        // The view remains valid after both handles are closed.
+        HANDLE mapping = ::CreateFileMappingW(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (!mapping) {
+            ec.assign(::GetLastError(), std::system_category());
+        }
+        else {
+            auto view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            if (!view)
+                ec.assign(::GetLastError(), std::system_category());
+            else
+                contents = {static_cast<const char*>(view), size_t(fileSize.QuadPart)};
+
+            ::CloseHandle(mapping);
+        }
+    }
+
+    ::CloseHandle(handle);
+    return ec;
+}
+
+void OS::unmapFile(std::span<const char> contents) {
+    if (!contents.empty())
+        ::UnmapViewOfFile(contents.data());
+}
+
 #else
 
 void OS::setupConsole() {
@@ -284,6 +324,45 @@ std::error_code OS::readFile(const fs::path& path, SmallVector<char>& buffer) {
     return ec;
 }
 
+std::error_code OS::mapFile(const fs::path& path, std::span<const char>& contents) {
+    contents = {};
+
+    int fd;
+    while (true) {
+        fd = ::open(path.native().c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd >= 0)
+            break;
+
+        if (errno != EINTR)
+            return std::error_code(errno, std::generic_category());
+    }
+
+    std::error_code ec;
+    struct stat status;
+    if (::fstat(fd, &status) != 0) {
+        ec.assign(errno, std::generic_category());
+    }
+    else if (status.st_size > 0) {
+        // The mapping remains valid after the descriptor is closed.
+        auto fileSize = (size_t)status.st_size;
+        void* addr = ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED)
+            ec.assign(errno, std::generic_category());
+        else
+            contents = {static_cast<const char*>(addr), fileSize};
+    }
+
+    if (::close(fd) < 0 && !ec)
+        ec.assign(errno, std::generic_category());
+
+    return ec;
+}
+
+void OS::unmapFile(std::span<const char> contents) {
+    if (!contents.empty())
+        ::munmap(const_cast<char*>(contents.data()), contents.size());
+}
+
 #endif
 
 void OS::writeFile(const fs::path& path, std::string_view contents) {
@@ -7,6 +7,7 @@
 //------------------------------------------------------------------------------
 #include "slang/util/TimeTrace.h"
 
+#include <algorithm>
 #include <chrono>
 #include <fmt/core.h>
 #include <mutex>
@@ -49,17 +50,24 @@ static std::string escapeString(std::string_view src) {
     return result;
 }
 
+// Counters are keyed by group and name; ungrouped counters have an empty group.
+using CounterKey = std::tuple<std::string_view, std::string_view>;
+using CounterMap = flat_hash_map<CounterKey, uint64_t>;
+
 struct Entry {
     time_point<steady_clock> start;
     DurationType duration;
     std::thread::id threadId;
     std::string name;
     std::string detail;
+    CounterMap counters;
 };
 
 struct TimeTrace::Profiler {
     static thread_local std::vector<Entry> stack;
+    static thread_local Entry* threadRoot;
     std::vector<Entry> entries;
+    std::vector<std::unique_ptr<Entry>> roots;
     time_point<steady_clock> startTime;
     std::mutex mut;
 
@@ -69,8 +77,8 @@ struct TimeTrace::Profiler {
     }
 
     void begin(std::string name, function_ref<std::string()> detail) {
-        stack.push_back(
-            Entry{steady_clock::now(), {}, std::this_thread::get_id(), std::move(name), detail()});
+        stack.push_back(Entry{steady_clock::now(), {}, std::this_thread::get_id(), std::move(name),
+                              detail(), {}});
     }
 
     void end() {
@@ -80,6 +88,13 @@ struct TimeTrace::Profiler {
         auto&& entry = stack.back();
         entry.duration = steady_clock::now() - entry.start;
 
+        // Counters are inclusive of nested sections.
+        if (stack.size() > 1) {
+            auto& parent = stack[stack.size() - 2];
+            for (auto& [key, value] : entry.counters)
+                parent.counters[key] += value;
+        }
+
         // Only include sections longer than 500us.
         if (duration_cast<microseconds>(entry.duration).count() > 500) {
             std::scoped_lock lock(mut);
@@ -89,6 +104,56 @@ struct TimeTrace::Profiler {
         stack.pop_back();
     }
 
+    void count(CounterKey key, uint64_t amount) {
+        if (!stack.empty()) {
+            stack.back().counters[key] += amount;
+            return;
+        }
+
+        // Counts made outside of any section go to a root entry for the thread,
+        // which is only ever touched by that thread until the trace is written.
+        if (!threadRoot) {
+            std::scoped_lock lock(mut);
+            threadRoot = roots
+                             .emplace_back(std::make_unique<Entry>(
+                                 Entry{startTime, {}, std::this_thread::get_id(), "Thread", "", {}}))
+                             .get();
+        }
+        threadRoot->counters[key] += amount;
+    }
+
+    static std::string formatArgs(const Entry& entry) {
+        std::string result = fmt::format("\"detail\":\"{}\"", escapeString(entry.detail));
+
+        std::vector<std::pair<CounterKey, uint64_t>> counters(entry.counters.begin(),
+                                                              entry.counters.end());
+        std::ranges::sort(counters);
+
+        std::string_view currGroup;
+        for (auto& [key, value] : counters) {
+            auto& [group, name] = key;
+            if (group != currGroup) {
+                if (!currGroup.empty())
+                    result += " }";
+
+                currGroup = group;
+                if (!group.empty())
+                    result += fmt::format(", \"{}\":{{ ", escapeString(group));
+            }
+            else if (!group.empty()) {
+                result += ", ";
+            }
+
+            if (group.empty())
+                result += ", ";
+            result += fmt::format("\"{}\":{}", escapeString(name), value);
+        }
+
+        if (!currGroup.empty())
+            result += " }";
+        return result;
+    }
+
     void write(std::ostream& os) {
         SLANG_ASSERT(stack.empty());
         std::scoped_lock lock(mut);
@@ -109,13 +174,23 @@ struct TimeTrace::Profiler {
 
         os << "{ \"traceEvents\": [\n";
 
-        for (auto& entry : entries) {
+        auto writeEntry = [&](const Entry& entry) {
             auto startUs = duration_cast<microseconds>(entry.start - startTime).count();
             auto durationUs = duration_cast<microseconds>(entry.duration).count();
             os << fmt::format("{{ \"pid\":1, \"tid\":{}, \"ph\":\"X\", \"ts\":{}, "
-                              "\"dur\":{}, \"name\":\"{}\", \"args\":{{ \"detail\":\"{}\" }} }},\n",
+                              "\"dur\":{}, \"name\":\"{}\", \"args\":{{ {} }} }},\n",
                               getTID(entry.threadId), startUs, durationUs, escapeString(entry.name),
-                              escapeString(entry.detail));
+                              formatArgs(entry));
+        };
+
+        for (auto& entry : entries)
+            writeEntry(entry);
+
+        // Each thread's root entry spans the whole trace.
+        auto now = steady_clock::now();
+        for (auto& root : roots) {
+            root->duration = now - startTime;
+            writeEntry(*root);
         }
 
         // Emit metadata event with process name.
@@ -126,6 +201,7 @@ struct TimeTrace::Profiler {
 };
 
 thread_local std::vector<Entry> TimeTrace::Profiler::stack;
+thread_local Entry* TimeTrace::Profiler::threadRoot = nullptr;
 
 void TimeTrace::initialize() {
     SLANG_ASSERT(!profiler);
@@ -152,4 +228,14 @@ void TimeTrace::endTrace() {
         profiler->end();
 }
 
+void TimeTrace::count(std::string_view name, uint64_t amount) {
+    if (profiler)
+        profiler->count({std::string_view(), name}, amount);
+}
+
+void TimeTrace::count(std::string_view group, std::string_view name, uint64_t amount) {
+    if (profiler)
+        profiler->count({group, name}, amount);
+}
+
 } // namespace slang
@@ -0,0 +1,130 @@
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "slang/numeric/SVInt.h"
+
+using namespace slang;
+
+namespace {
+
+// Builds a value of the given width with random bits. If fourState is set
+// roughly one bit in sixteen will be an X or Z.
+SVInt randomValue(std::mt19937& rng, bitwidth_t bits, bool fourState) {
+    std::string str = std::to_string(bits) + "'b";
+    str.reserve(str.size() + bits);
+    for (bitwidth_t i = 0; i < bits; i++) {
+        auto r = rng() % 16;
+        if (fourState && r == 14)
+            str += 'x';
+        else if (fourState && r == 15)
+            str += 'z';
+        else
+            str += char('0' + (r & 1));
+    }
+    return SVInt::fromString(str);
+}
+
+void benchmarkKernels(bitwidth_t bits, bool fourState) {
+    std::mt19937 rng(bits);
+    auto a = randomValue(rng, bits, fourState);
+    auto b = randomValue(rng, bits, fourState);
+
+    auto name = [&](const char* op) {
+        return std::string(op) + " " + std::to_string(bits) + (fourState ? " 4-state" : "");
+    };
+
+    BENCHMARK(name("and")) {
+        return a & b;
+    };
+    BENCHMARK(name("or")) {
+        return a | b;
+    };
+    BENCHMARK(name("xor")) {
+        return a ^ b;
+    };
+    BENCHMARK(name("xnor")) {
+        return a.xnor(b);
+    };
+    BENCHMARK(name("add")) {
+        return a + b;
+    };
+
+    // Inputs for which the reductions can't exit early and have to look at every word.
+    auto allX = SVInt::createFillX(bits, false);
+    auto ones = SVInt(bits, 0, false) - 1;
+    auto zero = SVInt(bits, 0, false);
+    auto& andInput = fourState ? allX : ones;
+    auto& orInput = fourState ? allX : zero;
+
+    BENCHMARK(name("reduction and")) {
+        return andInput.reductionAnd();
+    };
+    BENCHMARK(name("reduction or")) {
+        return orInput.reductionOr();
+    };
+    BENCHMARK(name("reduction xor")) {
+        return a.reductionXor();
+    };
+}
+
+} // namespace
+
+TEST_CASE("SVInt multiply and divide crossover", "[svint]") {
+    // Sizes on both sides of the Karatsuba and recursive division cutoffs,
+    // so that changes to the thresholds can be checked for a smooth curve.
+    std::mt19937 rng(1);
+    for (bitwidth_t words : {4u, 8u, 16u, 32u, 64u, 128u}) {
+        // The operands are extended so that the full product is computed.
+        auto a = randomValue(rng, words * 64, false).zext(words * 128);
+        auto b = randomValue(rng, words * 64, false).zext(words * 128);
+
+        BENCHMARK("mul " + std::to_string(words) + " words") {
+            return a * b;
+        };
+    }
+
+    for (bitwidth_t words : {20u, 40u, 80u, 160u, 320u}) {
+        auto a = randomValue(rng, words * 128, false);
+        auto b = randomValue(rng, words * 64, false).zext(words * 128);
+
+        BENCHMARK("div " + std::to_string(words * 2) + "/" + std::to_string(words) + " words") {
+            return a / b;
+        };
+    }
+}
+
+TEST_CASE("SVInt wide arithmetic", "[svint]") {
+    std::mt19937 rng(2);
+    for (bitwidth_t bits : {1024u, 4096u, 16384u, 65536u}) {
+        auto a = randomValue(rng, bits, false);
+        auto b = randomValue(rng, bits / 2, false).zext(bits);
+        auto exponent = SVInt(32, 1000, false);
+        auto suffix = " " + std::to_string(bits);
+
+        BENCHMARK("mul" + suffix) {
+            return a * b;
+        };
+        BENCHMARK("div" + suffix) {
+            return a / b;
+        };
+        BENCHMARK("rem" + suffix) {
+            return a % b;
+        };
+        BENCHMARK("pow" + suffix) {
+            return a.pow(exponent);
+        };
+    }
+}
+
+TEST_CASE("SVInt wide bitwise kernels", "[svint]") {
+    for (bitwidth_t bits : {256u, 4096u, 65536u}) {
+        benchmarkKernels(bits, false);
+        benchmarkKernels(bits, true);
+    }
+}
@@ -0,0 +1,9 @@
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+
+#include <catch2/catch_session.hpp>
+
+int main(int argc, char* argv[]) {
+    Catch::Session session;
+    return session.run(argc, argv);
+}
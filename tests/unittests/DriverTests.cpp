@@ -4,10 +4,15 @@
 #include "Test.h"
 #include <fmt/core.h>
 #include <regex>
+#include <sstream>
 
 #include "slang/ast/symbols/CompilationUnitSymbols.h"
 #include "slang/ast/symbols/InstanceSymbols.h"
+#include "slang/ast/symbols/VariableSymbols.h"
+#include "slang/ast/types/Type.h"
 #include "slang/driver/Driver.h"
+#include "slang/text/Json.h"
+#include "slang/util/String.h"
 
 using namespace slang::driver;
 
@@ -391,6 +396,16 @@ TEST_CASE("Driver command files") {
     auto compilation = driver.createCompilation();
     CHECK(driver.reportCompilation(*compilation, false));
     CHECK(stdoutContains("Build succeeded"));
+
+    // The command files that were read and the files they added are recorded.
+    auto commandFiles = driver.getCommandFiles();
+    REQUIRE(commandFiles.size() == 1);
+    CHECK(commandFiles[0].path.filename() == "cmd.f");
+    CHECK(commandFiles[0].contents.find("-v test.sv") != std::string::npos);
+
+    auto filePaths = driver.sourceLoader.getFilePaths();
+    REQUIRE(filePaths.size() == 1);
+    CHECK(filePaths[0].filename() == "test.sv");
 }
 
 TEST_CASE("Driver command file errors") {
@@ -695,3 +710,418 @@ TEST_CASE("Driver customize default lib name") {
     CHECK(units[0]->getSourceLibrary()->name == "blah");
     CHECK(units[1]->getSourceLibrary()->name == "blah");
 }
+
+TEST_CASE("Driver streaming diagnostics") {
+    auto guard = OS::captureOutput();
+
+    Driver driver;
+    driver.addStandardArgs();
+
+    auto args = fmt::format("testfoo \"{0}test4.sv\" --allow-use-before-declare --error-limit=2 "
+                            "--top=baz --stream-diagnostics",
+                            findTestDir());
+    CHECK(driver.parseCommandLine(args));
+    CHECK(driver.processOptions());
+    CHECK(driver.parseAllSources());
+
+    auto compilation = driver.createCompilation();
+    CHECK(!driver.reportCompilation(*compilation, false));
+    CHECK(stdoutContains("Build failed"));
+    CHECK(stdoutContains("1 error, 1 warning"));
+}
+
+TEST_CASE("Driver reparses only changed sources") {
+    std::error_code ec;
+    auto dir = fs::temp_directory_path(ec) / "slang_driver_reparse";
+    fs::create_directories(dir, ec);
+
+    auto header = dir / "defs.svh";
+    auto fileA = dir / "a.sv";
+    auto fileB = dir / "b.sv";
+    OS::writeFile(header, "`define WIDTH 4\n");
+    OS::writeFile(fileA, "`include \"defs.svh\"\nmodule a; logic [`WIDTH-1:0] x; endmodule\n");
+    OS::writeFile(fileB, "module b; endmodule\n");
+
+    Driver driver;
+    driver.addStandardArgs();
+
+    auto pathA = getU8Str(fileA);
+    auto pathB = getU8Str(fileB);
+    const char* argv[] = {"testfoo", pathA.c_str(), pathB.c_str()};
+    CHECK(driver.parseCommandLine(3, argv));
+    CHECK(driver.processOptions());
+    CHECK(driver.parseAllSources());
+    REQUIRE(driver.syntaxTrees.size() == 2);
+
+    auto findTree = [&](const fs::path& path) {
+        for (auto& tree : driver.syntaxTrees) {
+            auto id = tree->getSourceBufferIds()[0];
+            if (driver.sourceManager.getFullPath(id).filename() == path.filename())
+                return tree;
+        }
+        return std::shared_ptr<SyntaxTree>();
+    };
+
+    auto treeA = findTree(fileA);
+    auto treeB = findTree(fileB);
+    REQUIRE(treeA);
+    REQUIRE(treeB);
+
+    auto before = driver.syntaxTrees;
+    CHECK(driver.reparseChangedSources());
+    CHECK(driver.syntaxTrees == before);
+
+    // Changing the header only reparses the file that includes it.
+    OS::writeFile(header, "`define WIDTH 8\n");
+    CHECK(driver.reparseChangedSources());
+    CHECK(findTree(fileA) != treeA);
+    CHECK(findTree(fileB) == treeB);
+
+    auto compilation = driver.createCompilation();
+    auto& x = compilation->getRoot().lookupName<VariableSymbol>("a.x");
+    CHECK(x.getType().getBitWidth() == 8);
+
+    // Once a file can't be read anymore the driver has to start over.
+    fs::remove(fileB, ec);
+    CHECK(!driver.reparseChangedSources());
+
+    fs::remove_all(dir, ec);
+}
+
+TEST_CASE("Driver batch elaboration") {
+    auto guard = OS::captureOutput();
+
+    std::error_code ec;
+    auto dir = fs::temp_directory_path(ec) / "slang_driver_batch";
+    fs::create_directories(dir, ec);
+
+    auto source = dir / "top.sv";
+    auto batch = dir / "configs.txt";
+    OS::writeFile(source, R"(
+module top #(parameter int W = 4);
+    logic [W-1:0] x;
+    if (W > 8) begin : g
+        $error("too wide");
+    end
+endmodule
+
+module other;
+endmodule
+)");
+    OS::writeFile(batch, R"(// Configurations for the regression
+--name narrow --top top
+
+--top top -G W=16
+--name other --top=other --compat vcs # trailing comment
+)");
+
+    Driver driver;
+    driver.addStandardArgs();
+
+    auto sourcePath = getU8Str(source);
+    auto batchArg = "--batch=" + getU8Str(batch);
+    const char* argv[] = {"testfoo", sourcePath.c_str(), batchArg.c_str(), "-GW=2"};
+    CHECK(driver.parseCommandLine(4, argv));
+    CHECK(driver.processOptions());
+    CHECK(driver.parseAllSources());
+
+    REQUIRE(driver.batchConfigs.size() == 3);
+    CHECK(driver.batchConfigs[0].name == "narrow");
+    CHECK(driver.batchConfigs[1].name == getU8Str(batch) + ":4");
+    CHECK(driver.batchConfigs[1].paramOverrides == std::vector<std::string>{"W=16"});
+    CHECK(driver.batchConfigs[2].name == "other");
+    CHECK(driver.batchConfigs[2].compat == "vcs");
+
+    // The configuration's parameter overrides win over the driver's.
+    auto compilation = driver.createCompilation(driver.batchConfigs[1]);
+    auto& x = compilation->getRoot().lookupName<VariableSymbol>("top.x");
+    CHECK(x.getType().getBitWidth() == 16);
+
+    compilation = driver.createCompilation();
+    auto& y = compilation->getRoot().lookupName<VariableSymbol>("top.x");
+    CHECK(y.getType().getBitWidth() == 2);
+
+    CHECK(!driver.runBatch(false));
+    CHECK(stdoutContains("Configuration 'narrow':"));
+    CHECK(stdoutContains("Configuration 'other':"));
+    CHECK(stdoutContains("Build failed: 1 error"));
+    CHECK(stdoutContains("Batch failed: 1 of 3 configurations failed"));
+    CHECK(stderrContains("too wide"));
+
+    fs::remove_all(dir, ec);
+}
+
+TEST_CASE("Driver batch file errors") {
+    auto guard = OS::captureOutput();
+
+    std::error_code ec;
+    auto dir = fs::temp_directory_path(ec) / "slang_driver_batch_errors";
+    fs::create_directories(dir, ec);
+
+    auto batch = dir / "configs.txt";
+    OS::writeFile(batch, "--top top --compat blah\n");
+
+    Driver driver;
+    driver.addStandardArgs();
+
+    auto args = fmt::format("testfoo \"{}test.sv\" --batch \"{}\"", findTestDir(),
+                            getU8Str(batch));
+    CHECK(driver.parseCommandLine(args));
+    CHECK(!driver.processOptions());
+    CHECK(stderrContains("invalid value for compat option in configuration"));
+
+    OS::writeFile(batch, "--top top foo.sv\n");
+
+    Driver driver2;
+    driver2.addStandardArgs();
+    CHECK(!driver2.parseCommandLine(args));
+    CHECK(stderrContains(":1: "));
+
+    fs::remove_all(dir, ec);
+}
+
+TEST_CASE("Driver dependency scan") {
+    auto guard = OS::captureOutput();
+
+    std::error_code ec;
+    auto dir = fs::temp_directory_path(ec) / "slang_driver_deps";
+    fs::create_directories(dir, ec);
+
+    auto pkgFile = dir / "pkg.sv";
+    auto subFile = dir / "sub.sv";
+    auto topFile = dir / "top.sv";
+    OS::writeFile(dir / "defs.svh", "`define W 4\n");
+    OS::writeFile(pkgFile, "package p; typedef logic [3:0] t; endpackage\n");
+    OS::writeFile(subFile, "`include \"defs.svh\"\nmodule sub; p::t x; endmodule\n");
+    OS::writeFile(topFile, R"(
+module top;
+    import std::*;
+    sub s1();
+    sub s2();
+    missing m();
+    leaf l();
+endmodule
+
+module leaf;
+endmodule
+)");
+
+    Driver driver;
+    driver.addStandardArgs();
+
+    auto pkgPath = getU8Str(pkgFile);
+    auto subPath = getU8Str(subFile);
+    auto topPath = getU8Str(topFile);
+    const char* argv[] = {"testfoo", pkgPath.c_str(), subPath.c_str(), topPath.c_str()};
+    CHECK(driver.parseCommandLine(4, argv));
+    CHECK(driver.processOptions());
+    CHECK(driver.parseAllSources());
+
+    auto deps = driver.scanDependencies();
+    REQUIRE(deps.size() == 3);
+
+    auto& pkg = deps[0];
+    CHECK(pkg.definitions == std::vector<std::string_view>{"p"});
+    CHECK(pkg.dependsOn.empty());
+
+    auto& sub = deps[1];
+    REQUIRE(sub.includes.size() == 1);
+    CHECK(sub.includes[0].ends_with("defs.svh"));
+    CHECK(sub.packages == std::vector<std::string_view>{"p"});
+    CHECK(sub.dependsOn == std::vector<size_t>{0});
+
+    auto& top = deps[2];
+    CHECK(top.definitions == std::vector<std::string_view>{"top", "leaf"});
+    CHECK(top.instances == std::vector<std::string_view>{"sub"});
+    CHECK(top.unresolved == std::vector<std::string_view>{"missing"});
+    CHECK(top.dependsOn == std::vector<size_t>{1});
+
+    std::ostringstream perUnit;
+    driver.writeDepfile(perUnit, deps, "");
+    auto perUnitText = perUnit.str();
+    CHECK(perUnitText.find(top.files[0] + ": \\\n  " + sub.files[0] + "\n") !=
+          std::string::npos);
+    CHECK(perUnitText.find(sub.includes[0]) != std::string::npos);
+
+    std::ostringstream single;
+    driver.writeDepfile(single, deps, "out dir/design.stamp");
+    auto singleText = single.str();
+    CHECK(singleText.starts_with("out\\ dir/design.stamp:"));
+    CHECK(singleText.find(pkg.files[0]) != std::string::npos);
+    CHECK(singleText.find(sub.includes[0]) != std::string::npos);
+
+    JsonWriter writer;
+    Driver::writeDependencyGraph(writer, deps);
+    auto json = std::string(writer.view());
+    CHECK(json.find(R"("unresolved":["missing"])") != std::string::npos);
+    CHECK(json.find(R"("dependsOn":[1])") != std::string::npos);
+
+    fs::remove_all(dir, ec);
+}
+
+TEST_CASE("Driver minimal filelist pruning") {
+    auto guard = OS::captureOutput();
+
+    std::error_code ec;
+    auto dir = fs::temp_directory_path(ec) / "slang_driver_prune";
+    fs::create_directories(dir, ec);
+
+    auto write = [&](const char* name, std::string_view text) {
+        OS::writeFile(dir / name, text);
+        return getU8Str(dir / name);
+    };
+
+    write("defs.svh", "`define W 4\n");
+    auto pkg = write("pkg.sv",
+                     "`include \"defs.svh\"\npackage p; typedef logic [`W-1:0] t; endpackage\n");
+    auto unusedPkg = write("unused_pkg.sv", "package q; typedef int t; endpackage\n");
+    auto intf = write("intf.sv", "interface bus; logic a; endinterface\n");
+    auto sub = write("sub.sv", R"(module sub(bus b);
+    p::t x;
+    module inner; endmodule
+    inner i();
+endmodule
+)");
+    auto top = write("top.sv", "module top; bus b(); sub s(.b(b)); libmod l(); endmodule\n");
+    auto other = write("other.sv", "module other; q::t y; sub s(); endmodule\n");
+    auto chk = write("chk.sv", "module chk; endmodule\n");
+    auto binds = write("binds.sv", "bind sub chk c();\n");
+    auto lib = write("lib.sv", "module libmod; endmodule\n");
+
+    Driver driver;
+    driver.addStandardArgs();
+
+    const char* argv[] = {"testfoo",   pkg.c_str(),   unusedPkg.c_str(), intf.c_str(),
+                          sub.c_str(), top.c_str(),   other.c_str(),     chk.c_str(),
+                          binds.c_str(), "-v",        lib.c_str(),       "--top=top"};
+    CHECK(driver.parseCommandLine(12, argv));
+    CHECK(driver.processOptions());
+    CHECK(driver.parseAllSources());
+
+    auto compilation = driver.createCompilation();
+    auto sources = driver.findRequiredSources(*compilation);
+    CHECK(sources.unresolved.empty());
+
+    std::vector<std::string> files;
+    for (auto buffer : sources.files)
+        files.push_back(getU8Str(driver.sourceManager.getFullPath(buffer).filename()));
+    std::ranges::sort(files);
+    CHECK(files == std::vector<std::string>{"binds.sv", "chk.sv", "intf.sv", "lib.sv", "pkg.sv",
+                                            "sub.sv", "top.sv"});
+
+    REQUIRE(sources.includes.size() == 1);
+    CHECK(driver.sourceManager.getFullPath(sources.includes[0]).filename() == "defs.svh");
+
+    std::ostringstream filelist;
+    driver.writeFilelist(filelist, sources);
+    auto filelistText = filelist.str();
+    CHECK(filelistText.find("-v " + lib) != std::string::npos);
+    CHECK(filelistText.find("other.sv") == std::string::npos);
+
+    // Running again from just the pruned list of files still elaborates the design.
+    auto prunedFile = write("pruned.f", filelistText);
+    auto args = fmt::format("testfoo -f \"{}\" --top=top", prunedFile);
+
+    Driver driver2;
+    driver2.addStandardArgs();
+    CHECK(driver2.parseCommandLine(args));
+    CHECK(driver2.processOptions());
+    CHECK(driver2.parseAllSources());
+    CHECK(driver2.syntaxTrees.size() == 7);
+
+    auto compilation2 = driver2.createCompilation();
+    CHECK(driver2.reportCompilation(*compilation2, false));
+    CHECK(stdoutContains("Build succeeded"));
+
+    fs::remove_all(dir, ec);
+}
+
+TEST_CASE("Driver phase budgets") {
+    auto guard = OS::captureOutput();
+
+    // Parsing stops before starting on a file once the budget is used up.
+    SourceManager sourceManager;
+    SourceLoader loader(sourceManager);
+    loader.addFiles(findTestDir() + "test.sv");
+    loader.addFiles(findTestDir() + "test2.sv");
+
+    SourceOptions soptions{};
+    soptions.maxParseMemory = 1;
+    Bag bag;
+    bag.set(soptions);
+
+    auto trees = loader.loadAndParseSources(bag);
+    CHECK(trees.size() == 1);
+    REQUIRE(loader.getErrors().size() == 1);
+    CHECK(loader.getErrors()[0].starts_with(
+        "loading and parsing sources was cancelled: memory limit of"));
+    CHECK(loader.wasCancelled());
+
+    std::error_code ec;
+    auto dir = fs::temp_directory_path(ec) / "slang_driver_budgets";
+    fs::create_directories(dir, ec);
+
+    // The driver reports the cancellation so that callers can skip elaboration.
+    {
+        std::string text;
+        for (int i = 0; i < 20000; i++)
+            text += fmt::format("module m{0}(input logic [7:0] a, output logic [7:0] b); "
+                                "assign b = a + {0}; endmodule\n",
+                                i);
+
+        auto big1 = dir / "big1.sv";
+        auto big2 = dir / "big2.sv";
+        OS::writeFile(big1, text);
+        OS::writeFile(big2, text);
+
+        Driver driver;
+        driver.addStandardArgs();
+
+        auto path1 = getU8Str(big1);
+        auto path2 = getU8Str(big2);
+        const char* argv[] = {"testfoo", path1.c_str(), path2.c_str(), "--max-parse-memory=1",
+                              "--threads=1"};
+        CHECK(driver.parseCommandLine(5, argv));
+        CHECK(driver.processOptions());
+        CHECK(!driver.parseAllSources());
+        CHECK(driver.wasParseCancelled());
+        CHECK(driver.syntaxTrees.size() == 1);
+    }
+
+    auto source = dir / "spin.sv";
+    OS::writeFile(source, R"(
+function automatic int spin();
+    int i = 0;
+    while (1) i++;
+    return i;
+endfunction
+
+module m;
+    localparam int p = spin();
+endmodule
+
+module top;
+    m u();
+endmodule
+)");
+
+    Driver driver;
+    driver.addStandardArgs();
+
+    auto sourcePath = getU8Str(source);
+    const char* argv[] = {"testfoo", sourcePath.c_str(), "--max-elab-time=0.5",
+                          "--max-constexpr-steps=4294967295"};
+    CHECK(driver.parseCommandLine(4, argv));
+    CHECK(driver.processOptions());
+    CHECK(driver.parseAllSources());
+    CHECK(!driver.wasParseCancelled());
+
+    auto compilation = driver.createCompilation();
+    CHECK(!driver.reportCompilation(*compilation, false));
+    CHECK(stderrContains("constant evaluation was cancelled: time limit of 0.5s exceeded"));
+    CHECK(stderrContains("in call to 'spin()'"));
+    CHECK(stderrContains("elaboration of 'top.u' was cancelled: time limit of 0.5s exceeded"));
+    CHECK(stdoutContains("Build failed: 2 errors"));
+
+    fs::remove_all(dir, ec);
+}
@@ -6,7 +6,9 @@
 
 #include "slang/text/Glob.h"
 #include "slang/text/SourceManager.h"
+#include "slang/util/OS.h"
 #include "slang/util/String.h"
+#include "slang/util/ThreadPool.h"
 
 std::string getTestInclude() {
     return findTestDir() + "/include.svh";
@@ -175,6 +177,41 @@ TEST_CASE("File glob infinite recursion") {
     fs::remove_all("sandbox", ec);
 }
 
+TEST_CASE("Reloading changed files") {
+    std::error_code ec;
+    auto dir = fs::temp_directory_path(ec) / "slang_reload_test";
+    fs::create_directories(dir, ec);
+
+    auto changing = dir / "changing.sv";
+    auto missing = dir / "missing.sv";
+    OS::writeFile(changing, "module m; endmodule\n");
+    OS::writeFile(dir / "same.sv", "module n; endmodule\n");
+
+    SourceManager manager;
+    auto first = manager.readSource(changing, /* library */ nullptr);
+    REQUIRE(first);
+    CHECK(manager.readSource(dir / "same.sv", /* library */ nullptr));
+    CHECK(!manager.readSource(missing, /* library */ nullptr));
+    manager.assignText("assigned.sv", "module a; endmodule\n");
+    CHECK(manager.reloadChangedFiles().empty());
+
+    OS::writeFile(changing, "module m2; endmodule\n");
+    OS::writeFile(missing, "module x; endmodule\n");
+
+    auto changed = manager.reloadChangedFiles();
+    REQUIRE(changed.size() == 1);
+    CHECK(changed[0].filename() == "changing.sv");
+
+    // Existing buffers keep the old contents, new reads get the new ones.
+    auto second = manager.readSource(changing, /* library */ nullptr);
+    REQUIRE(second);
+    CHECK(first->data.starts_with("module m;"));
+    CHECK(second->data.starts_with("module m2;"));
+    CHECK(manager.readSource(missing, /* library */ nullptr));
+
+    fs::remove_all(dir, ec);
+}
+
 TEST_CASE("In-memory glob matching") {
     CHECK(svGlobMatches("foo/bar/baz.txt", "foo/bar/*.txt"));
     CHECK(svGlobMatches("foo/bar/baz.txt", "foo/bar/"));
@@ -182,3 +219,69 @@ TEST_CASE("In-memory glob matching") {
     CHECK(!svGlobMatches("foo/bar/baz.txt", "foo/...bat.txt"));
     CHECK(svGlobMatches("foo/bar/baz.txt", "...baz.txt"));
 }
+
+TEST_CASE("Line and column numbers") {
+    // Mix line ending styles and line lengths so that line breaks, including
+    // two character ones, land on every position within a search block.
+    std::string text;
+    const char* endings[] = {"\n", "\r\n", "\r", "\n\r", "\n\n", "\r\r\n"};
+    for (size_t i = 0; i < 300; i++) {
+        text.append(i % 37, char('a' + i % 26));
+        text += endings[i % std::size(endings)];
+    }
+    text += "end";
+
+    SourceManager manager;
+    auto buffer = manager.assignText(text);
+
+    // Compute the expected values with a simple character by character scan.
+    size_t line = 1;
+    size_t lineStart = 0;
+    for (size_t i = 0; i < text.size(); i++) {
+        SourceLocation loc(buffer.id, i);
+        CHECK(manager.getLineNumber(loc) == line);
+        CHECK(manager.getColumnNumber(loc) == i - lineStart + 1);
+
+        if (text[i] == '\n' || text[i] == '\r') {
+            if (i + 1 < text.size() && (text[i + 1] == '\n' || text[i + 1] == '\r') &&
+                text[i] != text[i + 1]) {
+                i++;
+            }
+            line++;
+            lineStart = i + 1;
+        }
+    }
+}
+
+TEST_CASE("Source manager lookups while adding buffers") {
+    SourceManager manager;
+    std::vector<SourceBuffer> buffers;
+    for (int i = 0; i < 16; i++)
+        buffers.push_back(manager.assignText(std::string(size_t(i + 1), 'x') + "\nfoo\nbar\n"));
+
+    // Query line numbers from many threads while more buffers and expansion
+    // locations are being added, which grows the buffer table underneath them.
+    std::atomic<int> failures = 0;
+    ThreadPool threadPool(4);
+    for (int t = 0; t < 4; t++) {
+        threadPool.pushTask([&, t] {
+            for (int i = 0; i < 2000; i++) {
+                auto& buffer = buffers[size_t(i + t) % buffers.size()];
+                SourceLocation loc(buffer.id, buffer.data.find("bar"));
+                if (manager.getLineNumber(loc) != 3 || manager.getColumnNumber(loc) != 1)
+                    failures++;
+            }
+        });
+    }
+
+    for (int i = 0; i < 2000; i++) {
+        auto loc = SourceLocation(buffers[0].id, 0);
+        manager.createExpansionLoc(loc, SourceRange(loc, loc), false);
+        if (i % 100 == 0)
+            manager.assignText("module m; endmodule");
+    }
+
+    threadPool.waitForAll();
+    CHECK(failures == 0);
+    CHECK(manager.getAllBuffers().size() == 16 + 2000 + 20);
+}
@@ -6,7 +6,14 @@
 #include <cmath>
 using Catch::Approx;
 
+#include "slang/ast/ConstEvalProfiler.h"
+#include "slang/ast/ConstFunctionMemo.h"
+#include "slang/ast/EvalProgram.h"
 #include "slang/ast/ScriptSession.h"
+#include "slang/ast/symbols/CompilationUnitSymbols.h"
+#include "slang/ast/symbols/ParameterSymbols.h"
+#include "slang/ast/symbols/SubroutineSymbols.h"
+#include "slang/ast/symbols/VariableSymbols.h"
 
 TEST_CASE("Simple eval") {
     ScriptSession session;
@@ -2540,3 +2547,749 @@ TEST_CASE("Array map eval") {
 
     NO_SESSION_ERRORS;
 }
+
+TEST_CASE("Bytecode eval matches AST eval") {
+    auto text = R"(
+function automatic logic [31:0] crc32(input logic [7:0] data, input logic [31:0] crc);
+    logic [31:0] c = crc;
+    for (int i = 0; i < 8; i++) begin
+        if ((c[0] ^ data[i]) == 1'b1)
+            c = (c >> 1) ^ 32'hEDB88320;
+        else
+            c = c >> 1;
+    end
+    return c;
+endfunction
+
+function automatic logic [31:0] crcAll(int n);
+    logic [31:0] c = '1;
+    for (int j = 0; j < n; j++)
+        c = crc32(j[7:0], c);
+    return ~c;
+endfunction
+
+function automatic logic [15:0] lfsr(int steps);
+    logic [15:0] s = 16'hACE1;
+    repeat (steps)
+        s = {s[14:0], s[15] ^ s[13] ^ s[12] ^ s[10]};
+    return s;
+endfunction
+
+function automatic int loops(int a);
+    int total = 0;
+    int k = 0;
+    do begin
+        k += 1;
+        if (k == 3) continue;
+        else if (k > 10) break;
+        else if (k == 5) total += 100;
+        total += k;
+    end while (k < 20);
+    forever begin
+        a--;
+        if (a < 0) break;
+        total = total * 2 + (a > 2 ? 1 : 0);
+    end
+    case (total % 3)
+        0: total += 1;
+        default: total -= 1;
+    endcase
+    return total + (a == -1 && total > 0) + (k || a);
+endfunction
+
+function automatic real reals(int n);
+    real r = 1.5;
+    for (int i = 0; i < n; ++i) r = r * 1.5 - i;
+    return r;
+endfunction
+
+function automatic logic [3:0] hybrid(logic c);
+    logic [3:0] a = 4'b1100, b = 4'b1010;
+    return c ? a : b;
+endfunction
+
+function automatic int sideEffects(int a);
+    int b = a;
+    return b + (b = 5) + b++ + ++b;
+endfunction
+)";
+
+    auto evalAll = [&](bitmask<CompilationFlags> flags) {
+        CompilationOptions co;
+        co.flags = flags;
+
+        ScriptSession session(Bag{co});
+        session.eval(text);
+
+        std::vector<std::string> results;
+        for (auto expr : {"crcAll(64)", "lfsr(100)", "loops(4)", "reals(5)", "hybrid(1'bx)",
+                          "sideEffects(3)"}) {
+            results.push_back(session.eval(expr).toString());
+        }
+
+        NO_SESSION_ERRORS;
+        return results;
+    };
+
+    auto vm = evalAll(CompilationFlags::None);
+    auto ast = evalAll(CompilationFlags::DisableConstBytecode);
+    CHECK(vm == ast);
+    CHECK(vm[0] == "32'd269405836");
+    CHECK(vm[4] == "4'b1xx0");
+}
+
+TEST_CASE("Bytecode compilation of constant functions") {
+    auto tree = SyntaxTree::fromText(R"(
+package p;
+    function automatic int clog2(int v);
+        int r = 0;
+        v = v - 1;
+        while (v > 0) begin
+            r++;
+            v >>= 1;
+        end
+        return r;
+    endfunction
+
+    function automatic int withDisable(int v);
+        begin : blk
+            if (v > 2) disable blk;
+            v++;
+        end
+        return v;
+    endfunction
+
+    function automatic int withCase(int v);
+        case (v)
+            1: return 2;
+            default: return v;
+        endcase
+    endfunction
+endpackage
+
+module m;
+    localparam int a = p::clog2(1000);
+    localparam int b = p::withDisable(1);
+    localparam int c = p::withCase(1);
+endmodule
+)");
+
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+    NO_COMPILATION_ERRORS;
+
+    auto& root = compilation.getRoot();
+    CHECK(root.lookupName<ParameterSymbol>("m.a").getValue().integer() == 10);
+    CHECK(root.lookupName<ParameterSymbol>("m.b").getValue().integer() == 2);
+    CHECK(root.lookupName<ParameterSymbol>("m.c").getValue().integer() == 2);
+
+    auto& pkg = *compilation.getPackage("p");
+    auto program = compilation.getEvalProgram(pkg.find<SubroutineSymbol>("clog2"));
+    REQUIRE(program);
+    CHECK(program->getFallbackCount() == 0);
+
+    CHECK(!compilation.getEvalProgram(pkg.find<SubroutineSymbol>("withDisable")));
+
+    program = compilation.getEvalProgram(pkg.find<SubroutineSymbol>("withCase"));
+    REQUIRE(program);
+    CHECK(program->getFallbackCount() == 1);
+}
+
+TEST_CASE("Bytecode eval step limit") {
+    auto tree = SyntaxTree::fromText(R"(
+function automatic int spin(int n);
+    int i = 0;
+    while (1) i++;
+    return i;
+endfunction
+
+module m;
+    localparam int i = spin(1);
+endmodule
+)");
+
+    CompilationOptions co;
+    co.maxConstexprSteps = 8192;
+
+    Bag options;
+    options.set(co);
+
+    Compilation compilation(options);
+    compilation.addSyntaxTree(tree);
+
+    auto& diags = compilation.getAllDiagnostics();
+    REQUIRE(diags.size() == 1);
+    CHECK(diags[0].code == diag::ConstEvalExceededMaxSteps);
+}
+
+TEST_CASE("Elaboration memory limit") {
+    auto tree = SyntaxTree::fromText(R"(
+module top;
+    logic [3:0] a;
+endmodule
+)");
+
+    CompilationOptions co;
+    co.maxElaborationMemory = 1;
+
+    Bag options;
+    options.set(co);
+
+    Compilation compilation(options);
+    compilation.addSyntaxTree(tree);
+
+    // Nothing has been elaborated yet, so there is no instance to blame.
+    auto& diags = compilation.getAllDiagnostics();
+    REQUIRE(diags.size() == 1);
+    CHECK(diags[0].code == diag::ElaborationCancelled);
+    CHECK(diags[0].location == SourceLocation::NoLocation);
+    CHECK(compilation.getCancellationToken().getReason() ==
+          CancellationToken::Reason::MemoryLimit);
+}
+
+TEST_CASE("Constant function memoization") {
+    auto tree = SyntaxTree::fromText(R"(
+module m;
+    localparam int P = 1;
+
+    function automatic int f(int x);
+        return x * 2;
+    endfunction
+
+    function automatic int g(int x);
+        return x + P;
+    endfunction
+
+    function automatic int h(int x);
+        $display("hello");
+        return x;
+    endfunction
+
+    localparam int A = f(4);
+    localparam int B = f(4);
+    localparam int C = f(5);
+    localparam int D = g(1);
+    localparam int E = g(1);
+    localparam int F = h(1);
+    localparam int G = h(1);
+endmodule
+)");
+
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+
+    auto& diags = compilation.getAllDiagnostics();
+    REQUIRE(diags.size() == 1);
+    CHECK(diags[0].code == diag::ConstSysTaskIgnored);
+
+    auto& root = compilation.getRoot();
+    CHECK(root.lookupName<ParameterSymbol>("m.B").getValue().integer() == 8);
+    CHECK(root.lookupName<ParameterSymbol>("m.C").getValue().integer() == 10);
+    CHECK(root.lookupName<ParameterSymbol>("m.E").getValue().integer() == 2);
+
+    auto memo = compilation.getConstFunctionMemo();
+    REQUIRE(memo);
+    CHECK(memo->getHitCount() == 2);
+    CHECK(memo->getMissCount() == 5);
+    CHECK(memo->size() == 3);
+}
+
+TEST_CASE("Constant function memoization respects declaration order") {
+    auto tree = SyntaxTree::fromText(R"(
+module m;
+    localparam int X = g(1);
+    localparam int P = 1;
+
+    function automatic int g(int x);
+        return x + P;
+    endfunction
+
+    localparam int Y = g(1);
+endmodule
+)");
+
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+
+    // Evaluate the valid call first so that its result is in the table.
+    auto& root = compilation.getRoot();
+    CHECK(root.lookupName<ParameterSymbol>("m.Y").getValue().integer() == 2);
+
+    auto& diags = compilation.getAllDiagnostics();
+    REQUIRE(diags.size() == 1);
+    CHECK(diags[0].code == diag::ConstEvalIdUsedInCEBeforeDecl);
+}
+
+TEST_CASE("Constant function memoization can be disabled") {
+    CompilationOptions co;
+    co.maxConstexprMemoEntries = 0;
+
+    Compilation compilation(Bag{co});
+    CHECK(!compilation.getConstFunctionMemo());
+}
+
+TEST_CASE("Constant function local variable slots") {
+    auto text = R"(
+function automatic int fib(int n);
+    int result;
+    if (n < 2) begin
+        int base = n;
+        result = base;
+    end
+    else begin
+        int a = fib(n - 1);
+        int b = fib(n - 2);
+        result = a + b;
+    end
+    return result;
+endfunction
+
+function automatic int sum(int n);
+    if (n == 0) return 0;
+    begin
+        int rest = sum(n - 1);
+        return n + rest;
+    end
+endfunction
+)";
+
+    auto evalAll = [&](bitmask<CompilationFlags> flags) {
+        CompilationOptions co;
+        co.flags = flags;
+
+        ScriptSession session(Bag{co});
+        session.eval(text);
+
+        std::vector<std::string> results;
+        for (auto expr : {"fib(15)", "sum(100)", "fib(3) + sum(3)"})
+            results.push_back(session.eval(expr).toString());
+
+        NO_SESSION_ERRORS;
+        return results;
+    };
+
+    auto vm = evalAll(CompilationFlags::None);
+    auto ast = evalAll(CompilationFlags::DisableConstBytecode);
+    CHECK(vm == ast);
+    CHECK(ast[0] == "610");
+    CHECK(ast[1] == "5050");
+    CHECK(ast[2] == "8");
+
+    auto tree = SyntaxTree::fromText(R"(
+package p;
+)" + std::string(text) + R"(
+endpackage
+)");
+
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+    NO_COMPILATION_ERRORS;
+
+    auto& fib = compilation.getPackage("p")->find("fib")->as<SubroutineSymbol>();
+    auto slots = fib.getLocalSlots();
+    REQUIRE(slots.size() == 6);
+    for (size_t i = 0; i < slots.size(); i++)
+        CHECK(slots[i]->localSlot == i);
+}
+
+TEST_CASE("Aggregate constant values share storage until modified") {
+    ScriptSession session;
+    session.eval("typedef int table_t[4];");
+    session.eval("localparam table_t A = '{1, 2, 3, 4};");
+    session.eval(R"(
+function automatic table_t build();
+    table_t t;
+    foreach (t[i]) t[i] = i * i;
+    return t;
+endfunction
+)");
+    session.eval("localparam table_t B = build();");
+    session.eval(R"(
+function automatic int sum(table_t t);
+    int s = 0;
+    foreach (t[i]) s += t[i];
+    return s;
+endfunction
+)");
+
+    auto data = [](const ConstantValue& cv) { return cv.elements().data(); };
+
+    auto a1 = session.eval("A");
+    auto a2 = session.eval("A");
+    CHECK(data(a1) == data(a2));
+    CHECK(session.eval("sum(A)").integer() == 10);
+
+    // A value built up by a function can still be shared once it's returned.
+    auto b1 = session.eval("B");
+    auto b2 = session.eval("B");
+    CHECK(data(b1) == data(b2));
+    CHECK(session.eval("sum(B)").integer() == 14);
+
+    // Modifying a copy clones it and leaves everything else alone.
+    a1.elements()[0] = SVInt(32, 5, true);
+    CHECK(data(a1) != data(a2));
+    CHECK(a2.elements()[0].integer() == 1);
+    CHECK(session.eval("A[0]").integer() == 1);
+    CHECK(session.eval("sum(A)").integer() == 10);
+
+    session.eval("table_t v = A;");
+    session.eval("v[1] = 7;");
+    CHECK(session.eval("sum(v)").integer() == 15);
+    CHECK(session.eval("sum(A)").integer() == 10);
+
+    // Values can be shared again once an assignment to them has finished,
+    // including the arrays along the way to a nested element.
+    auto v1 = session.eval("v");
+    auto v2 = session.eval("v");
+    CHECK(data(v1) == data(v2));
+
+    session.eval("table_t w[2];");
+    session.eval("w[1][2] = 3;");
+    auto w1 = session.eval("w[1]");
+    auto w2 = session.eval("w[1]");
+    CHECK(data(w1) == data(w2));
+    CHECK(w1.elements()[2].integer() == 3);
+    NO_SESSION_ERRORS;
+}
+
+TEST_CASE("Dense integral arrays") {
+    ScriptSession session;
+    session.eval("typedef logic [7:0] mem_t[64];");
+    session.eval(R"(
+function automatic mem_t fill(int seed);
+    mem_t m;
+    foreach (m[i]) m[i] = 8'(i * seed);
+    return m;
+endfunction
+)");
+    session.eval("localparam mem_t M = fill(3);");
+
+    auto m = session.eval("M");
+    REQUIRE(m.isDense());
+    CHECK(m.isUnpacked());
+    CHECK(m.size() == 64);
+    CHECK(m.getBitstreamWidth() == 512);
+    CHECK(m.getElement(10).integer() == 30);
+    CHECK(session.eval("M[63]").integer() == 189);
+
+    // Const iteration produces each element by value, so the results stay
+    // valid after the iterator that produced them has moved on.
+    const auto& cm = m;
+    std::vector<ConstantValue> elems(begin(cm), end(cm));
+    REQUIRE(elems.size() == 64);
+    CHECK(elems[10].integer() == 30);
+    CHECK((*std::reverse_iterator(end(cm))).integer() == 189);
+    CHECK(m.isDense());
+
+    // Default values of large fixed-size arrays start out dense too.
+    session.eval("mem_t d;");
+    CHECK(session.eval("d").isDense());
+    CHECK(session.eval("d[5]").integer().hasUnknown());
+    CHECK(session.eval("$countbits(d[5], 1'bx)").integer() == 8);
+
+    session.eval("d[5] = 8'hab;");
+    session.eval("d[6][3:0] = 4'h5;");
+    session.eval("d[7][1] = 1'b1;");
+    CHECK(session.eval("d[5]").integer() == 0xab);
+    CHECK(session.eval("d[6]").integer().toString() == "8'bxxxx0101");
+    CHECK(session.eval("d[7]").integer().toString() == "8'bxxxxxx1x");
+    CHECK(session.eval("d").isDense());
+
+    // Dense values compare and hash equal to the equivalent expanded form.
+    auto expanded = m;
+    expanded.expandDense();
+    CHECK(!expanded.isDense());
+    CHECK(expanded == m);
+    CHECK(m == expanded);
+    CHECK(expanded.hash() == m.hash());
+    CHECK(expanded.toString() == m.toString());
+    CHECK(session.eval("M == fill(3)").integer() == 1);
+    CHECK(session.eval("M == fill(5)").integer() == 0);
+
+    // Reading a copy leaves the original storage dense.
+    session.eval("mem_t v = M;");
+    CHECK(session.eval("v[1] + v[2]").integer() == 9);
+    session.eval("v[0] = 8'd77;");
+    CHECK(session.eval("v[0]").integer() == 77);
+    CHECK(session.eval("M[0]").integer() == 0);
+
+    // Bitstream casts and streaming round-trip through the packed storage.
+    session.eval("typedef logic [511:0] flat_t;");
+    session.eval("mem_t r = mem_t'(flat_t'(M));");
+    CHECK(session.eval("r").isDense());
+    CHECK(session.eval("r == M").integer() == 1);
+    CHECK(session.eval("flat_t'(M)[15:0]").integer() == ((186 << 8) | 189));
+
+    // Array methods and slices work directly on the dense storage.
+    CHECK(session.eval("M.sum() with (int'(item))").integer() == 6048);
+    CHECK(session.eval("M.max()[0]").integer() == 189);
+    CHECK(session.eval("M.find_first_index(x) with (x == 8'd30)[0]").integer() == 10);
+    CHECK(session.eval("M.find_last_index(x) with (x == 8'd0)[0]").integer() == 0);
+    CHECK(session.eval("M.find(x) with (x > 8'd180)").size() == 3);
+    CHECK(session.eval("$size(M[8:47])").integer() == 40);
+    CHECK(session.eval("M[8:47]").getElement(0).integer() == 24);
+    session.eval("v.sort();");
+    CHECK(session.eval("v[0]").integer() == 3);
+    CHECK(session.eval("v[63]").integer() == 189);
+    NO_SESSION_ERRORS;
+}
+
+TEST_CASE("Associative array traversal methods eval") {
+    ScriptSession session;
+    session.eval("int arr[int] = '{10:1, -5:2, 3:3, 100:4};");
+    session.eval(R"(
+function automatic string walk(int arr[int], bit forward);
+    string s;
+    int k;
+    if (forward ? arr.first(k) : arr.last(k)) begin
+        do s = {s, $sformatf("%0d,", k)};
+        while (forward ? arr.next(k) : arr.prev(k));
+    end
+    return s;
+endfunction
+)");
+    CHECK(session.eval("walk(arr, 1)").str() == "-5,3,10,100,");
+    CHECK(session.eval("walk(arr, 0)").str() == "100,10,3,-5,");
+
+    session.eval("int empty[int];");
+    session.eval("int k = 7;");
+    CHECK(session.eval("empty.first(k)").integer() == 0);
+    CHECK(session.eval("empty.last(k)").integer() == 0);
+    CHECK(session.eval("k").integer() == 7);
+    CHECK(session.eval("arr.next(k)").integer() == 1);
+    CHECK(session.eval("k").integer() == 10);
+
+    session.eval("k = 100;");
+    CHECK(session.eval("arr.next(k)").integer() == 0);
+    CHECK(session.eval("k").integer() == 100);
+    CHECK(session.eval("arr.prev(k)").integer() == 1);
+    CHECK(session.eval("k").integer() == 10);
+
+    session.eval("k = -6;");
+    CHECK(session.eval("arr.prev(k)").integer() == 0);
+    CHECK(session.eval("k").integer() == -6);
+
+    session.eval("int names[string] = '{\"b\":1, \"c\":2, \"a\":3};");
+    session.eval("string n;");
+    CHECK(session.eval("names.first(n)").integer() == 1);
+    CHECK(session.eval("n").str() == "a");
+    CHECK(session.eval("names.next(n)").integer() == 1);
+    CHECK(session.eval("n").str() == "b");
+    CHECK(session.eval("names.last(n)").integer() == 1);
+    CHECK(session.eval("n").str() == "c");
+    NO_SESSION_ERRORS;
+}
+
+TEST_CASE("Associative array hashing keeps key order") {
+    ScriptSession session;
+    session.eval(R"(
+function automatic int scoreboard(int n);
+    int sb[int];
+    int k, sum;
+    for (int i = 0; i < n; i++)
+        sb[(i * 7919) % n] = i;
+    for (int i = 0; i < n; i += 2)
+        sb.delete(i);
+    if (sb.first(k)) begin
+        do sum += k;
+        while (sb.next(k));
+    end
+    return sum + sb.num();
+endfunction
+)");
+    CHECK(session.eval("scoreboard(1000)").integer() == 250500);
+
+    // Interleaves insertions and removals with traversal so that
+    // the sorted view has to be kept up to date as the array changes.
+    session.eval(R"(
+function automatic int drain(int n);
+    int pq[int];
+    int k, result;
+    for (int i = 0; i < n; i++) begin
+        pq[(i * 37) % 101] = i;
+        if (i % 3 == 2) begin
+            void'(pq.first(k));
+            result += k * i;
+            pq.delete(k);
+        end
+    end
+    return result;
+endfunction
+)");
+    CHECK(session.eval("drain(100)").integer() == 27816);
+
+    session.eval("int arr[int];");
+    session.eval("for (int i = 0; i < 64; i++) arr[(i * 13) % 64 - 32] = i;");
+    auto cv = session.eval("arr");
+    auto& map = *std::as_const(cv).map();
+    REQUIRE(map.size() == 64);
+
+    int32_t expected = -32;
+    for (auto& [key, val] : map)
+        CHECK(*key.integer().as<int32_t>() == expected++);
+
+    CHECK(session.eval("arr.min()[0]").integer() == 0);
+    CHECK(session.eval("$low(arr)").integer() == -32);
+    CHECK(session.eval("$high(arr)").integer() == 31);
+
+    // Wildcard index keys are treated as unsigned regardless of their width.
+    session.eval("int w[*];");
+    session.eval("w[8'd5] = 1;");
+    session.eval("w[16'd5] = 2;");
+    CHECK(session.eval("w.num()").integer() == 1);
+    CHECK(session.eval("w[32'd5]").integer() == 2);
+    CHECK(session.eval("w.exists(4'd5)").integer() == 1);
+    NO_SESSION_ERRORS;
+}
+
+TEST_CASE("Associative array traversal truncates the index") {
+    ScriptSession session;
+    session.eval("int arr[int];");
+    session.eval("arr[300] = 1;");
+    session.eval("arr[5] = 2;");
+    session.eval("byte b;");
+    CHECK(session.eval("arr.last(b)").integer() == -1);
+    CHECK(session.eval("b").integer() == 44);
+    CHECK(session.eval("arr.prev(b)").integer() == -1);
+    CHECK(session.eval("b").integer() == 5);
+
+    session.eval("longint k = 5;");
+    CHECK(session.eval("arr.next(k)").integer() == 1);
+    CHECK(session.eval("k").integer() == 300);
+    CHECK(session.eval("arr.next(k)").integer() == 0);
+    NO_SESSION_ERRORS;
+}
+
+TEST_CASE("Queue ring buffer eval") {
+    ScriptSession session;
+    session.eval(R"(
+function automatic int qops();
+    int q[$];
+    int s;
+    for (int i = 0; i < 20; i++) begin
+        q.push_back(i);
+        q.push_front(-i);
+        if (i % 4 == 3)
+            void'(q.pop_back());
+    end
+    q.insert(3, 100);
+    q.insert(q.size() - 2, 200);
+    q.delete(1);
+    q.delete(q.size() - 3);
+    foreach (q[i])
+        s += q[i] * (i + 1);
+    return s;
+endfunction
+)");
+    CHECK(session.eval("qops()").integer() == 3173);
+
+    session.eval("int q[$];");
+    session.eval("for (int i = 0; i < 10; i++) begin q.push_front(i); q.push_back(i); end");
+    session.eval("for (int i = 0; i < 5; i++) void'(q.pop_front());");
+    CHECK(session.eval("q.size()").integer() == 15);
+    CHECK(session.eval("q[0]").integer() == 4);
+    CHECK(session.eval("q[$]").integer() == 9);
+
+    session.eval("q.sort();");
+    CHECK(session.eval("q[0]").integer() == 0);
+    CHECK(session.eval("q[14]").integer() == 9);
+    session.eval("q.reverse();");
+    CHECK(session.eval("q[0]").integer() == 9);
+    CHECK(session.eval("q[1] + q[2] * 10 + q[3] * 100").integer() == 678);
+    session.eval("int r[$] = {q[0:6], q[7:$]};");
+    CHECK(session.eval("q == r").integer() == 1);
+    NO_SESSION_ERRORS;
+}
+
+TEST_CASE("Constant evaluation profiler") {
+    auto tree = SyntaxTree::fromText(R"(
+package p;
+    function automatic int fact(int n);
+        if (n <= 1)
+            return 1;
+        return n * fact(n - 1);
+    endfunction
+
+    function automatic int sum(int n);
+        int r = 0;
+        for (int i = 0; i < n; i++)
+            r += fact(5);
+        return r;
+    endfunction
+
+    function automatic logic [4095:0] wide(int n);
+        logic [4095:0] r = 1;
+        for (int i = 0; i < n; i++)
+            r = r * 3;
+        return r;
+    endfunction
+endpackage
+
+module m;
+    localparam int A = p::sum(10);
+    localparam int B = p::fact(3);
+    localparam logic [4095:0] C = p::wide(20);
+endmodule
+)");
+
+    // Memoization would skip most of the calls, so turn it off
+    // to get predictable call counts.
+    CompilationOptions co;
+    co.flags |= CompilationFlags::ProfileConstEval;
+    co.maxConstexprMemoEntries = 0;
+
+    Compilation compilation(Bag{co});
+    compilation.addSyntaxTree(tree);
+    NO_COMPILATION_ERRORS;
+
+    auto profiler = compilation.getConstEvalProfiler();
+    REQUIRE(profiler);
+
+    auto entries = profiler->getEntries();
+    REQUIRE(entries.size() == 6);
+    for (size_t i = 1; i < entries.size(); i++)
+        CHECK(entries[i - 1]->time >= entries[i]->time);
+
+    auto find = [&](std::string_view name) -> const ConstEvalProfiler::Entry& {
+        auto it = std::ranges::find_if(entries, [&](auto e) { return e->name == name; });
+        REQUIRE(it != entries.end());
+        return **it;
+    };
+
+    auto& fact = find("p::fact");
+    auto& sum = find("p::sum");
+    auto& wide = find("p::wide");
+    auto& a = find("m.A");
+    auto& b = find("m.B");
+    auto& c = find("m.C");
+
+    CHECK(fact.calls == 53);
+    CHECK(sum.calls == 1);
+    CHECK(a.calls == 1);
+
+    // Recursive calls shouldn't count towards the inclusive totals more than once.
+    CHECK(fact.steps > 0);
+    CHECK(fact.steps == fact.selfSteps);
+    CHECK(fact.time >= fact.selfTime);
+
+    // Parameter initializers don't run statements themselves.
+    CHECK(a.selfSteps == 0);
+    CHECK(a.steps == sum.steps);
+    CHECK(b.steps > 0);
+    CHECK(a.steps + b.steps == sum.selfSteps + fact.steps);
+    CHECK(c.steps == wide.steps);
+
+    CHECK(wide.allocations > 0);
+    CHECK(c.allocations >= wide.allocations);
+    CHECK(fact.allocations == 0);
+
+    auto report = profiler->report(2);
+    CHECK(report.find("(2 of 6 entries)") != std::string::npos);
+    CHECK(report.find(entries[0]->name) != std::string::npos);
+    CHECK(report.find(entries[2]->name) == std::string::npos);
+}
+
+TEST_CASE("Constant evaluation profiler is off by default") {
+    Compilation compilation;
+    CHECK(!compilation.getConstEvalProfiler());
+}
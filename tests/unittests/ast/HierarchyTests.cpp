@@ -8,6 +8,8 @@
 #include "slang/ast/symbols/InstanceSymbols.h"
 #include "slang/ast/symbols/MemberSymbols.h"
 #include "slang/ast/symbols/ParameterSymbols.h"
+#include "slang/ast/symbols/VariableSymbols.h"
+#include "slang/ast/types/Type.h"
 #include "slang/text/SourceManager.h"
 
 TEST_CASE("Finding top level") {
@@ -187,6 +189,65 @@ endmodule
     NO_COMPILATION_ERRORS;
 }
 
+TEST_CASE("Genvar-invariant loop generate shares types and params") {
+    auto tree = SyntaxTree::fromText(R"(
+module Top;
+    function automatic int calc(int w);
+        return w * 2;
+    endfunction
+
+    logic [63:0] data;
+    for (genvar i = 0; i < 8; i++) begin : g
+        localparam int W = calc(4);
+        logic [W-1:0] a;
+        assign a = data[i*8 +: 8];
+        Leaf l(.in(a[i]));
+    end
+
+    for (genvar j = 0; j < 4; j++) begin : h
+        localparam int W = j + 1;
+        logic [W-1:0] b;
+    end
+
+    for (genvar k = 0; k < 2; k++) begin : s
+        typedef struct packed { logic f; } t;
+        t c;
+    end
+endmodule
+
+module Leaf(input logic in);
+endmodule
+)");
+
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+    NO_COMPILATION_ERRORS;
+
+    auto& top = compilation.getRoot().lookupName<InstanceSymbol>("Top").body;
+    auto& g = top.find<GenerateBlockArraySymbol>("g");
+    REQUIRE(g.entries.size() == 8);
+    CHECK(!g.entries[0]->prototype);
+    for (size_t i = 1; i < g.entries.size(); i++) {
+        auto& entry = *g.entries[i];
+        CHECK(entry.prototype == g.entries[0]);
+        CHECK(entry.find<ParameterSymbol>("W").getValue().integer() == 8);
+        CHECK(&entry.find<VariableSymbol>("a").getType() ==
+              &g.entries[0]->find<VariableSymbol>("a").getType());
+    }
+
+    auto& h = top.find<GenerateBlockArraySymbol>("h");
+    REQUIRE(h.entries.size() == 4);
+    for (size_t i = 0; i < h.entries.size(); i++) {
+        auto& entry = *h.entries[i];
+        CHECK(!entry.prototype);
+        CHECK(entry.find<VariableSymbol>("b").getType().getBitWidth() == i + 1);
+    }
+
+    auto& s = top.find<GenerateBlockArraySymbol>("s");
+    REQUIRE(s.entries.size() == 2);
+    CHECK(!s.entries[1]->prototype);
+}
+
 TEST_CASE("Module children (case generate)") {
     auto tree = SyntaxTree::fromText(R"(
 module Top #(parameter int val = 10)();
@@ -1908,3 +1969,70 @@ endmodule
     compilation.addSyntaxTree(tree);
     NO_COMPILATION_ERRORS;
 }
+
+TEST_CASE("Streaming semantic diagnostics") {
+    auto tree = SyntaxTree::fromText(R"(
+module m;
+  int i = foo;
+endmodule
+
+module n;
+  int j = bar;
+endmodule
+
+module top;
+  m m1();
+  m m2();
+  n n1();
+endmodule
+)");
+
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+
+    std::vector<std::vector<DiagCode>> batches;
+    compilation.setDiagnosticCallback([&](const Diagnostics& batch) {
+        auto& codes = batches.emplace_back();
+        for (auto& diag : batch)
+            codes.push_back(diag.code);
+        return true;
+    });
+
+    CHECK(compilation.getSemanticDiagnostics().empty());
+    CHECK(!compilation.isElaborationStopped());
+
+    // The error in the second instance of m is a repeat and gets dropped.
+    REQUIRE(batches.size() == 2);
+    CHECK(batches[0] == std::vector<DiagCode>{diag::UndeclaredIdentifier});
+    CHECK(batches[1] == std::vector<DiagCode>{diag::UndeclaredIdentifier});
+}
+
+TEST_CASE("Streaming semantic diagnostics can stop elaboration") {
+    auto tree = SyntaxTree::fromText(R"(
+module m;
+  int i = foo;
+endmodule
+
+module n;
+  int j = bar;
+endmodule
+
+module top;
+  m m1();
+  n n1();
+endmodule
+)");
+
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+
+    int numBatches = 0;
+    compilation.setDiagnosticCallback([&](const Diagnostics&) {
+        numBatches++;
+        return false;
+    });
+
+    compilation.getSemanticDiagnostics();
+    CHECK(numBatches == 1);
+    CHECK(compilation.isElaborationStopped());
+}
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: MIT
 
 #include "Test.h"
+#include <sstream>
 
 #include "slang/ast/ASTSerializer.h"
 #include "slang/ast/ASTVisitor.h"
@@ -20,7 +21,9 @@
 #include "slang/ast/symbols/VariableSymbols.h"
 #include "slang/ast/types/NetType.h"
 #include "slang/ast/types/Type.h"
+#include "slang/text/BinaryTree.h"
 #include "slang/text/Json.h"
+#include "slang/util/ThreadPool.h"
 
 TEST_CASE("Nets") {
     auto tree = SyntaxTree::fromText(R"(
@@ -339,6 +342,181 @@ endmodule
     writer.view();
 }
 
+TEST_CASE("JSON dump -- streaming") {
+    auto tree = SyntaxTree::fromText(R"(
+module m #(parameter int P = 3);
+    logic [P:0] a [2];
+    initial a[0] = '1;
+endmodule
+)");
+
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+    NO_COMPILATION_ERRORS;
+
+    auto serialize = [&](JsonWriter& writer, bool pretty) {
+        writer.setPrettyPrint(pretty);
+        ASTSerializer serializer(compilation, writer);
+        serializer.setIncludeAddresses(false);
+        serializer.serialize(compilation.getRoot());
+        writer.writeNewLine();
+    };
+
+    for (bool pretty : {false, true}) {
+        JsonWriter memWriter;
+        serialize(memWriter, pretty);
+
+        std::ostringstream stream;
+        JsonWriter streamWriter(stream, 16);
+        serialize(streamWriter, pretty);
+        CHECK(streamWriter.view().size() < 64);
+
+        streamWriter.flush();
+        CHECK(streamWriter.view().empty());
+        CHECK(stream.str() == memWriter.view());
+    }
+}
+
+TEST_CASE("JSON dump -- parallel") {
+    auto tree = SyntaxTree::fromText(R"(
+package p;
+    parameter int Q = 5;
+endpackage
+
+module m #(parameter int P = 3);
+    logic [P:0] a [2];
+    initial a[0] = '1;
+endmodule
+
+module top1;
+    m #(.P(p::Q)) m1();
+endmodule
+
+module top2;
+    function int f(int i); return i * 2; endfunction
+    localparam int R = f(4);
+endmodule
+)");
+
+    auto serialize = [&](Compilation& compilation, const Symbol& symbol, bool pretty,
+                         ThreadPool* threadPool) {
+        JsonWriter writer;
+        writer.setPrettyPrint(pretty);
+        ASTSerializer serializer(compilation, writer);
+        serializer.setIncludeAddresses(false);
+        serializer.setThreadPool(threadPool);
+        serializer.startObject();
+        serializer.write("design", symbol);
+        serializer.endObject();
+        return std::string(writer.view());
+    };
+
+    ThreadPool threadPool(4);
+    {
+        Compilation compilation;
+        compilation.addSyntaxTree(tree);
+        NO_COMPILATION_ERRORS;
+        CHECK(compilation.isFullyElaborated());
+
+        auto& root = compilation.getRoot();
+        for (bool pretty : {false, true}) {
+            CHECK(serialize(compilation, root, pretty, &threadPool) ==
+                  serialize(compilation, root, pretty, nullptr));
+        }
+
+        // A single scope, as with --ast-json-scope, has its members split up as well.
+        auto& inst = *root.lookupName("top1.m1");
+        CHECK(serialize(compilation, inst, true, &threadPool) ==
+              serialize(compilation, inst, true, nullptr));
+    }
+
+    // Compilations that haven't been fully elaborated are serialized serially.
+    {
+        CompilationOptions options;
+        options.flags |= CompilationFlags::LazySubroutineBodies;
+        Compilation compilation(options);
+        compilation.addSyntaxTree(tree);
+        NO_COMPILATION_ERRORS;
+        CHECK(!compilation.isFullyElaborated());
+
+        auto& root = compilation.getRoot();
+        CHECK(serialize(compilation, root, false, &threadPool) ==
+              serialize(compilation, root, false, nullptr));
+    }
+}
+
+TEST_CASE("Binary AST dump") {
+    auto tree = SyntaxTree::fromText(R"(
+module m #(parameter int P = -3);
+    logic [3:0] a;
+    real r = 1.5;
+    initial a = 4'b1010;
+endmodule
+)");
+
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+    NO_COMPILATION_ERRORS;
+
+    BinaryTreeWriter writer;
+    ASTSerializer serializer(compilation, writer);
+    serializer.setIncludeAddresses(false);
+    serializer.serialize(compilation.getRoot());
+
+    auto data = writer.finish();
+    BinaryTreeReader reader(std::span<const char>(data.data(), data.size()));
+    REQUIRE(reader.isValid());
+
+    auto root = reader.getRoot();
+    CHECK(root["kind"].getString() == "Root");
+
+    auto inst = root["members"][size_t(1)];
+    REQUIRE(inst.isObject());
+    CHECK(inst["name"].getString() == "m");
+
+    std::vector<std::string_view> names;
+    for (auto child : inst["body"]["members"])
+        names.push_back(child.node["name"].getString());
+    CHECK(names == std::vector<std::string_view>{"P", "a", "r", ""});
+
+    auto param = inst["body"]["members"][size_t(0)];
+    CHECK(param["value"].getString() == "-3");
+    CHECK(param["isLocal"].getBool() == false);
+    CHECK(!param["missing"].valid());
+
+    BinaryTreeReader bad(std::span<const char>(data.data(), data.size() - 1));
+    CHECK(!bad.isValid());
+
+    // Corrupted data is either rejected up front or reads as invalid nodes.
+    auto corrupt = [&](size_t offset, uint64_t value, size_t size) {
+        std::string copy(data);
+        for (size_t i = 0; i < size; i++)
+            copy[offset + i] = char((value >> (i * 8)) & 0xff);
+        return copy;
+    };
+
+    // A string table that starts at the trailer has no room for any offsets.
+    auto trailer = data.size() - 28;
+    auto noOffsets = corrupt(trailer + 8, trailer, 8);
+    CHECK(!BinaryTreeReader(std::span<const char>(noOffsets.data(), noOffsets.size())).isValid());
+
+    auto bigSize = corrupt(9, UINT64_MAX, 8);
+    BinaryTreeReader bigSizeReader(std::span<const char>(bigSize.data(), bigSize.size()));
+    REQUIRE(bigSizeReader.isValid());
+    CHECK(!bigSizeReader.getRoot().valid());
+
+    auto bigCount = corrupt(17, UINT32_MAX, 4);
+    BinaryTreeReader bigCountReader(std::span<const char>(bigCount.data(), bigCount.size()));
+    auto bigCountRoot = bigCountReader.getRoot();
+    size_t count = 0;
+    for (auto child : bigCountRoot) {
+        CHECK(child.node.valid());
+        count++;
+    }
+    CHECK(count == root.size());
+    CHECK(!bigCountRoot[size_t(100)].valid());
+}
+
 TEST_CASE("JSON dump -- types and values") {
     auto tree = SyntaxTree::fromText(R"(
 module test_enum;
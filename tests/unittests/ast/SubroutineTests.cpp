@@ -708,3 +708,112 @@ endmodule
     CHECK(diags[0].code == diag::MultipleAlwaysAssigns);
     CHECK(diags[1].code == diag::MultipleAlwaysAssigns);
 }
+
+TEST_CASE("Lazy subroutine body binding") {
+    auto tree = SyntaxTree::fromText(R"(
+package p;
+    function int unused1;
+        return undeclared1;
+    endfunction
+
+    function int helper;
+        return undeclared2;
+    endfunction
+
+    function int used;
+        return helper();
+    endfunction
+
+    function int exported;
+        return undeclared3;
+    endfunction
+    export "DPI-C" function exported;
+
+    function int unused3(int a = undeclared8);
+        return 0;
+    endfunction
+endpackage
+
+class Base;
+    virtual function void f;
+    endfunction
+
+    function void unused2;
+        undeclared4 = 1;
+    endfunction
+endclass
+
+class Derived extends Base;
+    virtual function void f;
+        undeclared5 = 1;
+    endfunction
+endclass
+
+interface class I1;
+    pure virtual function void g;
+endclass
+
+interface class I2 extends I1;
+    pure virtual function void h;
+endclass
+
+class Impl implements I1;
+    virtual function void g;
+        undeclared6 = 1;
+    endfunction
+endclass
+
+class HBase;
+    virtual function void g;
+    endfunction
+
+    virtual function void h;
+        undeclared7 = 1;
+    endfunction
+endclass
+
+class HImpl extends HBase implements I2;
+endclass
+
+module m;
+    Base b = new;
+    int i = p::used();
+    initial b.f();
+
+    I1 i1;
+    I2 i2;
+    initial begin
+        i1.g();
+        i2.h();
+    end
+endmodule
+)");
+
+    auto getDiags = [&](bitmask<CompilationFlags> flags) {
+        CompilationOptions options;
+        options.flags |= flags;
+
+        Compilation compilation(options);
+        compilation.addSyntaxTree(tree);
+
+        std::vector<std::string> names;
+        for (auto& diag : compilation.getAllDiagnostics()) {
+            CHECK(diag.code == diag::UndeclaredIdentifier);
+            names.push_back(std::get<std::string>(diag.args[0]));
+        }
+        std::ranges::sort(names);
+        return names;
+    };
+
+    using Names = std::vector<std::string>;
+    Names all{"undeclared1", "undeclared2", "undeclared3", "undeclared4",
+              "undeclared5", "undeclared6", "undeclared7", "undeclared8"};
+    CHECK(getDiags(CompilationFlags::None) == all);
+    CHECK(getDiags(CompilationFlags::LazySubroutineBodies | CompilationFlags::LintMode) == all);
+
+    // Methods reached through interface class handles are bound, and only
+    // the bodies of unneeded subroutines are skipped, not their arguments.
+    CHECK(getDiags(CompilationFlags::LazySubroutineBodies) ==
+          Names{"undeclared2", "undeclared3", "undeclared5", "undeclared6", "undeclared7",
+                "undeclared8"});
+}
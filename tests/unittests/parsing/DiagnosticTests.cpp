@@ -2,10 +2,13 @@
 // SPDX-License-Identifier: MIT
 
 #include "Test.h"
+#include <sstream>
 
 #include "slang/diagnostics/DiagnosticClient.h"
+#include "slang/diagnostics/JsonDiagnosticClient.h"
 #include "slang/diagnostics/TextDiagnosticClient.h"
 #include "slang/text/SourceManager.h"
+#include "slang/util/String.h"
 
 TEST_CASE("Diagnostic Line Number") {
     auto& text = "`include \"foofile\"\nident";
@@ -424,17 +427,22 @@ TEST_CASE("DiagnosticEngine stuff") {
     CHECK(engine.getNumErrors() == 0);
     CHECK(engine.getNumWarnings() == 0);
 
+    // Clearing the counts leaves the clients in place.
+    engine.issue(diag);
+    CHECK(client->count == 4);
+    CHECK(engine.getNumErrors() == 1);
+
     engine.clearClients();
     engine.issue(diag);
-    CHECK(client->count == 3);
+    CHECK(client->count == 4);
 
     engine.addClient(client);
     engine.issue(diag);
-    CHECK(client->count == 4);
+    CHECK(client->count == 5);
 
     engine.setSeverity(diag::ExpectedClosingQuote, DiagnosticSeverity::Ignored);
     engine.issue(diag);
-    CHECK(client->count == 4);
+    CHECK(client->count == 5);
 
     engine.setIgnoreAllNotes(true);
     engine.setIgnoreAllWarnings(true);
@@ -444,21 +452,21 @@ TEST_CASE("DiagnosticEngine stuff") {
 
     diag.code = diag::RealLiteralUnderflow;
     engine.issue(diag);
-    CHECK(client->count == 4);
+    CHECK(client->count == 5);
 
     diag.code = diag::NoteImportedFrom;
     engine.issue(diag);
-    CHECK(client->count == 4);
+    CHECK(client->count == 5);
 
     engine.setIgnoreAllWarnings(false);
     diag.code = diag::RealLiteralUnderflow;
     engine.issue(diag);
-    CHECK(client->count == 5);
+    CHECK(client->count == 6);
     CHECK(client->lastSeverity == DiagnosticSeverity::Error);
 
     diag.code = diag::DotOnType;
     engine.issue(diag);
-    CHECK(client->count == 6);
+    CHECK(client->count == 7);
     CHECK(client->lastSeverity == DiagnosticSeverity::Fatal);
 
     engine.setErrorLimit(7);
@@ -576,3 +584,97 @@ source:3:33: error: use of undeclared identifier 'a'
                                         ^
 )");
 }
+
+TEST_CASE("JSON Lines diagnostic client") {
+    auto tree = SyntaxTree::fromText(R"(
+module m;
+  int i = a;
+  string s;
+  int j = s;
+endmodule
+)");
+
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+
+    std::ostringstream stream;
+    DiagnosticEngine engine(*compilation.getSourceManager());
+    auto client = std::make_shared<JsonDiagnosticClient>(stream);
+    engine.addClient(client);
+
+    for (auto& diag : compilation.getAllDiagnostics())
+        engine.issue(diag);
+
+    Diagnostic diag(diag::WidthTruncate, SourceLocation::NoLocation);
+    diag << 8 << 4;
+    engine.issue(diag);
+
+    Diagnostic diag2(diag::RealLiteralUnderflow, SourceLocation::NoLocation);
+    diag2 << real_t(1.5);
+    engine.issue(diag2);
+    client->finish();
+
+    CHECK(stream.str() == R"({"severity":"error","code":"UndeclaredIdentifier","file":"source","line":3,"column":11,"args":["a"]}
+{"severity":"error","code":"NoImplicitConversion","file":"source","line":5,"column":9,"args":["'string'","'int'"]}
+{"severity":"warning","code":"WidthTruncate","option":"width-trunc","args":[8,4]}
+{"severity":"warning","code":"RealLiteralUnderflow","option":"real-underflow","args":[1.5]}
+)");
+}
+
+TEST_CASE("SARIF diagnostic client") {
+    auto tree = SyntaxTree::fromText(R"(
+module m;
+  int i = a;
+  int j = b;
+endmodule
+)");
+
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+
+    std::ostringstream stream;
+    DiagnosticEngine engine(*compilation.getSourceManager());
+    auto client = std::make_shared<JsonDiagnosticClient>(stream,
+                                                         JsonDiagnosticClient::Format::Sarif);
+    client->showMessage(true);
+    engine.addClient(client);
+
+    for (auto& diag : compilation.getAllDiagnostics())
+        engine.issue(diag);
+    client->finish();
+
+    auto result = stream.str();
+    CHECK(result.starts_with(
+        R"({"$schema":"https://json.schemastore.org/sarif-2.1.0.json","version":"2.1.0","runs":[{"results":[)"
+        R"({"ruleId":"UndeclaredIdentifier","ruleIndex":0,"level":"error","message":{"text":"use of undeclared identifier 'a'","id":"default","arguments":["a"]},)"
+        R"("locations":[{"physicalLocation":{"artifactLocation":{"uri":"source","uriBaseId":"%SRCROOT%","index":0},"region":{"startLine":3,"startColumn":11}}}]},)"
+        R"({"ruleId":"UndeclaredIdentifier","ruleIndex":0,"level":"error","message":{"text":"use of undeclared identifier 'b'","id":"default","arguments":["b"]},)"
+        R"("locations":[{"physicalLocation":{"artifactLocation":{"uri":"source","uriBaseId":"%SRCROOT%","index":0},"region":{"startLine":4,"startColumn":11}}}]}],)"
+        R"("artifacts":[{"location":{"uri":"source","uriBaseId":"%SRCROOT%"}}],"tool":{"driver":{"name":"slang",)"));
+    CHECK(result.ends_with(
+        R"("rules":[{"id":"UndeclaredIdentifier","messageStrings":{"default":{"text":"use of undeclared identifier '{0}'"}}}]}}}]})"
+        "\n"));
+
+    // Files with absolute paths are referred to with file URIs.
+    auto fileName = getU8Str(fs::current_path() / "my design.sv");
+    auto tree2 = SyntaxTree::fromText("module n; int k = c; endmodule",
+                                       std::string_view(fileName));
+
+    Compilation compilation2;
+    compilation2.addSyntaxTree(tree2);
+
+    std::ostringstream stream2;
+    DiagnosticEngine engine2(*compilation2.getSourceManager());
+    auto client2 = std::make_shared<JsonDiagnosticClient>(stream2,
+                                                          JsonDiagnosticClient::Format::Sarif);
+    engine2.addClient(client2);
+
+    for (auto& diag : compilation2.getAllDiagnostics())
+        engine2.issue(diag);
+    client2->finish();
+
+    result = stream2.str();
+    CHECK(result.find(R"("artifactLocation":{"uri":"file:)") != std::string::npos);
+    CHECK(result.find(R"(/my%20design.sv","index":0})") != std::string::npos);
+    CHECK(result.find("uriBaseId") == std::string::npos);
+}
@@ -4,6 +4,7 @@
 #include "Test.h"
 #include <catch2/catch_approx.hpp>
 #include <cmath>
+#include <random>
 #include <sstream>
 using Catch::Approx;
 
@@ -666,6 +667,161 @@ TEST_CASE("SVInt misc functions") {
     CHECK_THAT("128'b1x10"_si.shl(124).reverse(), exactlyEquals("128'b1x1"_si));
 }
 
+TEST_CASE("SVInt wide bitwise and reduction operators") {
+    // Check the word-at-a-time implementations against bit-by-bit results
+    // for widths that exercise partial blocks and partial top words.
+    std::mt19937 rng(1234);
+    auto randomValue = [&](bitwidth_t bits, bool unknowns) {
+        std::string str = std::to_string(bits) + "'b";
+        for (bitwidth_t i = 0; i < bits; i++) {
+            auto r = rng() % 16;
+            str += !unknowns || r < 14 ? char('0' + (r & 1)) : r == 14 ? 'x' : 'z';
+        }
+        return SVInt::fromString(str);
+    };
+
+    for (bitwidth_t bits : {65u, 130u, 256u, 500u, 1021u, 4096u}) {
+        for (int i = 0; i < 4; i++) {
+            auto a = randomValue(bits, i & 1);
+            auto b = randomValue(bits, i & 2);
+            auto andResult = a & b;
+            auto orResult = a | b;
+            auto xorResult = a ^ b;
+            auto xnorResult = a.xnor(b);
+
+            logic_t redAnd(1), redOr(0), redXor(0);
+            for (bitwidth_t j = 0; j < bits; j++) {
+                auto l = a[int32_t(j)];
+                auto r = b[int32_t(j)];
+                CHECK_THAT(andResult[int32_t(j)], exactlyEquals(l & r));
+                CHECK_THAT(orResult[int32_t(j)], exactlyEquals(l | r));
+                CHECK_THAT(xorResult[int32_t(j)], exactlyEquals(l ^ r));
+                CHECK_THAT(xnorResult[int32_t(j)], exactlyEquals(~(l ^ r)));
+
+                redAnd = redAnd & l;
+                redOr = redOr | l;
+                redXor = redXor ^ l;
+            }
+
+            CHECK_THAT(a.reductionAnd(), exactlyEquals(redAnd));
+            CHECK_THAT(a.reductionOr(), exactlyEquals(redOr));
+            CHECK_THAT(a.reductionXor(), exactlyEquals(redXor));
+        }
+
+        auto ones = SVInt(bits, 0, false) - 1;
+        CHECK(ones.reductionAnd() == logic_t(1));
+        CHECK(SVInt(bits, 0, false).reductionOr() == logic_t(0));
+        auto top = SVInt(bits, 1, false).shl(bits - 1);
+        CHECK(top.reductionOr() == logic_t(1));
+        CHECK(top.reductionAnd() == logic_t(0));
+        CHECK(top.reductionXor() == logic_t(1));
+    }
+}
+
+TEST_CASE("SVInt inline storage") {
+    // Values that fit in the inline buffer, values that don't,
+    // and moves and copies between the two.
+    SVInt a = "120'hba9876543210fedcba9876543210"_si;
+    SVInt b = "60'b1x0z"_si;
+    SVInt c = SVInt(1000, 0, false).shl(900) + 5;
+
+    SVInt a2 = a;
+    SVInt a3 = std::move(a2);
+    CHECK(a3 == a);
+    CHECK(a3.countOnes() == 52);
+
+    SVInt b2 = b;
+    SVInt b3 = std::move(b2);
+    CHECK_THAT(b3, exactlyEquals(b));
+    CHECK(b3.countXs() == 1);
+    CHECK(b3.countZs() == 1);
+
+    SVInt c2 = c;
+    c2 = a3;
+    CHECK(c2 == a);
+    c2 = std::move(c);
+    CHECK(c2.getBitWidth() == 1000);
+    CHECK(c2[0] == logic_t(1));
+
+    a3 = std::move(b3);
+    CHECK_THAT(a3, exactlyEquals(b));
+    a3 = c2;
+    CHECK(a3 == c2);
+    a3 = std::move(b);
+    CHECK_THAT(a3, exactlyEquals("60'b1x0z"_si));
+
+    // Gaining and losing unknown bits moves between inline and heap storage.
+    SVInt d = "120'h1"_si;
+    d.set(100, 99, "2'bx1"_si);
+    CHECK(d.hasUnknown());
+    CHECK(d.countXs() == 1);
+    CHECK(d[99] == logic_t(1));
+
+    d.set(100, 99, "2'b10"_si);
+    d.flattenUnknowns();
+    CHECK(!d.hasUnknown());
+    CHECK(d == "120'h1"_si + SVInt(120, 1, false).shl(100));
+
+    SVInt e = "65'b0"_si;
+    e.setAllX();
+    CHECK(e.countXs() == 65);
+    e.setAllOnes();
+    CHECK(!e.hasUnknown());
+    CHECK(e.countOnes() == 65);
+    e.setAllZ();
+    CHECK(e.countZs() == 65);
+
+    SVInt f = "64'hx"_si;
+    SVInt g = f & SVInt(64, 0, false);
+    CHECK(!g.hasUnknown());
+    CHECK(g == 0);
+}
+
+TEST_CASE("SVInt large multiply and divide") {
+    // Operands large enough to use the recursive multiply and divide
+    // algorithms, checked against identities that only need small ones.
+    std::mt19937 rng(4321);
+    auto randomValue = [&](bitwidth_t width, bitwidth_t activeBits, bool allOnes) {
+        std::string str = std::to_string(width) + "'b1";
+        for (bitwidth_t i = 1; i < activeBits; i++)
+            str += allOnes ? '1' : char('0' + (rng() & 1));
+        return SVInt::fromString(str);
+    };
+
+    for (auto [aBits, bBits] : {std::pair{900u, 300u}, {3000u, 1000u}, {8000u, 2600u},
+                                {8000u, 5200u}, {20000u, 5000u}, {20000u, 15000u}}) {
+        bitwidth_t width = aBits + 64;
+        for (int i = 0; i < 4; i++) {
+            auto a = randomValue(width, aBits, i == 3);
+            auto b = randomValue(width, bBits, i >= 2);
+            if (i == 1)
+                a = b.shl(aBits - bBits) + b.lshr(bBits / 2);
+
+            auto q = a / b;
+            auto r = a % b;
+            CHECK(q * b + r == a);
+            CHECK(r < b);
+
+            // Build the product up one word of b at a time.
+            auto product = a * b;
+            auto expected = SVInt(width, 0, false);
+            for (bitwidth_t j = 0; j < bBits; j += 64) {
+                auto word = b.lshr(j).trunc(64).extend(width, false);
+                expected += (a * word).shl(j);
+            }
+            CHECK(product == expected);
+
+            // The same product computed at twice the width and truncated.
+            auto wide = a.extend(width * 2, false) * b.extend(width * 2, false);
+            CHECK(wide.trunc(width) == product);
+            CHECK(wide / b.extend(width * 2, false) == a.extend(width * 2, false));
+        }
+    }
+
+    auto x = randomValue(3000, 2900, false);
+    CHECK(x.pow(SVInt(5)) == x * x * x * x * x);
+}
+
 TEST_CASE("Double conversions") {
     CHECK("112'b1xxx1"_si.toDouble() == 17.0);
     CHECK("112'd0"_si.toDouble() == 0.0);
@@ -4,7 +4,10 @@
 #include "Test.h"
 #include <catch2/matchers/catch_matchers_string.hpp>
 #include <sstream>
+#include <thread>
 
+#include "slang/util/CancellationToken.h"
+#include "slang/util/CowPtr.h"
 #include "slang/util/Random.h"
 #include "slang/util/ThreadPool.h"
 #include "slang/util/TimeTrace.h"
@@ -42,6 +45,7 @@ TEST_CASE("TimeTrace tests") {
 
     auto frob = [] {
         TimeTraceScope timeScope("Nested\nbaz"sv, ""sv);
+        TimeTrace::count("nested"sv);
         std::this_thread::sleep_for(std::chrono::milliseconds(10));
     };
 
@@ -50,6 +54,9 @@ TEST_CASE("TimeTrace tests") {
         pool.pushTask([i, &frob] {
             if (i % 2 == 0) {
                 TimeTraceScope timeScope("Foo\"thing"sv, std::to_string(i));
+                TimeTrace::count("widgets"sv, 2);
+                TimeTrace::count("kinds"sv, "B"sv);
+                TimeTrace::count("kinds"sv, "A"sv, 3);
                 std::this_thread::sleep_for(std::chrono::milliseconds(1));
             }
             else {
@@ -61,6 +68,118 @@ TEST_CASE("TimeTrace tests") {
 
     pool.waitForAll();
 
+    // Counts made outside of any section are kept for the thread as a whole.
+    std::thread([] { TimeTrace::count("loose"sv, 5); }).join();
+
     std::ostringstream sstr;
     TimeTrace::write(sstr);
+
+    // Counters are grouped and sorted, and nested sections add to their parents.
+    auto str = sstr.str();
+    CHECK_THAT(str, ContainsSubstring(R"("detail":"0", "widgets":2, "kinds":{ "A":3, "B":1 })"));
+    CHECK_THAT(str, ContainsSubstring(R"("detail":"1", "nested":1)"));
+    CHECK_THAT(str, ContainsSubstring(R"("detail":"", "nested":1)"));
+    CHECK_THAT(str, ContainsSubstring(R"("name":"Thread", "args":{ "detail":"", "loose":5 })"));
+}
+
+TEST_CASE("BumpAllocator statistics") {
+    BumpAllocator alloc;
+    CHECK(alloc.getSegmentCount() == 1);
+    auto initialBytes = alloc.getBytesAllocated();
+
+    // Large allocations get their own segment.
+    alloc.allocate(10000, 8);
+    CHECK(alloc.getSegmentCount() == 2);
+    CHECK(alloc.getBytesAllocated() > initialBytes + 10000);
+
+    BumpAllocator other;
+    for (int i = 0; i < 100; i++)
+        other.allocate(100, 8);
+
+    auto otherSegments = other.getSegmentCount();
+    auto otherBytes = other.getBytesAllocated();
+    CHECK(otherSegments > 1);
+
+    auto bytes = alloc.getBytesAllocated();
+    alloc.steal(std::move(other));
+    CHECK(alloc.getSegmentCount() == 2 + otherSegments);
+    CHECK(alloc.getBytesAllocated() == bytes + otherBytes);
+
+    BumpAllocator moved(std::move(alloc));
+    CHECK(moved.getSegmentCount() == 2 + otherSegments);
+    CHECK(alloc.getSegmentCount() == 0);
+}
+
+TEST_CASE("CowPtr sharing") {
+    CowPtr<std::vector<int>> a(std::vector<int>{1, 2, 3});
+    auto b = a;
+    CHECK(a.isShared());
+    CHECK(std::as_const(a).get() == std::as_const(b).get());
+
+    // Modifying one copy clones it and leaves the other alone.
+    b->push_back(4);
+    CHECK(!a.isShared());
+    CHECK(a->size() == 3);
+    CHECK(std::as_const(b)->size() == 4);
+
+    // A modified value is copied eagerly from then on, since a reference
+    // obtained from it might still be used to modify it.
+    auto& ref = (*b)[0];
+    auto c = b;
+    CHECK(!b.isShared());
+    ref = 10;
+    CHECK(std::as_const(c)->at(0) == 1);
+
+    b.allowSharing();
+    auto d = b;
+    CHECK(b.isShared());
+    CHECK(std::as_const(d)->at(0) == 10);
+
+    // Comparisons and hashes look at the values rather than the pointers.
+    CowPtr<std::string> s1(std::string("abc"));
+    CowPtr<std::string> s2(std::string("abc"));
+    CowPtr<std::string> s3(std::string("abd"));
+    CHECK(s1 == s2);
+    CHECK(s1 != s3);
+    CHECK(s1 < s3);
+    CHECK(s1 != CowPtr<std::string>());
+    CHECK(CowPtr<std::string>() == CowPtr<std::string>());
+    CHECK(std::hash<CowPtr<std::string>>{}(s1) == std::hash<CowPtr<std::string>>{}(s2));
+}
+
+TEST_CASE("CancellationToken") {
+    using namespace std::chrono_literals;
+    using Reason = CancellationToken::Reason;
+
+    CancellationToken token;
+    CHECK(!token.poll());
+    CHECK(!token.check(SIZE_MAX));
+
+    // The first reason given is the one that sticks.
+    token.cancel();
+    token.cancel(Reason::TimeLimit);
+    CHECK(token.poll());
+    CHECK(token.getReason() == Reason::Requested);
+    CHECK(token.getReasonString() == "cancellation was requested");
+
+    // Starting a new phase clears the cancellation.
+    token.start(0ms, 2 * 1024 * 1024);
+    CHECK(!token.isCancelled());
+    CHECK(!token.poll(2 * 1024 * 1024));
+    CHECK(token.poll(2 * 1024 * 1024 + 1));
+    CHECK(token.getReasonString() == "memory limit of 2 MB exceeded");
+
+    token.start(1ms, 0);
+    std::this_thread::sleep_for(5ms);
+    CHECK(token.check());
+    CHECK(token.getReasonString() == "time limit of 0.001s exceeded");
+
+    // Polling only looks at the clock every so often.
+    token.start(1ms, 0);
+    std::this_thread::sleep_for(5ms);
+    uint32_t polls = 1;
+    while (!token.poll())
+        polls++;
+    CHECK(polls == CancellationToken::PollInterval);
+    CHECK(token.getReason() == Reason::TimeLimit);
 }
@@ -0,0 +1,617 @@
+//------------------------------------------------------------------------------
+// slang_bench.cpp
+// Synthetic design generator and compiler phase benchmarks
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <fmt/format.h>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <numeric>
+
+#include "slang/ast/Compilation.h"
+#include "slang/diagnostics/DiagnosticEngine.h"
+#include "slang/diagnostics/TextDiagnosticClient.h"
+#include "slang/parsing/Lexer.h"
+#include "slang/parsing/Preprocessor.h"
+#include "slang/syntax/SyntaxTree.h"
+#include "slang/text/Json.h"
+#include "slang/text/SourceManager.h"
+#include "slang/util/CommandLine.h"
+#include "slang/util/OS.h"
+#include "slang/util/String.h"
+#include "slang/util/VersionInfo.h"
+
+using namespace slang;
+using namespace slang::ast;
+using namespace slang::parsing;
+using namespace slang::syntax;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// A chain of distinct module definitions, each instantiating the next,
+// so that the hierarchy is as deep as it is long.
+std::string genDeepHierarchy(uint32_t scale) {
+    const uint32_t depth = 200 * scale;
+
+    std::string out;
+    auto it = std::back_inserter(out);
+    for (uint32_t i = 0; i < depth; i++) {
+        fmt::format_to(it,
+                       "module level{0} #(parameter int W = 16) (input logic clk,\n"
+                       "    input logic [W-1:0] d, output logic [W-1:0] q);\n"
+                       "  logic [W-1:0] r, unused{0};\n"
+                       "  always_ff @(posedge clk) r <= d ^ W'({0});\n",
+                       i);
+
+        if (i + 1 < depth)
+            fmt::format_to(it, "  level{} #(.W(W)) u(.clk, .d(r), .q);\n", i + 1);
+        else
+            out += "  assign q = r;\n";
+        out += "endmodule\n\n";
+    }
+
+    out += "module top(input logic clk, input logic [15:0] d, output logic [15:0] q);\n"
+           "  level0 u(.clk, .d, .q);\n"
+           "endmodule\n";
+    return out;
+}
+
+// Generate loops that produce a large number of blocks, nested two deep.
+std::string genWideGenerate(uint32_t scale) {
+    const uint32_t outer = 64 * scale;
+    const uint32_t inner = 32;
+
+    return fmt::format(R"(module leaf #(parameter int I, parameter int J) (input logic [7:0] a,
+    output logic [7:0] y);
+  assign y = a + 8'(I * J);
+endmodule
+
+module top(input logic [7:0] in, output logic [7:0] out);
+  localparam int N = {0};
+  localparam int M = {1};
+  logic [7:0] chain [N * M + 1];
+  assign chain[0] = in;
+
+  for (genvar i = 0; i < N; i++) begin : row
+    for (genvar j = 0; j < M; j++) begin : col
+      localparam int K = i * M + j;
+      logic [7:0] tmp;
+      if (K % 3 == 0) begin : c
+        leaf #(.I(i), .J(j)) u(.a(chain[K]), .y(tmp));
+      end
+      else begin : a
+        assign tmp = chain[K] ^ 8'(K);
+      end
+      assign chain[K + 1] = tmp;
+    end
+  end
+
+  assign out = chain[N * M];
+endmodule
+)",
+                       outer, inner);
+}
+
+// A flat gate level netlist with lots of nets and small cell instances.
+std::string genNetlist(uint32_t scale) {
+    const uint32_t gates = 20000 * scale;
+
+    std::string out = "module nand2(input wire a, b, output wire y);\n"
+                      "  assign y = ~(a & b);\n"
+                      "endmodule\n\n"
+                      "module dff(input wire clk, d, output reg q);\n"
+                      "  always @(posedge clk) q <= d;\n"
+                      "endmodule\n\n"
+                      "module top(input wire clk, input wire [63:0] in, output wire [63:0] out);\n";
+
+    auto it = std::back_inserter(out);
+    fmt::format_to(it, "  wire [{}:0] n;\n", gates + 63);
+    out += "  assign n[63:0] = in;\n";
+
+    for (uint32_t i = 0; i < gates; i++) {
+        const uint32_t k = i + 64;
+        switch (i % 4) {
+            case 0:
+                fmt::format_to(it, "  nand2 g{}(.a(n[{}]), .b(n[{}]), .y(n[{}]));\n", i, k - 64,
+                               k - 37, k);
+                break;
+            case 1:
+                fmt::format_to(it, "  dff r{}(.clk(clk), .d(n[{}]), .q(n[{}]));\n", i, k - 1, k);
+                break;
+            case 2:
+                fmt::format_to(it, "  assign n[{}] = n[{}] ^ n[{}];\n", k, k - 2, k - 51);
+                break;
+            default:
+                fmt::format_to(it, "  wire w{0} = n[{1}] | n[{2}];\n  assign n[{3}] = w{0};\n", i,
+                               k - 3, k - 17, k);
+                break;
+        }
+    }
+
+    fmt::format_to(it, "  assign out = n[{}:{}];\n", gates + 63, gates);
+    out += "endmodule\n";
+    return out;
+}
+
+// Many macros with arguments, nested expansions, token pasting, and
+// conditional compilation, similar to generated register banks.
+std::string genMacros(uint32_t scale) {
+    const uint32_t regs = 2000 * scale;
+
+    std::string out = R"(`define FIELD(name, width) logic [width-1:0] name``_q, name``_d;
+`define FLOP(name, rst) always_ff @(posedge clk or negedge rst_n) \
+    if (!rst_n) name``_q <= rst; else name``_q <= name``_d;
+`define NEXT(name, expr) assign name``_d = (expr);
+`define REG(name, width, rst, expr) \
+    `FIELD(name, width) \
+    `FLOP(name, rst) \
+    `NEXT(name, expr)
+`define STR(x) `"x`"
+`define ADD3(a, b, c) ((a) + (b) + (c))
+
+module top(input logic clk, rst_n, input logic [31:0] in, output logic [31:0] out);
+)";
+
+    auto it = std::back_inserter(out);
+    for (uint32_t i = 0; i < regs; i++) {
+        if (i == 0) {
+            out += "  `REG(r0, 32, '0, in)\n";
+            continue;
+        }
+
+        fmt::format_to(it, "`ifdef BENCH_SKIP_{0}\n  `REG(r{0}, 32, '0, 32'd0)\n`else\n", i);
+        fmt::format_to(it, "  `REG(r{0}, 32, 32'd{0}, `ADD3(r{1}_q, 32'd{0}, in))\n", i, i - 1);
+        out += "`endif\n";
+        if (i % 50 == 0)
+            fmt::format_to(it, "  localparam string name{0} = `STR(r{0});\n", i);
+    }
+
+    fmt::format_to(it, "  assign out = r{}_q;\nendmodule\n", regs - 1);
+    return out;
+}
+
+// Constant functions with loops over large data, evaluated for parameters.
+std::string genConstFunctions(uint32_t scale) {
+    const uint32_t funcs = 40 * scale;
+
+    std::string out = R"(package funcs;
+  function automatic logic [31:0] crc32(int unsigned n);
+    logic [31:0] crc = '1;
+    for (int unsigned i = 0; i < n; i++) begin
+      logic [7:0] b = 8'(i * 31);
+      crc ^= 32'(b);
+      for (int k = 0; k < 8; k++)
+        crc = crc[0] ? (crc >> 1) ^ 32'hEDB88320 : crc >> 1;
+    end
+    return ~crc;
+  endfunction
+
+  function automatic int count_primes(int limit);
+    bit sieve [];
+    int count = 0;
+    sieve = new[limit + 1];
+    for (int i = 2; i <= limit; i++) begin
+      if (!sieve[i]) begin
+        count++;
+        for (int j = i * 2; j <= limit; j += i)
+          sieve[j] = 1;
+      end
+    end
+    return count;
+  endfunction
+)";
+
+    auto it = std::back_inserter(out);
+    for (uint32_t i = 0; i < funcs; i++) {
+        fmt::format_to(it,
+                       "\n  function automatic logic [127:0] mix{0}(int n);\n"
+                       "    logic [127:0] acc = 128'd{0};\n"
+                       "    for (int i = 0; i < n; i++)\n"
+                       "      acc = {{acc[126:0], acc[127]}} ^ 128'(i * {1});\n"
+                       "    return acc;\n"
+                       "  endfunction\n",
+                       i, 2 * i + 1);
+    }
+    out += "endpackage\n\nmodule top;\n  import funcs::*;\n";
+
+    for (uint32_t i = 0; i < funcs; i++) {
+        fmt::format_to(it,
+                       "  localparam logic [31:0] C{0} = crc32({1});\n"
+                       "  localparam int P{0} = count_primes({2});\n"
+                       "  localparam logic [127:0] M{0} = mix{0}({3});\n",
+                       i, 200 + i, 1000 + i * 10, 500 + i);
+    }
+    out += "endmodule\n";
+    return out;
+}
+
+// UVM style class hierarchies with parameterized classes, virtual methods,
+// and a factory-like registry.
+std::string genClasses(uint32_t scale) {
+    const uint32_t classes = 300 * scale;
+
+    std::string out = R"(package bench_pkg;
+  virtual class object;
+    string name;
+    function new(string name); this.name = name; endfunction
+    pure virtual function object clone();
+    pure virtual function string convert2string();
+    virtual function void do_copy(object rhs); endfunction
+  endclass
+
+  class sequence_item extends object;
+    rand bit [31:0] addr;
+    rand bit [63:0] data;
+    constraint c_addr { addr[1:0] == 0; }
+    function new(string name = "sequence_item"); super.new(name); endfunction
+    virtual function object clone();
+      sequence_item item = new(name);
+      item.do_copy(this);
+      return item;
+    endfunction
+    virtual function string convert2string();
+      return $sformatf("%s addr=%0h data=%0h", name, addr, data);
+    endfunction
+    virtual function void do_copy(object rhs);
+      sequence_item other;
+      if ($cast(other, rhs)) begin
+        addr = other.addr;
+        data = other.data;
+      end
+    endfunction
+  endclass
+
+  class registry #(type T = sequence_item, string Tname = "");
+    static T instances[$];
+    static function T create(string name);
+      T obj = new(name);
+      instances.push_back(obj);
+      return obj;
+    endfunction
+    static function string type_name(); return Tname; endfunction
+  endclass
+)";
+
+    auto it = std::back_inserter(out);
+    for (uint32_t i = 0; i < classes; i++) {
+        auto base = i % 10 == 0 ? "sequence_item"s : fmt::format("item{}", i - 1);
+        fmt::format_to(it, R"(
+  class item{0} extends {1};
+    typedef registry #(item{0}, "item{0}") type_id;
+    rand bit [15:0] f{0};
+    int unsigned count{0};
+    constraint c{0} {{ f{0} < 16'd{2}; }}
+    function new(string name = "item{0}"); super.new(name); endfunction
+    virtual function object clone();
+      item{0} item = new(name);
+      item.do_copy(this);
+      return item;
+    endfunction
+    virtual function string convert2string();
+      return $sformatf("%s f{0}=%0d", super.convert2string(), f{0});
+    endfunction
+    virtual function void do_copy(object rhs);
+      item{0} other;
+      super.do_copy(rhs);
+      if ($cast(other, rhs)) begin
+        f{0} = other.f{0};
+        count{0}++;
+      end
+    endfunction
+  endclass
+)",
+                       i, base, 100 + i);
+    }
+
+    out += "endpackage\n\nmodule top;\n  import bench_pkg::*;\n  initial begin\n"
+           "    object objs[$];\n";
+    for (uint32_t i = 0; i < classes; i += 7)
+        fmt::format_to(it, "    objs.push_back(item{0}::type_id::create(\"i{0}\"));\n", i);
+    out += "    foreach (objs[i]) $display(\"%s\", objs[i].clone().convert2string());\n"
+           "  end\nendmodule\n";
+    return out;
+}
+
+struct Workload {
+    std::string_view name;
+    std::string (*generate)(uint32_t scale);
+};
+
+constexpr Workload AllWorkloads[] = {
+    {"deep-hierarchy"sv, genDeepHierarchy},     {"wide-generate"sv, genWideGenerate},
+    {"netlist"sv, genNetlist},                  {"macros"sv, genMacros},
+    {"const-functions"sv, genConstFunctions},   {"classes"sv, genClasses},
+};
+
+enum Phase { Lex, Preprocess, Parse, Elaborate, Diagnose, PhaseCount };
+
+constexpr std::string_view PhaseNames[] = {"lex"sv, "preprocess"sv, "parse"sv, "elaborate"sv,
+                                           "diagnostics"sv};
+
+struct Result {
+    std::string_view name;
+    size_t bytes = 0;
+    size_t lines = 0;
+    size_t tokens = 0;
+    size_t diagnostics = 0;
+    std::array<std::vector<double>, PhaseCount> samples;
+};
+
+double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Runs each phase of the compiler over the generated source, timing each one separately.
+// Lexing and preprocessing are timed on their own; parsing includes both of them again
+// since that's how the parser consumes its input.
+Result runWorkload(const Workload& workload, std::string_view text, uint32_t iterations) {
+    Result result;
+    result.name = workload.name;
+    result.bytes = text.size();
+    result.lines = size_t(std::ranges::count(text, '\n'));
+
+    for (uint32_t iter = 0; iter < iterations; iter++) {
+        SourceManager sourceManager;
+        auto buffer = sourceManager.assignText(fmt::format("{}.sv", workload.name), text);
+
+        {
+            BumpAllocator alloc;
+            Diagnostics diags;
+            auto start = Clock::now();
+            Lexer lexer(buffer, alloc, diags);
+
+            size_t tokens = 0;
+            while (lexer.lex().kind != TokenKind::EndOfFile)
+                tokens++;
+
+            result.samples[Lex].push_back(msSince(start));
+            result.tokens = tokens;
+        }
+
+        {
+            BumpAllocator alloc;
+            Diagnostics diags;
+            auto start = Clock::now();
+            Preprocessor preprocessor(sourceManager, alloc, diags);
+            preprocessor.pushSource(buffer);
+            while (preprocessor.next().kind != TokenKind::EndOfFile) {
+            }
+            result.samples[Preprocess].push_back(msSince(start));
+        }
+
+        auto start = Clock::now();
+        auto tree = SyntaxTree::fromBuffer(buffer, sourceManager);
+        result.samples[Parse].push_back(msSince(start));
+
+        // The deep hierarchy workload goes well past the default instance depth limit.
+        Bag options;
+        CompilationOptions compOptions;
+        compOptions.maxInstanceDepth = 8192;
+        options.set(compOptions);
+
+        start = Clock::now();
+        Compilation compilation(options);
+        compilation.addSyntaxTree(tree);
+        auto& diags = compilation.getAllDiagnostics();
+        result.samples[Elaborate].push_back(msSince(start));
+
+        // Every warning is turned on so that there's a meaningful amount of work to do.
+        start = Clock::now();
+        DiagnosticEngine engine(sourceManager);
+        std::vector warningOptions{"everything"s};
+        engine.setWarningOptions(warningOptions);
+
+        auto client = std::make_shared<TextDiagnosticClient>();
+        engine.addClient(client);
+        for (auto& diag : diags)
+            engine.issue(diag);
+
+        auto output = client->getString();
+        result.samples[Diagnose].push_back(msSince(start));
+        result.diagnostics = size_t(engine.getNumErrors() + engine.getNumWarnings());
+    }
+
+    return result;
+}
+
+double minOf(const std::vector<double>& samples) {
+    return *std::ranges::min_element(samples);
+}
+
+double meanOf(const std::vector<double>& samples) {
+    return std::accumulate(samples.begin(), samples.end(), 0.0) / double(samples.size());
+}
+
+void writeJson(std::ostream& stream, std::span<const Result> results, uint32_t scale,
+               uint32_t iterations) {
+    JsonWriter writer(stream);
+    writer.setPrettyPrint(true);
+
+    writer.startObject();
+    writer.writeProperty("version");
+    writer.writeValue(fmt::format("{}.{}.{}+{}", VersionInfo::getMajor(), VersionInfo::getMinor(),
+                                  VersionInfo::getPatch(), VersionInfo::getHash()));
+    writer.writeProperty("scale");
+    writer.writeValue(uint64_t(scale));
+    writer.writeProperty("iterations");
+    writer.writeValue(uint64_t(iterations));
+
+    writer.writeProperty("workloads");
+    writer.startArray();
+    for (auto& result : results) {
+        writer.startObject();
+        writer.writeProperty("name");
+        writer.writeValue(result.name);
+        writer.writeProperty("bytes");
+        writer.writeValue(uint64_t(result.bytes));
+        writer.writeProperty("lines");
+        writer.writeValue(uint64_t(result.lines));
+        writer.writeProperty("tokens");
+        writer.writeValue(uint64_t(result.tokens));
+        writer.writeProperty("diagnostics");
+        writer.writeValue(uint64_t(result.diagnostics));
+
+        // All times are in milliseconds.
+        writer.writeProperty("phases");
+        writer.startObject();
+        for (size_t i = 0; i < PhaseCount; i++) {
+            auto& samples = result.samples[i];
+            writer.writeProperty(PhaseNames[i]);
+            writer.startObject();
+            writer.writeProperty("min");
+            writer.writeValue(minOf(samples));
+            writer.writeProperty("mean");
+            writer.writeValue(meanOf(samples));
+            writer.writeProperty("samples");
+            writer.startArray();
+            for (auto sample : samples)
+                writer.writeValue(sample);
+            writer.endArray();
+            writer.endObject();
+        }
+        writer.endObject();
+        writer.endObject();
+    }
+    writer.endArray();
+    writer.endObject();
+    writer.writeNewLine();
+    writer.flush();
+}
+
+void printTable(std::span<const Result> results) {
+    OS::print(fmt::format("{:<16} {:>10} {:>10}", "workload", "lines", "tokens"));
+    for (auto name : PhaseNames)
+        OS::print(fmt::format(" {:>12}", name));
+    OS::print("\n");
+
+    for (auto& result : results) {
+        OS::print(fmt::format("{:<16} {:>10} {:>10}", result.name, result.lines, result.tokens));
+        for (auto& samples : result.samples)
+            OS::print(fmt::format(" {:>12.2f}", minOf(samples)));
+        OS::print("\n");
+    }
+    OS::print("\n(minimum time of each phase in milliseconds)\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    OS::setupConsole();
+
+    CommandLine cmdLine;
+    std::optional<bool> showHelp;
+    std::optional<bool> showVersion;
+    std::optional<bool> listWorkloads;
+    std::vector<std::string> workloadNames;
+    std::optional<uint32_t> scale;
+    std::optional<uint32_t> iterations;
+    std::optional<std::string> jsonFile;
+    std::optional<std::string> emitDir;
+
+    cmdLine.add("-h,--help", showHelp, "Display available options");
+    cmdLine.add("--version", showVersion, "Display version information and exit");
+    cmdLine.add("--list", listWorkloads, "List the available workloads and exit");
+    cmdLine.add("-w,--workload", workloadNames,
+                "One or more workloads to run (instead of all of them)", "<name>",
+                CommandLineFlags::CommaList);
+    cmdLine.add("--scale", scale,
+                "Multiplier for the size of each generated design (default 1)", "<n>");
+    cmdLine.add("--iterations", iterations,
+                "Number of times to run each workload (default 3)", "<n>");
+    cmdLine.add("--json", jsonFile,
+                "Write results to the given file in JSON format, or '-' for stdout", "<file>",
+                CommandLineFlags::FilePath);
+    cmdLine.add("--emit", emitDir,
+                "Write the generated source for each workload to the given directory", "<dir>",
+                CommandLineFlags::FilePath);
+
+    if (!cmdLine.parse(argc, argv)) {
+        for (auto& err : cmdLine.getErrors())
+            OS::printE(fmt::format("{}\n", err));
+        return 1;
+    }
+
+    if (showHelp == true) {
+        OS::print(fmt::format("{}\n", cmdLine.getHelpText("slang compiler benchmarks")));
+        return 0;
+    }
+
+    if (showVersion == true) {
+        OS::print(fmt::format("slang-bench version {}.{}.{}+{}\n", VersionInfo::getMajor(),
+                              VersionInfo::getMinor(), VersionInfo::getPatch(),
+                              VersionInfo::getHash()));
+        return 0;
+    }
+
+    if (listWorkloads == true) {
+        for (auto& workload : AllWorkloads)
+            OS::print(fmt::format("{}\n", workload.name));
+        return 0;
+    }
+
+    std::vector<const Workload*> selected;
+    for (auto& workload : AllWorkloads) {
+        if (workloadNames.empty() ||
+            std::ranges::find(workloadNames, workload.name) != workloadNames.end()) {
+            selected.push_back(&workload);
+        }
+    }
+
+    for (auto& name : workloadNames) {
+        if (std::ranges::none_of(AllWorkloads, [&](auto& w) { return w.name == name; })) {
+            OS::printE(fmt::format("error: unknown workload '{}'\n", name));
+            return 1;
+        }
+    }
+
+    const uint32_t scaleValue = std::max(scale.value_or(1), 1u);
+    const uint32_t iterValue = std::max(iterations.value_or(3), 1u);
+
+    std::vector<Result> results;
+    SLANG_TRY {
+        for (auto workload : selected) {
+            auto text = workload->generate(scaleValue);
+            if (emitDir) {
+                auto path = fs::path(*emitDir) / fmt::format("{}.sv", workload->name);
+                std::ofstream file(path);
+                file.exceptions(std::ios::failbit | std::ios::badbit);
+                file << text;
+            }
+
+            // Progress goes to stderr so that JSON written to stdout stays clean.
+            OS::printE(fmt::format("running {}...\n", workload->name));
+            results.push_back(runWorkload(*workload, text, iterValue));
+        }
+
+        if (jsonFile == "-") {
+            writeJson(std::cout, results, scaleValue, iterValue);
+        }
+        else if (jsonFile) {
+            std::ofstream file(*jsonFile);
+            file.exceptions(std::ios::failbit | std::ios::badbit);
+            writeJson(file, results, scaleValue, iterValue);
+        }
+
+        if (jsonFile != "-")
+            printTable(results);
+    }
+    SLANG_CATCH(const std::exception& e) {
+#if __cpp_exceptions
+        OS::printE(fmt::format("error: {}\n", e.what()));
+#endif
+        return 2;
+    }
+
+    return 0;
+}
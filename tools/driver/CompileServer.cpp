@@ -0,0 +1,240 @@
+//------------------------------------------------------------------------------
+// CompileServer.cpp
+// Local socket server and client for running the driver persistently
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#include "CompileServer.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fmt/format.h>
+
+#include "slang/util/OS.h"
+#include "slang/util/String.h"
+
+#if !defined(_WIN32)
+#    include <cerrno>
+#    include <csignal>
+#    include <cstring>
+#    include <sys/socket.h>
+#    include <sys/un.h>
+#    include <unistd.h>
+#endif
+
+using namespace slang;
+
+#if defined(_WIN32)
+
+int runCompileServer(const std::string&, const CompileRequestHandler&) {
+    OS::printE("error: the compile server is not supported on this platform\n");
+    return 1;
+}
+
+std::optional<int> runCompileClient(const std::string&, std::span<const std::string>) {
+    return std::nullopt;
+}
+
+#else
+
+// Messages are sequences of strings, each of which is sent as a 32-bit
+// length followed by its bytes. A request is the working directory followed
+// by the arguments, and a response is the exit code, stdout, and stderr text.
+static constexpr uint32_t MaxMessageStrings = 1u << 20;
+
+static bool readAll(int fd, char* data, size_t size) {
+    while (size > 0) {
+        auto result = ::read(fd, data, size);
+        if (result < 0 && errno == EINTR)
+            continue;
+        if (result <= 0)
+            return false;
+
+        data += result;
+        size -= size_t(result);
+    }
+    return true;
+}
+
+static bool writeAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        auto result = ::write(fd, data, size);
+        if (result < 0 && errno == EINTR)
+            continue;
+        if (result <= 0)
+            return false;
+
+        data += result;
+        size -= size_t(result);
+    }
+    return true;
+}
+
+static bool readUInt(int fd, uint32_t& value) {
+    return readAll(fd, reinterpret_cast<char*>(&value), sizeof(value));
+}
+
+static bool writeUInt(int fd, uint32_t value) {
+    return writeAll(fd, reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+static bool readString(int fd, std::string& str) {
+    uint32_t size;
+    if (!readUInt(fd, size))
+        return false;
+
+    str.resize(size);
+    return readAll(fd, str.data(), size);
+}
+
+static bool writeString(int fd, std::string_view str) {
+    return writeUInt(fd, uint32_t(str.size())) && writeAll(fd, str.data(), str.size());
+}
+
+static bool makeAddress(const std::string& socketPath, sockaddr_un& addr) {
+    addr = {};
+    addr.sun_family = AF_UNIX;
+    if (socketPath.empty() || socketPath.size() >= sizeof(addr.sun_path))
+        return false;
+
+    std::memcpy(addr.sun_path, socketPath.data(), socketPath.size());
+    return true;
+}
+
+static int connectTo(const sockaddr_un& addr) {
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        return -1;
+
+    if (::connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static volatile std::sig_atomic_t stopRequested = 0;
+
+static void handleStopSignal(int) {
+    stopRequested = 1;
+}
+
+static void handleConnection(int fd, const CompileRequestHandler& handler) {
+    uint32_t count;
+    if (!readUInt(fd, count) || count == 0 || count > MaxMessageStrings)
+        return;
+
+    CompileRequest request;
+    if (!readString(fd, request.workingDir))
+        return;
+
+    request.args.resize(count - 1);
+    for (auto& arg : request.args) {
+        if (!readString(fd, arg))
+            return;
+    }
+
+    // If the client has gone away in the meantime there's no one left to tell.
+    auto response = handler(request);
+    if (writeUInt(fd, uint32_t(response.exitCode)) && writeString(fd, response.output))
+        writeString(fd, response.errors);
+}
+
+int runCompileServer(const std::string& socketPath, const CompileRequestHandler& handler) {
+    auto printError = [&](std::string_view message) {
+        OS::printE(fmt::format("error: '{}': {}\n", socketPath, message));
+        return 1;
+    };
+
+    sockaddr_un addr;
+    if (!makeAddress(socketPath, addr))
+        return printError("invalid socket path");
+
+    // Don't take the socket away from a server that's still running.
+    if (int fd = connectTo(addr); fd >= 0) {
+        ::close(fd);
+        return printError("a compile server is already listening on this socket");
+    }
+
+    int listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0)
+        return printError(std::strerror(errno));
+
+    ::unlink(socketPath.c_str());
+    if (::bind(listenFd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        ::listen(listenFd, 16) != 0) {
+        auto message = std::strerror(errno);
+        ::close(listenFd);
+        return printError(message);
+    }
+
+    // Interrupting the server should still clean up the socket file, so the
+    // handlers are installed without SA_RESTART to break out of accept().
+    // Clients that disconnect early shouldn't take the server down with them.
+    struct sigaction action = {};
+    action.sa_handler = handleStopSignal;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    OS::printE(fmt::format("slang compile server listening on '{}'\n", socketPath));
+
+    int result = 0;
+    while (!stopRequested) {
+        int fd = ::accept(listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR)
+                continue;
+
+            result = printError(std::strerror(errno));
+            break;
+        }
+
+        handleConnection(fd, handler);
+        ::close(fd);
+    }
+
+    ::close(listenFd);
+    ::unlink(socketPath.c_str());
+    return result;
+}
+
+std::optional<int> runCompileClient(const std::string& socketPath,
+                                    std::span<const std::string> args) {
+    sockaddr_un addr;
+    if (!makeAddress(socketPath, addr))
+        return std::nullopt;
+
+    int fd = connectTo(addr);
+    if (fd < 0)
+        return std::nullopt;
+
+    std::error_code ec;
+    auto workingDir = getU8Str(std::filesystem::current_path(ec));
+
+    // A server that goes away partway through is treated the same
+    // as there not being one, since nothing has been printed yet.
+    std::signal(SIGPIPE, SIG_IGN);
+    bool sent = writeUInt(fd, uint32_t(args.size() + 1)) && writeString(fd, workingDir);
+    for (auto& arg : args)
+        sent = sent && writeString(fd, arg);
+
+    uint32_t exitCode = 0;
+    std::string output, errors;
+    bool received = sent && readUInt(fd, exitCode) && readString(fd, output) &&
+                    readString(fd, errors);
+    ::close(fd);
+
+    if (!received)
+        return std::nullopt;
+
+    std::fwrite(output.data(), 1, output.size(), stdout);
+    std::fflush(stdout);
+    std::fwrite(errors.data(), 1, errors.size(), stderr);
+    std::fflush(stderr);
+    return int(exitCode);
+}
+
+#endif
@@ -0,0 +1,50 @@
+//------------------------------------------------------------------------------
+//! @file CompileServer.h
+//! @brief Local socket server and client for running the driver persistently
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+/// A request sent by a client to the compile server.
+struct CompileRequest {
+    /// The working directory of the client, against which
+    /// relative paths in the arguments are resolved.
+    std::string workingDir;
+
+    /// The command line arguments, not including the program name.
+    std::vector<std::string> args;
+};
+
+/// The result of handling a request, which is sent back to the client.
+struct CompileResponse {
+    /// The exit code the client should return.
+    int exitCode = 0;
+
+    /// Text to write to the client's stdout.
+    std::string output;
+
+    /// Text to write to the client's stderr.
+    std::string errors;
+};
+
+using CompileRequestHandler = std::function<CompileResponse(const CompileRequest&)>;
+
+/// Listens on a Unix domain socket at @a socketPath and passes each request
+/// that arrives to @a handler, one at a time, until the process is interrupted
+/// or terminated. Returns the exit code for the server process.
+int runCompileServer(const std::string& socketPath, const CompileRequestHandler& handler);
+
+/// Sends @a args along with the current working directory to the compile server
+/// listening at @a socketPath, and writes its response to stdout and stderr.
+/// Returns the exit code sent back by the server, or std::nullopt if there is no
+/// server listening (or it went away before responding).
+std::optional<int> runCompileClient(const std::string& socketPath,
+                                    std::span<const std::string> args);
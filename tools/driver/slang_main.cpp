@@ -5,18 +5,25 @@
 // SPDX-FileCopyrightText: Michael Popoloski
 // SPDX-License-Identifier: MIT
 //------------------------------------------------------------------------------
+#include "CompileServer.h"
+
 #include <fmt/color.h>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 
 #include "slang/ast/ASTSerializer.h"
 #include "slang/ast/Compilation.h"
 #include "slang/ast/symbols/CompilationUnitSymbols.h"
+#include "slang/diagnostics/JsonDiagnosticClient.h"
 #include "slang/diagnostics/TextDiagnosticClient.h"
 #include "slang/driver/Driver.h"
 #include "slang/syntax/SyntaxTree.h"
+#include "slang/text/BinaryTree.h"
 #include "slang/text/Json.h"
+#include "slang/util/ScopeGuard.h"
 #include "slang/util/String.h"
+#include "slang/util/ThreadPool.h"
 #include "slang/util/TimeTrace.h"
 #include "slang/util/VersionInfo.h"
 
@@ -24,12 +31,10 @@ using namespace slang;
 using namespace slang::ast;
 using namespace slang::driver;
 
-void printJson(Compilation& compilation, const std::string& fileName,
-               const std::vector<std::string>& scopes, bool includeSourceInfo) {
-    JsonWriter writer;
-    writer.setPrettyPrint(true);
+namespace fs = std::filesystem;
 
-    ASTSerializer serializer(compilation, writer);
+void serializeAST(ASTSerializer& serializer, Compilation& compilation,
+                  const std::vector<std::string>& scopes, bool includeSourceInfo) {
     serializer.setIncludeSourceInfo(includeSourceInfo);
     if (scopes.empty()) {
         serializer.startObject();
@@ -49,30 +54,84 @@ void printJson(Compilation& compilation, const std::string& fileName,
                 serializer.serialize(*sym);
         }
     }
+}
+
+void printJson(Compilation& compilation, const std::string& fileName,
+               const std::vector<std::string>& scopes, bool includeSourceInfo, bool compact,
+               std::optional<uint32_t> numThreads, std::ostream& out) {
+    auto writeJson = [&](std::ostream& stream) {
+        // Output is streamed out in chunks as it's produced so that
+        // memory usage doesn't scale with the size of the design.
+        JsonWriter writer(stream);
+        writer.setPrettyPrint(!compact);
+
+        // Independent top-level scopes can be serialized in parallel, but only
+        // if elaboration ran to completion; lazily elaborated, stopped, or cancelled
+        // compilations would still create state while being serialized.
+        std::optional<ThreadPool> threadPool;
+        ASTSerializer serializer(compilation, writer);
+        if (numThreads != 1u && compilation.isFullyElaborated()) {
+            threadPool.emplace(numThreads.value_or(0u));
+            serializer.setThreadPool(&*threadPool);
+        }
+
+        serializeAST(serializer, compilation, scopes, includeSourceInfo);
+
+        writer.writeNewLine();
+        writer.flush();
+        stream.flush();
+    };
 
-    writer.writeNewLine();
-    OS::writeFile(fileName, writer.view());
+    if (fileName == "-") {
+        writeJson(out);
+    }
+    else {
+        std::ofstream file(fileName);
+        file.exceptions(std::ios::failbit | std::ios::badbit);
+        writeJson(file);
+    }
 }
 
-template<typename TArgs>
-int driverMain(int argc, TArgs argv) {
-    SLANG_TRY {
-        OS::setupConsole();
-        OS::tryEnableColors();
+void printBinary(Compilation& compilation, const std::string& fileName,
+                 const std::vector<std::string>& scopes, bool includeSourceInfo,
+                 std::ostream& out) {
+    BinaryTreeWriter writer;
 
-        Driver driver;
+    // Multiple scopes are wrapped in an array so that the result is a single tree.
+    ASTSerializer serializer(compilation, writer);
+    if (scopes.size() > 1)
+        serializer.startArray();
+    serializeAST(serializer, compilation, scopes, includeSourceInfo);
+    if (scopes.size() > 1)
+        serializer.endArray();
+
+    auto contents = writer.finish();
+    if (fileName == "-") {
+        out.write(contents.data(), (std::streamsize)contents.size());
+        out.flush();
+    }
+    else {
+        std::ofstream file(fileName, std::ios::binary);
+        file.exceptions(std::ios::failbit | std::ios::badbit);
+        file.write(contents.data(), (std::streamsize)contents.size());
+        file.flush();
+    }
+}
+
+// The driver along with all of the options that the main program adds to it.
+// The compile server keeps one of these alive between requests so that it
+// can reuse the loaded sources, syntax trees, and compilation.
+class MainDriver {
+public:
+    Driver driver;
+
+    MainDriver() {
         driver.addStandardArgs();
 
-        std::optional<bool> showHelp;
-        std::optional<bool> showVersion;
-        std::optional<bool> quiet;
         driver.cmdLine.add("-h,--help", showHelp, "Display available options");
         driver.cmdLine.add("--version", showVersion, "Display version information and exit");
         driver.cmdLine.add("-q,--quiet", quiet, "Suppress non-essential output");
 
-        std::optional<bool> onlyPreprocess;
-        std::optional<bool> onlyParse;
-        std::optional<bool> onlyMacros;
         driver.cmdLine.add("-E,--preprocess", onlyPreprocess,
                            "Only run the preprocessor (and print preprocessed files to stdout)");
         driver.cmdLine.add("--macros-only", onlyMacros, "Print a list of found macros and exit");
@@ -80,9 +139,6 @@ int driverMain(int argc, TArgs argv) {
             "--parse-only", onlyParse,
             "Stop after parsing input files, don't perform elaboration or type checking");
 
-        std::optional<bool> includeComments;
-        std::optional<bool> includeDirectives;
-        std::optional<bool> obfuscateIds;
         driver.cmdLine.add("--comments", includeComments,
                            "Include comments in preprocessed output (with -E)");
         driver.cmdLine.add("--directives", includeDirectives,
@@ -90,31 +146,81 @@ int driverMain(int argc, TArgs argv) {
         driver.cmdLine.add("--obfuscate-ids", obfuscateIds,
                            "Randomize all identifiers in preprocessed output (with -E)");
 
-        std::optional<std::string> astJsonFile;
         driver.cmdLine.add(
             "--ast-json", astJsonFile,
             "Dump the compiled AST in JSON format to the specified file, or '-' for stdout",
             "<file>", CommandLineFlags::FilePath);
 
-        std::vector<std::string> astJsonScopes;
+        driver.cmdLine.add("--ast-json-compact", astJsonCompact,
+                           "When dumping AST to JSON, omit all indentation and whitespace");
+
+        driver.cmdLine.add("--ast-binary", astBinaryFile,
+                           "Dump the compiled AST in a compact binary format to the specified "
+                           "file, or '-' for stdout",
+                           "<file>", CommandLineFlags::FilePath);
+
         driver.cmdLine.add("--ast-json-scope", astJsonScopes,
-                           "When dumping AST to JSON, include only the scopes specified by the "
+                           "When dumping the AST, include only the scopes specified by the "
                            "given hierarchical paths",
                            "<path>");
 
-        std::optional<bool> includeSourceInfo;
         driver.cmdLine.add("--ast-json-source-info", includeSourceInfo,
-                           "When dumping AST to JSON, include source line and file information");
+                           "When dumping the AST, include source line and file information");
+
+        driver.cmdLine.add("--diag-json", diagJsonFile,
+                           "Also write all diagnostics to the specified file as JSON Lines, "
+                           "or '-' for stdout",
+                           "<file>", CommandLineFlags::FilePath);
+
+        driver.cmdLine.add("--diag-sarif", diagSarifFile,
+                           "Also write all diagnostics to the specified file in SARIF format, "
+                           "or '-' for stdout",
+                           "<file>", CommandLineFlags::FilePath);
+
+        driver.cmdLine.add("--depfile", depfile,
+                           "Only preprocess and parse the input files, and write the files that "
+                           "each compilation unit depends on to the specified file in the "
+                           "Makefile depfile format, or '-' for stdout",
+                           "<file>", CommandLineFlags::FilePath);
+
+        driver.cmdLine.add("--depfile-target", depfileTarget,
+                           "Write a single depfile rule for the given target, listing every "
+                           "input file, instead of one rule per compilation unit (with --depfile)",
+                           "<name>");
+
+        driver.cmdLine.add("--dep-json", depJsonFile,
+                           "Only preprocess and parse the input files, and write the dependency "
+                           "graph between compilation units to the specified file in JSON "
+                           "format, or '-' for stdout",
+                           "<file>", CommandLineFlags::FilePath);
+
+        driver.cmdLine.add("--prune-filelist", prunedFilelist,
+                           "Only preprocess and parse the input files, and write a command file "
+                           "listing just the source files needed to elaborate the modules given "
+                           "by --top to the specified file, or '-' for stdout",
+                           "<file>", CommandLineFlags::FilePath);
 
-        std::optional<std::string> timeTrace;
         driver.cmdLine.add("--time-trace", timeTrace,
                            "Do performance profiling of the slang compiler and output "
                            "the results to the given file in Chrome Event Tracing JSON format",
                            "<path>");
 
-        if (!driver.parseCommandLine(argc, argv))
-            return 1;
+        // These are handled in main() before the rest of the command line is parsed;
+        // they're only listed here so that they show up in the help text.
+        driver.cmdLine.add("--server", serverSocket,
+                           "Run as a compile server listening on the given Unix socket, "
+                           "keeping sources and compilation results in memory between "
+                           "requests (must be the first argument)",
+                           "<socket>", CommandLineFlags::FilePath);
+        driver.cmdLine.add("--connect", connectSocket,
+                           "Send the rest of the command line to the compile server listening "
+                           "on the given Unix socket, or compile locally if there isn't one "
+                           "(must be the first argument)",
+                           "<socket>", CommandLineFlags::FilePath);
+    }
 
+    /// Runs the driver on the command line that has been parsed.
+    int run(std::ostream& out) {
         if (showHelp == true) {
             OS::print(
                 fmt::format("{}", driver.cmdLine.getHelpText("slang SystemVerilog compiler")));
@@ -128,21 +234,79 @@ int driverMain(int argc, TArgs argv) {
             return 0;
         }
 
+        if (serverSocket || connectSocket) {
+            OS::printE(fg(driver.diagClient->errorColor), "error: ");
+            OS::printE("--server and --connect must be the first argument\n");
+            return 3;
+        }
+
         if (!driver.processOptions())
             return 2;
 
+        bool scanDeps = depfile || depJsonFile;
         if (onlyParse.has_value() + onlyPreprocess.has_value() + onlyMacros.has_value() +
-                driver.options.lintMode() >
+                driver.options.lintMode() + scanDeps + prunedFilelist.has_value() >
             1) {
             OS::printE(fg(driver.diagClient->errorColor), "error: ");
             OS::printE("can only specify one of --preprocess, --macros-only, "
-                       "--parse-only, --lint-only");
+                       "--parse-only, --lint-only, --depfile / --dep-json, --prune-filelist");
+            return 3;
+        }
+
+        if (prunedFilelist && driver.options.topModules.empty()) {
+            OS::printE(fg(driver.diagClient->errorColor), "error: ");
+            OS::printE("--prune-filelist requires the top modules to be given with --top\n");
+            return 3;
+        }
+
+        if (!driver.batchConfigs.empty() && (astJsonFile || astBinaryFile)) {
+            OS::printE(fg(driver.diagClient->errorColor), "error: ");
+            OS::printE("--ast-json and --ast-binary can't be used with --batch\n");
             return 3;
         }
 
         if (timeTrace)
             TimeTrace::initialize();
 
+        // Machine-readable diagnostics are written alongside the normal text output.
+        std::vector<std::unique_ptr<std::ofstream>> diagFiles;
+        std::vector<std::shared_ptr<JsonDiagnosticClient>> jsonClients;
+        auto addJsonClient = [&](const std::string& fileName, JsonDiagnosticClient::Format format) {
+            std::ostream* stream = &out;
+            if (fileName != "-") {
+                auto& file = diagFiles.emplace_back(std::make_unique<std::ofstream>(fileName));
+                file->exceptions(std::ios::failbit | std::ios::badbit);
+                stream = file.get();
+            }
+
+            auto client = std::make_shared<JsonDiagnosticClient>(*stream, format);
+            client->showColumn(driver.options.diagColumn.value_or(true));
+            driver.diagEngine.addClient(client);
+            jsonClients.push_back(std::move(client));
+        };
+
+        if (diagJsonFile)
+            addJsonClient(*diagJsonFile, JsonDiagnosticClient::Format::JsonLines);
+        if (diagSarifFile)
+            addJsonClient(*diagSarifFile, JsonDiagnosticClient::Format::Sarif);
+
+        auto finishDiagOutput = [&] {
+            for (auto& client : jsonClients)
+                client->finish();
+            for (auto& file : diagFiles)
+                file->flush();
+        };
+
+        // Leave complete JSON documents behind on early returns as well. Errors
+        // writing them out are only reported on the normal path below.
+        ScopeGuard diagGuard([&] {
+            SLANG_TRY {
+                finishDiagOutput();
+            }
+            SLANG_CATCH(const std::exception&) {
+            }
+        });
+
         bool ok = true;
         SLANG_TRY {
             if (onlyPreprocess == true) {
@@ -156,19 +320,44 @@ int driverMain(int argc, TArgs argv) {
                 ok = driver.parseAllSources();
                 ok &= driver.reportParseDiags();
             }
+            else if (scanDeps) {
+                {
+                    TimeTraceScope timeScope("parseAllSources"sv, ""sv);
+                    ok = driver.parseAllSources();
+                }
+                ok &= driver.reportParseDiags();
+                if (!driver.wasParseCancelled())
+                    writeDependencies(out);
+            }
+            else if (prunedFilelist) {
+                {
+                    TimeTraceScope timeScope("parseAllSources"sv, ""sv);
+                    ok = driver.parseAllSources();
+                }
+                ok &= driver.reportParseDiags();
+                if (!driver.wasParseCancelled())
+                    writePrunedFilelist(out);
+            }
             else {
                 {
                     TimeTraceScope timeScope("parseAllSources"sv, ""sv);
                     ok = driver.parseAllSources();
                 }
 
-                {
+                // An incomplete set of sources would only produce spurious errors.
+                if (driver.wasParseCancelled()) {
+                    ok = false;
+                }
+                else if (!driver.batchConfigs.empty()) {
                     TimeTraceScope timeScope("elaboration"sv, ""sv);
-                    auto compilation = driver.createCompilation();
-                    ok &= driver.reportCompilation(*compilation, quiet == true);
-                    if (astJsonFile)
-                        printJson(*compilation, *astJsonFile, astJsonScopes,
-                                  includeSourceInfo == true);
+                    ok &= driver.runBatch(quiet == true);
+                }
+                else {
+                    // Only a run with a clean set of sources can be picked back up later.
+                    // Extra diagnostic clients can't be removed from the engine once
+                    // they've been added, so runs that use them start fresh every time.
+                    canRerun = ok && jsonClients.empty();
+                    ok &= elaborate(out);
                 }
             }
         }
@@ -176,20 +365,175 @@ int driverMain(int argc, TArgs argv) {
 #if __cpp_exceptions
             OS::printE(fmt::format("internal compiler error: {}\n", e.what()));
 #endif
+            canRerun = false;
             return 4;
         }
 
-        if (timeTrace) {
-            std::ofstream file(*timeTrace);
-            TimeTrace::write(file);
-            if (!file.flush()) {
-                SLANG_THROW(std::runtime_error(
-                    fmt::format("Unable to write time trace to '{}'", *timeTrace)));
+        finishDiagOutput();
+        writeTimeTrace();
+        return ok ? 0 : 5;
+    }
+
+    /// Runs the driver again on the same command line, picking up any changes
+    /// made to the source files since the last run. Returns std::nullopt if the
+    /// previous run can't be reused, in which case a new driver should be used.
+    std::optional<int> rerun(std::ostream& out) {
+        if (!canRerun)
+            return std::nullopt;
+
+        canRerun = false;
+        driver.diagEngine.clearCounts();
+        driver.diagClient->clear();
+
+        if (timeTrace)
+            TimeTrace::initialize();
+
+        bool ok;
+        SLANG_TRY {
+            auto prevTrees = driver.syntaxTrees;
+            {
+                TimeTraceScope timeScope("parseAllSources"sv, ""sv);
+                if (!driver.reparseChangedSources())
+                    return std::nullopt;
             }
+
+            // If none of the sources changed, the previous compilation
+            // (and all of its diagnostics) is still valid.
+            if (driver.syntaxTrees != prevTrees)
+                compilation.reset();
+
+            canRerun = true;
+            ok = elaborate(out);
+        }
+        SLANG_CATCH(const std::exception& e) {
+#if __cpp_exceptions
+            OS::printE(fmt::format("internal compiler error: {}\n", e.what()));
+#endif
+            canRerun = false;
+            return 4;
         }
 
+        writeTimeTrace();
         return ok ? 0 : 5;
     }
+
+private:
+    bool elaborate(std::ostream& out) {
+        TimeTraceScope timeScope("elaboration"sv, ""sv);
+        if (!compilation)
+            compilation = driver.createCompilation();
+
+        bool ok = driver.reportCompilation(*compilation, quiet == true);
+        if (astJsonFile) {
+            printJson(*compilation, *astJsonFile, astJsonScopes, includeSourceInfo == true,
+                      astJsonCompact == true, driver.options.numThreads, out);
+        }
+        if (astBinaryFile)
+            printBinary(*compilation, *astBinaryFile, astJsonScopes, includeSourceInfo == true, out);
+        return ok;
+    }
+
+    template<typename TFunc>
+    static void writeOutput(const std::string& fileName, std::ostream& out, TFunc&& writeTo) {
+        if (fileName == "-") {
+            writeTo(out);
+            out.flush();
+        }
+        else {
+            std::ofstream file(fileName);
+            file.exceptions(std::ios::failbit | std::ios::badbit);
+            writeTo(file);
+            file.flush();
+        }
+    }
+
+    void writeDependencies(std::ostream& out) {
+        TimeTraceScope timeScope("writeDependencies"sv, ""sv);
+        auto deps = driver.scanDependencies();
+
+        if (depfile) {
+            writeOutput(*depfile, out, [&](std::ostream& stream) {
+                driver.writeDepfile(stream, deps, depfileTarget.value_or(""));
+            });
+        }
+
+        if (depJsonFile) {
+            writeOutput(*depJsonFile, out, [&](std::ostream& stream) {
+                JsonWriter writer(stream);
+                writer.setPrettyPrint(true);
+                Driver::writeDependencyGraph(writer, deps);
+                writer.writeNewLine();
+                writer.flush();
+            });
+        }
+    }
+
+    void writePrunedFilelist(std::ostream& out) {
+        TimeTraceScope timeScope("writePrunedFilelist"sv, ""sv);
+        auto compilation = driver.createCompilation();
+        auto sources = driver.findRequiredSources(*compilation);
+
+        for (auto name : sources.unresolved) {
+            OS::printE(fg(driver.diagClient->warningColor), "warning: ");
+            OS::printE(fmt::format("no definition or package named '{}' was found\n", name));
+        }
+
+        writeOutput(*prunedFilelist, out,
+                    [&](std::ostream& stream) { driver.writeFilelist(stream, sources); });
+    }
+
+    void writeTimeTrace() {
+        if (!timeTrace)
+            return;
+
+        std::ofstream file(*timeTrace);
+        TimeTrace::write(file);
+        if (!file.flush()) {
+            SLANG_THROW(
+                std::runtime_error(fmt::format("Unable to write time trace to '{}'", *timeTrace)));
+        }
+    }
+
+    std::optional<bool> showHelp;
+    std::optional<bool> showVersion;
+    std::optional<bool> quiet;
+    std::optional<bool> onlyPreprocess;
+    std::optional<bool> onlyParse;
+    std::optional<bool> onlyMacros;
+    std::optional<bool> includeComments;
+    std::optional<bool> includeDirectives;
+    std::optional<bool> obfuscateIds;
+    std::optional<std::string> astJsonFile;
+    std::optional<bool> astJsonCompact;
+    std::optional<std::string> astBinaryFile;
+    std::vector<std::string> astJsonScopes;
+    std::optional<bool> includeSourceInfo;
+    std::optional<std::string> diagJsonFile;
+    std::optional<std::string> diagSarifFile;
+    std::optional<std::string> depfile;
+    std::optional<std::string> depfileTarget;
+    std::optional<std::string> depJsonFile;
+    std::optional<std::string> prunedFilelist;
+    std::optional<std::string> timeTrace;
+    std::optional<std::string> serverSocket;
+    std::optional<std::string> connectSocket;
+
+    std::unique_ptr<Compilation> compilation;
+    bool canRerun = false;
+};
+
+template<typename TArgs>
+int driverMain(int argc, TArgs argv) {
+    SLANG_TRY {
+        OS::setupConsole();
+        OS::tryEnableColors();
+
+        MainDriver mainDriver;
+        if (!mainDriver.driver.parseCommandLine(argc, argv))
+            return 1;
+
+        return mainDriver.run(std::cout);
+    }
     SLANG_CATCH(const std::exception& e) {
 #if __cpp_exceptions
         OS::printE(fmt::format("{}\n", e.what()));
@@ -200,7 +544,108 @@ int driverMain(int argc, TArgs argv) {
 
 #ifndef FUZZ_TARGET
 
+// Everything that decides what a compile server request builds. The arguments
+// alone aren't enough, since the command files they reference can be edited and
+// the files that globs match can come and go between requests.
+struct ReuseKey {
+    std::string workingDir;
+    std::vector<std::string> args;
+    std::vector<Driver::CommandFile> commandFiles;
+    std::vector<fs::path> sourceFiles;
+
+    ReuseKey(const CompileRequest& request, const Driver& driver) :
+        workingDir(request.workingDir), args(request.args),
+        commandFiles(driver.getCommandFiles().begin(), driver.getCommandFiles().end()),
+        sourceFiles(driver.sourceLoader.getFilePaths()) {}
+
+    bool operator==(const ReuseKey&) const = default;
+};
+
+int runServer(const std::string& socketPath) {
+    // The command line of each request is always processed again, but the driver
+    // from the previous request is reused if that comes up with the same inputs,
+    // so that only the sources that have changed since then need to be parsed again.
+    std::unique_ptr<MainDriver> lastDriver;
+    std::optional<ReuseKey> lastKey;
+
+    return runCompileServer(socketPath, [&](const CompileRequest& request) {
+        CompileResponse response;
+        std::error_code ec;
+        fs::current_path(request.workingDir, ec);
+        if (ec) {
+            response.exitCode = 6;
+            response.errors = fmt::format("error: '{}': {}\n", request.workingDir, ec.message());
+            return response;
+        }
+
+        auto guard = OS::captureOutput();
+        std::ostringstream out;
+        std::optional<int> result;
+        SLANG_TRY {
+            auto nextDriver = std::make_unique<MainDriver>();
+
+            std::vector<const char*> argv{"slang"};
+            for (auto& arg : request.args)
+                argv.push_back(arg.c_str());
+
+            if (!nextDriver->driver.parseCommandLine(int(argv.size()), argv.data())) {
+                lastDriver.reset();
+                lastKey.reset();
+                result = 1;
+            }
+            else {
+                ReuseKey key(request, nextDriver->driver);
+                if (lastDriver && key == lastKey)
+                    result = lastDriver->rerun(out);
+
+                if (!result) {
+                    lastDriver = std::move(nextDriver);
+                    lastKey = std::move(key);
+                    result = lastDriver->run(out);
+                }
+            }
+        }
+        SLANG_CATCH(const std::exception& e) {
+#if __cpp_exceptions
+            OS::printE(fmt::format("{}\n", e.what()));
+#endif
+            lastDriver.reset();
+            lastKey.reset();
+            result = 6;
+        }
+
+        response.exitCode = *result;
+        response.output = std::move(OS::capturedStdout) + out.str();
+        response.errors = std::move(OS::capturedStderr);
+        return response;
+    });
+}
+
 int main(int argc, char** argv) {
+    if (argc >= 2) {
+        // The compile server options have to come first, since everything
+        // after them is meant for the server rather than for us.
+        std::string_view firstArg = argv[1];
+        if (firstArg == "--server"sv || firstArg == "--connect"sv) {
+            if (argc < 3) {
+                OS::printE(fmt::format("error: no socket path given for '{}'\n", firstArg));
+                return 1;
+            }
+
+            if (firstArg == "--server"sv)
+                return runServer(argv[2]);
+
+            std::vector<std::string> args(argv + 3, argv + argc);
+            if (auto result = runCompileClient(argv[2], args))
+                return *result;
+
+            // There's no server listening, so do the work ourselves.
+            std::vector<char*> localArgs{argv[0]};
+            localArgs.insert(localArgs.end(), argv + 3, argv + argc);
+            return driverMain(int(localArgs.size()), localArgs.data());
+        }
+    }
+
     return driverMain(argc, argv);
 }
 
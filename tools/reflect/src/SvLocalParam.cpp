@@ -6,8 +6,11 @@
 void unwrapUnpackedArray(const std::span<const slang::ConstantValue> constantValues,
                          std::vector<std::vector<uint64_t>>& values, uint64_t& biggestElementSize) {
     if (constantValues.front().isUnpacked())
-        for (const auto& unpackedArray : constantValues)
-            unwrapUnpackedArray(unpackedArray.elements(), values, biggestElementSize);
+        for (auto unpackedArray : constantValues) {
+            unpackedArray.expandDense();
+            unwrapUnpackedArray(std::as_const(unpackedArray).elements(), values,
+                                biggestElementSize);
+        }
     else if (constantValues.front().isInteger()) {
         std::vector<uint64_t> collectedValues;
         for (const auto& value : constantValues) {
@@ -31,7 +34,9 @@ void SvLocalParam::toCpp(HppFile& hppFile, std::string_view, const SvAliases&, b
         std::vector<std::vector<uint64_t>> unpackedArrays;
         uint64_t biggestSize = 0;
         SLANG_TRY {
-            unwrapUnpackedArray(parameter.getValue().elements(), unpackedArrays, biggestSize);
+            auto value = parameter.getValue();
+            value.expandDense();
+            unwrapUnpackedArray(std::as_const(value).elements(), unpackedArrays, biggestSize);
         }
         SLANG_CATCH(const std::runtime_error& error) {
 #if __cpp_exceptions